@@ -34,6 +34,15 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 
+#ifdef RTC_ENABLE_H265
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_h265.h"
+#include "modules/video_coding/h265_packet_buffer.h"
+#endif
+#ifdef RTC_ENABLE_H266
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_h266.h"
+#include "modules/video_coding/h266_packet_buffer.h"
+#endif
+
 namespace webrtc {
 namespace {
 std::unique_ptr<VideoRtpDepacketizer> CreateDepacketizer(
@@ -52,9 +61,19 @@ std::unique_ptr<VideoRtpDepacketizer> CreateDepacketizer(
     case RtpVideoFrameAssembler::kGeneric:
       return std::make_unique<VideoRtpDepacketizerGeneric>();
     case RtpVideoFrameAssembler::kH265:
-      // TODO(bugs.webrtc.org/13485): Implement VideoRtpDepacketizerH265
+#ifdef RTC_ENABLE_H265
+      return std::make_unique<VideoRtpDepacketizerH265>();
+#else
+      RTC_DCHECK_NOTREACHED();
+      return nullptr;
+#endif
+    case RtpVideoFrameAssembler::kH266:
+#ifdef RTC_ENABLE_H266
+      return std::make_unique<VideoRtpDepacketizerH266>();
+#else
       RTC_DCHECK_NOTREACHED();
       return nullptr;
+#endif
   }
   RTC_DCHECK_NOTREACHED();
   return nullptr;
@@ -63,7 +82,8 @@ std::unique_ptr<VideoRtpDepacketizer> CreateDepacketizer(
 
 class RtpVideoFrameAssembler::Impl {
  public:
-  explicit Impl(std::unique_ptr<VideoRtpDepacketizer> depacketizer);
+  Impl(RtpVideoFrameAssembler::PayloadFormat payload_format,
+       std::unique_ptr<VideoRtpDepacketizer> depacketizer);
   ~Impl() = default;
 
   FrameVector InsertPacket(const RtpPacketReceived& packet);
@@ -72,6 +92,10 @@ class RtpVideoFrameAssembler::Impl {
   using RtpFrameVector =
       absl::InlinedVector<std::unique_ptr<RtpFrameObject>, 3>;
 
+  video_coding::PacketBuffer::InsertResult InsertIntoPacketBuffer(
+      std::unique_ptr<video_coding::PacketBuffer::Packet> packet);
+  video_coding::PacketBuffer::InsertResult InsertPaddingIntoPacketBuffer(
+      uint16_t seq_num);
   RtpFrameVector AssembleFrames(
       video_coding::PacketBuffer::InsertResult insert_result);
   FrameVector FindReferences(RtpFrameVector frames);
@@ -87,13 +111,36 @@ class RtpVideoFrameAssembler::Impl {
   absl::optional<int64_t> video_structure_frame_id_;
   std::unique_ptr<VideoRtpDepacketizer> depacketizer_;
   video_coding::PacketBuffer packet_buffer_;
+#ifdef RTC_ENABLE_H265
+  // H265 payloads do not tell where a frame starts, so frames are delimited
+  // by RTP timestamp and marker bit instead of by `packet_buffer_`.
+  std::unique_ptr<H265PacketBuffer> h265_packet_buffer_;
+#endif
+#ifdef RTC_ENABLE_H266
+  // Same as `h265_packet_buffer_`, for H266.
+  std::unique_ptr<H266PacketBuffer> h266_packet_buffer_;
+#endif
   RtpFrameReferenceFinder reference_finder_;
 };
 
 RtpVideoFrameAssembler::Impl::Impl(
+    RtpVideoFrameAssembler::PayloadFormat payload_format,
     std::unique_ptr<VideoRtpDepacketizer> depacketizer)
     : depacketizer_(std::move(depacketizer)),
-      packet_buffer_(/*start_buffer_size=*/2048, /*max_buffer_size=*/2048) {}
+      packet_buffer_(/*start_buffer_size=*/2048, /*max_buffer_size=*/2048) {
+#ifdef RTC_ENABLE_H265
+  if (payload_format == RtpVideoFrameAssembler::kH265) {
+    h265_packet_buffer_ = std::make_unique<H265PacketBuffer>(
+        /*irap_only_keyframes_allowed=*/true);
+  }
+#endif
+#ifdef RTC_ENABLE_H266
+  if (payload_format == RtpVideoFrameAssembler::kH266) {
+    h266_packet_buffer_ = std::make_unique<H266PacketBuffer>(
+        /*irap_only_keyframes_allowed=*/true);
+  }
+#endif
+}
 
 RtpVideoFrameAssembler::FrameVector RtpVideoFrameAssembler::Impl::InsertPacket(
     const RtpPacketReceived& rtp_packet) {
@@ -129,7 +176,38 @@ RtpVideoFrameAssembler::FrameVector RtpVideoFrameAssembler::Impl::InsertPacket(
 
   ClearOldData(rtp_packet.SequenceNumber());
   return FindReferences(
-      AssembleFrames(packet_buffer_.InsertPacket(std::move(packet))));
+      AssembleFrames(InsertIntoPacketBuffer(std::move(packet))));
+}
+
+video_coding::PacketBuffer::InsertResult
+RtpVideoFrameAssembler::Impl::InsertIntoPacketBuffer(
+    std::unique_ptr<video_coding::PacketBuffer::Packet> packet) {
+#ifdef RTC_ENABLE_H265
+  if (h265_packet_buffer_) {
+    return h265_packet_buffer_->InsertPacket(std::move(packet));
+  }
+#endif
+#ifdef RTC_ENABLE_H266
+  if (h266_packet_buffer_) {
+    return h266_packet_buffer_->InsertPacket(std::move(packet));
+  }
+#endif
+  return packet_buffer_.InsertPacket(std::move(packet));
+}
+
+video_coding::PacketBuffer::InsertResult
+RtpVideoFrameAssembler::Impl::InsertPaddingIntoPacketBuffer(uint16_t seq_num) {
+#ifdef RTC_ENABLE_H265
+  if (h265_packet_buffer_) {
+    return h265_packet_buffer_->InsertPadding(seq_num);
+  }
+#endif
+#ifdef RTC_ENABLE_H266
+  if (h266_packet_buffer_) {
+    return h266_packet_buffer_->InsertPadding(seq_num);
+  }
+#endif
+  return packet_buffer_.InsertPadding(seq_num);
 }
 
 void RtpVideoFrameAssembler::Impl::ClearOldData(uint16_t incoming_seq_num) {
@@ -204,7 +282,7 @@ RtpVideoFrameAssembler::Impl::FindReferences(RtpFrameVector frames) {
 RtpVideoFrameAssembler::FrameVector
 RtpVideoFrameAssembler::Impl::UpdateWithPadding(uint16_t seq_num) {
   auto res =
-      FindReferences(AssembleFrames(packet_buffer_.InsertPadding(seq_num)));
+      FindReferences(AssembleFrames(InsertPaddingIntoPacketBuffer(seq_num)));
   auto ref_finder_update = reference_finder_.PaddingReceived(seq_num);
 
   for (std::unique_ptr<RtpFrameObject>& complete_frame : ref_finder_update) {
@@ -332,7 +410,8 @@ bool RtpVideoFrameAssembler::Impl::ParseGenericDescriptorExtension(
 }
 
 RtpVideoFrameAssembler::RtpVideoFrameAssembler(PayloadFormat payload_format)
-    : impl_(std::make_unique<Impl>(CreateDepacketizer(payload_format))) {}
+    : impl_(std::make_unique<Impl>(payload_format,
+                                   CreateDepacketizer(payload_format))) {}
 
 RtpVideoFrameAssembler::~RtpVideoFrameAssembler() = default;
 
@@ -52,7 +52,16 @@ class RtpVideoFrameAssembler {
   // FrameVector is just a vector-like type of std::unique_ptr<EncodedFrame>.
   // The vector type may change without notice.
   using FrameVector = absl::InlinedVector<AssembledFrame, 3>;
-  enum PayloadFormat { kRaw, kH264, kVp8, kVp9, kAv1, kGeneric, kH265 };
+  enum PayloadFormat {
+    kRaw,
+    kH264,
+    kVp8,
+    kVp9,
+    kAv1,
+    kGeneric,
+    kH265,
+    kH266
+  };
 
   explicit RtpVideoFrameAssembler(PayloadFormat payload_format);
   RtpVideoFrameAssembler(const RtpVideoFrameAssembler& other) = delete;
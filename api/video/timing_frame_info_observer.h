@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_TIMING_FRAME_INFO_OBSERVER_H_
+#define API_VIDEO_TIMING_FRAME_INFO_OBSERVER_H_
+
+#include "api/video/video_timing.h"
+
+namespace webrtc {
+
+// Receives the TimingFrameInfo of every frame decoded by a video receive
+// stream. Unlike the receive stream stats, which only expose the slowest
+// timing frame of a recent window, this sees each frame and is meant for tools
+// that trace per-frame pipeline latency.
+//
+// OnTimingFrameInfo() is called on the decoder callback thread of the stream,
+// before the frame is passed on for rendering, and must be thread safe and
+// cheap.
+class TimingFrameInfoObserver {
+ public:
+  virtual ~TimingFrameInfoObserver() = default;
+
+  virtual void OnTimingFrameInfo(const TimingFrameInfo& info) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_TIMING_FRAME_INFO_OBSERVER_H_
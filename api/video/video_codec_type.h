@@ -23,6 +23,7 @@ enum VideoCodecType {
   kVideoCodecH264,
   kVideoCodecMultiplex,
   kVideoCodecH265,
+  kVideoCodecH266,
 };
 
 }  // namespace webrtc
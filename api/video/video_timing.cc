@@ -48,6 +48,7 @@ TimingFrameInfo::TimingFrameInfo()
       receive_start_ms(-1),
       receive_finish_ms(-1),
       decode_start_ms(-1),
+      first_slice_decode_start_ms(-1),
       decode_finish_ms(-1),
       render_time_ms(-1),
       flags(VideoSendTiming::kNotTriggered) {}
@@ -98,6 +98,10 @@ struct RTC_EXPORT TimingFrameInfo {
   int64_t receive_start_ms;   // First received packet time.
   int64_t receive_finish_ms;  // Last received packet time.
   int64_t decode_start_ms;    // Decode start time.
+  // Time the first part of the frame was passed to the decoder. Equal to
+  // `decode_start_ms` unless the frame was decoded in parts while it was
+  // still being received.
+  int64_t first_slice_decode_start_ms;
   int64_t decode_finish_ms;   // Decode completion time.
   int64_t render_time_ms;     // Proposed render time to insure smooth playback.
 
@@ -29,6 +29,7 @@ constexpr char kPayloadNameH264[] = "H264";
 constexpr char kPayloadNameGeneric[] = "Generic";
 constexpr char kPayloadNameMultiplex[] = "Multiplex";
 constexpr char kPayloadNameH265[] = "H265";
+constexpr char kPayloadNameH266[] = "H266";
 }  // namespace
 
 bool VideoCodecVP8::operator==(const VideoCodecVP8& other) const {
@@ -129,6 +130,8 @@ const char* CodecTypeToPayloadString(VideoCodecType type) {
       return kPayloadNameGeneric;
     case kVideoCodecH265:
       return kPayloadNameH265;
+    case kVideoCodecH266:
+      return kPayloadNameH266;
   }
   RTC_CHECK_NOTREACHED();
 }
@@ -147,6 +150,8 @@ VideoCodecType PayloadStringToCodecType(const std::string& name) {
     return kVideoCodecMultiplex;
   if (absl::EqualsIgnoreCase(name, kPayloadNameH265))
     return kVideoCodecH265;
+  if (absl::EqualsIgnoreCase(name, kPayloadNameH266))
+    return kVideoCodecH266;
   return kVideoCodecGeneric;
 }
 
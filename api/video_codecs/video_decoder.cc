@@ -36,6 +36,15 @@ VideoDecoder::DecoderInfo VideoDecoder::GetDecoderInfo() const {
   return info;
 }
 
+int32_t VideoDecoder::DecodePart(const EncodedImage& input_part,
+                                 bool last_part) {
+  RTC_DCHECK_NOTREACHED() << "Decoder does not support frame parts.";
+  // WEBRTC_VIDEO_CODEC_ERROR.
+  return -1;
+}
+
+void VideoDecoder::DiscardFrameParts() {}
+
 const char* VideoDecoder::ImplementationName() const {
   return "unknown";
 }
@@ -48,12 +57,15 @@ std::string VideoDecoder::DecoderInfo::ToString() const {
       << "prefers_late_decoding = "
       << "implementation_name = '" << implementation_name << "', "
       << "is_hardware_accelerated = "
-      << (is_hardware_accelerated ? "true" : "false") << " }";
+      << (is_hardware_accelerated ? "true" : "false") << ", "
+      << "supports_frame_parts = "
+      << (supports_frame_parts ? "true" : "false") << " }";
   return oss.str();
 }
 
 bool VideoDecoder::DecoderInfo::operator==(const DecoderInfo& rhs) const {
   return is_hardware_accelerated == rhs.is_hardware_accelerated &&
+         supports_frame_parts == rhs.supports_frame_parts &&
          implementation_name == rhs.implementation_name;
 }
 
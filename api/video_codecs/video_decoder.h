@@ -51,6 +51,9 @@ class RTC_EXPORT VideoDecoder {
     // True if the decoder is backed by hardware acceleration.
     bool is_hardware_accelerated = false;
 
+    // True if frames may be passed to `DecodePart` in parts.
+    bool supports_frame_parts = false;
+
     std::string ToString() const;
     bool operator==(const DecoderInfo& rhs) const;
     bool operator!=(const DecoderInfo& rhs) const { return !(*this == rhs); }
@@ -85,11 +88,18 @@ class RTC_EXPORT VideoDecoder {
     VideoCodecType codec_type() const { return codec_type_; }
     void set_codec_type(VideoCodecType value) { codec_type_ = value; }
 
+    // When true, the user of the VideoDecoder interface may pass frames to
+    // `DecodePart` while they are still being received, if the decoder
+    // reports `DecoderInfo::supports_frame_parts`.
+    bool frame_parts_enabled() const { return frame_parts_enabled_; }
+    void set_frame_parts_enabled(bool value) { frame_parts_enabled_ = value; }
+
    private:
     absl::optional<int> buffer_pool_size_;
     RenderResolution max_resolution_;
     int number_of_cores_ = 1;
     VideoCodecType codec_type_ = kVideoCodecGeneric;
+    bool frame_parts_enabled_ = false;
   };
 
   virtual ~VideoDecoder() = default;
@@ -113,6 +123,20 @@ class RTC_EXPORT VideoDecoder {
     return Decode(input_image, render_time_ms);
   }
 
+  // Decodes a part of a frame, which ends on a slice or tile boundary, so that
+  // decoding overlaps with the reception of the rest of the frame. The parts
+  // of a frame share its RTP timestamp, are passed in bitstream order and
+  // together make up the complete frame, which is delivered to the decode
+  // complete callback once it has been decoded. A frame left unfinished is
+  // dropped with `DiscardFrameParts` before the next frame is decoded. Only
+  // called on decoders that report `DecoderInfo::supports_frame_parts`.
+  virtual int32_t DecodePart(const EncodedImage& input_part, bool last_part);
+
+  // Drops what has been decoded of a frame passed to `DecodePart` without its
+  // last part, so that the frame can be passed to `Decode` as a whole, or be
+  // skipped.
+  virtual void DiscardFrameParts();
+
   virtual int32_t RegisterDecodeCompleteCallback(
       DecodedImageCallback* callback) = 0;
 
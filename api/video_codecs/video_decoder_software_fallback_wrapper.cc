@@ -174,6 +174,10 @@ void VideoDecoderSoftwareFallbackWrapper::UpdateFallbackDecoderHistograms() {
       RTC_HISTOGRAM_COUNTS_100000(kFallbackHistogramsUmaPrefix + "H265",
                                   hw_decoded_frames_since_last_fallback_);
       break;
+    case kVideoCodecH266:
+      RTC_HISTOGRAM_COUNTS_100000(kFallbackHistogramsUmaPrefix + "H266",
+                                  hw_decoded_frames_since_last_fallback_);
+      break;
   }
 }
 
@@ -256,6 +260,9 @@ VideoDecoder::DecoderInfo VideoDecoderSoftwareFallbackWrapper::GetDecoderInfo()
     // Cached "A (fallback from B)" string.
     info.implementation_name = fallback_implementation_name_;
   }
+  // Frame parts would have to be replayed on the fallback decoder if the
+  // active decoder fails mid-frame, so they are not passed through.
+  info.supports_frame_parts = false;
   return info;
 }
 
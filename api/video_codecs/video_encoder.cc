@@ -89,6 +89,13 @@ bool VideoEncoder::ResolutionBitrateLimits::operator==(
          max_bitrate_bps == rhs.max_bitrate_bps;
 }
 
+bool VideoEncoder::EncodeSpeedStats::operator==(
+    const EncodeSpeedStats& rhs) const {
+  return speed == rhs.speed && num_threads == rhs.num_threads &&
+         encode_time_fraction == rhs.encode_time_fraction &&
+         num_adaptations == rhs.num_adaptations;
+}
+
 VideoEncoder::EncoderInfo::EncoderInfo()
     : scaling_settings(VideoEncoder::ScalingSettings::kOff),
       requested_resolution_alignment(1),
@@ -186,6 +193,15 @@ std::string VideoEncoder::EncoderInfo::ToString() const {
   if (is_qp_trusted.has_value()) {
     oss << ", is_qp_trusted = " << is_qp_trusted.value();
   }
+  if (encode_latency.has_value()) {
+    oss << ", encode_latency = " << webrtc::ToString(*encode_latency);
+  }
+  if (encode_speed.has_value()) {
+    oss << ", encode_speed = { speed = " << encode_speed->speed
+        << ", num_threads = " << encode_speed->num_threads
+        << ", encode_time_fraction = " << encode_speed->encode_time_fraction
+        << ", num_adaptations = " << encode_speed->num_adaptations << " }";
+  }
   oss << "}";
   return oss.str();
 }
@@ -225,6 +241,11 @@ bool VideoEncoder::EncoderInfo::operator==(const EncoderInfo& rhs) const {
     return false;
   }
 
+  if (encode_latency != rhs.encode_latency ||
+      encode_speed != rhs.encode_speed) {
+    return false;
+  }
+
   return true;
 }
 
@@ -20,6 +20,7 @@
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_codec_constants.h"
@@ -80,6 +81,22 @@ class RTC_EXPORT EncodedImageCallback {
       const EncodedImage& encoded_image,
       const CodecSpecificInfo* codec_specific_info) = 0;
 
+  // Optionally called by encoders that produce an image in self-contained
+  // parts, e.g. slices, as soon as each part is complete, so that it can be
+  // sent before the rest of the image is encoded. `encoded_part` carries the
+  // data of the part and the metadata of the image. The parts of an image are
+  // delivered in decoding order, with `last_part` set on the final one. The
+  // complete image must still be delivered to OnEncodedImage() afterwards,
+  // but is not sent again if all of its parts were. Callbacks that can't send
+  // parts return ERROR_SEND_FAILED, in which case the image is only sent
+  // from OnEncodedImage().
+  virtual Result OnEncodedImagePart(
+      const EncodedImage& encoded_part,
+      const CodecSpecificInfo* codec_specific_info,
+      bool last_part) {
+    return Result(Result::ERROR_SEND_FAILED);
+  }
+
   virtual void OnDroppedFrame(DropReason reason) {}
 };
 
@@ -150,6 +167,24 @@ class RTC_EXPORT VideoEncoder {
     }
   };
 
+  // State of an encoder that adapts its speed setting to the measured encode
+  // time, see Settings::target_encode_time_fraction.
+  struct EncodeSpeedStats {
+    // Codec specific speed setting currently used for the base layer.
+    int speed = 0;
+    int num_threads = 1;
+    // Smoothed encode time as a fraction of the frame interval, or a negative
+    // value if not yet measured since the last adaptation.
+    double encode_time_fraction = -1.0;
+    // Number of times the speed or the number of threads have been changed.
+    int num_adaptations = 0;
+
+    bool operator==(const EncodeSpeedStats& rhs) const;
+    bool operator!=(const EncodeSpeedStats& rhs) const {
+      return !(*this == rhs);
+    }
+  };
+
   // Struct containing metadata about the encoder implementing this interface.
   struct RTC_EXPORT EncoderInfo {
     static constexpr uint8_t kMaxFramerateFraction =
@@ -259,6 +294,15 @@ class RTC_EXPORT VideoEncoder {
     // Indicates whether or not QP value encoder writes into frame/slice/tile
     // header can be interpreted as average frame/slice/tile QP.
     absl::optional<bool> is_qp_trusted;
+
+    // Time from the most recently delivered frame being passed to Encode()
+    // until its encoded image was returned through the EncodedImageCallback.
+    // Set by encoders that keep frames in an internal pipeline, where output
+    // may be delivered from a later Encode() call.
+    absl::optional<TimeDelta> encode_latency;
+
+    // Set by encoders that adapt their speed to the measured encode time.
+    absl::optional<EncodeSpeedStats> encode_speed;
   };
 
   struct RTC_EXPORT RateControlParameters {
@@ -333,6 +377,15 @@ class RTC_EXPORT VideoEncoder {
     // Experimental API - currently only supported by LibvpxVp8Encoder and
     // the OpenH264 encoder. If set, limits the number of encoder threads.
     absl::optional<int> encoder_thread_limit;
+    // Experimental API - currently only supported by LibvpxVp8Encoder,
+    // LibvpxVp9Encoder and LibaomAv1Encoder. If set, the encoder adapts its
+    // speed setting and number of threads so that encoding a frame takes
+    // about this fraction of the frame interval.
+    absl::optional<double> target_encode_time_fraction;
+    // Experimental API - currently only supported by SimulcastEncoderAdapter.
+    // If set, the encoders of the simulcast streams encode each frame in
+    // parallel, using up to `number_of_cores` threads.
+    bool parallel_simulcast_encoding = false;
   };
 
   static VideoCodecVP8 GetDefaultVp8Settings();
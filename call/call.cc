@@ -1078,7 +1078,7 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
   // in a valid state, since OnRtpPacket runs on the same thread.
   FlexfecReceiveStreamImpl* receive_stream = new FlexfecReceiveStreamImpl(
       clock_, std::move(config), &video_receiver_controller_,
-      call_stats_->AsRtcpRttStats());
+      call_stats_->AsRtcpRttStats(), trials_);
 
   // TODO(bugs.webrtc.org/11993): Set this up asynchronously on the network
   // thread.
@@ -13,6 +13,7 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -21,6 +22,7 @@
 #include "api/rtp_parameters.h"
 #include "call/rtp_stream_receiver_controller_interface.h"
 #include "modules/rtp_rtcp/include/flexfec_receiver.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_receiver.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -60,8 +62,15 @@ bool FlexfecReceiveStream::Config::IsCompleteAndEnabled() const {
 
 namespace {
 
+bool UseReedSolomonFec(const FieldTrialsView& field_trials) {
+  return field_trials.IsEnabled("WebRTC-ReedSolomonFec");
+}
+
+// Creates a FlexfecReceiver or ReedSolomonFecReceiver, which are configured in
+// the same way.
 // TODO(brandtr): Update this function when we support multistream protection.
-std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
+template <typename FecReceiver>
+std::unique_ptr<FecReceiver> MaybeCreateFecReceiver(
     Clock* clock,
     const FlexfecReceiveStream::Config& config,
     RecoveredPacketReceiver* recovered_packet_receiver) {
@@ -95,9 +104,9 @@ std::unique_ptr<FlexfecReceiver> MaybeCreateFlexfecReceiver(
     return nullptr;
   }
   RTC_DCHECK_EQ(1U, config.protected_media_ssrcs.size());
-  return std::unique_ptr<FlexfecReceiver>(new FlexfecReceiver(
-      clock, config.rtp.remote_ssrc, config.protected_media_ssrcs[0],
-      recovered_packet_receiver));
+  return std::make_unique<FecReceiver>(clock, config.rtp.remote_ssrc,
+                                       config.protected_media_ssrcs[0],
+                                       recovered_packet_receiver);
 }
 
 std::unique_ptr<ModuleRtpRtcpImpl2> CreateRtpRtcpModule(
@@ -122,11 +131,19 @@ FlexfecReceiveStreamImpl::FlexfecReceiveStreamImpl(
     Clock* clock,
     Config config,
     RecoveredPacketReceiver* recovered_packet_receiver,
-    RtcpRttStats* rtt_stats)
+    RtcpRttStats* rtt_stats,
+    const FieldTrialsView& field_trials)
     : remote_ssrc_(config.rtp.remote_ssrc),
       payload_type_(config.payload_type),
-      receiver_(
-          MaybeCreateFlexfecReceiver(clock, config, recovered_packet_receiver)),
+      receiver_(UseReedSolomonFec(field_trials)
+                    ? nullptr
+                    : MaybeCreateFecReceiver<FlexfecReceiver>(
+                          clock, config, recovered_packet_receiver)),
+      reed_solomon_receiver_(
+          UseReedSolomonFec(field_trials)
+              ? MaybeCreateFecReceiver<ReedSolomonFecReceiver>(
+                    clock, config, recovered_packet_receiver)
+              : nullptr),
       rtp_receive_statistics_(ReceiveStatistics::Create(clock)),
       rtp_rtcp_(CreateRtpRtcpModule(clock,
                                     rtp_receive_statistics_.get(),
@@ -150,7 +167,7 @@ void FlexfecReceiveStreamImpl::RegisterWithTransport(
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   RTC_DCHECK(!rtp_stream_receiver_);
 
-  if (!receiver_)
+  if (!receiver_ && !reed_solomon_receiver_)
     return;
 
   // TODO(nisse): OnRtpPacket in this class delegates all real work to
@@ -168,10 +185,13 @@ void FlexfecReceiveStreamImpl::UnregisterFromTransport() {
 
 void FlexfecReceiveStreamImpl::OnRtpPacket(const RtpPacketReceived& packet) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
-  if (!receiver_)
+  if (receiver_) {
+    receiver_->OnRtpPacket(packet);
+  } else if (reed_solomon_receiver_) {
+    reed_solomon_receiver_->OnRtpPacket(packet);
+  } else {
     return;
-
-  receiver_->OnRtpPacket(packet);
+  }
 
   // Do not report media packets in the RTCP RRs generated by `rtp_rtcp_`.
   if (packet.Ssrc() == remote_ssrc()) {
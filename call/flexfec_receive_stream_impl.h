@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "api/field_trials_view.h"
 #include "call/flexfec_receive_stream.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
@@ -25,6 +26,7 @@ namespace webrtc {
 class FlexfecReceiver;
 class ReceiveStatistics;
 class RecoveredPacketReceiver;
+class ReedSolomonFecReceiver;
 class RtcpRttStats;
 class RtpPacketReceived;
 class RtpRtcp;
@@ -36,7 +38,8 @@ class FlexfecReceiveStreamImpl : public FlexfecReceiveStream {
   FlexfecReceiveStreamImpl(Clock* clock,
                            Config config,
                            RecoveredPacketReceiver* recovered_packet_receiver,
-                           RtcpRttStats* rtt_stats);
+                           RtcpRttStats* rtt_stats,
+                           const FieldTrialsView& field_trials);
   // Destruction happens on the worker thread. Prior to destruction the caller
   // must ensure that a registration with the transport has been cleared. See
   // `RegisterWithTransport` for details.
@@ -83,8 +86,11 @@ class FlexfecReceiveStreamImpl : public FlexfecReceiveStream {
   // disabled.
   int payload_type_ RTC_GUARDED_BY(packet_sequence_checker_) = -1;
 
-  // Erasure code interfacing.
+  // Erasure code interfacing. With the WebRTC-ReedSolomonFec field trial the
+  // stream receives Reed-Solomon FEC in place of FlexFEC, and only
+  // `reed_solomon_receiver_` is set.
   const std::unique_ptr<FlexfecReceiver> receiver_;
+  const std::unique_ptr<ReedSolomonFecReceiver> reed_solomon_receiver_;
 
   // RTCP reporting.
   const std::unique_ptr<ReceiveStatistics> rtp_receive_statistics_;
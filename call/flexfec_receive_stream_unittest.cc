@@ -14,6 +14,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "api/call/transport.h"
 #include "api/rtp_headers.h"
@@ -24,12 +25,15 @@
 #include "modules/rtp_rtcp/mocks/mock_recovered_packet_receiver.h"
 #include "modules/rtp_rtcp/mocks/mock_rtcp_rtt_stats.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/thread.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/mock_transport.h"
+#include "test/scoped_key_value_config.h"
 
 namespace webrtc {
 
@@ -38,6 +42,7 @@ namespace {
 using ::testing::_;
 using ::testing::Eq;
 using ::testing::Property;
+using ::testing::SizeIs;
 
 constexpr uint8_t kFlexfecPlType = 118;
 constexpr uint8_t kFlexfecSsrc[] = {0x00, 0x00, 0x00, 0x01};
@@ -85,17 +90,19 @@ TEST(FlexfecReceiveStreamConfigTest, IsCompleteAndEnabled) {
 
 class FlexfecReceiveStreamTest : public ::testing::Test {
  protected:
-  FlexfecReceiveStreamTest()
-      : config_(CreateDefaultConfig(&rtcp_send_transport_)) {
+  explicit FlexfecReceiveStreamTest(absl::string_view field_trials = "")
+      : field_trials_(field_trials),
+        config_(CreateDefaultConfig(&rtcp_send_transport_)) {
     receive_stream_ = std::make_unique<FlexfecReceiveStreamImpl>(
         Clock::GetRealTimeClock(), config_, &recovered_packet_receiver_,
-        &rtt_stats_);
+        &rtt_stats_, field_trials_);
     receive_stream_->RegisterWithTransport(&rtp_stream_receiver_controller_);
   }
 
   ~FlexfecReceiveStreamTest() { receive_stream_->UnregisterFromTransport(); }
 
   rtc::AutoThread main_thread_;
+  test::ScopedKeyValueConfig field_trials_;
   MockTransport rtcp_send_transport_;
   FlexfecReceiveStream::Config config_;
   MockRecoveredPacketReceiver recovered_packet_receiver_;
@@ -151,4 +158,52 @@ TEST_F(FlexfecReceiveStreamTest, RecoversPacket) {
   receive_stream_->UnregisterFromTransport();
 }
 
+class ReedSolomonFecReceiveStreamTest : public FlexfecReceiveStreamTest {
+ protected:
+  ReedSolomonFecReceiveStreamTest()
+      : FlexfecReceiveStreamTest("WebRTC-ReedSolomonFec/Enabled/") {}
+};
+
+// Protect two media packets with one Reed-Solomon FEC packet and ensure that
+// the lost one is recovered. Correctness of recovery is checked in the
+// ReedSolomonFecReceiver unit tests.
+TEST_F(ReedSolomonFecReceiveStreamTest, RecoversPacket) {
+  constexpr uint8_t kMediaPlType = 107;
+  constexpr uint16_t kReceivedSeqNum = 2;
+  constexpr uint16_t kLostSeqNum = 3;
+  ReedSolomonFecSender sender(
+      kFlexfecPlType, config_.rtp.remote_ssrc, config_.protected_media_ssrcs[0],
+      /*mid=*/"", /*rtp_header_extensions=*/{}, /*extension_sizes=*/{},
+      /*rtp_state=*/nullptr, Clock::GetRealTimeClock());
+  FecProtectionParams params;
+  // One FEC packet for the two media packets.
+  params.fec_rate = 128;
+  params.max_fec_frames = 1;
+  sender.SetProtectionParameters(params, params);
+
+  std::vector<RtpPacketReceived> received_packets;
+  for (uint16_t seq_num : {kReceivedSeqNum, kLostSeqNum}) {
+    RtpPacketToSend packet(nullptr);
+    packet.SetPayloadType(kMediaPlType);
+    packet.SetSsrc(config_.protected_media_ssrcs[0]);
+    packet.SetSequenceNumber(seq_num);
+    packet.SetMarker(seq_num == kLostSeqNum);
+    packet.AllocatePayload(4)[0] = seq_num;
+    sender.AddPacketAndGenerateFec(packet);
+    if (seq_num != kLostSeqNum)
+      received_packets.push_back(ParsePacket(packet.Buffer()));
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender.GetFecPackets();
+  ASSERT_THAT(fec_packets, SizeIs(1));
+  received_packets.push_back(ParsePacket(fec_packets[0]->Buffer()));
+
+  EXPECT_CALL(recovered_packet_receiver_,
+              OnRecoveredPacket(Property(&RtpPacketReceived::SequenceNumber,
+                                         Eq(kLostSeqNum))));
+  for (const RtpPacketReceived& packet : received_packets) {
+    receive_stream_->OnRtpPacket(packet);
+  }
+}
+
 }  // namespace webrtc
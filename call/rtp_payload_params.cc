@@ -106,24 +106,6 @@ void PopulateRtpWithCodecSpecifics(const CodecSpecificInfo& info,
   }
 }
 
-void SetVideoTiming(const EncodedImage& image, VideoSendTiming* timing) {
-  if (image.timing_.flags == VideoSendTiming::TimingFrameFlags::kInvalid ||
-      image.timing_.flags == VideoSendTiming::TimingFrameFlags::kNotTriggered) {
-    timing->flags = VideoSendTiming::TimingFrameFlags::kInvalid;
-    return;
-  }
-
-  timing->encode_start_delta_ms = VideoSendTiming::GetDeltaCappedMs(
-      image.capture_time_ms_, image.timing_.encode_start_ms);
-  timing->encode_finish_delta_ms = VideoSendTiming::GetDeltaCappedMs(
-      image.capture_time_ms_, image.timing_.encode_finish_ms);
-  timing->packetization_finish_delta_ms = 0;
-  timing->pacer_exit_delta_ms = 0;
-  timing->network_timestamp_delta_ms = 0;
-  timing->network2_timestamp_delta_ms = 0;
-  timing->flags = image.timing_.flags;
-}
-
 // Returns structure that aligns with simulated generic info. The templates
 // allow to produce valid dependency descriptor for any stream where
 // `num_spatial_layers` * `num_temporal_layers` <= 32 (limited by
@@ -231,6 +213,25 @@ RTPVideoHeader RtpPayloadParams::GetRtpVideoHeader(
   return rtp_video_header;
 }
 
+void RtpPayloadParams::SetVideoTiming(const EncodedImage& image,
+                                      VideoSendTiming* timing) {
+  if (image.timing_.flags == VideoSendTiming::TimingFrameFlags::kInvalid ||
+      image.timing_.flags == VideoSendTiming::TimingFrameFlags::kNotTriggered) {
+    timing->flags = VideoSendTiming::TimingFrameFlags::kInvalid;
+    return;
+  }
+
+  timing->encode_start_delta_ms = VideoSendTiming::GetDeltaCappedMs(
+      image.capture_time_ms_, image.timing_.encode_start_ms);
+  timing->encode_finish_delta_ms = VideoSendTiming::GetDeltaCappedMs(
+      image.capture_time_ms_, image.timing_.encode_finish_ms);
+  timing->packetization_finish_delta_ms = 0;
+  timing->pacer_exit_delta_ms = 0;
+  timing->network_timestamp_delta_ms = 0;
+  timing->network2_timestamp_delta_ms = 0;
+  timing->flags = image.timing_.flags;
+}
+
 uint32_t RtpPayloadParams::ssrc() const {
   return ssrc_;
 }
@@ -343,7 +344,9 @@ void RtpPayloadParams::SetGeneric(const CodecSpecificInfo* codec_specific_info,
     case VideoCodecType::kVideoCodecMultiplex:
       return;
     case VideoCodecType::kVideoCodecH265:
-      // TODO(bugs.webrtc.org/13485): Implement H265 to generic descriptor.
+    case VideoCodecType::kVideoCodecH266:
+      // TODO(bugs.webrtc.org/13485): Implement H265 and H266 to generic
+      // descriptor.
       return;
   }
   RTC_DCHECK_NOTREACHED() << "Unsupported codec.";
@@ -407,6 +410,7 @@ absl::optional<FrameDependencyStructure> RtpPayloadParams::GenericStructure(
     case VideoCodecType::kVideoCodecAV1:
     case VideoCodecType::kVideoCodecH264:
     case VideoCodecType::kVideoCodecH265:
+    case VideoCodecType::kVideoCodecH266:
     case VideoCodecType::kVideoCodecMultiplex:
       return absl::nullopt;
   }
@@ -40,6 +40,10 @@ class RtpPayloadParams final {
                                    const CodecSpecificInfo* codec_specific_info,
                                    int64_t shared_frame_id);
 
+  // Sets the video timing header extension fields from the timing of `image`.
+  static void SetVideoTiming(const EncodedImage& image,
+                             VideoSendTiming* timing);
+
   // Returns structure that aligns with simulated generic info generated by
   // `GetRtpVideoHeader` for the `codec_specific_info`
   absl::optional<FrameDependencyStructure> GenericStructure(
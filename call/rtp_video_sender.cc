@@ -26,6 +26,7 @@
 #include "call/rtp_transport_controller_send_interface.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_impl2.h"
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "modules/video_coding/include/video_codec_interface.h"
@@ -91,7 +92,8 @@ bool ShouldDisableRedAndUlpfec(bool flexfec_enabled,
     should_disable_red_and_ulpfec = true;
   }
 
-  // If enabled, FlexFEC takes priority over RED+ULPFEC.
+  // If enabled, FlexFEC, or Reed-Solomon FEC sent in its place, takes priority
+  // over RED+ULPFEC.
   if (flexfec_enabled) {
     if (IsUlpfecEnabled()) {
       RTC_LOG(LS_INFO)
@@ -169,6 +171,14 @@ std::unique_ptr<VideoFecGenerator> MaybeCreateFecGenerator(
     }
 
     RTC_DCHECK_EQ(1U, rtp.flexfec.protected_media_ssrcs.size());
+    if (trials.IsEnabled("WebRTC-ReedSolomonFec")) {
+      // Reed-Solomon FEC is sent in place of FlexFEC, with the FlexFEC payload
+      // type and SSRC. The receiver must have the same field trial enabled.
+      return std::make_unique<ReedSolomonFecSender>(
+          rtp.flexfec.payload_type, rtp.flexfec.ssrc,
+          rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
+          RTPSender::FecExtensionSizes(), rtp_state, clock);
+    }
     return std::make_unique<FlexfecSender>(
         rtp.flexfec.payload_type, rtp.flexfec.ssrc,
         rtp.flexfec.protected_media_ssrcs[0], rtp.mid, rtp.extensions,
@@ -284,7 +294,9 @@ std::vector<RtpStreamSender> CreateRtpStreamSenders(
 
     const bool using_flexfec =
         fec_generator &&
-        fec_generator->GetFecType() == VideoFecGenerator::FecType::kFlexFec;
+        (fec_generator->GetFecType() == VideoFecGenerator::FecType::kFlexFec ||
+         fec_generator->GetFecType() ==
+             VideoFecGenerator::FecType::kReedSolomon);
     const bool should_disable_red_and_ulpfec =
         ShouldDisableRedAndUlpfec(using_flexfec, rtp_config, trials);
     if (!should_disable_red_and_ulpfec &&
@@ -404,6 +416,7 @@ RtpVideoSender::RtpVideoSender(
       transport_overhead_bytes_per_packet_(0),
       encoder_target_rate_bps_(0),
       frame_counts_(rtp_config.ssrcs.size()),
+      frames_sent_in_parts_(rtp_config.ssrcs.size()),
       frame_count_observer_(observers.frame_count_observer) {
   transport_checker_.Detach();
   RTC_DCHECK_EQ(rtp_config_.ssrcs.size(), rtp_streams_.size());
@@ -451,8 +464,9 @@ RtpVideoSender::RtpVideoSender(
       fec_enabled = true;
     }
   }
-  // Currently, both ULPFEC and FlexFEC use the same FEC rate calculation logic,
-  // so enable that logic if either of those FEC schemes are enabled.
+  // Currently, ULPFEC, FlexFEC and Reed-Solomon FEC use the same FEC rate
+  // calculation logic, so enable that logic if any of those FEC schemes are
+  // enabled.
   fec_controller_->SetProtectionMethod(fec_enabled, NackEnabled());
 
   fec_controller_->SetProtectionCallback(this);
@@ -560,24 +574,11 @@ bool RtpVideoSender::IsActiveLocked() {
   return active_ && !rtp_streams_.empty();
 }
 
-EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
+bool RtpVideoSender::OnSendingFrame(
     const EncodedImage& encoded_image,
-    const CodecSpecificInfo* codec_specific_info) {
-  fec_controller_->UpdateWithEncodedData(encoded_image.size(),
-                                         encoded_image._frameType);
-  MutexLock lock(&mutex_);
-  RTC_DCHECK(!rtp_streams_.empty());
-  if (!active_)
-    return Result(Result::ERROR_SEND_FAILED);
-
-  shared_frame_id_++;
-  size_t simulcast_index = encoded_image.SimulcastIndex().value_or(0);
-  RTC_DCHECK_LT(simulcast_index, rtp_streams_.size());
-
-  uint32_t rtp_timestamp =
-      encoded_image.RtpTimestamp() +
-      rtp_streams_[simulcast_index].rtp_rtcp->StartTimestamp();
-
+    const CodecSpecificInfo* codec_specific_info,
+    size_t simulcast_index,
+    TimeDelta* expected_retransmission_time) {
   // RTCPSender has it's own copy of the timestamp offset, added in
   // RTCPSender::BuildSR, hence we must not add the in the offset for this call.
   // TODO(nisse): Delete RTCPSender:timestamp_offset_, and see if we can confine
@@ -587,12 +588,12 @@ EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
           rtp_config_.payload_type,
           encoded_image._frameType == VideoFrameType::kVideoFrameKey)) {
     // The payload router could be active but this module isn't sending.
-    return Result(Result::ERROR_SEND_FAILED);
+    return false;
   }
 
-  TimeDelta expected_retransmission_time = TimeDelta::PlusInfinity();
+  *expected_retransmission_time = TimeDelta::PlusInfinity();
   if (encoded_image.RetransmissionAllowed()) {
-    expected_retransmission_time =
+    *expected_retransmission_time =
         rtp_streams_[simulcast_index].rtp_rtcp->ExpectedRetransmissionTime();
   }
 
@@ -616,13 +617,52 @@ EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
       sender_video.SetVideoStructure(nullptr);
     }
   }
+  return true;
+}
+
+EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo* codec_specific_info) {
+  fec_controller_->UpdateWithEncodedData(encoded_image.size(),
+                                         encoded_image._frameType);
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(!rtp_streams_.empty());
+  if (!active_)
+    return Result(Result::ERROR_SEND_FAILED);
 
-  bool send_result =
-      rtp_streams_[simulcast_index].sender_video->SendEncodedImage(
-          rtp_config_.payload_type, codec_type_, rtp_timestamp, encoded_image,
-          params_[simulcast_index].GetRtpVideoHeader(
-              encoded_image, codec_specific_info, shared_frame_id_),
-          expected_retransmission_time);
+  size_t simulcast_index = encoded_image.SimulcastIndex().value_or(0);
+  RTC_DCHECK_LT(simulcast_index, rtp_streams_.size());
+
+  uint32_t rtp_timestamp =
+      encoded_image.RtpTimestamp() +
+      rtp_streams_[simulcast_index].rtp_rtcp->StartTimestamp();
+
+  bool send_result;
+  absl::optional<FrameSentInParts>& frame_sent_in_parts =
+      frames_sent_in_parts_[simulcast_index];
+  if (frame_sent_in_parts &&
+      frame_sent_in_parts->rtp_timestamp == encoded_image.RtpTimestamp()) {
+    // The frame has already been packetized part by part.
+    if (frame_sent_in_parts->state == FrameSentInParts::State::kSending) {
+      RTC_LOG(LS_WARNING) << "Frame " << rtp_timestamp
+                          << " was encoded without its last part being sent.";
+    }
+    send_result = frame_sent_in_parts->state == FrameSentInParts::State::kSent;
+    frame_sent_in_parts = absl::nullopt;
+  } else {
+    shared_frame_id_++;
+    TimeDelta expected_retransmission_time = TimeDelta::PlusInfinity();
+    if (!OnSendingFrame(encoded_image, codec_specific_info, simulcast_index,
+                        &expected_retransmission_time)) {
+      return Result(Result::ERROR_SEND_FAILED);
+    }
+
+    send_result = rtp_streams_[simulcast_index].sender_video->SendEncodedImage(
+        rtp_config_.payload_type, codec_type_, rtp_timestamp, encoded_image,
+        params_[simulcast_index].GetRtpVideoHeader(
+            encoded_image, codec_specific_info, shared_frame_id_),
+        expected_retransmission_time);
+  }
   if (frame_count_observer_) {
     FrameCounts& counts = frame_counts_[simulcast_index];
     if (encoded_image._frameType == VideoFrameType::kVideoFrameKey) {
@@ -641,6 +681,63 @@ EncodedImageCallback::Result RtpVideoSender::OnEncodedImage(
   return Result(Result::OK, rtp_timestamp);
 }
 
+EncodedImageCallback::Result RtpVideoSender::OnEncodedImagePart(
+    const EncodedImage& encoded_part,
+    const CodecSpecificInfo* codec_specific_info,
+    bool last_part) {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK(!rtp_streams_.empty());
+  if (!active_)
+    return Result(Result::ERROR_SEND_FAILED);
+
+  size_t simulcast_index = encoded_part.SimulcastIndex().value_or(0);
+  RTC_DCHECK_LT(simulcast_index, rtp_streams_.size());
+  RTPSenderVideo& sender_video = *rtp_streams_[simulcast_index].sender_video;
+  if (!sender_video.SupportsFrameParts(codec_type_))
+    return Result(Result::ERROR_SEND_FAILED);
+
+  uint32_t rtp_timestamp =
+      encoded_part.RtpTimestamp() +
+      rtp_streams_[simulcast_index].rtp_rtcp->StartTimestamp();
+
+  absl::optional<FrameSentInParts>& frame =
+      frames_sent_in_parts_[simulcast_index];
+  if (!frame || frame->rtp_timestamp != encoded_part.RtpTimestamp()) {
+    // First part of the frame. Per-frame state, like the frame id, is only
+    // advanced once, and the resulting header is used for all the parts.
+    frame.emplace();
+    frame->rtp_timestamp = encoded_part.RtpTimestamp();
+    shared_frame_id_++;
+    if (!OnSendingFrame(encoded_part, codec_specific_info, simulcast_index,
+                        &frame->expected_retransmission_time)) {
+      frame->state = FrameSentInParts::State::kFailed;
+      return Result(Result::ERROR_SEND_FAILED);
+    }
+    frame->video_header = params_[simulcast_index].GetRtpVideoHeader(
+        encoded_part, codec_specific_info, shared_frame_id_);
+  }
+  if (frame->state != FrameSentInParts::State::kSending)
+    return Result(Result::ERROR_SEND_FAILED);
+  // Timing is only known once the frame is fully encoded, and only the last
+  // packet carries the video timing extension.
+  if (last_part) {
+    RtpPayloadParams::SetVideoTiming(encoded_part,
+                                     &frame->video_header.video_timing);
+  }
+
+  if (!sender_video.SendVideoPart(
+          rtp_config_.payload_type, codec_type_, rtp_timestamp,
+          encoded_part.CaptureTime(), encoded_part, frame->video_header,
+          frame->expected_retransmission_time, last_part)) {
+    frame->state = FrameSentInParts::State::kFailed;
+    return Result(Result::ERROR_SEND_FAILED);
+  }
+  if (last_part)
+    frame->state = FrameSentInParts::State::kSent;
+
+  return Result(Result::OK, rtp_timestamp);
+}
+
 void RtpVideoSender::OnBitrateAllocationUpdated(
     const VideoBitrateAllocation& bitrate) {
   RTC_DCHECK_RUN_ON(&transport_checker_);
@@ -26,6 +26,7 @@
 #include "api/sequence_checker.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
 #include "api/video_codecs/video_encoder.h"
 #include "call/rtp_config.h"
 #include "call/rtp_payload_params.h"
@@ -134,6 +135,10 @@ class RtpVideoSender : public RtpVideoSenderInterface,
       const EncodedImage& encoded_image,
       const CodecSpecificInfo* codec_specific_info)
       RTC_LOCKS_EXCLUDED(mutex_) override;
+  EncodedImageCallback::Result OnEncodedImagePart(
+      const EncodedImage& encoded_part,
+      const CodecSpecificInfo* codec_specific_info,
+      bool last_part) RTC_LOCKS_EXCLUDED(mutex_) override;
 
   void OnBitrateAllocationUpdated(const VideoBitrateAllocation& bitrate)
       RTC_LOCKS_EXCLUDED(mutex_) override;
@@ -160,6 +165,13 @@ class RtpVideoSender : public RtpVideoSenderInterface,
 
  private:
   bool IsActiveLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Prepares the RTP module of `simulcast_index` for sending `encoded_image`.
+  // Returns false if the module isn't sending.
+  bool OnSendingFrame(const EncodedImage& encoded_image,
+                      const CodecSpecificInfo* codec_specific_info,
+                      size_t simulcast_index,
+                      TimeDelta* expected_retransmission_time)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   void SetActiveModulesLocked(const std::vector<bool>& active_modules)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   void UpdateModuleSendingState() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
@@ -210,6 +222,20 @@ class RtpVideoSender : public RtpVideoSenderInterface,
   std::vector<bool> loss_mask_vector_ RTC_GUARDED_BY(mutex_);
 
   std::vector<FrameCounts> frame_counts_ RTC_GUARDED_BY(mutex_);
+
+  // A frame of which parts were sent by OnEncodedImagePart(), kept until the
+  // complete frame is passed to OnEncodedImage().
+  struct FrameSentInParts {
+    enum class State { kSending, kSent, kFailed };
+
+    uint32_t rtp_timestamp = 0;
+    RTPVideoHeader video_header;
+    TimeDelta expected_retransmission_time = TimeDelta::PlusInfinity();
+    State state = State::kSending;
+  };
+  // Indexed by simulcast index.
+  std::vector<absl::optional<FrameSentInParts>> frames_sent_in_parts_
+      RTC_GUARDED_BY(mutex_);
   FrameCountObserver* const frame_count_observer_;
 
   // Effectively const map from SSRC to RtpRtcp, for all media SSRCs.
@@ -240,6 +240,37 @@ TEST(RtpVideoSenderTest, SendOnOneModule) {
             test.router()->OnEncodedImage(encoded_image, nullptr).error);
 }
 
+TEST(RtpVideoSenderTest, SendsCompleteImageWhenPartsAreUnsupported) {
+  RtpVideoSenderTestFixture test({kSsrc1}, {}, kPayloadType, {});
+  test.SetActiveModules({true});
+  int packets_sent = 0;
+  ON_CALL(test.transport(), SendRtp).WillByDefault([&] {
+    ++packets_sent;
+    return true;
+  });
+
+  constexpr uint8_t kPayload = 'a';
+  EncodedImage encoded_image;
+  encoded_image.SetRtpTimestamp(1);
+  encoded_image.capture_time_ms_ = 2;
+  encoded_image._frameType = VideoFrameType::kVideoFrameKey;
+  encoded_image.SetEncodedData(EncodedImageBuffer::Create(&kPayload, 1));
+
+  // The payload descriptor of the generic codec describes the position of
+  // the packet within the whole frame, so it can't be sent in parts.
+  EXPECT_NE(test.router()
+                ->OnEncodedImagePart(encoded_image, nullptr, /*last_part=*/true)
+                .error,
+            EncodedImageCallback::Result::OK);
+  test.AdvanceTime(TimeDelta::Millis(33));
+  EXPECT_EQ(packets_sent, 0);
+
+  EXPECT_EQ(test.router()->OnEncodedImage(encoded_image, nullptr).error,
+            EncodedImageCallback::Result::OK);
+  test.AdvanceTime(TimeDelta::Millis(33));
+  EXPECT_EQ(packets_sent, 1);
+}
+
 TEST(RtpVideoSenderTest, SendSimulcastSetActive) {
   constexpr uint8_t kPayload = 'a';
   EncodedImage encoded_image_1;
@@ -0,0 +1,129 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/trace_network_behavior.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+absl::optional<std::vector<int64_t>> TraceNetworkBehavior::ParseTrace(
+    absl::string_view trace) {
+  std::vector<int64_t> opportunities_ms;
+  for (absl::string_view line :
+       absl::StrSplit(trace, '\n', absl::SkipWhitespace())) {
+    int64_t time_ms;
+    if (!absl::SimpleAtoi(absl::StripAsciiWhitespace(line), &time_ms) ||
+        time_ms < 0) {
+      return absl::nullopt;
+    }
+    if (!opportunities_ms.empty() && time_ms < opportunities_ms.back())
+      return absl::nullopt;
+    opportunities_ms.push_back(time_ms);
+  }
+  if (opportunities_ms.empty() || opportunities_ms.back() == 0)
+    return absl::nullopt;
+  return opportunities_ms;
+}
+
+TraceNetworkBehavior::TraceNetworkBehavior(
+    std::vector<int64_t> opportunities_ms,
+    size_t queue_length_packets)
+    : opportunities_ms_(std::move(opportunities_ms)),
+      queue_length_packets_(queue_length_packets) {
+  RTC_CHECK(!opportunities_ms_.empty());
+  RTC_CHECK(std::is_sorted(opportunities_ms_.begin(), opportunities_ms_.end()));
+  RTC_CHECK_GE(opportunities_ms_.front(), 0);
+  RTC_CHECK_GT(opportunities_ms_.back(), 0);
+}
+
+TraceNetworkBehavior::~TraceNetworkBehavior() = default;
+
+bool TraceNetworkBehavior::EnqueuePacket(PacketInFlightInfo packet) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  if (queue_length_packets_ > 0) {
+    size_t queued = 0;
+    for (auto it = packets_.rbegin();
+         it != packets_.rend() && it->arrival_time_us > packet.send_time_us;
+         ++it) {
+      ++queued;
+    }
+    if (queued >= queue_length_packets_)
+      return false;
+  }
+
+  if (!start_time_us_)
+    start_time_us_ = packet.send_time_us;
+  if (OpportunityTimeUs(next_opportunity_) < packet.send_time_us) {
+    // The link went idle, drop the opportunities that passed meanwhile. Jump
+    // close to the current period first so long idle times stay cheap.
+    const int64_t period_us = opportunities_ms_.back() * 1000;
+    const int64_t periods =
+        (packet.send_time_us - *start_time_us_) / period_us - 1;
+    const int64_t num_opportunities = opportunities_ms_.size();
+    next_opportunity_ =
+        std::max(next_opportunity_, periods * num_opportunities);
+    while (OpportunityTimeUs(next_opportunity_) < packet.send_time_us)
+      ++next_opportunity_;
+    bytes_left_in_opportunity_ = kBytesPerOpportunity;
+  }
+
+  size_t bytes_to_send = packet.size;
+  while (bytes_to_send > bytes_left_in_opportunity_) {
+    bytes_to_send -= bytes_left_in_opportunity_;
+    ++next_opportunity_;
+    bytes_left_in_opportunity_ = kBytesPerOpportunity;
+  }
+  bytes_left_in_opportunity_ -= bytes_to_send;
+  const int64_t arrival_time_us = OpportunityTimeUs(next_opportunity_);
+  if (bytes_left_in_opportunity_ == 0) {
+    ++next_opportunity_;
+    bytes_left_in_opportunity_ = kBytesPerOpportunity;
+  }
+
+  packets_.push_back({packet, arrival_time_us});
+  return true;
+}
+
+std::vector<PacketDeliveryInfo> TraceNetworkBehavior::DequeueDeliverablePackets(
+    int64_t receive_time_us) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  std::vector<PacketDeliveryInfo> packets_to_deliver;
+  while (!packets_.empty() &&
+         packets_.front().arrival_time_us <= receive_time_us) {
+    packets_to_deliver.emplace_back(packets_.front().packet,
+                                    packets_.front().arrival_time_us);
+    packets_.pop_front();
+  }
+  return packets_to_deliver;
+}
+
+absl::optional<int64_t> TraceNetworkBehavior::NextDeliveryTimeUs() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  if (packets_.empty())
+    return absl::nullopt;
+  return packets_.front().arrival_time_us;
+}
+
+int64_t TraceNetworkBehavior::OpportunityTimeUs(int64_t index) const {
+  const int64_t num_opportunities = opportunities_ms_.size();
+  const int64_t time_ms =
+      (index / num_opportunities) * opportunities_ms_.back() +
+      opportunities_ms_[index % num_opportunities];
+  return *start_time_us_ + time_ms * 1000;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef CALL_TRACE_NETWORK_BEHAVIOR_H_
+#define CALL_TRACE_NETWORK_BEHAVIOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/test/simulated_network.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Network link whose capacity follows a packet delivery trace in the format
+// used by mahimahi's mm-link: one integer per line, each line being the time
+// in milliseconds at which the link can deliver one MTU (1500 bytes). Several
+// lines with the same timestamp give several opportunities at that time. The
+// trace repeats with a period equal to its last timestamp, starting from the
+// first packet enqueued.
+//
+// As in mm-link, packets are served in order from an unbounded (or, if
+// `queue_length_packets` is set, drop-tail) queue, a packet may be spread over
+// several opportunities and is delivered at the opportunity that carries its
+// last byte. Opportunities that come while the queue is empty are lost.
+//
+// Only capacity is modelled, chain it with a SimulatedNetwork for propagation
+// delay and random loss.
+class TraceNetworkBehavior : public NetworkBehaviorInterface {
+ public:
+  static constexpr size_t kBytesPerOpportunity = 1500;
+
+  // Parses a mahimahi trace. Returns nullopt if `trace` is empty, contains
+  // anything but non-negative integers, is not sorted, or ends at time 0.
+  static absl::optional<std::vector<int64_t>> ParseTrace(
+      absl::string_view trace);
+
+  // `opportunities_ms` must be a valid trace, as returned by ParseTrace().
+  // `queue_length_packets` of 0 means an unbounded queue.
+  explicit TraceNetworkBehavior(std::vector<int64_t> opportunities_ms,
+                                size_t queue_length_packets = 0);
+  ~TraceNetworkBehavior() override;
+
+  // NetworkBehaviorInterface
+  bool EnqueuePacket(PacketInFlightInfo packet) override;
+  std::vector<PacketDeliveryInfo> DequeueDeliverablePackets(
+      int64_t receive_time_us) override;
+  absl::optional<int64_t> NextDeliveryTimeUs() const override;
+
+ private:
+  struct PacketInfo {
+    PacketInFlightInfo packet;
+    int64_t arrival_time_us;
+  };
+
+  // Time of the `index`th opportunity since the trace started.
+  int64_t OpportunityTimeUs(int64_t index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(race_checker_);
+
+  const std::vector<int64_t> opportunities_ms_;
+  const size_t queue_length_packets_;
+
+  rtc::RaceChecker race_checker_;
+  // Packets in send order, with the time they leave the link. Since the link
+  // is FIFO the arrival times are non-decreasing.
+  std::deque<PacketInfo> packets_ RTC_GUARDED_BY(race_checker_);
+  // Send time of the first packet, the trace is replayed relative to it.
+  absl::optional<int64_t> start_time_us_ RTC_GUARDED_BY(race_checker_);
+  // The opportunity the next byte will be sent in and how many bytes it still
+  // has room for.
+  int64_t next_opportunity_ RTC_GUARDED_BY(race_checker_) = 0;
+  size_t bytes_left_in_opportunity_ RTC_GUARDED_BY(race_checker_) =
+      kBytesPerOpportunity;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_TRACE_NETWORK_BEHAVIOR_H_
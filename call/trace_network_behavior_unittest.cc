@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "call/trace_network_behavior.h"
+
+#include <vector>
+
+#include "api/test/simulated_network.h"
+#include "api/units/time_delta.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+
+constexpr size_t kMtu = TraceNetworkBehavior::kBytesPerOpportunity;
+
+PacketInFlightInfo Packet(size_t size, int64_t send_time_us, uint64_t id) {
+  return PacketInFlightInfo(size, send_time_us, id);
+}
+
+TEST(TraceNetworkBehaviorTest, ParsesMahimahiTrace) {
+  EXPECT_THAT(TraceNetworkBehavior::ParseTrace("0\n1\n1\r\n5\n\n"),
+              Optional(ElementsAre(0, 1, 1, 5)));
+}
+
+TEST(TraceNetworkBehaviorTest, RejectsInvalidTraces) {
+  EXPECT_EQ(TraceNetworkBehavior::ParseTrace(""), absl::nullopt);
+  EXPECT_EQ(TraceNetworkBehavior::ParseTrace("0\n0\n"), absl::nullopt);
+  EXPECT_EQ(TraceNetworkBehavior::ParseTrace("1\nx\n"), absl::nullopt);
+  EXPECT_EQ(TraceNetworkBehavior::ParseTrace("2\n1\n"), absl::nullopt);
+  EXPECT_EQ(TraceNetworkBehavior::ParseTrace("-1\n1\n"), absl::nullopt);
+}
+
+TEST(TraceNetworkBehaviorTest, NextDeliveryTimeIsUnknownOnEmptyNetwork) {
+  TraceNetworkBehavior network({1});
+  EXPECT_EQ(network.NextDeliveryTimeUs(), absl::nullopt);
+}
+
+TEST(TraceNetworkBehaviorTest, DeliversPacketAtFirstOpportunity) {
+  TraceNetworkBehavior network({10, 20});
+  ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu, /*send_time_us=*/0, 1)));
+
+  EXPECT_EQ(network.NextDeliveryTimeUs(), TimeDelta::Millis(10).us());
+  EXPECT_THAT(network.DequeueDeliverablePackets(TimeDelta::Millis(9).us()),
+              IsEmpty());
+  EXPECT_THAT(network.DequeueDeliverablePackets(TimeDelta::Millis(10).us()),
+              ElementsAre(PacketDeliveryInfo(Packet(kMtu, 0, 1),
+                                             TimeDelta::Millis(10).us())));
+}
+
+TEST(TraceNetworkBehaviorTest, SmallPacketsShareAnOpportunity) {
+  TraceNetworkBehavior network({10, 20});
+  ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu / 2, 0, 1)));
+  ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu / 2, 0, 2)));
+  ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu / 2, 0, 3)));
+
+  EXPECT_THAT(
+      network.DequeueDeliverablePackets(TimeDelta::Millis(20).us()),
+      ElementsAre(
+          PacketDeliveryInfo(Packet(0, 0, 1), TimeDelta::Millis(10).us()),
+          PacketDeliveryInfo(Packet(0, 0, 2), TimeDelta::Millis(10).us()),
+          PacketDeliveryInfo(Packet(0, 0, 3), TimeDelta::Millis(20).us())));
+}
+
+TEST(TraceNetworkBehaviorTest, LargePacketIsDeliveredWithItsLastByte) {
+  TraceNetworkBehavior network({10, 20, 30});
+  ASSERT_TRUE(network.EnqueuePacket(Packet(2 * kMtu + 1, 0, 1)));
+
+  EXPECT_EQ(network.NextDeliveryTimeUs(), TimeDelta::Millis(30).us());
+}
+
+TEST(TraceNetworkBehaviorTest, TraceRepeatsFromFirstPacket) {
+  TraceNetworkBehavior network({5, 10});
+  const int64_t start_us = TimeDelta::Seconds(1).us();
+  for (uint64_t id = 1; id <= 4; ++id)
+    ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu, start_us, id)));
+
+  EXPECT_THAT(network.DequeueDeliverablePackets(start_us +
+                                                TimeDelta::Millis(20).us()),
+              ElementsAre(PacketDeliveryInfo(Packet(0, 0, 1),
+                                             start_us + 5'000),
+                          PacketDeliveryInfo(Packet(0, 0, 2),
+                                             start_us + 10'000),
+                          PacketDeliveryInfo(Packet(0, 0, 3),
+                                             start_us + 15'000),
+                          PacketDeliveryInfo(Packet(0, 0, 4),
+                                             start_us + 20'000)));
+}
+
+TEST(TraceNetworkBehaviorTest, OpportunitiesAreLostWhileIdle) {
+  TraceNetworkBehavior network({10, 20});
+  ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu / 2, 0, 1)));
+  // The rest of the opportunity at 10 ms, and the ones at 20 and 30 ms, pass
+  // with nothing to send.
+  ASSERT_TRUE(network.EnqueuePacket(
+      Packet(kMtu / 2, TimeDelta::Millis(35).us(), 2)));
+
+  EXPECT_THAT(
+      network.DequeueDeliverablePackets(TimeDelta::Seconds(1).us()),
+      ElementsAre(
+          PacketDeliveryInfo(Packet(0, 0, 1), TimeDelta::Millis(10).us()),
+          PacketDeliveryInfo(Packet(0, 0, 2), TimeDelta::Millis(40).us())));
+}
+
+TEST(TraceNetworkBehaviorTest, SkipsLongIdlePeriods) {
+  TraceNetworkBehavior network({10, 20});
+  ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu, 0, 1)));
+  const int64_t send_time_us = TimeDelta::Seconds(3600).us() + 1;
+  ASSERT_TRUE(network.EnqueuePacket(Packet(kMtu, send_time_us, 2)));
+
+  network.DequeueDeliverablePackets(TimeDelta::Millis(10).us());
+  EXPECT_EQ(network.NextDeliveryTimeUs(),
+            TimeDelta::Seconds(3600).us() + TimeDelta::Millis(10).us());
+}
+
+TEST(TraceNetworkBehaviorTest, DropsPacketsWhenQueueIsFull) {
+  TraceNetworkBehavior network({10}, /*queue_length_packets=*/2);
+  EXPECT_TRUE(network.EnqueuePacket(Packet(kMtu, 0, 1)));
+  EXPECT_TRUE(network.EnqueuePacket(Packet(kMtu, 0, 2)));
+  EXPECT_FALSE(network.EnqueuePacket(Packet(kMtu, 0, 3)));
+  // The first packet has left the queue by 10 ms.
+  EXPECT_TRUE(
+      network.EnqueuePacket(Packet(kMtu, TimeDelta::Millis(10).us(), 4)));
+}
+
+}  // namespace
+}  // namespace webrtc
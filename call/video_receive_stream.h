@@ -24,6 +24,7 @@
 #include "api/rtp_headers.h"
 #include "api/rtp_parameters.h"
 #include "api/video/recordable_encoded_frame.h"
+#include "api/video/timing_frame_info_observer.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -248,6 +249,16 @@ class VideoReceiveStreamInterface : public MediaReceiveStreamInterface {
     // available.
     bool enable_prerenderer_smoothing = true;
 
+    // If true, the leading NAL units of an H.264 frame that is still being
+    // received are passed to the decoder ahead of the rest of the frame, when
+    // the decoder supports it. Only used with zero playout delay and without
+    // frame decryption or frame transformation.
+    bool enable_frame_part_decoding = false;
+
+    // If set, receives the TimingFrameInfo of every decoded frame. Must
+    // outlive the stream.
+    TimingFrameInfoObserver* timing_frame_info_observer = nullptr;
+
     // Identifier for an A/V synchronization group. Empty string to disable.
     // TODO(pbos): Synchronize streams in a sync group, not just video streams
     // to one of the audio streams.
@@ -11,6 +11,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -67,6 +68,9 @@ constexpr int kMaxAbsQpDeltaValue = 51;
 constexpr int kMinQpValue = 0;
 constexpr int kMaxQpValue = 51;
 constexpr int kMaxRefIdxActive = 15;
+// Upper bound on the number of bytes a slice segment header occupies up to
+// and including slice_qp_delta. Only this prefix of a slice is unescaped.
+constexpr size_t kMaxSliceHeaderSize = 512;
 
 }  // namespace
 
@@ -85,7 +89,7 @@ H265BitstreamParser::Result H265BitstreamParser::ParseNonParameterSetNalu(
   last_slice_qp_delta_ = absl::nullopt;
   last_slice_pps_id_ = absl::nullopt;
   const std::vector<uint8_t> slice_rbsp =
-      H265::ParseRbsp(source, source_length);
+      H265::ParseRbsp(source, std::min(source_length, kMaxSliceHeaderSize));
   if (slice_rbsp.size() < H265::kNaluHeaderSize)
     return kInvalidStream;
 
@@ -529,8 +533,7 @@ absl::optional<int> H265BitstreamParser::GetLastSliceQp() const {
   if (!last_slice_qp_delta_ || !last_slice_pps_id_) {
     return absl::nullopt;
   }
-  uint32_t pps_id = 0;
-  const H265PpsParser::PpsState* pps = GetPPS(pps_id);
+  const H265PpsParser::PpsState* pps = GetPPS(*last_slice_pps_id_);
   if (!pps)
     return absl::nullopt;
   const int parsed_qp = 26 + pps->init_qp_minus26 + *last_slice_qp_delta_;
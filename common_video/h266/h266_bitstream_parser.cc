@@ -0,0 +1,1419 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "common_video/h266/h266_bitstream_parser.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "common_video/h264/h264_common.h"
+#include "common_video/h266/h266_common.h"
+#include "rtc_base/logging.h"
+
+#define IN_RANGE_OR_RETURN(val, min, max)                                     \
+  do {                                                                        \
+    if (!reader.Ok() || (val) < (min) || (val) > (max)) {                     \
+      RTC_LOG(LS_WARNING) << "Error in stream: invalid value, expected " #val \
+                             " to be"                                         \
+                          << " in range [" << (min) << ":" << (max) << "]"    \
+                          << " found " << (val) << " instead";                \
+      return kInvalidStream;                                                  \
+    }                                                                         \
+  } while (0)
+
+#define IN_RANGE_OR_RETURN_NULL(val, min, max)                                \
+  do {                                                                        \
+    if (!reader.Ok() || (val) < (min) || (val) > (max)) {                     \
+      RTC_LOG(LS_WARNING) << "Error in stream: invalid value, expected " #val \
+                             " to be"                                         \
+                          << " in range [" << (min) << ":" << (max) << "]"    \
+                          << " found " << (val) << " instead";                \
+      return absl::nullopt;                                                   \
+    }                                                                         \
+  } while (0)
+
+#define TRUE_OR_RETURN(a)                                                \
+  do {                                                                   \
+    if (!reader.Ok() || !(a)) {                                          \
+      RTC_LOG(LS_WARNING) << "Error in stream: invalid value, expected " \
+                          << #a;                                         \
+      return kInvalidStream;                                             \
+    }                                                                    \
+  } while (0)
+
+namespace webrtc {
+namespace {
+
+// Slice types, VVC spec Table 9.
+enum SliceType : uint32_t { kB = 0, kP = 1, kI = 2 };
+
+constexpr uint32_t kMaxPpsId = 63;
+constexpr int kMaxQpValue = 63;
+constexpr uint32_t kMaxBitDepthMinus8 = 8;
+// MaxSlicesPerAu of the highest level, VVC spec Table A.1.
+constexpr uint32_t kMaxSlicesPerAu = 1000;
+constexpr uint32_t kMaxSubpics = kMaxSlicesPerAu;
+constexpr uint32_t kMaxRefPicLists = 64;
+// MaxDpbSize + 13, VVC spec section 7.4.10.
+constexpr uint32_t kMaxRefEntries = 29;
+constexpr uint32_t kMaxRefIdxActive = 15;
+constexpr uint32_t kMaxVirtualBoundaries = 3;
+constexpr uint32_t kMaxChromaQpOffsetListLen = 6;
+// Number of bits of general_constraints_info() between gci_present_flag and
+// gci_num_additional_bits.
+constexpr int kNumGciConstraintBits = 71;
+
+// Returns the number of bits of a u(v) element that takes values in
+// [0, num_values - 1].
+int CeilLog2(uint32_t num_values) {
+  return num_values > 1 ? absl::bit_width(num_values - 1) : 0;
+}
+
+void ByteAlign(BitstreamReader& reader) {
+  reader.ConsumeBits(reader.RemainingBitCount() % 8);
+}
+
+// Removes the emulation prevention bytes from `nalu` until `rbsp` is full.
+// Returns the number of bytes written to `rbsp`.
+size_t UnescapeRbsp(rtc::ArrayView<const uint8_t> nalu,
+                    rtc::ArrayView<uint8_t> rbsp) {
+  size_t rbsp_size = 0;
+  int zero_count = 0;
+  for (uint8_t byte : nalu) {
+    if (rbsp_size == rbsp.size()) {
+      break;
+    }
+    if (zero_count >= 2 && byte == 0x03) {
+      zero_count = 0;
+      continue;
+    }
+    rbsp[rbsp_size++] = byte;
+    zero_count = byte == 0 ? zero_count + 1 : 0;
+  }
+  return rbsp_size;
+}
+
+// profile_tier_level(1, max_sublayers_minus1), VVC spec section 7.3.3.1.
+void SkipProfileTierLevel(BitstreamReader& reader,
+                          uint32_t max_sublayers_minus1) {
+  // general_profile_idc: u(7)
+  // general_tier_flag: u(1)
+  // general_level_idc: u(8)
+  // ptl_frame_only_constraint_flag: u(1)
+  // ptl_multilayer_enabled_flag: u(1)
+  reader.ConsumeBits(18);
+  // general_constraints_info()
+  // gci_present_flag: u(1)
+  if (reader.Read<bool>()) {
+    reader.ConsumeBits(kNumGciConstraintBits);
+    // gci_num_additional_bits: u(8)
+    reader.ConsumeBits(reader.ReadBits(8));
+  }
+  ByteAlign(reader);
+  std::vector<bool> sublayer_level_present(max_sublayers_minus1);
+  for (uint32_t i = max_sublayers_minus1; i > 0; --i) {
+    // ptl_sublayer_level_present_flag: u(1)
+    sublayer_level_present[i - 1] = reader.Read<bool>();
+  }
+  ByteAlign(reader);
+  for (uint32_t i = max_sublayers_minus1; i > 0; --i) {
+    if (sublayer_level_present[i - 1]) {
+      // sublayer_level_idc: u(8)
+      reader.ConsumeBits(8);
+    }
+  }
+  // ptl_num_sub_profiles: u(8)
+  uint32_t num_sub_profiles = reader.ReadBits(8);
+  // general_sub_profile_idc: u(32)
+  reader.ConsumeBits(32 * num_sub_profiles);
+}
+
+// Skips a partition constraint override: the QT/MTT depth syntax elements
+// that follow each other in the SPS and picture header.
+void SkipPartitionConstraints(BitstreamReader& reader) {
+  // log2_diff_min_qt_min_cb: ue(v)
+  reader.ReadExponentialGolomb();
+  // max_mtt_hierarchy_depth: ue(v)
+  if (reader.ReadExponentialGolomb() != 0) {
+    // log2_diff_max_bt_min_qt: ue(v)
+    reader.ReadExponentialGolomb();
+    // log2_diff_max_tt_min_qt: ue(v)
+    reader.ReadExponentialGolomb();
+  }
+}
+
+// Skips the ALF APS ids of a picture or slice header whose ALF enabled flag
+// is set.
+void SkipAlfApsIds(BitstreamReader& reader,
+                   uint32_t chroma_format_idc,
+                   bool ccalf_enabled_flag) {
+  // num_alf_aps_ids_luma: u(3)
+  uint32_t num_alf_aps_ids_luma = reader.ReadBits(3);
+  // alf_aps_id_luma: u(3)
+  reader.ConsumeBits(3 * num_alf_aps_ids_luma);
+  bool alf_cb_enabled_flag = false;
+  bool alf_cr_enabled_flag = false;
+  if (chroma_format_idc != 0) {
+    alf_cb_enabled_flag = reader.Read<bool>();
+    alf_cr_enabled_flag = reader.Read<bool>();
+  }
+  if (alf_cb_enabled_flag || alf_cr_enabled_flag) {
+    // alf_aps_id_chroma: u(3)
+    reader.ConsumeBits(3);
+  }
+  if (ccalf_enabled_flag) {
+    // alf_cc_cb_enabled_flag: u(1)
+    if (reader.Read<bool>()) {
+      // alf_cc_cb_aps_id: u(3)
+      reader.ConsumeBits(3);
+    }
+    // alf_cc_cr_enabled_flag: u(1)
+    if (reader.Read<bool>()) {
+      // alf_cc_cr_aps_id: u(3)
+      reader.ConsumeBits(3);
+    }
+  }
+}
+
+// Skips the virtual boundary positions of an SPS or picture header.
+bool SkipVirtualBoundaries(BitstreamReader& reader) {
+  for (int direction = 0; direction < 2; ++direction) {
+    // num_ver_virtual_boundaries / num_hor_virtual_boundaries: ue(v)
+    uint32_t num_boundaries = reader.ReadExponentialGolomb();
+    if (!reader.Ok() || num_boundaries > kMaxVirtualBoundaries) {
+      return false;
+    }
+    for (uint32_t i = 0; i < num_boundaries; ++i) {
+      // virtual_boundary_pos_minus1: ue(v)
+      reader.ReadExponentialGolomb();
+    }
+  }
+  return reader.Ok();
+}
+
+// Derives the tile column widths or row heights in CTBs from the explicitly
+// signalled sizes, VVC spec section 6.5.1.
+absl::optional<std::vector<uint32_t>> ReadTileSizes(BitstreamReader& reader,
+                                                    uint32_t num_explicit,
+                                                    uint32_t size_in_ctbs) {
+  std::vector<uint32_t> sizes;
+  uint32_t remaining = size_in_ctbs;
+  for (uint32_t i = 0; i < num_explicit; ++i) {
+    // tile_column_width_minus1 / tile_row_height_minus1: ue(v)
+    uint32_t size = reader.ReadExponentialGolomb() + 1;
+    if (!reader.Ok() || size > remaining) {
+      return absl::nullopt;
+    }
+    sizes.push_back(size);
+    remaining -= size;
+  }
+  const uint32_t uniform_size = sizes.back();
+  while (remaining >= uniform_size) {
+    sizes.push_back(uniform_size);
+    remaining -= uniform_size;
+  }
+  if (remaining > 0) {
+    sizes.push_back(remaining);
+  }
+  return sizes;
+}
+
+}  // namespace
+
+H266BitstreamParser::SpsState::SpsState() = default;
+H266BitstreamParser::SpsState::SpsState(const SpsState&) = default;
+H266BitstreamParser::SpsState& H266BitstreamParser::SpsState::operator=(
+    const SpsState&) = default;
+H266BitstreamParser::SpsState::~SpsState() = default;
+
+H266BitstreamParser::H266BitstreamParser() = default;
+H266BitstreamParser::~H266BitstreamParser() = default;
+
+// General note: this is based off the 04/2022 version of the H.266 standard.
+// You can find it on this page:
+// http://www.itu.int/rec/T-REC-H.266
+
+// ref_pic_list_struct(), VVC spec section 7.3.10.
+absl::optional<H266BitstreamParser::RefPicListStruct>
+H266BitstreamParser::ParseRefPicListStruct(BitstreamReader& reader,
+                                           const SpsState& sps,
+                                           uint32_t rpls_idx,
+                                           uint32_t num_ref_pic_lists) {
+  RefPicListStruct rpl;
+  // num_ref_entries: ue(v)
+  rpl.num_ref_entries = reader.ReadExponentialGolomb();
+  IN_RANGE_OR_RETURN_NULL(rpl.num_ref_entries, 0, kMaxRefEntries);
+  if (sps.long_term_ref_pics_flag && rpls_idx < num_ref_pic_lists &&
+      rpl.num_ref_entries > 0) {
+    // ltrp_in_header_flag: u(1)
+    rpl.ltrp_in_header_flag = reader.Read<bool>();
+  }
+  for (uint32_t i = 0; i < rpl.num_ref_entries; ++i) {
+    bool inter_layer_ref_pic_flag = false;
+    if (sps.inter_layer_prediction_enabled_flag) {
+      // inter_layer_ref_pic_flag: u(1)
+      inter_layer_ref_pic_flag = reader.Read<bool>();
+    }
+    if (inter_layer_ref_pic_flag) {
+      // ilrp_idx: ue(v)
+      reader.ReadExponentialGolomb();
+      continue;
+    }
+    bool st_ref_pic_flag = true;
+    if (sps.long_term_ref_pics_flag) {
+      // st_ref_pic_flag: u(1)
+      st_ref_pic_flag = reader.Read<bool>();
+    }
+    if (st_ref_pic_flag) {
+      // abs_delta_poc_st: ue(v)
+      uint32_t abs_delta_poc_st = reader.ReadExponentialGolomb();
+      if ((sps.weighted_pred_flag || sps.weighted_bipred_flag) && i != 0) {
+        // AbsDeltaPocSt equals abs_delta_poc_st.
+      } else {
+        ++abs_delta_poc_st;
+      }
+      if (abs_delta_poc_st > 0) {
+        // strp_entry_sign_flag: u(1)
+        reader.ConsumeBits(1);
+      }
+    } else {
+      if (!rpl.ltrp_in_header_flag) {
+        // rpls_poc_lsb_lt: u(v)
+        reader.ConsumeBits(sps.log2_max_pic_order_cnt_lsb);
+      }
+      ++rpl.num_ltrp_entries;
+    }
+  }
+  if (!reader.Ok()) {
+    return absl::nullopt;
+  }
+  return rpl;
+}
+
+// seq_parameter_set_rbsp(), VVC spec section 7.3.2.4. Parsing stops after the
+// last syntax element that picture and slice headers depend on.
+absl::optional<H266BitstreamParser::SpsState> H266BitstreamParser::ParseSps(
+    BitstreamReader& reader) {
+  SpsState sps;
+  // sps_seq_parameter_set_id: u(4)
+  sps.sps_id = reader.ReadBits(4);
+  // sps_video_parameter_set_id: u(4)
+  uint32_t vps_id = reader.ReadBits(4);
+  // sps_max_sublayers_minus1: u(3)
+  uint32_t max_sublayers_minus1 = reader.ReadBits(3);
+  IN_RANGE_OR_RETURN_NULL(max_sublayers_minus1, 0, 6);
+  // sps_chroma_format_idc: u(2)
+  sps.chroma_format_idc = reader.ReadBits(2);
+  // sps_log2_ctu_size_minus5: u(2)
+  uint32_t log2_ctu_size = reader.ReadBits(2) + 5;
+  IN_RANGE_OR_RETURN_NULL(log2_ctu_size, 5, 7);
+  // sps_ptl_dpb_hrd_params_present_flag: u(1)
+  bool ptl_dpb_hrd_params_present_flag = reader.Read<bool>();
+  if (ptl_dpb_hrd_params_present_flag) {
+    SkipProfileTierLevel(reader, max_sublayers_minus1);
+  }
+  // sps_gdr_enabled_flag: u(1)
+  reader.ConsumeBits(1);
+  // sps_ref_pic_resampling_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_res_change_in_clvs_allowed_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  // sps_pic_width_max_in_luma_samples: ue(v)
+  uint32_t pic_width_max = reader.ReadExponentialGolomb();
+  // sps_pic_height_max_in_luma_samples: ue(v)
+  uint32_t pic_height_max = reader.ReadExponentialGolomb();
+  // sps_conformance_window_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_conf_win_{left,right,top,bottom}_offset: ue(v)
+    for (int i = 0; i < 4; ++i) {
+      reader.ReadExponentialGolomb();
+    }
+  }
+  // sps_subpic_info_present_flag: u(1)
+  sps.subpic_info_present_flag = reader.Read<bool>();
+  if (sps.subpic_info_present_flag) {
+    // sps_num_subpics_minus1: ue(v)
+    sps.num_subpics_minus1 = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN_NULL(sps.num_subpics_minus1, 0, kMaxSubpics - 1);
+    bool independent_subpics_flag = true;
+    bool subpic_same_size_flag = false;
+    if (sps.num_subpics_minus1 > 0) {
+      // sps_independent_subpics_flag: u(1)
+      independent_subpics_flag = reader.Read<bool>();
+      // sps_subpic_same_size_flag: u(1)
+      subpic_same_size_flag = reader.Read<bool>();
+    }
+    const uint32_t ctb_size = 1 << log2_ctu_size;
+    const int x_bits =
+        CeilLog2((pic_width_max + ctb_size - 1) >> log2_ctu_size);
+    const int y_bits =
+        CeilLog2((pic_height_max + ctb_size - 1) >> log2_ctu_size);
+    for (uint32_t i = 0;
+         sps.num_subpics_minus1 > 0 && i <= sps.num_subpics_minus1; ++i) {
+      if (!subpic_same_size_flag || i == 0) {
+        if (i > 0 && pic_width_max > ctb_size) {
+          // sps_subpic_ctu_top_left_x: u(v)
+          reader.ConsumeBits(x_bits);
+        }
+        if (i > 0 && pic_height_max > ctb_size) {
+          // sps_subpic_ctu_top_left_y: u(v)
+          reader.ConsumeBits(y_bits);
+        }
+        if (i < sps.num_subpics_minus1 && pic_width_max > ctb_size) {
+          // sps_subpic_width_minus1: u(v)
+          reader.ConsumeBits(x_bits);
+        }
+        if (i < sps.num_subpics_minus1 && pic_height_max > ctb_size) {
+          // sps_subpic_height_minus1: u(v)
+          reader.ConsumeBits(y_bits);
+        }
+      }
+      if (!independent_subpics_flag) {
+        // sps_subpic_treated_as_pic_flag: u(1)
+        // sps_loop_filter_across_subpic_enabled_flag: u(1)
+        reader.ConsumeBits(2);
+      }
+    }
+    // sps_subpic_id_len_minus1: ue(v)
+    sps.subpic_id_len_minus1 = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN_NULL(sps.subpic_id_len_minus1, 0, 15);
+    // sps_subpic_id_mapping_explicitly_signalled_flag: u(1)
+    if (reader.Read<bool>()) {
+      // sps_subpic_id_mapping_present_flag: u(1)
+      if (reader.Read<bool>()) {
+        // sps_subpic_id: u(v)
+        reader.ConsumeBits((sps.num_subpics_minus1 + 1) *
+                           (sps.subpic_id_len_minus1 + 1));
+      }
+    }
+  }
+  // sps_bitdepth_minus8: ue(v)
+  sps.bit_depth_minus8 = reader.ReadExponentialGolomb();
+  IN_RANGE_OR_RETURN_NULL(sps.bit_depth_minus8, 0, kMaxBitDepthMinus8);
+  // sps_entropy_coding_sync_enabled_flag: u(1)
+  // sps_entry_point_offsets_present_flag: u(1)
+  reader.ConsumeBits(2);
+  // sps_log2_max_pic_order_cnt_lsb_minus4: u(4)
+  sps.log2_max_pic_order_cnt_lsb = reader.ReadBits(4) + 4;
+  IN_RANGE_OR_RETURN_NULL(sps.log2_max_pic_order_cnt_lsb, 4, 16);
+  // sps_poc_msb_cycle_flag: u(1)
+  sps.poc_msb_cycle_flag = reader.Read<bool>();
+  if (sps.poc_msb_cycle_flag) {
+    // sps_poc_msb_cycle_len_minus1: ue(v)
+    sps.poc_msb_cycle_len = reader.ReadExponentialGolomb() + 1;
+    IN_RANGE_OR_RETURN_NULL(sps.poc_msb_cycle_len, 1,
+                            32 - sps.log2_max_pic_order_cnt_lsb);
+  }
+  // sps_num_extra_ph_bytes: u(2)
+  uint32_t num_extra_ph_bytes = reader.ReadBits(2);
+  for (uint32_t i = 0; i < num_extra_ph_bytes * 8; ++i) {
+    // sps_extra_ph_bit_present_flag: u(1)
+    sps.num_extra_ph_bits += reader.ReadBit();
+  }
+  // sps_num_extra_sh_bytes: u(2)
+  uint32_t num_extra_sh_bytes = reader.ReadBits(2);
+  for (uint32_t i = 0; i < num_extra_sh_bytes * 8; ++i) {
+    // sps_extra_sh_bit_present_flag: u(1)
+    sps.num_extra_sh_bits += reader.ReadBit();
+  }
+  if (ptl_dpb_hrd_params_present_flag) {
+    bool sublayer_dpb_params_flag = false;
+    if (max_sublayers_minus1 > 0) {
+      // sps_sublayer_dpb_params_flag: u(1)
+      sublayer_dpb_params_flag = reader.Read<bool>();
+    }
+    // dpb_parameters()
+    for (uint32_t i = sublayer_dpb_params_flag ? 0 : max_sublayers_minus1;
+         i <= max_sublayers_minus1; ++i) {
+      // dpb_max_dec_pic_buffering_minus1: ue(v)
+      // dpb_max_num_reorder_pics: ue(v)
+      // dpb_max_latency_increase_plus1: ue(v)
+      for (int j = 0; j < 3; ++j) {
+        reader.ReadExponentialGolomb();
+      }
+    }
+  }
+  // sps_log2_min_luma_coding_block_size_minus2: ue(v)
+  reader.ReadExponentialGolomb();
+  // sps_partition_constraints_override_enabled_flag: u(1)
+  sps.partition_constraints_override_enabled_flag = reader.Read<bool>();
+  // Intra slice luma partition constraints.
+  SkipPartitionConstraints(reader);
+  if (sps.chroma_format_idc != 0) {
+    // sps_qtbtt_dual_tree_intra_flag: u(1)
+    sps.qtbtt_dual_tree_intra_flag = reader.Read<bool>();
+  }
+  if (sps.qtbtt_dual_tree_intra_flag) {
+    // Intra slice chroma partition constraints.
+    SkipPartitionConstraints(reader);
+  }
+  // Inter slice partition constraints.
+  SkipPartitionConstraints(reader);
+  bool max_luma_transform_size_64_flag = false;
+  if (log2_ctu_size > 5) {
+    // sps_max_luma_transform_size_64_flag: u(1)
+    max_luma_transform_size_64_flag = reader.Read<bool>();
+  }
+  // sps_transform_skip_enabled_flag: u(1)
+  bool transform_skip_enabled_flag = reader.Read<bool>();
+  if (transform_skip_enabled_flag) {
+    // sps_log2_transform_skip_max_size_minus2: ue(v)
+    reader.ReadExponentialGolomb();
+    // sps_bdpcm_enabled_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  // sps_mts_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_explicit_mts_intra_enabled_flag: u(1)
+    // sps_explicit_mts_inter_enabled_flag: u(1)
+    reader.ConsumeBits(2);
+  }
+  // sps_lfnst_enabled_flag: u(1)
+  bool lfnst_enabled_flag = reader.Read<bool>();
+  if (sps.chroma_format_idc != 0) {
+    // sps_joint_cbcr_enabled_flag: u(1)
+    bool joint_cbcr_enabled_flag = reader.Read<bool>();
+    // sps_same_qp_table_for_chroma_flag: u(1)
+    bool same_qp_table_for_chroma_flag = reader.Read<bool>();
+    int num_qp_tables =
+        same_qp_table_for_chroma_flag ? 1 : (joint_cbcr_enabled_flag ? 3 : 2);
+    for (int i = 0; i < num_qp_tables; ++i) {
+      // sps_qp_table_start_minus26: se(v)
+      reader.ReadSignedExponentialGolomb();
+      // sps_num_points_in_qp_table_minus1: ue(v)
+      uint32_t num_points_minus1 = reader.ReadExponentialGolomb();
+      IN_RANGE_OR_RETURN_NULL(num_points_minus1, 0,
+                              kMaxQpValue + 6 * kMaxBitDepthMinus8);
+      for (uint32_t j = 0; j <= num_points_minus1; ++j) {
+        // sps_delta_qp_in_val_minus1: ue(v)
+        reader.ReadExponentialGolomb();
+        // sps_delta_qp_diff_val: ue(v)
+        reader.ReadExponentialGolomb();
+      }
+    }
+  }
+  // sps_sao_enabled_flag: u(1)
+  reader.ConsumeBits(1);
+  // sps_alf_enabled_flag: u(1)
+  sps.alf_enabled_flag = reader.Read<bool>();
+  if (sps.alf_enabled_flag && sps.chroma_format_idc != 0) {
+    // sps_ccalf_enabled_flag: u(1)
+    sps.ccalf_enabled_flag = reader.Read<bool>();
+  }
+  // sps_lmcs_enabled_flag: u(1)
+  sps.lmcs_enabled_flag = reader.Read<bool>();
+  // sps_weighted_pred_flag: u(1)
+  sps.weighted_pred_flag = reader.Read<bool>();
+  // sps_weighted_bipred_flag: u(1)
+  sps.weighted_bipred_flag = reader.Read<bool>();
+  // sps_long_term_ref_pics_flag: u(1)
+  sps.long_term_ref_pics_flag = reader.Read<bool>();
+  if (vps_id > 0) {
+    // sps_inter_layer_prediction_enabled_flag: u(1)
+    sps.inter_layer_prediction_enabled_flag = reader.Read<bool>();
+  }
+  // sps_idr_rpl_present_flag: u(1)
+  sps.idr_rpl_present_flag = reader.Read<bool>();
+  // sps_rpl1_same_as_rpl0_flag: u(1)
+  bool rpl1_same_as_rpl0_flag = reader.Read<bool>();
+  for (uint32_t i = 0; i < (rpl1_same_as_rpl0_flag ? 1u : 2u); ++i) {
+    // sps_num_ref_pic_lists: ue(v)
+    uint32_t num_ref_pic_lists = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN_NULL(num_ref_pic_lists, 0, kMaxRefPicLists);
+    for (uint32_t j = 0; j < num_ref_pic_lists; ++j) {
+      absl::optional<RefPicListStruct> rpl =
+          ParseRefPicListStruct(reader, sps, j, num_ref_pic_lists);
+      if (!rpl) {
+        return absl::nullopt;
+      }
+      sps.ref_pic_lists[i].push_back(*rpl);
+    }
+  }
+  if (rpl1_same_as_rpl0_flag) {
+    sps.ref_pic_lists[1] = sps.ref_pic_lists[0];
+  }
+  // sps_ref_wraparound_enabled_flag: u(1)
+  reader.ConsumeBits(1);
+  // sps_temporal_mvp_enabled_flag: u(1)
+  sps.temporal_mvp_enabled_flag = reader.Read<bool>();
+  if (sps.temporal_mvp_enabled_flag) {
+    // sps_sbtmvp_enabled_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  // sps_amvr_enabled_flag: u(1)
+  bool amvr_enabled_flag = reader.Read<bool>();
+  // sps_bdof_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_bdof_control_present_in_ph_flag: u(1)
+    sps.bdof_control_present_in_ph_flag = reader.Read<bool>();
+  }
+  // sps_smvd_enabled_flag: u(1)
+  reader.ConsumeBits(1);
+  // sps_dmvr_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_dmvr_control_present_in_ph_flag: u(1)
+    sps.dmvr_control_present_in_ph_flag = reader.Read<bool>();
+  }
+  // sps_mmvd_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_mmvd_fullpel_only_enabled_flag: u(1)
+    sps.mmvd_fullpel_only_enabled_flag = reader.Read<bool>();
+  }
+  // sps_six_minus_max_num_merge_cand: ue(v)
+  uint32_t six_minus_max_num_merge_cand = reader.ReadExponentialGolomb();
+  IN_RANGE_OR_RETURN_NULL(six_minus_max_num_merge_cand, 0, 5);
+  const uint32_t max_num_merge_cand = 6 - six_minus_max_num_merge_cand;
+  // sps_sbt_enabled_flag: u(1)
+  reader.ConsumeBits(1);
+  // sps_affine_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_five_minus_max_num_subblock_merge_cand: ue(v)
+    reader.ReadExponentialGolomb();
+    // sps_6param_affine_enabled_flag: u(1)
+    reader.ConsumeBits(1);
+    if (amvr_enabled_flag) {
+      // sps_affine_amvr_enabled_flag: u(1)
+      reader.ConsumeBits(1);
+    }
+    // sps_affine_prof_enabled_flag: u(1)
+    if (reader.Read<bool>()) {
+      // sps_prof_control_present_in_ph_flag: u(1)
+      sps.prof_control_present_in_ph_flag = reader.Read<bool>();
+    }
+  }
+  // sps_bcw_enabled_flag: u(1)
+  // sps_ciip_enabled_flag: u(1)
+  reader.ConsumeBits(2);
+  if (max_num_merge_cand >= 2) {
+    // sps_gpm_enabled_flag: u(1)
+    bool gpm_enabled_flag = reader.Read<bool>();
+    if (gpm_enabled_flag && max_num_merge_cand >= 3) {
+      // sps_max_num_merge_cand_minus_max_num_gpm_cand: ue(v)
+      reader.ReadExponentialGolomb();
+    }
+  }
+  // sps_log2_parallel_merge_level_minus2: ue(v)
+  reader.ReadExponentialGolomb();
+  // sps_isp_enabled_flag: u(1)
+  // sps_mrl_enabled_flag: u(1)
+  // sps_mip_enabled_flag: u(1)
+  reader.ConsumeBits(3);
+  if (sps.chroma_format_idc != 0) {
+    // sps_cclm_enabled_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  if (sps.chroma_format_idc == 1) {
+    // sps_chroma_horizontal_collocated_flag: u(1)
+    // sps_chroma_vertical_collocated_flag: u(1)
+    reader.ConsumeBits(2);
+  }
+  // sps_palette_enabled_flag: u(1)
+  bool palette_enabled_flag = reader.Read<bool>();
+  bool act_enabled_flag = false;
+  if (sps.chroma_format_idc == 3 && !max_luma_transform_size_64_flag) {
+    // sps_act_enabled_flag: u(1)
+    act_enabled_flag = reader.Read<bool>();
+  }
+  if (transform_skip_enabled_flag || palette_enabled_flag) {
+    // sps_min_qp_prime_ts: ue(v)
+    reader.ReadExponentialGolomb();
+  }
+  // sps_ibc_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_six_minus_max_num_ibc_merge_cand: ue(v)
+    reader.ReadExponentialGolomb();
+  }
+  // sps_ladf_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // sps_num_ladf_intervals_minus2: u(2)
+    uint32_t num_ladf_intervals_minus2 = reader.ReadBits(2);
+    // sps_ladf_lowest_interval_qp_offset: se(v)
+    reader.ReadSignedExponentialGolomb();
+    for (uint32_t i = 0; i < num_ladf_intervals_minus2 + 1; ++i) {
+      // sps_ladf_qp_offset: se(v)
+      reader.ReadSignedExponentialGolomb();
+      // sps_ladf_delta_threshold_minus1: ue(v)
+      reader.ReadExponentialGolomb();
+    }
+  }
+  // sps_explicit_scaling_list_enabled_flag: u(1)
+  sps.explicit_scaling_list_enabled_flag = reader.Read<bool>();
+  if (lfnst_enabled_flag && sps.explicit_scaling_list_enabled_flag) {
+    // sps_scaling_matrix_for_lfnst_disabled_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  bool scaling_matrix_for_alternative_colour_space_disabled_flag = false;
+  if (act_enabled_flag && sps.explicit_scaling_list_enabled_flag) {
+    // sps_scaling_matrix_for_alternative_colour_space_disabled_flag: u(1)
+    scaling_matrix_for_alternative_colour_space_disabled_flag =
+        reader.Read<bool>();
+  }
+  if (scaling_matrix_for_alternative_colour_space_disabled_flag) {
+    // sps_scaling_matrix_designated_colour_space_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  // sps_dep_quant_enabled_flag: u(1)
+  // sps_sign_data_hiding_enabled_flag: u(1)
+  reader.ConsumeBits(2);
+  // sps_virtual_boundaries_enabled_flag: u(1)
+  sps.virtual_boundaries_enabled_flag = reader.Read<bool>();
+  if (sps.virtual_boundaries_enabled_flag) {
+    // sps_virtual_boundaries_present_flag: u(1)
+    sps.virtual_boundaries_present_flag = reader.Read<bool>();
+    if (sps.virtual_boundaries_present_flag && !SkipVirtualBoundaries(reader)) {
+      return absl::nullopt;
+    }
+  }
+  if (!reader.Ok()) {
+    return absl::nullopt;
+  }
+  return sps;
+}
+
+// pic_parameter_set_rbsp(), VVC spec section 7.3.2.5. Parsing stops after the
+// last syntax element that picture and slice headers depend on.
+absl::optional<H266BitstreamParser::PpsState> H266BitstreamParser::ParsePps(
+    BitstreamReader& reader) {
+  PpsState pps;
+  // pps_pic_parameter_set_id: u(6)
+  pps.pps_id = reader.ReadBits(6);
+  // pps_seq_parameter_set_id: u(4)
+  pps.sps_id = reader.ReadBits(4);
+  // pps_mixed_nalu_types_in_pic_flag: u(1)
+  reader.ConsumeBits(1);
+  // pps_pic_width_in_luma_samples: ue(v)
+  uint32_t pic_width = reader.ReadExponentialGolomb();
+  // pps_pic_height_in_luma_samples: ue(v)
+  uint32_t pic_height = reader.ReadExponentialGolomb();
+  // pps_conformance_window_flag: u(1)
+  if (reader.Read<bool>()) {
+    // pps_conf_win_{left,right,top,bottom}_offset: ue(v)
+    for (int i = 0; i < 4; ++i) {
+      reader.ReadExponentialGolomb();
+    }
+  }
+  // pps_scaling_window_explicit_signalling_flag: u(1)
+  if (reader.Read<bool>()) {
+    // pps_scaling_win_{left,right,top,bottom}_offset: se(v)
+    for (int i = 0; i < 4; ++i) {
+      reader.ReadSignedExponentialGolomb();
+    }
+  }
+  // pps_output_flag_present_flag: u(1)
+  pps.output_flag_present_flag = reader.Read<bool>();
+  // pps_no_pic_partition_flag: u(1)
+  bool no_pic_partition_flag = reader.Read<bool>();
+  // pps_subpic_id_mapping_present_flag: u(1)
+  if (reader.Read<bool>()) {
+    uint32_t num_subpics_minus1 = 0;
+    if (!no_pic_partition_flag) {
+      // pps_num_subpics_minus1: ue(v)
+      num_subpics_minus1 = reader.ReadExponentialGolomb();
+      IN_RANGE_OR_RETURN_NULL(num_subpics_minus1, 0, kMaxSubpics - 1);
+    }
+    // pps_subpic_id_len_minus1: ue(v)
+    uint32_t subpic_id_len_minus1 = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN_NULL(subpic_id_len_minus1, 0, 15);
+    // pps_subpic_id: u(v)
+    reader.ConsumeBits((num_subpics_minus1 + 1) * (subpic_id_len_minus1 + 1));
+  }
+  if (!no_pic_partition_flag) {
+    // pps_log2_ctu_size_minus5: u(2)
+    uint32_t log2_ctu_size = reader.ReadBits(2) + 5;
+    IN_RANGE_OR_RETURN_NULL(log2_ctu_size, 5, 7);
+    const uint32_t ctb_size = 1 << log2_ctu_size;
+    const uint32_t pic_width_in_ctbs =
+        (pic_width + ctb_size - 1) >> log2_ctu_size;
+    const uint32_t pic_height_in_ctbs =
+        (pic_height + ctb_size - 1) >> log2_ctu_size;
+    // pps_num_exp_tile_columns_minus1: ue(v)
+    uint32_t num_exp_tile_columns_minus1 = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN_NULL(num_exp_tile_columns_minus1, 0,
+                            pic_width_in_ctbs - 1);
+    // pps_num_exp_tile_rows_minus1: ue(v)
+    uint32_t num_exp_tile_rows_minus1 = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN_NULL(num_exp_tile_rows_minus1, 0,
+                            pic_height_in_ctbs - 1);
+    absl::optional<std::vector<uint32_t>> column_widths = ReadTileSizes(
+        reader, num_exp_tile_columns_minus1 + 1, pic_width_in_ctbs);
+    if (!column_widths) {
+      return absl::nullopt;
+    }
+    absl::optional<std::vector<uint32_t>> row_heights = ReadTileSizes(
+        reader, num_exp_tile_rows_minus1 + 1, pic_height_in_ctbs);
+    if (!row_heights) {
+      return absl::nullopt;
+    }
+    const uint32_t num_tile_columns = column_widths->size();
+    const uint32_t num_tile_rows = row_heights->size();
+    pps.num_tiles_in_pic = num_tile_columns * num_tile_rows;
+    if (pps.num_tiles_in_pic > 1) {
+      // pps_loop_filter_across_tiles_enabled_flag: u(1)
+      reader.ConsumeBits(1);
+      // pps_rect_slice_flag: u(1)
+      pps.rect_slice_flag = reader.Read<bool>();
+    }
+    if (pps.rect_slice_flag) {
+      // pps_single_slice_per_subpic_flag: u(1)
+      pps.single_slice_per_subpic_flag = reader.Read<bool>();
+    }
+    uint32_t num_slices_in_pic_minus1 = 0;
+    if (pps.rect_slice_flag && !pps.single_slice_per_subpic_flag) {
+      // pps_num_slices_in_pic_minus1: ue(v)
+      num_slices_in_pic_minus1 = reader.ReadExponentialGolomb();
+      IN_RANGE_OR_RETURN_NULL(num_slices_in_pic_minus1, 0,
+                              kMaxSlicesPerAu - 1);
+      bool tile_idx_delta_present_flag = false;
+      if (num_slices_in_pic_minus1 > 1) {
+        // pps_tile_idx_delta_present_flag: u(1)
+        tile_idx_delta_present_flag = reader.Read<bool>();
+      }
+      // Walks the slice layout to find which syntax elements are present,
+      // VVC spec section 6.5.1.
+      int64_t tile_idx = 0;
+      uint32_t slice_height_in_tiles_minus1 = 0;
+      for (uint32_t i = 0; i < num_slices_in_pic_minus1; ++i) {
+        IN_RANGE_OR_RETURN_NULL(tile_idx, 0, pps.num_tiles_in_pic - 1);
+        const uint32_t tile_x = tile_idx % num_tile_columns;
+        const uint32_t tile_y = tile_idx / num_tile_columns;
+        uint32_t slice_width_in_tiles_minus1 = 0;
+        if (tile_x != num_tile_columns - 1) {
+          // pps_slice_width_in_tiles_minus1: ue(v)
+          slice_width_in_tiles_minus1 = reader.ReadExponentialGolomb();
+          IN_RANGE_OR_RETURN_NULL(slice_width_in_tiles_minus1, 0,
+                                  num_tile_columns - 1);
+        }
+        if (tile_y != num_tile_rows - 1 &&
+            (tile_idx_delta_present_flag || tile_x == 0)) {
+          // pps_slice_height_in_tiles_minus1: ue(v)
+          slice_height_in_tiles_minus1 = reader.ReadExponentialGolomb();
+          IN_RANGE_OR_RETURN_NULL(slice_height_in_tiles_minus1, 0,
+                                  num_tile_rows - 1);
+        } else if (tile_y == num_tile_rows - 1) {
+          slice_height_in_tiles_minus1 = 0;
+        }
+        const uint32_t row_height = (*row_heights)[tile_y];
+        if (slice_width_in_tiles_minus1 == 0 &&
+            slice_height_in_tiles_minus1 == 0 && row_height > 1) {
+          // pps_num_exp_slices_in_tile: ue(v)
+          uint32_t num_exp_slices_in_tile = reader.ReadExponentialGolomb();
+          IN_RANGE_OR_RETURN_NULL(num_exp_slices_in_tile, 0, row_height);
+          uint32_t num_slices_in_tile = 1;
+          if (num_exp_slices_in_tile > 0) {
+            uint32_t remaining_height = row_height;
+            uint32_t slice_height = 0;
+            for (uint32_t j = 0; j < num_exp_slices_in_tile; ++j) {
+              // pps_exp_slice_height_in_ctus_minus1: ue(v)
+              slice_height = reader.ReadExponentialGolomb() + 1;
+              IN_RANGE_OR_RETURN_NULL(slice_height, 1, remaining_height);
+              remaining_height -= slice_height;
+            }
+            num_slices_in_tile = num_exp_slices_in_tile +
+                                 remaining_height / slice_height +
+                                 (remaining_height % slice_height ? 1 : 0);
+          }
+          i += num_slices_in_tile - 1;
+          IN_RANGE_OR_RETURN_NULL(i, 0, num_slices_in_pic_minus1);
+        }
+        if (i < num_slices_in_pic_minus1) {
+          if (tile_idx_delta_present_flag) {
+            // pps_tile_idx_delta_val: se(v)
+            tile_idx += reader.ReadSignedExponentialGolomb();
+          } else {
+            tile_idx += slice_width_in_tiles_minus1 + 1;
+            if (tile_idx % num_tile_columns == 0) {
+              tile_idx += slice_height_in_tiles_minus1 * num_tile_columns;
+            }
+          }
+        }
+      }
+      pps.num_slices_in_pic = num_slices_in_pic_minus1 + 1;
+    }
+    if (!pps.rect_slice_flag || pps.single_slice_per_subpic_flag ||
+        num_slices_in_pic_minus1 > 0) {
+      // pps_loop_filter_across_slices_enabled_flag: u(1)
+      reader.ConsumeBits(1);
+    }
+  }
+  // pps_cabac_init_present_flag: u(1)
+  pps.cabac_init_present_flag = reader.Read<bool>();
+  for (int i = 0; i < 2; ++i) {
+    // pps_num_ref_idx_default_active_minus1: ue(v)
+    pps.num_ref_idx_default_active_minus1[i] = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN_NULL(pps.num_ref_idx_default_active_minus1[i], 0,
+                            kMaxRefIdxActive - 1);
+  }
+  // pps_rpl1_idx_present_flag: u(1)
+  pps.rpl1_idx_present_flag = reader.Read<bool>();
+  // pps_weighted_pred_flag: u(1)
+  pps.weighted_pred_flag = reader.Read<bool>();
+  // pps_weighted_bipred_flag: u(1)
+  pps.weighted_bipred_flag = reader.Read<bool>();
+  // pps_ref_wraparound_enabled_flag: u(1)
+  if (reader.Read<bool>()) {
+    // pps_pic_width_minus_wraparound_offset: ue(v)
+    reader.ReadExponentialGolomb();
+  }
+  // pps_init_qp_minus26: se(v)
+  pps.init_qp_minus26 = reader.ReadSignedExponentialGolomb();
+  IN_RANGE_OR_RETURN_NULL(pps.init_qp_minus26,
+                          -26 - 6 * static_cast<int>(kMaxBitDepthMinus8),
+                          kMaxQpValue - 26);
+  // pps_cu_qp_delta_enabled_flag: u(1)
+  pps.cu_qp_delta_enabled_flag = reader.Read<bool>();
+  // pps_chroma_tool_offsets_present_flag: u(1)
+  bool chroma_tool_offsets_present_flag = reader.Read<bool>();
+  if (chroma_tool_offsets_present_flag) {
+    // pps_cb_qp_offset: se(v)
+    // pps_cr_qp_offset: se(v)
+    reader.ReadSignedExponentialGolomb();
+    reader.ReadSignedExponentialGolomb();
+    // pps_joint_cbcr_qp_offset_present_flag: u(1)
+    bool joint_cbcr_qp_offset_present_flag = reader.Read<bool>();
+    if (joint_cbcr_qp_offset_present_flag) {
+      // pps_joint_cbcr_qp_offset_value: se(v)
+      reader.ReadSignedExponentialGolomb();
+    }
+    // pps_slice_chroma_qp_offsets_present_flag: u(1)
+    reader.ConsumeBits(1);
+    // pps_cu_chroma_qp_offset_list_enabled_flag: u(1)
+    pps.cu_chroma_qp_offset_list_enabled_flag = reader.Read<bool>();
+    if (pps.cu_chroma_qp_offset_list_enabled_flag) {
+      // pps_chroma_qp_offset_list_len_minus1: ue(v)
+      uint32_t list_len_minus1 = reader.ReadExponentialGolomb();
+      IN_RANGE_OR_RETURN_NULL(list_len_minus1, 0,
+                              kMaxChromaQpOffsetListLen - 1);
+      for (uint32_t i = 0; i <= list_len_minus1; ++i) {
+        // pps_cb_qp_offset_list: se(v)
+        // pps_cr_qp_offset_list: se(v)
+        reader.ReadSignedExponentialGolomb();
+        reader.ReadSignedExponentialGolomb();
+        if (joint_cbcr_qp_offset_present_flag) {
+          // pps_joint_cbcr_qp_offset_list: se(v)
+          reader.ReadSignedExponentialGolomb();
+        }
+      }
+    }
+  }
+  // pps_deblocking_filter_control_present_flag: u(1)
+  if (reader.Read<bool>()) {
+    // pps_deblocking_filter_override_enabled_flag: u(1)
+    bool deblocking_filter_override_enabled_flag = reader.Read<bool>();
+    // pps_deblocking_filter_disabled_flag: u(1)
+    bool deblocking_filter_disabled_flag = reader.Read<bool>();
+    if (!no_pic_partition_flag && deblocking_filter_override_enabled_flag) {
+      // pps_dbf_info_in_ph_flag: u(1)
+      reader.ConsumeBits(1);
+    }
+    if (!deblocking_filter_disabled_flag) {
+      // pps_luma_beta_offset_div2: se(v)
+      // pps_luma_tc_offset_div2: se(v)
+      int num_offsets = chroma_tool_offsets_present_flag ? 6 : 2;
+      for (int i = 0; i < num_offsets; ++i) {
+        reader.ReadSignedExponentialGolomb();
+      }
+    }
+  }
+  if (!no_pic_partition_flag) {
+    // pps_rpl_info_in_ph_flag: u(1)
+    pps.rpl_info_in_ph_flag = reader.Read<bool>();
+    // pps_sao_info_in_ph_flag: u(1)
+    reader.ConsumeBits(1);
+    // pps_alf_info_in_ph_flag: u(1)
+    pps.alf_info_in_ph_flag = reader.Read<bool>();
+    if ((pps.weighted_pred_flag || pps.weighted_bipred_flag) &&
+        pps.rpl_info_in_ph_flag) {
+      // pps_wp_info_in_ph_flag: u(1)
+      pps.wp_info_in_ph_flag = reader.Read<bool>();
+    }
+    // pps_qp_delta_info_in_ph_flag: u(1)
+    pps.qp_delta_info_in_ph_flag = reader.Read<bool>();
+  }
+  if (!reader.Ok()) {
+    return absl::nullopt;
+  }
+  return pps;
+}
+
+// ref_pic_lists(), VVC spec section 7.3.9.
+H266BitstreamParser::Result H266BitstreamParser::ParseRefPicLists(
+    BitstreamReader& reader,
+    const SpsState& sps,
+    const PpsState& pps,
+    uint32_t num_ref_entries[2]) {
+  bool rpl_sps_flag[2] = {false, false};
+  uint32_t rpl_idx[2] = {0, 0};
+  for (uint32_t i = 0; i < 2; ++i) {
+    const uint32_t num_ref_pic_lists = sps.ref_pic_lists[i].size();
+    const bool idx_present = i == 0 || pps.rpl1_idx_present_flag;
+    if (num_ref_pic_lists > 0 && idx_present) {
+      // rpl_sps_flag: u(1)
+      rpl_sps_flag[i] = reader.Read<bool>();
+    } else if (num_ref_pic_lists > 0) {
+      rpl_sps_flag[i] = rpl_sps_flag[0];
+    }
+    RefPicListStruct rpl;
+    if (rpl_sps_flag[i]) {
+      if (num_ref_pic_lists > 1 && idx_present) {
+        // rpl_idx: u(v)
+        rpl_idx[i] = reader.ReadBits(CeilLog2(num_ref_pic_lists));
+      } else if (!idx_present) {
+        rpl_idx[i] = rpl_idx[0];
+      }
+      IN_RANGE_OR_RETURN(rpl_idx[i], 0, num_ref_pic_lists - 1);
+      rpl = sps.ref_pic_lists[i][rpl_idx[i]];
+    } else {
+      absl::optional<RefPicListStruct> parsed_rpl = ParseRefPicListStruct(
+          reader, sps, num_ref_pic_lists, num_ref_pic_lists);
+      TRUE_OR_RETURN(parsed_rpl);
+      rpl = *parsed_rpl;
+    }
+    for (uint32_t j = 0; j < rpl.num_ltrp_entries; ++j) {
+      if (rpl.ltrp_in_header_flag) {
+        // poc_lsb_lt: u(v)
+        reader.ConsumeBits(sps.log2_max_pic_order_cnt_lsb);
+      }
+      // delta_poc_msb_cycle_present_flag: u(1)
+      if (reader.Read<bool>()) {
+        // delta_poc_msb_cycle_lt: ue(v)
+        reader.ReadExponentialGolomb();
+      }
+    }
+    num_ref_entries[i] = rpl.num_ref_entries;
+  }
+  return reader.Ok() ? kOk : kInvalidStream;
+}
+
+// picture_header_structure(), VVC spec section 7.3.2.8. Parsing stops after
+// ph_qp_delta.
+H266BitstreamParser::Result H266BitstreamParser::ParsePictureHeader(
+    BitstreamReader& reader,
+    PictureHeaderState& ph) {
+  // ph_gdr_or_irap_pic_flag: u(1)
+  bool gdr_or_irap_pic_flag = reader.Read<bool>();
+  // ph_non_ref_pic_flag: u(1)
+  bool non_ref_pic_flag = reader.Read<bool>();
+  bool gdr_pic_flag = false;
+  if (gdr_or_irap_pic_flag) {
+    // ph_gdr_pic_flag: u(1)
+    gdr_pic_flag = reader.Read<bool>();
+  }
+  // ph_inter_slice_allowed_flag: u(1)
+  ph.inter_slice_allowed_flag = reader.Read<bool>();
+  bool intra_slice_allowed_flag = true;
+  if (ph.inter_slice_allowed_flag) {
+    // ph_intra_slice_allowed_flag: u(1)
+    intra_slice_allowed_flag = reader.Read<bool>();
+  }
+  // ph_pic_parameter_set_id: ue(v)
+  ph.pps_id = reader.ReadExponentialGolomb();
+  IN_RANGE_OR_RETURN(ph.pps_id, 0, kMaxPpsId);
+  const PpsState* pps = GetPPS(ph.pps_id);
+  TRUE_OR_RETURN(pps);
+  const SpsState* sps = GetSPS(pps->sps_id);
+  TRUE_OR_RETURN(sps);
+  // ph_pic_order_cnt_lsb: u(v)
+  reader.ConsumeBits(sps->log2_max_pic_order_cnt_lsb);
+  if (gdr_pic_flag) {
+    // ph_recovery_poc_cnt: ue(v)
+    reader.ReadExponentialGolomb();
+  }
+  // ph_extra_bit: u(1)
+  reader.ConsumeBits(sps->num_extra_ph_bits);
+  if (sps->poc_msb_cycle_flag) {
+    // ph_poc_msb_cycle_present_flag: u(1)
+    if (reader.Read<bool>()) {
+      // ph_poc_msb_cycle_val: u(v)
+      reader.ConsumeBits(sps->poc_msb_cycle_len);
+    }
+  }
+  if (sps->alf_enabled_flag && pps->alf_info_in_ph_flag) {
+    // ph_alf_enabled_flag: u(1)
+    if (reader.Read<bool>()) {
+      SkipAlfApsIds(reader, sps->chroma_format_idc, sps->ccalf_enabled_flag);
+    }
+  }
+  if (sps->lmcs_enabled_flag) {
+    // ph_lmcs_enabled_flag: u(1)
+    ph.lmcs_enabled_flag = reader.Read<bool>();
+    if (ph.lmcs_enabled_flag) {
+      // ph_lmcs_aps_id: u(2)
+      reader.ConsumeBits(2);
+      if (sps->chroma_format_idc != 0) {
+        // ph_chroma_residual_scale_flag: u(1)
+        reader.ConsumeBits(1);
+      }
+    }
+  }
+  if (sps->explicit_scaling_list_enabled_flag) {
+    // ph_explicit_scaling_list_enabled_flag: u(1)
+    ph.explicit_scaling_list_enabled_flag = reader.Read<bool>();
+    if (ph.explicit_scaling_list_enabled_flag) {
+      // ph_scaling_list_aps_id: u(3)
+      reader.ConsumeBits(3);
+    }
+  }
+  if (sps->virtual_boundaries_enabled_flag &&
+      !sps->virtual_boundaries_present_flag) {
+    // ph_virtual_boundaries_present_flag: u(1)
+    if (reader.Read<bool>()) {
+      TRUE_OR_RETURN(SkipVirtualBoundaries(reader));
+    }
+  }
+  if (pps->output_flag_present_flag && !non_ref_pic_flag) {
+    // ph_pic_output_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  if (pps->rpl_info_in_ph_flag) {
+    Result res = ParseRefPicLists(reader, *sps, *pps, ph.num_ref_entries);
+    if (res != kOk) {
+      return res;
+    }
+  }
+  bool partition_constraints_override_flag = false;
+  if (sps->partition_constraints_override_enabled_flag) {
+    // ph_partition_constraints_override_flag: u(1)
+    partition_constraints_override_flag = reader.Read<bool>();
+  }
+  if (intra_slice_allowed_flag) {
+    if (partition_constraints_override_flag) {
+      SkipPartitionConstraints(reader);
+      if (sps->qtbtt_dual_tree_intra_flag) {
+        SkipPartitionConstraints(reader);
+      }
+    }
+    if (pps->cu_qp_delta_enabled_flag) {
+      // ph_cu_qp_delta_subdiv_intra_slice: ue(v)
+      reader.ReadExponentialGolomb();
+    }
+    if (pps->cu_chroma_qp_offset_list_enabled_flag) {
+      // ph_cu_chroma_qp_offset_subdiv_intra_slice: ue(v)
+      reader.ReadExponentialGolomb();
+    }
+  }
+  if (ph.inter_slice_allowed_flag) {
+    if (partition_constraints_override_flag) {
+      SkipPartitionConstraints(reader);
+    }
+    if (pps->cu_qp_delta_enabled_flag) {
+      // ph_cu_qp_delta_subdiv_inter_slice: ue(v)
+      reader.ReadExponentialGolomb();
+    }
+    if (pps->cu_chroma_qp_offset_list_enabled_flag) {
+      // ph_cu_chroma_qp_offset_subdiv_inter_slice: ue(v)
+      reader.ReadExponentialGolomb();
+    }
+    if (sps->temporal_mvp_enabled_flag) {
+      // ph_temporal_mvp_enabled_flag: u(1)
+      ph.temporal_mvp_enabled_flag = reader.Read<bool>();
+      if (ph.temporal_mvp_enabled_flag && pps->rpl_info_in_ph_flag) {
+        bool collocated_from_l0_flag = true;
+        if (ph.num_ref_entries[1] > 0) {
+          // ph_collocated_from_l0_flag: u(1)
+          collocated_from_l0_flag = reader.Read<bool>();
+        }
+        if ((collocated_from_l0_flag && ph.num_ref_entries[0] > 1) ||
+            (!collocated_from_l0_flag && ph.num_ref_entries[1] > 1)) {
+          // ph_collocated_ref_idx: ue(v)
+          reader.ReadExponentialGolomb();
+        }
+      }
+    }
+    if (sps->mmvd_fullpel_only_enabled_flag) {
+      // ph_mmvd_fullpel_only_flag: u(1)
+      reader.ConsumeBits(1);
+    }
+    if (!pps->rpl_info_in_ph_flag || ph.num_ref_entries[1] > 0) {
+      // ph_mvd_l1_zero_flag: u(1)
+      reader.ConsumeBits(1);
+      if (sps->bdof_control_present_in_ph_flag) {
+        // ph_bdof_disabled_flag: u(1)
+        reader.ConsumeBits(1);
+      }
+      if (sps->dmvr_control_present_in_ph_flag) {
+        // ph_dmvr_disabled_flag: u(1)
+        reader.ConsumeBits(1);
+      }
+    }
+    if (sps->prof_control_present_in_ph_flag) {
+      // ph_prof_disabled_flag: u(1)
+      reader.ConsumeBits(1);
+    }
+    if ((pps->weighted_pred_flag || pps->weighted_bipred_flag) &&
+        pps->wp_info_in_ph_flag) {
+      // pred_weight_table()
+      RTC_LOG(LS_ERROR) << "Streams with pred_weight_table unsupported.";
+      return kUnsupportedStream;
+    }
+  }
+  if (pps->qp_delta_info_in_ph_flag) {
+    // ph_qp_delta: se(v)
+    ph.qp_delta = reader.ReadSignedExponentialGolomb();
+  }
+  return reader.Ok() ? kOk : kInvalidStream;
+}
+
+// slice_header(), VVC spec section 7.3.7. Parsing stops after sh_qp_delta.
+H266BitstreamParser::Result H266BitstreamParser::ParseSliceHeader(
+    BitstreamReader& reader,
+    uint8_t nalu_type) {
+  // sh_picture_header_in_slice_header_flag: u(1)
+  bool picture_header_in_slice_header_flag = reader.Read<bool>();
+  PictureHeaderState ph;
+  if (picture_header_in_slice_header_flag) {
+    Result res = ParsePictureHeader(reader, ph);
+    if (res != kOk) {
+      return res;
+    }
+  } else {
+    TRUE_OR_RETURN(picture_header_);
+    ph = *picture_header_;
+  }
+  const PpsState* pps = GetPPS(ph.pps_id);
+  TRUE_OR_RETURN(pps);
+  const SpsState* sps = GetSPS(pps->sps_id);
+  TRUE_OR_RETURN(sps);
+
+  if (sps->subpic_info_present_flag) {
+    // sh_subpic_id: u(v)
+    reader.ConsumeBits(sps->subpic_id_len_minus1 + 1);
+  }
+  uint32_t slice_address = 0;
+  if (pps->rect_slice_flag) {
+    uint32_t num_slices_in_subpic = 1;
+    if (!pps->single_slice_per_subpic_flag) {
+      if (sps->num_subpics_minus1 > 0) {
+        // The number of slices in the current subpicture depends on the
+        // subpicture layout, which is not tracked.
+        RTC_LOG(LS_ERROR) << "Streams with several slices in several "
+                             "subpictures unsupported.";
+        return kUnsupportedStream;
+      }
+      num_slices_in_subpic = pps->num_slices_in_pic;
+    }
+    if (num_slices_in_subpic > 1) {
+      // sh_slice_address: u(v)
+      slice_address = reader.ReadBits(CeilLog2(num_slices_in_subpic));
+      IN_RANGE_OR_RETURN(slice_address, 0, num_slices_in_subpic - 1);
+    }
+  } else if (pps->num_tiles_in_pic > 1) {
+    // sh_slice_address: u(v)
+    slice_address = reader.ReadBits(CeilLog2(pps->num_tiles_in_pic));
+    IN_RANGE_OR_RETURN(slice_address, 0, pps->num_tiles_in_pic - 1);
+  }
+  // sh_extra_bit: u(1)
+  reader.ConsumeBits(sps->num_extra_sh_bits);
+  if (!pps->rect_slice_flag && pps->num_tiles_in_pic - slice_address > 1) {
+    // sh_num_tiles_in_slice_minus1: ue(v)
+    reader.ReadExponentialGolomb();
+  }
+  uint32_t slice_type = SliceType::kI;
+  if (ph.inter_slice_allowed_flag) {
+    // sh_slice_type: ue(v)
+    slice_type = reader.ReadExponentialGolomb();
+    IN_RANGE_OR_RETURN(slice_type, 0, 2);
+  }
+  if (nalu_type >= kH266IdrWRadlNut && nalu_type <= kH266GdrNut) {
+    // sh_no_output_of_prior_pics_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  if (sps->alf_enabled_flag && !pps->alf_info_in_ph_flag) {
+    // sh_alf_enabled_flag: u(1)
+    if (reader.Read<bool>()) {
+      SkipAlfApsIds(reader, sps->chroma_format_idc, sps->ccalf_enabled_flag);
+    }
+  }
+  if (ph.lmcs_enabled_flag && !picture_header_in_slice_header_flag) {
+    // sh_lmcs_used_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  if (ph.explicit_scaling_list_enabled_flag &&
+      !picture_header_in_slice_header_flag) {
+    // sh_explicit_scaling_list_used_flag: u(1)
+    reader.ConsumeBits(1);
+  }
+  uint32_t num_ref_entries[2] = {0, 0};
+  if (pps->rpl_info_in_ph_flag) {
+    num_ref_entries[0] = ph.num_ref_entries[0];
+    num_ref_entries[1] = ph.num_ref_entries[1];
+  } else if ((nalu_type != kH266IdrWRadlNut && nalu_type != kH266IdrNLpNut) ||
+             sps->idr_rpl_present_flag) {
+    Result res = ParseRefPicLists(reader, *sps, *pps, num_ref_entries);
+    if (res != kOk) {
+      return res;
+    }
+  }
+  if (slice_type != SliceType::kI) {
+    const uint32_t num_lists = slice_type == SliceType::kB ? 2 : 1;
+    bool num_ref_idx_active_override_flag = true;
+    const bool override_present =
+        num_ref_entries[0] > 1 ||
+        (slice_type == SliceType::kB && num_ref_entries[1] > 1);
+    if (override_present) {
+      // sh_num_ref_idx_active_override_flag: u(1)
+      num_ref_idx_active_override_flag = reader.Read<bool>();
+    }
+    uint32_t num_ref_idx_active[2] = {0, 0};
+    for (uint32_t i = 0; i < num_lists; ++i) {
+      if (num_ref_idx_active_override_flag) {
+        uint32_t num_ref_idx_active_minus1 = 0;
+        if (override_present && num_ref_entries[i] > 1) {
+          // sh_num_ref_idx_active_minus1: ue(v)
+          num_ref_idx_active_minus1 = reader.ReadExponentialGolomb();
+          IN_RANGE_OR_RETURN(num_ref_idx_active_minus1, 0,
+                             kMaxRefIdxActive - 1);
+        }
+        num_ref_idx_active[i] = num_ref_idx_active_minus1 + 1;
+      } else {
+        num_ref_idx_active[i] =
+            std::min(num_ref_entries[i],
+                     pps->num_ref_idx_default_active_minus1[i] + 1);
+      }
+    }
+    if (pps->cabac_init_present_flag) {
+      // sh_cabac_init_flag: u(1)
+      reader.ConsumeBits(1);
+    }
+    if (ph.temporal_mvp_enabled_flag && !pps->rpl_info_in_ph_flag) {
+      bool collocated_from_l0_flag = true;
+      if (slice_type == SliceType::kB) {
+        // sh_collocated_from_l0_flag: u(1)
+        collocated_from_l0_flag = reader.Read<bool>();
+      }
+      if ((collocated_from_l0_flag && num_ref_idx_active[0] > 1) ||
+          (!collocated_from_l0_flag && num_ref_idx_active[1] > 1)) {
+        // sh_collocated_ref_idx: ue(v)
+        reader.ReadExponentialGolomb();
+      }
+    }
+    if (!pps->wp_info_in_ph_flag &&
+        ((pps->weighted_pred_flag && slice_type == SliceType::kP) ||
+         (pps->weighted_bipred_flag && slice_type == SliceType::kB))) {
+      // pred_weight_table()
+      RTC_LOG(LS_ERROR) << "Streams with pred_weight_table unsupported.";
+      return kUnsupportedStream;
+    }
+  }
+  int32_t qp_delta = ph.qp_delta;
+  if (!pps->qp_delta_info_in_ph_flag) {
+    // sh_qp_delta: se(v)
+    qp_delta = reader.ReadSignedExponentialGolomb();
+  }
+  // 7-137 in H266 spec.
+  const int qp = 26 + pps->init_qp_minus26 + qp_delta;
+  IN_RANGE_OR_RETURN(qp, -6 * static_cast<int>(sps->bit_depth_minus8),
+                     kMaxQpValue);
+  last_slice_qp_ = qp;
+  return kOk;
+}
+
+const H266BitstreamParser::PpsState* H266BitstreamParser::GetPPS(
+    uint32_t id) const {
+  auto it = pps_.find(id);
+  if (it == pps_.end()) {
+    RTC_LOG(LS_WARNING) << "Requested a nonexistent PPS id " << id;
+    return nullptr;
+  }
+  return &it->second;
+}
+
+const H266BitstreamParser::SpsState* H266BitstreamParser::GetSPS(
+    uint32_t id) const {
+  auto it = sps_.find(id);
+  if (it == sps_.end()) {
+    RTC_LOG(LS_WARNING) << "Requested a nonexistent SPS id " << id;
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void H266BitstreamParser::ParseNalu(const uint8_t* nalu, size_t length) {
+  if (length < kH266NalHeaderSize) {
+    return;
+  }
+  const uint8_t nalu_type = H266Common::ParseNaluType(nalu);
+  rtc::ArrayView<const uint8_t> payload(nalu + kH266NalHeaderSize,
+                                        length - kH266NalHeaderSize);
+  switch (nalu_type) {
+    case kH266SpsNut: {
+      std::vector<uint8_t> rbsp =
+          H264::ParseRbsp(payload.data(), payload.size());
+      BitstreamReader reader(rbsp);
+      absl::optional<SpsState> sps = ParseSps(reader);
+      if (!sps) {
+        RTC_LOG(LS_WARNING) << "Unable to parse SPS from H266 bitstream.";
+      } else {
+        sps_[sps->sps_id] = std::move(*sps);
+      }
+      break;
+    }
+    case kH266PpsNut: {
+      std::vector<uint8_t> rbsp =
+          H264::ParseRbsp(payload.data(), payload.size());
+      BitstreamReader reader(rbsp);
+      absl::optional<PpsState> pps = ParsePps(reader);
+      if (!pps) {
+        RTC_LOG(LS_WARNING) << "Unable to parse PPS from H266 bitstream.";
+      } else {
+        pps_[pps->pps_id] = *pps;
+      }
+      break;
+    }
+    case kH266PhNut: {
+      uint8_t rbsp[kMaxSliceHeaderSize];
+      BitstreamReader reader(
+          rtc::ArrayView<const uint8_t>(rbsp, UnescapeRbsp(payload, rbsp)));
+      PictureHeaderState ph;
+      Result res = ParsePictureHeader(reader, ph);
+      if (res != kOk) {
+        RTC_LOG(LS_INFO) << "Failed to parse picture header. Error: " << res;
+        picture_header_ = absl::nullopt;
+      } else {
+        picture_header_ = ph;
+      }
+      break;
+    }
+    case kH266TrailNut:
+    case kH266StsaNut:
+    case kH266RadlNut:
+    case kH266RaslNut:
+    case kH266IdrWRadlNut:
+    case kH266IdrNLpNut:
+    case kH266CraNut:
+    case kH266GdrNut: {
+      last_slice_qp_ = absl::nullopt;
+      uint8_t rbsp[kMaxSliceHeaderSize];
+      BitstreamReader reader(
+          rtc::ArrayView<const uint8_t>(rbsp, UnescapeRbsp(payload, rbsp)));
+      Result res = ParseSliceHeader(reader, nalu_type);
+      if (res != kOk) {
+        RTC_LOG(LS_INFO) << "Failed to parse bitstream. Error: " << res;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void H266BitstreamParser::ParseBitstream(
+    rtc::ArrayView<const uint8_t> bitstream) {
+  std::vector<H264::NaluIndex> nalu_indices =
+      H264::FindNaluIndices(bitstream.data(), bitstream.size());
+  for (const H264::NaluIndex& index : nalu_indices)
+    ParseNalu(&bitstream[index.payload_start_offset], index.payload_size);
+}
+
+absl::optional<int> H266BitstreamParser::GetLastSliceQp() const {
+  return last_slice_qp_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_H266_H266_BITSTREAM_PARSER_H_
+#define COMMON_VIDEO_H266_H266_BITSTREAM_PARSER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/video_codecs/bitstream_parser.h"
+#include "rtc_base/bitstream_reader.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Stateful H266 bitstream parser (due to SPS/PPS/PH). Used to parse out QP
+// values from the bitstream.
+//
+// Only the parts of the SPS and PPS that determine the layout of the picture
+// and slice headers are kept. Of slice and picture header NAL units only the
+// first kMaxSliceHeaderSize bytes are unescaped, so the cost of parsing does
+// not depend on the size of the coded slice data.
+class RTC_EXPORT H266BitstreamParser : public BitstreamParser {
+ public:
+  // Upper bound on the number of bytes a slice header, including an embedded
+  // picture header, occupies up to and including its QP delta. Same bound as
+  // in H265BitstreamParser; VVC headers can carry reference picture lists,
+  // weighted prediction tables and ALF/LMCS parameters before the QP delta.
+  static constexpr size_t kMaxSliceHeaderSize = 512;
+
+  H266BitstreamParser();
+  ~H266BitstreamParser() override;
+
+  void ParseBitstream(rtc::ArrayView<const uint8_t> bitstream) override;
+  absl::optional<int> GetLastSliceQp() const override;
+
+ protected:
+  enum Result {
+    kOk,
+    kInvalidStream,
+    kUnsupportedStream,
+  };
+
+  // ref_pic_list_struct() fields needed to skip over reference picture lists.
+  struct RefPicListStruct {
+    uint32_t num_ref_entries = 0;
+    uint32_t num_ltrp_entries = 0;
+    bool ltrp_in_header_flag = true;
+  };
+
+  struct SpsState {
+    SpsState();
+    SpsState(const SpsState&);
+    SpsState& operator=(const SpsState&);
+    ~SpsState();
+
+    uint32_t sps_id = 0;
+    uint32_t chroma_format_idc = 0;
+    uint32_t bit_depth_minus8 = 0;
+    bool subpic_info_present_flag = false;
+    uint32_t num_subpics_minus1 = 0;
+    uint32_t subpic_id_len_minus1 = 0;
+    uint32_t log2_max_pic_order_cnt_lsb = 0;
+    bool poc_msb_cycle_flag = false;
+    uint32_t poc_msb_cycle_len = 0;
+    uint32_t num_extra_ph_bits = 0;
+    uint32_t num_extra_sh_bits = 0;
+    bool partition_constraints_override_enabled_flag = false;
+    bool qtbtt_dual_tree_intra_flag = false;
+    bool alf_enabled_flag = false;
+    bool ccalf_enabled_flag = false;
+    bool lmcs_enabled_flag = false;
+    bool weighted_pred_flag = false;
+    bool weighted_bipred_flag = false;
+    bool long_term_ref_pics_flag = false;
+    bool inter_layer_prediction_enabled_flag = false;
+    bool idr_rpl_present_flag = false;
+    std::vector<RefPicListStruct> ref_pic_lists[2];
+    bool temporal_mvp_enabled_flag = false;
+    bool mmvd_fullpel_only_enabled_flag = false;
+    bool bdof_control_present_in_ph_flag = false;
+    bool dmvr_control_present_in_ph_flag = false;
+    bool prof_control_present_in_ph_flag = false;
+    bool explicit_scaling_list_enabled_flag = false;
+    bool virtual_boundaries_enabled_flag = false;
+    bool virtual_boundaries_present_flag = false;
+  };
+
+  struct PpsState {
+    uint32_t pps_id = 0;
+    uint32_t sps_id = 0;
+    bool output_flag_present_flag = false;
+    uint32_t num_tiles_in_pic = 1;
+    bool rect_slice_flag = true;
+    bool single_slice_per_subpic_flag = true;
+    uint32_t num_slices_in_pic = 1;
+    bool cabac_init_present_flag = false;
+    uint32_t num_ref_idx_default_active_minus1[2] = {0, 0};
+    bool rpl1_idx_present_flag = false;
+    bool weighted_pred_flag = false;
+    bool weighted_bipred_flag = false;
+    int32_t init_qp_minus26 = 0;
+    bool cu_qp_delta_enabled_flag = false;
+    bool cu_chroma_qp_offset_list_enabled_flag = false;
+    bool rpl_info_in_ph_flag = false;
+    bool alf_info_in_ph_flag = false;
+    bool wp_info_in_ph_flag = false;
+    bool qp_delta_info_in_ph_flag = false;
+  };
+
+  // Picture header fields that the slice headers of the picture depend on.
+  struct PictureHeaderState {
+    uint32_t pps_id = 0;
+    bool inter_slice_allowed_flag = false;
+    bool lmcs_enabled_flag = false;
+    bool explicit_scaling_list_enabled_flag = false;
+    bool temporal_mvp_enabled_flag = false;
+    // Only set when the PPS signals reference picture lists in the picture
+    // header.
+    uint32_t num_ref_entries[2] = {0, 0};
+    // Only set when the PPS signals the QP delta in the picture header.
+    int32_t qp_delta = 0;
+  };
+
+  static absl::optional<SpsState> ParseSps(BitstreamReader& reader);
+  static absl::optional<PpsState> ParsePps(BitstreamReader& reader);
+  static absl::optional<RefPicListStruct> ParseRefPicListStruct(
+      BitstreamReader& reader,
+      const SpsState& sps,
+      uint32_t rpls_idx,
+      uint32_t num_ref_pic_lists);
+
+  void ParseNalu(const uint8_t* nalu, size_t length);
+  Result ParsePictureHeader(BitstreamReader& reader, PictureHeaderState& ph);
+  Result ParseRefPicLists(BitstreamReader& reader,
+                          const SpsState& sps,
+                          const PpsState& pps,
+                          uint32_t num_ref_entries[2]);
+  Result ParseSliceHeader(BitstreamReader& reader, uint8_t nalu_type);
+
+  const PpsState* GetPPS(uint32_t id) const;
+  const SpsState* GetSPS(uint32_t id) const;
+
+  // SPS/PPS state, updated when parsing new SPS/PPS, used to parse picture
+  // and slice headers.
+  flat_map<uint32_t, SpsState> sps_;
+  flat_map<uint32_t, PpsState> pps_;
+  // The picture header of the current picture, if it was sent in its own
+  // NAL unit.
+  absl::optional<PictureHeaderState> picture_header_;
+
+  // Last parsed slice QP.
+  absl::optional<int> last_slice_qp_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_H266_H266_BITSTREAM_PARSER_H_
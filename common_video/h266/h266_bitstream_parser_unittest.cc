@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h266/h266_bitstream_parser.h"
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+// SPS and two PPSs, the second of which splits the picture into two tiles
+// and signals reference picture lists and QP delta in the picture header.
+const uint8_t kH266SpsPps[] = {
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x79, 0x00, 0x0d, 0x02, 0x33, 0x80, 0x00,
+    0x00, 0x0a, 0x02, 0x00, 0xb4, 0x46, 0xa0, 0x0d, 0xe8, 0x8d, 0xdb, 0x69,
+    0x10, 0xa4, 0xc8, 0x9c, 0x26, 0xcc, 0x41, 0x62, 0x42, 0xa1, 0x0f, 0x0b,
+    0x5b, 0xd1, 0xed, 0x75, 0xcd, 0x7e, 0x44, 0xab, 0xcd, 0x80, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x81, 0x00, 0x00, 0x05, 0x01, 0x00, 0x5a, 0x22, 0xe0,
+    0x33, 0xf3, 0x7f, 0x00, 0x00, 0x00, 0x01, 0x00, 0x81, 0x04, 0x00, 0x05,
+    0x01, 0x00, 0x5a, 0x20, 0x94, 0xa5, 0x31, 0x60, 0x20, 0x5c,
+};
+
+// IDR slice with the picture header in the slice header, slice QP 35.
+const uint8_t kH266IdrSlice[] = {
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x41, 0xc4, 0x02, 0x49, 0x23, 0x10, 0x30,
+    0x00, 0x00, 0x08, 0x00, 0x00, 0x03, 0x02, 0x13, 0xfc,
+};
+
+// P slice referring to an SPS reference picture list, slice QP 27.
+const uint8_t kH266TrailSlice[] = {
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x9c, 0x04, 0x4a, 0x48, 0x2c, 0x00,
+    0x00, 0x04, 0x00, 0x00, 0x03, 0x01, 0x09, 0xfe,
+};
+
+// Picture header NAL unit followed by a B slice of its picture, slice QP 29.
+const uint8_t kH266PictureHeaderAndSlice[] = {
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x99, 0x34, 0x05, 0x20, 0x1b, 0x9c, 0x00,
+    0x00, 0x00, 0x01, 0x00, 0x01, 0x16, 0xa0, 0x00, 0x00, 0x20, 0x00, 0x00,
+    0x08, 0x4f, 0xf0,
+};
+
+// IDR slice with slice QP 64.
+const uint8_t kH266InvalidQpSlice[] = {
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x41, 0xc4, 0x02, 0x49, 0x23, 0x10, 0x02,
+    0x00, 0x00, 0x03, 0x00, 0x08, 0x00, 0x00, 0x03, 0x02, 0x13, 0xfc,
+};
+
+TEST(H266BitstreamParserTest, ReportsNoQpWithoutParsedSlices) {
+  H266BitstreamParser h266_parser;
+  EXPECT_FALSE(h266_parser.GetLastSliceQp().has_value());
+}
+
+TEST(H266BitstreamParserTest, ReportsNoQpWithOnlyParsedSpsAndPps) {
+  H266BitstreamParser h266_parser;
+  h266_parser.ParseBitstream(kH266SpsPps);
+  EXPECT_FALSE(h266_parser.GetLastSliceQp().has_value());
+}
+
+TEST(H266BitstreamParserTest, ReportsNoQpForSliceWithoutParameterSets) {
+  H266BitstreamParser h266_parser;
+  h266_parser.ParseBitstream(kH266IdrSlice);
+  EXPECT_FALSE(h266_parser.GetLastSliceQp().has_value());
+}
+
+TEST(H266BitstreamParserTest, ReportsLastSliceQpForImageSlices) {
+  H266BitstreamParser h266_parser;
+  h266_parser.ParseBitstream(kH266SpsPps);
+  h266_parser.ParseBitstream(kH266IdrSlice);
+  absl::optional<int> qp = h266_parser.GetLastSliceQp();
+  ASSERT_TRUE(qp.has_value());
+  EXPECT_EQ(35, *qp);
+
+  // Parse an additional image slice.
+  h266_parser.ParseBitstream(kH266TrailSlice);
+  qp = h266_parser.GetLastSliceQp();
+  ASSERT_TRUE(qp.has_value());
+  EXPECT_EQ(27, *qp);
+}
+
+TEST(H266BitstreamParserTest, ReportsLastSliceQpFromPictureHeader) {
+  H266BitstreamParser h266_parser;
+  h266_parser.ParseBitstream(kH266SpsPps);
+  h266_parser.ParseBitstream(kH266PictureHeaderAndSlice);
+  absl::optional<int> qp = h266_parser.GetLastSliceQp();
+  ASSERT_TRUE(qp.has_value());
+  EXPECT_EQ(29, *qp);
+}
+
+TEST(H266BitstreamParserTest, ReportsNoQpForSliceWithoutPictureHeader) {
+  H266BitstreamParser h266_parser;
+  h266_parser.ParseBitstream(kH266SpsPps);
+  // Skip the picture header NAL unit.
+  h266_parser.ParseBitstream(
+      rtc::ArrayView<const uint8_t>(kH266PictureHeaderAndSlice).subview(11));
+  EXPECT_FALSE(h266_parser.GetLastSliceQp().has_value());
+}
+
+TEST(H266BitstreamParserTest, ReportsLastSliceQpInvalidQpSlices) {
+  H266BitstreamParser h266_parser;
+  h266_parser.ParseBitstream(kH266SpsPps);
+  h266_parser.ParseBitstream(kH266InvalidQpSlice);
+  EXPECT_FALSE(h266_parser.GetLastSliceQp().has_value());
+}
+
+TEST(H266BitstreamParserTest, ParsesSliceHeaderOfLargeSlice) {
+  H266BitstreamParser h266_parser;
+  h266_parser.ParseBitstream(kH266SpsPps);
+  std::vector<uint8_t> large_slice(std::begin(kH266IdrSlice),
+                                   std::end(kH266IdrSlice));
+  large_slice.resize(100 * H266BitstreamParser::kMaxSliceHeaderSize, 0x5a);
+  h266_parser.ParseBitstream(large_slice);
+  absl::optional<int> qp = h266_parser.GetLastSliceQp();
+  ASSERT_TRUE(qp.has_value());
+  EXPECT_EQ(35, *qp);
+}
+
+}  // namespace webrtc
@@ -11,6 +11,7 @@
 #ifndef COMMON_VIDEO_H266_H266_COMMON_H_
 #define COMMON_VIDEO_H266_H266_COMMON_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "rtc_base/system/rtc_export.h"
@@ -23,27 +24,32 @@ const int kH266NalHeaderSize = 2;
 // VVC NAL Unit Type codes (VVC spec Table 7-1)
 enum H266NaluType : uint8_t {
   kH266TrailNut = 0,
-  kH266StashNut = 1,
+  kH266StsaNut = 1,
   kH266RadlNut = 2,
   kH266RaslNut = 3,
-  kH266IdrWRadlNut = 4,
-  kH266IdrNRadlNut = 5,
-  kH266CraNut = 6,
-  kH266GdrNut = 7,
-  kH266PrefixApsNut = 16,
-  kH266SuffixApsNut = 17,
-  kH266PrefixSeiNut = 18,
-  kH266SuffixSeiNut = 19,
-  kH266PhNut = 20,
-  kH266VpsNut = 32,
-  kH266SpsNut = 33,
-  kH266PpsNut = 34,
-  kH266PrefixNut = 35,
-  kH266SuffixNut = 36,
-  kH266EosNut = 37,
-  kH266EobNut = 38,
-  kH266FdNut = 39,
-  kH266UnspecifiedNut = 63,
+  kH266IdrWRadlNut = 7,
+  kH266IdrNLpNut = 8,
+  kH266CraNut = 9,
+  kH266GdrNut = 10,
+  kH266RsvIrap11 = 11,
+  kH266OpiNut = 12,
+  kH266DciNut = 13,
+  kH266VpsNut = 14,
+  kH266SpsNut = 15,
+  kH266PpsNut = 16,
+  kH266PrefixApsNut = 17,
+  kH266SuffixApsNut = 18,
+  kH266PhNut = 19,
+  kH266AudNut = 20,
+  kH266EosNut = 21,
+  kH266EobNut = 22,
+  kH266PrefixSeiNut = 23,
+  kH266SuffixSeiNut = 24,
+  kH266FdNut = 25,
+  // Payload types of the RTP payload format, RFC 9328 section 4.3.
+  kH266Ap = 28,
+  kH266Fu = 29,
+  kH266UnspecifiedNut = 31,
 };
 
 // A class for common VVC parsing functions.
@@ -18,27 +18,27 @@ namespace {
 TEST(H266CommonTest, ParseNaluType) {
   // Test parsing NAL unit type from a byte
   // NAL unit type is in bits 3-7 of the second byte
-  uint8_t data = 0x08;  // 00001000 - should be NAL type 1 (STASH_NUT)
-  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266StashNut);
+  uint8_t data = 0x08;  // 00001000 - should be NAL type 1 (STSA_NUT)
+  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266StsaNut);
   
-  data = 0x28;  // 00101000 - should be NAL type 5 (IDR_N_RADL_NUT)
-  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266IdrNRadlNut);
+  data = 0x40;  // 01000000 - should be NAL type 8 (IDR_N_LP)
+  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266IdrNLpNut);
   
   data = 0xF8;  // 11111000 - should be NAL type 31 (unspecified)
-  EXPECT_EQ(H266Common::ParseNaluType(data), static_cast<H266NaluType>(31));
+  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266UnspecifiedNut);
 }
 
 TEST(H266CommonTest, ParseNaluTypeFromData) {
   // Test parsing NAL unit type from a buffer
   // NAL unit type is in bits 3-7 of the second byte
-  uint8_t data[2] = {0x00, 0x08};  // Second byte 00001000 - should be NAL type 1 (STASH_NUT)
-  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266StashNut);
+  uint8_t data[2] = {0x00, 0x08};  // Second byte 00001000 - should be NAL type 1 (STSA_NUT)
+  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266StsaNut);
   
-  data[1] = 0x28;  // 00101000 - should be NAL type 5 (IDR_N_RADL_NUT)
-  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266IdrNRadlNut);
+  data[1] = 0x40;  // 01000000 - should be NAL type 8 (IDR_N_LP)
+  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266IdrNLpNut);
   
   data[1] = 0xF8;  // 11111000 - should be NAL type 31 (unspecified)
-  EXPECT_EQ(H266Common::ParseNaluType(data), static_cast<H266NaluType>(31));
+  EXPECT_EQ(H266Common::ParseNaluType(data), H266NaluType::kH266UnspecifiedNut);
 }
 
 }  // namespace
@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2012 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_LOCALVIDEO_CAPTURER_TRACK_SOURCE_H_
+#define EXAMPLES_PEERCONNECTION_LOCALVIDEO_CAPTURER_TRACK_SOURCE_H_
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/types/optional.h"
+#include "api/make_ref_counted.h"
+#include "api/scoped_refptr.h"
+#include "examples/peerconnection/localvideo/wrapped_desktop_capturer.h"
+#include "pc/video_track_source.h"
+
+// Video track source that streams the local video file through a
+// WrappedDesktopCapturer.
+class CapturerTrackSource : public webrtc::VideoTrackSource {
+ public:
+  // `on_end_of_input` is called once a non-looping input has been played
+  // through. Without it the process exits at that point.
+  static rtc::scoped_refptr<CapturerTrackSource> Create(
+      std::function<void()> on_end_of_input = nullptr) {
+    std::unique_ptr<webrtc::WrappedDesktopCapturer> capturer =
+        absl::WrapUnique(webrtc::WrappedDesktopCapturer::Create(
+            std::move(on_end_of_input)));
+    if (capturer) {
+      capturer->StartCapture();
+      return rtc::make_ref_counted<CapturerTrackSource>(std::move(capturer));
+    }
+
+    return nullptr;
+  }
+
+  bool is_screencast() const override { return m_screencast; }
+  absl::optional<bool> needs_denoising() const override { return m_screencast; }
+
+ protected:
+  explicit CapturerTrackSource(
+      std::unique_ptr<webrtc::WrappedDesktopCapturer> capturer)
+      : VideoTrackSource(/*remote=*/false), capturer_(std::move(capturer)) {}
+
+ private:
+  rtc::VideoSourceInterface<webrtc::VideoFrame>* source() override {
+    return capturer_.get();
+  }
+  std::unique_ptr<webrtc::WrappedDesktopCapturer> capturer_;
+  bool m_screencast = true;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_LOCALVIDEO_CAPTURER_TRACK_SOURCE_H_
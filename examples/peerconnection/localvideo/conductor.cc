@@ -41,7 +41,10 @@
 #include "api/video_codecs/video_encoder_factory_template_libvpx_vp8_adapter.h"
 #include "api/video_codecs/video_encoder_factory_template_libvpx_vp9_adapter.h"
 #include "api/video_codecs/video_encoder_factory_template_open_h264_adapter.h"
+#include "examples/peerconnection/localvideo/capturer_track_source.h"
 #include "examples/peerconnection/localvideo/defaults.h"
+#include "examples/peerconnection/localvideo/frame_tagger.h"
+#include "examples/peerconnection/localvideo/pipeline_trace_recorder.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "modules/video_capture/video_capture.h"
@@ -57,6 +60,7 @@
 #include "examples/peerconnection/localvideo/test_desktop_capturer.h"
 
 extern bool is_sender;
+extern bool frame_tagging_enabled;
 
 namespace {
 // Names used for a IceCandidate JSON object.
@@ -81,36 +85,6 @@ class DummySetSessionDescriptionObserver
   }
 };
 
-class CapturerTrackSource : public webrtc::VideoTrackSource {
- public:
-  static rtc::scoped_refptr<CapturerTrackSource> Create() {
-    std::unique_ptr<webrtc::WrappedDesktopCapturer> capturer;
-    capturer = absl::WrapUnique(
-      webrtc::WrappedDesktopCapturer::Create());
-    if (capturer) {
-		  capturer->StartCapture();
-		  return rtc::make_ref_counted<CapturerTrackSource>(std::move(capturer));
-	  }
-
-    return nullptr;
-  }
-
-  bool is_screencast() const override { return m_screencast; }
-  absl::optional<bool> needs_denoising() const override { return m_screencast; }
-
- protected:
-  explicit CapturerTrackSource(
-      std::unique_ptr<webrtc::WrappedDesktopCapturer> capturer)
-      : VideoTrackSource(/*remote=*/false), capturer_(std::move(capturer)) {}
-
- private:
-  rtc::VideoSourceInterface<webrtc::VideoFrame>* source() override {
-    return capturer_.get();
-  }
-  std::unique_ptr<webrtc::WrappedDesktopCapturer> capturer_;
-  bool m_screencast = true;
-};
-
 }  // namespace
 
 Conductor::Conductor(PeerConnectionClient* client, MainWindow* main_wnd)
@@ -211,6 +185,8 @@ bool Conductor::CreatePeerConnection() {
   webrtc::PeerConnectionInterface::IceServer server;
   server.uri = GetPeerConnectionString();
   config.servers.push_back(server);
+  config.media_config.video.timing_frame_info_observer =
+      webrtc::PipelineTraceRecorder::Get();
 
   webrtc::PeerConnectionDependencies pc_dependencies(this);
   auto error_or_peer_connection =
@@ -249,6 +225,11 @@ void Conductor::OnAddTrack(
     const std::vector<rtc::scoped_refptr<webrtc::MediaStreamInterface>>&
         streams) {
   RTC_LOG(LS_INFO) << __FUNCTION__ << " " << receiver->id();
+  if (frame_tagging_enabled &&
+      receiver->media_type() == cricket::MEDIA_TYPE_VIDEO) {
+    receiver->SetDepacketizerToDecoderFrameTransformer(
+        webrtc::FrameTagger::Get()->CreateTransformer());
+  }
   main_wnd_->QueueUIThreadCallback(NEW_TRACK_ADDED,
                                    receiver->track().release());
 }
@@ -518,6 +499,9 @@ void Conductor::AddTracks() {
       if (!result_or_error.ok()) {
         RTC_LOG(LS_ERROR) << "Failed to add video track to PeerConnection: "
                           << result_or_error.error().message();
+      } else if (frame_tagging_enabled) {
+        result_or_error.value()->SetEncoderToPacketizerFrameTransformer(
+            webrtc::FrameTagger::Get()->CreateTransformer());
       }
     }
     
@@ -18,8 +18,10 @@
 extern const uint16_t kDefaultServerPort;  // From defaults.[h|cc]
 const uint16_t kDefaultHeight = 1080;
 const uint16_t kDefaultWidth = 1920;
-const uint16_t kDefaultFps = 30;
+const double kDefaultFps = 30;
 const bool kDefaultisGUI = false;
+const int kDefaultReadAheadFrames = 16;
+const int kDefaultReconQueueFrames = 8;
 // Define flags for the peerconnect_client testing tool, in a separate
 // header file so that they can be shared across the different main.cc's
 // for each platform.
@@ -31,18 +33,140 @@ ABSL_FLAG(bool,
           "intervention.");
 ABSL_FLAG(std::string, server, "127.0.0.1", "The server to connect to.");
 
-ABSL_FLAG(std::string, file, "NONE", "The video file to stream to the peer.");
+ABSL_FLAG(std::string,
+          file,
+          "NONE",
+          "The video file to stream to the peer. A comma separated list of "
+          ".yuv/.y4m files is played back as one concatenated sequence.");
+
+ABSL_FLAG(std::string,
+          loop,
+          "single",
+          "Playback mode once the input has been played through: 'single' "
+          "exits, 'repeat' starts over and 'pingpong' plays backwards and "
+          "forwards.");
+
+ABSL_FLAG(bool,
+          preload,
+          true,
+          "Copy every frame of the input into memory before streaming "
+          "starts. All passes over the input and all streams then share "
+          "these buffers and the files are not read again. --nopreload "
+          "streams inputs too large for memory from the file, see "
+          "--read_ahead.");
 
 ABSL_FLAG(std::string, recon, "recon.yuv", "The received and decoded YUV file");
 
+ABSL_FLAG(int,
+          recon_queue,
+          kDefaultReconQueueFrames,
+          "Maximum number of decoded frames queued for the recon writer. When "
+          "the disk falls behind further frames are dropped from the recon "
+          "file and counted, instead of stalling the render path.");
+
+ABSL_FLAG(std::string,
+          recon_frame_ids,
+          "recon_frame_ids.txt",
+          "Text file the receiver writes the source frame ID of every frame in "
+          "the recon file to, one per line (-1 if the frame carried no frame "
+          "tag). Used by aligned_quality_analysis to align recon with the "
+          "input. Requires --frame_tag; empty disables it.");
+
+ABSL_FLAG(bool,
+          recon_direct_io,
+          false,
+          "Write the recon file with O_DIRECT, bypassing the page cache.");
+
 ABSL_FLAG(int,height,kDefaultHeight,"The height of the video file to stream to the peer.");
 
 ABSL_FLAG(int,width,kDefaultWidth,"The width of the video file to stream to the peer.");
 
-ABSL_FLAG(int,fps,kDefaultFps,"The fps of the video file to stream to the peer.");
+ABSL_FLAG(double,
+          fps,
+          kDefaultFps,
+          "The fps of the video file to stream to the peer. Fractional rates "
+          "such as 29.97 are supported.");
 
 ABSL_FLAG(bool,gui,kDefaultisGUI,"Graphical User Interface");
 
+ABSL_FLAG(bool,
+          frame_tag,
+          true,
+          "Attach the source frame index and capture time to every encoded "
+          "frame, and have the receiver strip them and log per-frame delay.");
+
+ABSL_FLAG(std::string,
+          delay_log,
+          "delay.csv",
+          "CSV file the receiver writes per-frame glass-to-glass delay to when "
+          "--frame_tag is enabled.");
+
+ABSL_FLAG(std::string,
+          pipeline_trace,
+          "",
+          "CSV file the receiver writes a per-frame latency breakdown to "
+          "(capture, adapter, encode, packetization, pacer, network, jitter "
+          "buffer, decode and render). Empty disables the trace. Also makes "
+          "every frame this process sends a timing frame.");
+
+ABSL_FLAG(int,
+          read_ahead,
+          kDefaultReadAheadFrames,
+          "Number of frames of the input file to keep resident ahead of the "
+          "capture thread. 0 disables the background read-ahead. Only used "
+          "with --nopreload.");
+
+ABSL_FLAG(int,
+          streams,
+          0,
+          "Run headless as a load generator: stream --file over this many "
+          "in-process sender/receiver PeerConnection pairs sharing one "
+          "PeerConnectionFactory, then print a CPU/throughput/latency report. "
+          "0 runs the normal client.");
+
+ABSL_FLAG(int,
+          duration_s,
+          60,
+          "How long the load generator runs, in seconds. With --loop=single "
+          "it stops earlier if the input has been played through.");
+
+ABSL_FLAG(int,
+          report_interval_s,
+          5,
+          "How often the load generator prints an interval report, in "
+          "seconds.");
+
+ABSL_FLAG(std::string,
+          link_trace,
+          "",
+          "mahimahi packet delivery trace the load generator replays as the "
+          "capacity of the link from senders to receivers. Setting this or "
+          "any other --link_ flag runs the load generator over an emulated "
+          "network instead of loopback.");
+
+ABSL_FLAG(int,
+          link_queue_packets,
+          0,
+          "Drop-tail queue length of the emulated link, in packets. 0 is "
+          "unbounded.");
+
+ABSL_FLAG(int,
+          link_delay_ms,
+          0,
+          "One way delay of the emulated link, in both directions.");
+
+ABSL_FLAG(int,
+          link_loss_percent,
+          0,
+          "Random packet loss on the emulated link from senders to "
+          "receivers.");
+
+ABSL_FLAG(int,
+          link_burst_loss,
+          -1,
+          "Average length of a burst of lost packets on the emulated link. "
+          "-1 makes losses independent.");
+
 ABSL_FLAG(int,
           port,
           kDefaultServerPort,
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/frame_clock.h"
+
+#if defined(WEBRTC_LINUX)
+#include <errno.h>
+#include <time.h>
+#endif
+
+#include <cmath>
+#include <thread>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+namespace {
+
+void SleepUntil(Timestamp deadline) {
+#if defined(WEBRTC_LINUX)
+  // The real-time clock reads rtc::TimeMicros(), which is based on
+  // CLOCK_MONOTONIC on Linux, so the deadline can be handed to the kernel as an
+  // absolute time and is immune to the time spent between computing it and
+  // going to sleep.
+  struct timespec ts;
+  ts.tv_sec = deadline.us() / rtc::kNumMicrosecsPerSec;
+  ts.tv_nsec = (deadline.us() % rtc::kNumMicrosecsPerSec) *
+               rtc::kNumNanosecsPerMicrosec;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+         EINTR) {
+  }
+#else
+  Clock* clock = Clock::GetRealTimeClock();
+  for (Timestamp now = clock->CurrentTime(); now < deadline;
+       now = clock->CurrentTime()) {
+    std::this_thread::sleep_for(
+        std::chrono::microseconds((deadline - now).us()));
+  }
+#endif
+}
+
+}  // namespace
+
+constexpr TimeDelta FrameClock::kLateThreshold;
+
+FrameClock::FrameClock(double fps)
+    : FrameClock(fps, Clock::GetRealTimeClock(), &SleepUntil) {}
+
+FrameClock::FrameClock(double fps,
+                       Clock* clock,
+                       absl::AnyInvocable<void(Timestamp)> sleep_until)
+    : fps_(fps),
+      frame_interval_(TimeDelta::Seconds(1) / fps),
+      clock_(clock),
+      sleep_until_(std::move(sleep_until)) {
+  RTC_CHECK_GT(fps, 0);
+  RTC_DCHECK(clock_);
+}
+
+Timestamp FrameClock::WaitForNextFrame() {
+  Timestamp now = clock_->CurrentTime();
+  if (!start_)
+    start_ = now;
+
+  Timestamp deadline = Deadline(frame_index_);
+  if (now - deadline > frame_interval_) {
+    // Fell behind by more than a frame, e.g. because the process was
+    // descheduled. Resume at the current slot rather than catching up in a
+    // burst that would distort the cadence further.
+    const int64_t current_index = static_cast<int64_t>(
+        std::floor((now - *start_).us() * fps_ / rtc::kNumMicrosecsPerSec));
+    skipped_deadlines_ += current_index - frame_index_;
+    frame_index_ = current_index;
+    deadline = Deadline(frame_index_);
+  }
+
+  sleep_until_(deadline);
+
+  last_lateness_ = clock_->CurrentTime() - deadline;
+  lateness_us_.Add(static_cast<int>(last_lateness_.us()));
+  if (last_lateness_ > kLateThreshold)
+    ++late_frames_;
+  ++frame_index_;
+  return deadline;
+}
+
+FrameClock::Stats FrameClock::GetStats() const {
+  Stats stats;
+  stats.frames = lateness_us_.NumSamples();
+  stats.late_frames = late_frames_;
+  stats.skipped_deadlines = skipped_deadlines_;
+  stats.mean_lateness = TimeDelta::Micros(lateness_us_.Avg(1).value_or(0));
+  stats.max_lateness = TimeDelta::Micros(lateness_us_.Max().value_or(0));
+  return stats;
+}
+
+Timestamp FrameClock::Deadline(int64_t frame_index) const {
+  RTC_DCHECK(start_);
+  return *start_ + TimeDelta::Micros(std::llround(
+                       frame_index * rtc::kNumMicrosecsPerSec / fps_));
+}
+
+}  // namespace webrtc
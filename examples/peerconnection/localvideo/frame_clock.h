@@ -0,0 +1,83 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_LOCALVIDEO_FRAME_CLOCK_H_
+#define EXAMPLES_PEERCONNECTION_LOCALVIDEO_FRAME_CLOCK_H_
+
+#include <stdint.h>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/numerics/sample_counter.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Paces a periodic frame source against absolute deadlines on the monotonic
+// clock. The deadline of frame n is start + n / fps, computed from the frame
+// index rather than accumulated, so neither rounding nor loop overhead makes
+// the cadence drift and fractional rates such as 29.97 are exact on average.
+//
+// If the caller falls behind by more than one frame interval the missed
+// deadlines are skipped instead of being delivered in a burst.
+//
+// This class is not thread safe.
+class FrameClock {
+ public:
+  struct Stats {
+    int64_t frames = 0;
+    // Frames woken up more than kLateThreshold after their deadline.
+    int64_t late_frames = 0;
+    // Deadlines dropped because the caller fell behind.
+    int64_t skipped_deadlines = 0;
+    TimeDelta mean_lateness = TimeDelta::Zero();
+    TimeDelta max_lateness = TimeDelta::Zero();
+  };
+
+  static constexpr TimeDelta kLateThreshold = TimeDelta::Millis(1);
+
+  explicit FrameClock(double fps);
+  // Reads the time from `clock` and waits by calling `sleep_until`, which must
+  // not return before `clock` has reached the given time. Used by tests to run
+  // the clock in simulated time.
+  FrameClock(double fps,
+             Clock* clock,
+             absl::AnyInvocable<void(Timestamp)> sleep_until);
+
+  // Blocks until the deadline of the next frame and returns that deadline,
+  // which should be used as the capture time of the frame. The first call
+  // starts the clock and returns immediately.
+  Timestamp WaitForNextFrame();
+
+  double fps() const { return fps_; }
+  // How late the most recent WaitForNextFrame() woke up.
+  TimeDelta last_lateness() const { return last_lateness_; }
+  Stats GetStats() const;
+
+ private:
+  Timestamp Deadline(int64_t frame_index) const;
+
+  const double fps_;
+  const TimeDelta frame_interval_;
+  Clock* const clock_;
+  absl::AnyInvocable<void(Timestamp)> sleep_until_;
+  absl::optional<Timestamp> start_;
+  int64_t frame_index_ = 0;
+  int64_t late_frames_ = 0;
+  int64_t skipped_deadlines_ = 0;
+  TimeDelta last_lateness_ = TimeDelta::Zero();
+  rtc::SampleCounter lateness_us_;
+};
+
+}  // namespace webrtc
+
+#endif  // EXAMPLES_PEERCONNECTION_LOCALVIDEO_FRAME_CLOCK_H_
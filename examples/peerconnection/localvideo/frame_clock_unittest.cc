@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/frame_clock.h"
+
+#include <cmath>
+#include <cstdint>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr Timestamp kStartTime = Timestamp::Seconds(1000);
+
+// Runs a FrameClock in simulated time. Every sleep wakes up `oversleep` after
+// the requested deadline, like a real scheduler would.
+class FrameClockTest : public ::testing::Test {
+ protected:
+  FrameClockTest() : clock_(kStartTime) {}
+
+  FrameClock CreateFrameClock(double fps) {
+    return FrameClock(fps, &clock_, [this](Timestamp deadline) {
+      if (deadline > clock_.CurrentTime()) {
+        clock_.AdvanceTime(deadline - clock_.CurrentTime() + oversleep_);
+      }
+    });
+  }
+
+  SimulatedClock clock_;
+  TimeDelta oversleep_ = TimeDelta::Zero();
+};
+
+TEST_F(FrameClockTest, FirstFrameIsDueImmediately) {
+  FrameClock frame_clock = CreateFrameClock(30);
+  EXPECT_EQ(frame_clock.WaitForNextFrame(), kStartTime);
+  EXPECT_EQ(clock_.CurrentTime(), kStartTime);
+}
+
+TEST_F(FrameClockTest, DeadlinesDoNotDriftWithLateWakeUps) {
+  constexpr double kFps = 29.97;
+  constexpr int kNumFrames = 3000;
+  oversleep_ = TimeDelta::Micros(700);
+  FrameClock frame_clock = CreateFrameClock(kFps);
+
+  for (int i = 0; i < kNumFrames; ++i) {
+    const Timestamp deadline = frame_clock.WaitForNextFrame();
+    ASSERT_EQ(deadline,
+              kStartTime + TimeDelta::Micros(std::llround(i * 1e6 / kFps)));
+  }
+
+  // Every wake-up was late, but the lateness never carried over to the next
+  // deadline: the last frame is only one oversleep behind the ideal cadence.
+  EXPECT_EQ(frame_clock.last_lateness(), oversleep_);
+  EXPECT_EQ(clock_.CurrentTime(),
+            kStartTime +
+                TimeDelta::Micros(std::llround((kNumFrames - 1) * 1e6 / kFps)) +
+                oversleep_);
+  FrameClock::Stats stats = frame_clock.GetStats();
+  EXPECT_EQ(stats.frames, kNumFrames);
+  EXPECT_EQ(stats.late_frames, 0);
+  EXPECT_EQ(stats.skipped_deadlines, 0);
+  EXPECT_EQ(stats.max_lateness, oversleep_);
+}
+
+TEST_F(FrameClockTest, CountsWakeUpsPastThresholdAsLate) {
+  oversleep_ = FrameClock::kLateThreshold + TimeDelta::Micros(1);
+  FrameClock frame_clock = CreateFrameClock(10);
+  frame_clock.WaitForNextFrame();
+  frame_clock.WaitForNextFrame();
+  frame_clock.WaitForNextFrame();
+  EXPECT_EQ(frame_clock.GetStats().late_frames, 2);
+}
+
+TEST_F(FrameClockTest, CatchesUpWhenLessThanAFrameBehind) {
+  FrameClock frame_clock = CreateFrameClock(10);
+  EXPECT_EQ(frame_clock.WaitForNextFrame(), kStartTime);
+  // The caller spends 150 ms on the first frame and misses the deadline of
+  // the second one by half a frame.
+  clock_.AdvanceTime(TimeDelta::Millis(150));
+  EXPECT_EQ(frame_clock.WaitForNextFrame(),
+            kStartTime + TimeDelta::Millis(100));
+  EXPECT_EQ(frame_clock.last_lateness(), TimeDelta::Millis(50));
+  // The third frame is back on schedule.
+  EXPECT_EQ(frame_clock.WaitForNextFrame(),
+            kStartTime + TimeDelta::Millis(200));
+  EXPECT_EQ(frame_clock.last_lateness(), TimeDelta::Zero());
+  EXPECT_EQ(frame_clock.GetStats().skipped_deadlines, 0);
+}
+
+TEST_F(FrameClockTest, SkipsMissedDeadlinesInsteadOfBursting) {
+  FrameClock frame_clock = CreateFrameClock(10);
+  EXPECT_EQ(frame_clock.WaitForNextFrame(), kStartTime);
+  EXPECT_EQ(frame_clock.WaitForNextFrame(),
+            kStartTime + TimeDelta::Millis(100));
+  // Stalled for 350 ms: the deadlines at 200 and 300 ms have passed and the
+  // clock resumes at the slot that is current now, 400 ms.
+  clock_.AdvanceTime(TimeDelta::Millis(350));
+  EXPECT_EQ(frame_clock.WaitForNextFrame(),
+            kStartTime + TimeDelta::Millis(400));
+  EXPECT_EQ(frame_clock.last_lateness(), TimeDelta::Millis(50));
+  // Subsequent frames stay on the original grid.
+  EXPECT_EQ(frame_clock.WaitForNextFrame(),
+            kStartTime + TimeDelta::Millis(500));
+  EXPECT_EQ(clock_.CurrentTime(), kStartTime + TimeDelta::Millis(500));
+
+  FrameClock::Stats stats = frame_clock.GetStats();
+  EXPECT_EQ(stats.frames, 4);
+  EXPECT_EQ(stats.skipped_deadlines, 2);
+  EXPECT_EQ(stats.late_frames, 1);
+  EXPECT_EQ(stats.max_lateness, TimeDelta::Millis(50));
+}
+
+}  // namespace
+}  // namespace webrtc
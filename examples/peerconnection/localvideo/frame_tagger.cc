@@ -0,0 +1,193 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/frame_tagger.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+namespace {
+
+// Upper bound on tags waiting to be matched, so that frames dropped by the
+// encoder or lost on the network do not grow the maps without bound. Sized for
+// the load generator, where all streams share one tagger.
+constexpr size_t kMaxPendingTags = 1024;
+
+template <typename Key>
+void TrimOldest(std::map<Key, FrameTag>& tags) {
+  while (tags.size() > kMaxPendingTags)
+    tags.erase(tags.begin());
+}
+
+}  // namespace
+
+// Routes frames to the callbacks registered by the one RTP sender or receiver
+// using this transformer.
+class FrameTagger::Transformer : public FrameTransformerInterface {
+ public:
+  explicit Transformer(FrameTagger* tagger) : tagger_(tagger) {}
+
+  void Transform(std::unique_ptr<TransformableFrameInterface> frame) override {
+    switch (frame->GetDirection()) {
+      case TransformableFrameInterface::Direction::kSender:
+        tagger_->AppendTag(*frame);
+        break;
+      case TransformableFrameInterface::Direction::kReceiver:
+        tagger_->StripTag(*frame);
+        break;
+      case TransformableFrameInterface::Direction::kUnknown:
+        break;
+    }
+    rtc::scoped_refptr<TransformedFrameCallback> callback =
+        GetCallback(frame->GetSsrc());
+    if (callback)
+      callback->OnTransformedFrame(std::move(frame));
+  }
+
+  void RegisterTransformedFrameCallback(
+      rtc::scoped_refptr<TransformedFrameCallback> callback) override {
+    MutexLock lock(&mutex_);
+    callback_ = std::move(callback);
+  }
+
+  void RegisterTransformedFrameSinkCallback(
+      rtc::scoped_refptr<TransformedFrameCallback> callback,
+      uint32_t ssrc) override {
+    MutexLock lock(&mutex_);
+    sink_callbacks_[ssrc] = std::move(callback);
+  }
+
+  void UnregisterTransformedFrameCallback() override {
+    MutexLock lock(&mutex_);
+    callback_ = nullptr;
+  }
+
+  void UnregisterTransformedFrameSinkCallback(uint32_t ssrc) override {
+    MutexLock lock(&mutex_);
+    sink_callbacks_.erase(ssrc);
+  }
+
+ private:
+  rtc::scoped_refptr<TransformedFrameCallback> GetCallback(uint32_t ssrc) {
+    MutexLock lock(&mutex_);
+    auto it = sink_callbacks_.find(ssrc);
+    if (it != sink_callbacks_.end())
+      return it->second;
+    return callback_;
+  }
+
+  FrameTagger* const tagger_;
+  Mutex mutex_;
+  rtc::scoped_refptr<TransformedFrameCallback> callback_
+      RTC_GUARDED_BY(mutex_);
+  std::map<uint32_t, rtc::scoped_refptr<TransformedFrameCallback>>
+      sink_callbacks_ RTC_GUARDED_BY(mutex_);
+};
+
+constexpr size_t FrameTagger::kTrailerSize;
+constexpr uint16_t FrameTagger::kMagic;
+
+FrameTagger* FrameTagger::Get() {
+  static FrameTagger* const instance = new FrameTagger();
+  return instance;
+}
+
+FrameTagger::FrameTagger() = default;
+FrameTagger::~FrameTagger() = default;
+
+rtc::scoped_refptr<FrameTransformerInterface> FrameTagger::CreateTransformer() {
+  return rtc::make_ref_counted<Transformer>(this);
+}
+
+void FrameTagger::OnFrameCaptured(Timestamp capture_time_identifier,
+                                  const FrameTag& tag) {
+  MutexLock lock(&mutex_);
+  captured_tags_[capture_time_identifier.us()] = tag;
+  TrimOldest(captured_tags_);
+}
+
+void FrameTagger::OnFrameAdapted(Timestamp capture_time_identifier,
+                                 Timestamp adapted_time) {
+  MutexLock lock(&mutex_);
+  auto it = captured_tags_.find(capture_time_identifier.us());
+  if (it == captured_tags_.end())
+    return;
+  it->second.adapter_delay_us = static_cast<uint32_t>(
+      std::max<int64_t>((adapted_time - capture_time_identifier).us(), 0));
+}
+
+absl::optional<FrameTag> FrameTagger::TakeReceivedTag(uint32_t rtp_timestamp) {
+  MutexLock lock(&mutex_);
+  auto it = received_tags_.find(rtp_timestamp);
+  if (it == received_tags_.end())
+    return absl::nullopt;
+  FrameTag tag = it->second;
+  received_tags_.erase(it);
+  return tag;
+}
+
+void FrameTagger::AppendTag(TransformableFrameInterface& frame) {
+  absl::optional<Timestamp> capture_time_identifier =
+      frame.GetCaptureTimeIdentifier();
+  if (!capture_time_identifier)
+    return;
+
+  FrameTag tag;
+  {
+    MutexLock lock(&mutex_);
+    auto it = captured_tags_.find(capture_time_identifier->us());
+    if (it == captured_tags_.end())
+      return;
+    tag = it->second;
+    // Simulcast layers share the capture time, so the tag is kept until it
+    // ages out rather than erased here.
+  }
+
+  rtc::ArrayView<const uint8_t> data = frame.GetData();
+  std::vector<uint8_t> tagged(data.size() + kTrailerSize);
+  memcpy(tagged.data(), data.data(), data.size());
+  uint8_t* trailer = tagged.data() + data.size();
+  ByteWriter<uint32_t>::WriteBigEndian(trailer, tag.frame_id);
+  ByteWriter<int64_t>::WriteBigEndian(trailer + 4, tag.capture_time_utc_us);
+  ByteWriter<uint32_t>::WriteBigEndian(trailer + 12, tag.adapter_delay_us);
+  ByteWriter<uint16_t>::WriteBigEndian(trailer + 16, kMagic);
+  frame.SetData(tagged);
+}
+
+void FrameTagger::StripTag(TransformableFrameInterface& frame) {
+  rtc::ArrayView<const uint8_t> data = frame.GetData();
+  if (data.size() < kTrailerSize)
+    return;
+  const uint8_t* trailer = data.data() + data.size() - kTrailerSize;
+  if (ByteReader<uint16_t>::ReadBigEndian(trailer + 16) != kMagic)
+    return;
+
+  FrameTag tag;
+  tag.frame_id = ByteReader<uint32_t>::ReadBigEndian(trailer);
+  tag.capture_time_utc_us = ByteReader<int64_t>::ReadBigEndian(trailer + 4);
+  tag.adapter_delay_us = ByteReader<uint32_t>::ReadBigEndian(trailer + 12);
+  {
+    MutexLock lock(&mutex_);
+    received_tags_[frame.GetTimestamp()] = tag;
+    TrimOldest(received_tags_);
+  }
+  frame.SetData(data.subview(0, data.size() - kTrailerSize));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_LOCALVIDEO_FRAME_TAGGER_H_
+#define EXAMPLES_PEERCONNECTION_LOCALVIDEO_FRAME_TAGGER_H_
+
+#include <stdint.h>
+
+#include <map>
+
+#include "absl/types/optional.h"
+#include "api/frame_transformer_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Identity of a source frame, carried in-band from sender to receiver.
+struct FrameTag {
+  // Index of the frame in the input file.
+  uint32_t frame_id = 0;
+  // Wall clock (UTC) time at which the frame was captured on the sender.
+  int64_t capture_time_utc_us = 0;
+  // Time from capture until the capturer handed the adapted (scaled) frame on
+  // to the encoder.
+  uint32_t adapter_delay_us = 0;
+};
+
+// Appends a FrameTag trailer to every encoded frame on the sender and strips
+// it again on the receiver, before the frame reaches the decoder. This lets
+// the receiver compute exact per-frame glass-to-glass delay without decoding
+// anything from the pixels.
+//
+// Wire format, appended to the encoded payload:
+//   frame_id (4 bytes) | capture_time_utc_us (8 bytes) |
+//   adapter_delay_us (4 bytes) | kMagic (2 bytes)
+// all big endian. Frames without the magic are passed through untouched, so
+// an untagged sender can talk to a tagging receiver and vice versa.
+//
+// The FrameTagger holds the tags; the frames go through the transformers it
+// creates. Every RTP sender and receiver needs a transformer of its own: they
+// register their callbacks by SSRC, and a sender and a receiver in the same
+// process, as in the load generator, use the same SSRC.
+//
+// Delay measurements are only meaningful if sender and receiver clocks are
+// synchronized, e.g. both run on the same host or are NTP disciplined.
+class FrameTagger {
+ public:
+  static constexpr size_t kTrailerSize = 18;
+  static constexpr uint16_t kMagic = 0xF7AA;
+
+  // Process wide instance shared by the capturer, the RTP senders/receivers
+  // and the renderer.
+  static FrameTagger* Get();
+
+  FrameTagger();
+  ~FrameTagger();
+
+  // Returns a new transformer that tags frames sent and strips the tags of
+  // frames received. It must not outlive this FrameTagger.
+  rtc::scoped_refptr<FrameTransformerInterface> CreateTransformer();
+
+  // Sender side. Records the tag of a captured frame, keyed by the capture
+  // time identifier that the encoder copies into the encoded image.
+  void OnFrameCaptured(Timestamp capture_time_identifier, const FrameTag& tag);
+  // Sender side. Records when the frame captured at `capture_time_identifier`
+  // left the video adapter.
+  void OnFrameAdapted(Timestamp capture_time_identifier,
+                      Timestamp adapted_time);
+
+  // Receiver side. Returns and forgets the tag received for the frame with
+  // `rtp_timestamp`, if any.
+  absl::optional<FrameTag> TakeReceivedTag(uint32_t rtp_timestamp);
+
+ private:
+  class Transformer;
+
+  void AppendTag(TransformableFrameInterface& frame);
+  void StripTag(TransformableFrameInterface& frame);
+
+  Mutex mutex_;
+  // Both maps are bounded, see kMaxPendingTags.
+  std::map<int64_t, FrameTag> captured_tags_ RTC_GUARDED_BY(mutex_);
+  std::map<uint32_t, FrameTag> received_tags_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // EXAMPLES_PEERCONNECTION_LOCALVIDEO_FRAME_TAGGER_H_
@@ -0,0 +1,136 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/frame_tagger.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/make_ref_counted.h"
+#include "api/test/mock_transformable_video_frame.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::NiceMock;
+using ::testing::Return;
+using ::testing::SizeIs;
+
+constexpr uint32_t kSsrc = 1234;
+constexpr uint32_t kRtpTimestamp = 90000;
+constexpr Timestamp kCaptureTime = Timestamp::Millis(5000);
+constexpr uint8_t kPayload[] = {1, 2, 3, 4};
+
+class FrameCollector : public TransformedFrameCallback {
+ public:
+  void OnTransformedFrame(
+      std::unique_ptr<TransformableFrameInterface> frame) override {
+    frames_.push_back(std::move(frame));
+  }
+
+  int num_frames() const { return frames_.size(); }
+
+ private:
+  std::vector<std::unique_ptr<TransformableFrameInterface>> frames_;
+};
+
+// Returns a frame that holds `data`, which is updated on SetData().
+std::unique_ptr<MockTransformableVideoFrame> CreateFrame(
+    TransformableFrameInterface::Direction direction,
+    std::vector<uint8_t>& data) {
+  auto frame = std::make_unique<NiceMock<MockTransformableVideoFrame>>();
+  ON_CALL(*frame, GetDirection).WillByDefault(Return(direction));
+  ON_CALL(*frame, GetSsrc).WillByDefault(Return(kSsrc));
+  ON_CALL(*frame, GetTimestamp).WillByDefault(Return(kRtpTimestamp));
+  ON_CALL(*frame, GetCaptureTimeIdentifier)
+      .WillByDefault(Return(kCaptureTime));
+  ON_CALL(*frame, GetData).WillByDefault([&data] {
+    return rtc::ArrayView<const uint8_t>(data);
+  });
+  ON_CALL(*frame, SetData)
+      .WillByDefault([&data](rtc::ArrayView<const uint8_t> new_data) {
+        data.assign(new_data.begin(), new_data.end());
+      });
+  return frame;
+}
+
+// A sender and a receiver in one process, as in the load generator, register
+// their callbacks for the same SSRC.
+class FrameTaggerTest : public ::testing::Test {
+ protected:
+  FrameTaggerTest()
+      : sender_transformer_(tagger_.CreateTransformer()),
+        receiver_transformer_(tagger_.CreateTransformer()),
+        sender_callback_(rtc::make_ref_counted<FrameCollector>()),
+        receiver_callback_(rtc::make_ref_counted<FrameCollector>()) {
+    sender_transformer_->RegisterTransformedFrameSinkCallback(sender_callback_,
+                                                              kSsrc);
+    receiver_transformer_->RegisterTransformedFrameSinkCallback(
+        receiver_callback_, kSsrc);
+  }
+
+  FrameTagger tagger_;
+  const rtc::scoped_refptr<FrameTransformerInterface> sender_transformer_;
+  const rtc::scoped_refptr<FrameTransformerInterface> receiver_transformer_;
+  const rtc::scoped_refptr<FrameCollector> sender_callback_;
+  const rtc::scoped_refptr<FrameCollector> receiver_callback_;
+};
+
+TEST_F(FrameTaggerTest, DeliversFramesToTheirOwnSideWithTheSameSsrc) {
+  FrameTag tag;
+  tag.frame_id = 7;
+  tag.capture_time_utc_us = 123456789;
+  tagger_.OnFrameCaptured(kCaptureTime, tag);
+  tagger_.OnFrameAdapted(kCaptureTime, kCaptureTime + TimeDelta::Micros(300));
+
+  std::vector<uint8_t> data(std::begin(kPayload), std::end(kPayload));
+  sender_transformer_->Transform(
+      CreateFrame(TransformableFrameInterface::Direction::kSender, data));
+  EXPECT_EQ(sender_callback_->num_frames(), 1);
+  EXPECT_EQ(receiver_callback_->num_frames(), 0);
+  EXPECT_THAT(data, SizeIs(sizeof(kPayload) + FrameTagger::kTrailerSize));
+
+  receiver_transformer_->Transform(
+      CreateFrame(TransformableFrameInterface::Direction::kReceiver, data));
+  EXPECT_EQ(sender_callback_->num_frames(), 1);
+  EXPECT_EQ(receiver_callback_->num_frames(), 1);
+  EXPECT_THAT(data, ElementsAreArray(kPayload));
+
+  absl::optional<FrameTag> received = tagger_.TakeReceivedTag(kRtpTimestamp);
+  ASSERT_TRUE(received);
+  EXPECT_EQ(received->frame_id, tag.frame_id);
+  EXPECT_EQ(received->capture_time_utc_us, tag.capture_time_utc_us);
+  EXPECT_EQ(received->adapter_delay_us, 300u);
+}
+
+TEST_F(FrameTaggerTest, UnregisteringReceiverKeepsSenderCallback) {
+  receiver_transformer_->UnregisterTransformedFrameSinkCallback(kSsrc);
+
+  std::vector<uint8_t> data(std::begin(kPayload), std::end(kPayload));
+  sender_transformer_->Transform(
+      CreateFrame(TransformableFrameInterface::Direction::kSender, data));
+  EXPECT_EQ(sender_callback_->num_frames(), 1);
+
+  receiver_transformer_->Transform(
+      CreateFrame(TransformableFrameInterface::Direction::kReceiver, data));
+  EXPECT_EQ(receiver_callback_->num_frames(), 0);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,245 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/linux/async_yuv_writer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace {
+
+// O_DIRECT requires file offsets, sizes and memory to be block aligned.
+constexpr size_t kDirectIoAlignment = 4096;
+constexpr size_t kDirectIoStagingSize = 4 * 1024 * 1024;
+
+struct Plane {
+  const uint8_t* data;
+  int stride;
+  int width;
+  int height;
+};
+
+std::vector<Plane> GetPlanes(const webrtc::I420BufferInterface& buffer) {
+  return {{buffer.DataY(), buffer.StrideY(), buffer.width(), buffer.height()},
+          {buffer.DataU(), buffer.StrideU(), buffer.ChromaWidth(),
+           buffer.ChromaHeight()},
+          {buffer.DataV(), buffer.StrideV(), buffer.ChromaWidth(),
+           buffer.ChromaHeight()}};
+}
+
+}  // namespace
+
+class AsyncYuvWriter::Sink {
+ public:
+  static std::unique_ptr<Sink> Open(const std::string& filename,
+                                    bool direct_io) {
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#if defined(O_DIRECT)
+    if (direct_io) {
+      const int fd = open(filename.c_str(), flags | O_DIRECT, 0644);
+      void* staging = nullptr;
+      if (fd >= 0 && posix_memalign(&staging, kDirectIoAlignment,
+                                    kDirectIoStagingSize) == 0) {
+        return std::unique_ptr<Sink>(
+            new Sink(fd, static_cast<uint8_t*>(staging)));
+      }
+      if (fd >= 0)
+        close(fd);
+      RTC_LOG(LS_WARNING) << "O_DIRECT not usable for " << filename
+                          << ", falling back to buffered writes.";
+    }
+#else
+    if (direct_io) {
+      RTC_LOG(LS_WARNING) << "O_DIRECT not supported on this platform, "
+                             "falling back to buffered writes.";
+    }
+#endif
+    const int fd = open(filename.c_str(), flags, 0644);
+    if (fd < 0) {
+      RTC_LOG(LS_ERROR) << "Failed to open " << filename << ": "
+                        << strerror(errno);
+      return nullptr;
+    }
+    return std::unique_ptr<Sink>(new Sink(fd, /*staging=*/nullptr));
+  }
+
+  ~Sink() {
+    if (staging_) {
+      FlushStaging(/*final=*/true);
+      free(staging_);
+    }
+    close(fd_);
+  }
+
+  void Write(
+      const std::vector<rtc::scoped_refptr<webrtc::I420BufferInterface>>&
+          frames) {
+    if (staging_) {
+      for (const auto& frame : frames) {
+        for (const Plane& plane : GetPlanes(*frame)) {
+          for (int row = 0; row < plane.height; ++row)
+            Stage(plane.data + row * plane.stride, plane.width);
+        }
+      }
+      return;
+    }
+
+    std::vector<iovec> iov;
+    for (const auto& frame : frames) {
+      for (const Plane& plane : GetPlanes(*frame)) {
+        if (plane.stride == plane.width) {
+          iov.push_back({const_cast<uint8_t*>(plane.data),
+                         static_cast<size_t>(plane.width) * plane.height});
+          continue;
+        }
+        for (int row = 0; row < plane.height; ++row) {
+          iov.push_back({const_cast<uint8_t*>(plane.data + row * plane.stride),
+                         static_cast<size_t>(plane.width)});
+        }
+      }
+    }
+    WriteVectors(iov.data(), iov.size());
+  }
+
+ private:
+  Sink(int fd, uint8_t* staging) : fd_(fd), staging_(staging) {}
+
+  void WriteVectors(iovec* iov, size_t count) {
+    while (count > 0) {
+      const int batch = static_cast<int>(std::min<size_t>(count, IOV_MAX));
+      ssize_t written = writev(fd_, iov, batch);
+      if (written < 0) {
+        if (errno == EINTR)
+          continue;
+        RTC_LOG(LS_ERROR) << "writev failed: " << strerror(errno);
+        return;
+      }
+      // Skip over fully written vectors and adjust a partially written one.
+      while (count > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+        written -= iov->iov_len;
+        ++iov;
+        --count;
+      }
+      if (written > 0) {
+        iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + written;
+        iov->iov_len -= written;
+      }
+    }
+  }
+
+  void Stage(const uint8_t* data, size_t size) {
+    while (size > 0) {
+      const size_t chunk = std::min(size, kDirectIoStagingSize - staged_);
+      memcpy(staging_ + staged_, data, chunk);
+      staged_ += chunk;
+      data += chunk;
+      size -= chunk;
+      if (staged_ == kDirectIoStagingSize)
+        FlushStaging(/*final=*/false);
+    }
+  }
+
+  void FlushStaging(bool final) {
+    size_t aligned = staged_ / kDirectIoAlignment * kDirectIoAlignment;
+    if (final && aligned != staged_) {
+#if defined(O_DIRECT)
+      // The unaligned tail can only be written without O_DIRECT.
+      fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) & ~O_DIRECT);
+#endif
+      aligned = staged_;
+    }
+    iovec iov = {staging_, aligned};
+    WriteVectors(&iov, 1);
+    memmove(staging_, staging_ + aligned, staged_ - aligned);
+    staged_ -= aligned;
+  }
+
+  const int fd_;
+  uint8_t* const staging_;
+  size_t staged_ = 0;
+};
+
+std::unique_ptr<AsyncYuvWriter> AsyncYuvWriter::Create(
+    const std::string& filename,
+    const Config& config) {
+  RTC_DCHECK_GT(config.max_queued_frames, 0);
+  std::unique_ptr<Sink> sink = Sink::Open(filename, config.direct_io);
+  if (!sink)
+    return nullptr;
+  return std::unique_ptr<AsyncYuvWriter>(
+      new AsyncYuvWriter(std::move(sink), config));
+}
+
+AsyncYuvWriter::AsyncYuvWriter(std::unique_ptr<Sink> sink,
+                               const Config& config)
+    : config_(config), sink_(std::move(sink)) {
+  thread_ = rtc::PlatformThread::SpawnJoinable([this] { Run(); },
+                                               "AsyncYuvWriter");
+}
+
+AsyncYuvWriter::~AsyncYuvWriter() {
+  {
+    webrtc::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  wake_.Set();
+  thread_.Finalize();
+  RTC_LOG(LS_INFO) << "AsyncYuvWriter: frames_written=" << frames_written()
+                   << " frames_dropped=" << frames_dropped();
+}
+
+bool AsyncYuvWriter::WriteFrame(
+    rtc::scoped_refptr<webrtc::I420BufferInterface> buffer) {
+  {
+    webrtc::MutexLock lock(&mutex_);
+    if (queue_.size() >= config_.max_queued_frames) {
+      ++frames_dropped_;
+      return false;
+    }
+    queue_.push_back(std::move(buffer));
+  }
+  wake_.Set();
+  return true;
+}
+
+void AsyncYuvWriter::Run() {
+  std::vector<rtc::scoped_refptr<webrtc::I420BufferInterface>> batch;
+  while (true) {
+    wake_.Wait(rtc::Event::kForever);
+    bool stopping;
+    {
+      webrtc::MutexLock lock(&mutex_);
+      batch.assign(std::make_move_iterator(queue_.begin()),
+                   std::make_move_iterator(queue_.end()));
+      queue_.clear();
+      stopping = stopping_;
+    }
+    if (!batch.empty()) {
+      sink_->Write(batch);
+      frames_written_ += batch.size();
+      // Release decoder buffers as soon as they are on disk.
+      batch.clear();
+    }
+    if (stopping)
+      return;
+  }
+}
@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_LOCALVIDEO_LINUX_ASYNC_YUV_WRITER_H_
+#define EXAMPLES_PEERCONNECTION_LOCALVIDEO_LINUX_ASYNC_YUV_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+// Writes I420 frames to a raw .yuv file on a dedicated thread, so that disk
+// I/O never blocks the render callback. WriteFrame() only takes a reference
+// to the buffer and queues it; the writer thread drains the whole queue at
+// once and hands it to the kernel in as few writev() calls as possible.
+//
+// The queue is bounded. When the disk cannot keep up, new frames are dropped
+// and counted instead of stalling the caller, so the receive pipeline being
+// measured is never throttled by the recorder.
+class AsyncYuvWriter {
+ public:
+  struct Config {
+    // Maximum number of frames waiting to be written. Queued frames hold
+    // references to decoder output buffers, so keep this small relative to
+    // the decoder's buffer pool.
+    size_t max_queued_frames = 8;
+    // Open the file with O_DIRECT where supported, bypassing the page cache.
+    // Frames are then staged in an aligned buffer and written in whole
+    // blocks.
+    bool direct_io = false;
+  };
+
+  static std::unique_ptr<AsyncYuvWriter> Create(const std::string& filename,
+                                                const Config& config);
+
+  // Writes out all queued frames before returning.
+  ~AsyncYuvWriter();
+
+  // Queues `buffer` for writing. Returns false if the frame was dropped
+  // because the queue is full.
+  bool WriteFrame(rtc::scoped_refptr<webrtc::I420BufferInterface> buffer);
+
+  int64_t frames_written() const { return frames_written_.load(); }
+  int64_t frames_dropped() const { return frames_dropped_.load(); }
+
+ private:
+  class Sink;
+
+  AsyncYuvWriter(std::unique_ptr<Sink> sink, const Config& config);
+  void Run();
+
+  const Config config_;
+  const std::unique_ptr<Sink> sink_;
+  webrtc::Mutex mutex_;
+  std::deque<rtc::scoped_refptr<webrtc::I420BufferInterface>> queue_
+      RTC_GUARDED_BY(mutex_);
+  bool stopping_ RTC_GUARDED_BY(mutex_) = false;
+  rtc::Event wake_;
+  std::atomic<int64_t> frames_written_{0};
+  std::atomic<int64_t> frames_dropped_{0};
+  rtc::PlatformThread thread_;
+};
+
+#endif  // EXAMPLES_PEERCONNECTION_LOCALVIDEO_LINUX_ASYNC_YUV_WRITER_H_
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <map>
 #include <utility>
@@ -25,8 +26,11 @@
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_source_interface.h"
+#include "examples/peerconnection/localvideo/frame_tagger.h"
+#include "examples/peerconnection/localvideo/pipeline_trace_recorder.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "third_party/libyuv/include/libyuv/convert.h"
 #include "third_party/libyuv/include/libyuv/convert_from.h"
 // sleep
@@ -34,6 +38,11 @@
 
 extern bool is_sender;
 extern std::string recon_filename;
+extern int recon_queue_frames;
+extern bool recon_direct_io;
+extern std::string recon_frame_ids_filename;
+extern bool frame_tagging_enabled;
+extern std::string delay_log_filename;
 
 FakeMainWnd::FakeMainWnd(const char* server,
                        int port,
@@ -175,14 +184,41 @@ FakeMainWnd::VideoRenderer::VideoRenderer(
   rendered_track_->AddOrUpdateSink(this, rtc::VideoSinkWants());
 // Open file to write
   if (!is_sender) {
-    file_ = fopen(recon_filename.c_str(), "wb");
+    AsyncYuvWriter::Config config;
+    config.max_queued_frames = std::max(recon_queue_frames, 1);
+    config.direct_io = recon_direct_io;
+    recon_writer_ = AsyncYuvWriter::Create(recon_filename, config);
+    if (recon_writer_ && frame_tagging_enabled &&
+        !recon_frame_ids_filename.empty()) {
+      recon_ids_file_ = fopen(recon_frame_ids_filename.c_str(), "w");
+      if (!recon_ids_file_)
+        RTC_LOG(LS_ERROR) << "Failed to open " << recon_frame_ids_filename;
+    }
+    if (frame_tagging_enabled && !delay_log_filename.empty()) {
+      delay_file_ = fopen(delay_log_filename.c_str(), "w");
+      if (delay_file_) {
+        fprintf(delay_file_,
+                "frame_id,capture_time_utc_us,render_time_utc_us,delay_ms\n");
+      } else {
+        RTC_LOG(LS_ERROR) << "Failed to open " << delay_log_filename;
+      }
+    }
   }
 }
 
 FakeMainWnd::VideoRenderer::~VideoRenderer() {
-
-  fclose(file_);
+  // Detach first so that OnFrame() can no longer run on the decoder thread
+  // while the writer and files below are torn down.
   rendered_track_->RemoveSink(this);
+  // Flushes queued frames to disk.
+  recon_writer_.reset();
+  if (recon_ids_file_)
+    fclose(recon_ids_file_);
+  if (delay_file_) {
+    RTC_LOG(LS_INFO) << "Frames rendered without frame tag: "
+                     << untagged_frames_;
+    fclose(delay_file_);
+  }
 }
 
 void FakeMainWnd::VideoRenderer::SetSize(int width, int height) {
@@ -198,6 +234,16 @@ void FakeMainWnd::VideoRenderer::SetSize(int width, int height) {
 }
 
 void FakeMainWnd::VideoRenderer::OnFrame(const webrtc::VideoFrame& video_frame) {
+  // Take the render timestamp before any conversion work.
+  absl::optional<webrtc::FrameTag> tag;
+  if (!is_sender) {
+    tag = webrtc::FrameTagger::Get()->TakeReceivedTag(video_frame.timestamp());
+    LogFrameDelay(tag);
+    if (webrtc::PipelineTraceRecorder* trace =
+            webrtc::PipelineTraceRecorder::Get()) {
+      trace->OnFrameRendered(video_frame.timestamp(), tag);
+    }
+  }
 
   rtc::scoped_refptr<webrtc::I420BufferInterface> buffer(
       video_frame.video_frame_buffer()->ToI420());
@@ -214,10 +260,15 @@ void FakeMainWnd::VideoRenderer::OnFrame(const webrtc::VideoFrame& video_frame)
   // little-endian format, with B in the first byte in memory, regardless of
   // native endianness.
 if (!is_sender){
-    RTC_LOG(LS_INFO) << __FUNCTION__ << " write to file";
-    fwrite(buffer->DataY(), 1, buffer->width() * buffer->height(), file_);
-    fwrite(buffer->DataU(), 1, buffer->width() * buffer->height() / 4, file_);
-    fwrite(buffer->DataV(), 1, buffer->width() * buffer->height() / 4, file_);
+    if (recon_writer_ && !recon_writer_->WriteFrame(buffer)) {
+      RTC_LOG(LS_WARNING) << "Recon writer behind, dropped frames: "
+                          << recon_writer_->frames_dropped();
+    } else if (recon_ids_file_) {
+      // One line per frame that made it into the recon file, so line i
+      // names the source frame of recon frame i.
+      fprintf(recon_ids_file_, "%lld\n",
+              tag ? static_cast<long long>(tag->frame_id) : -1LL);
+    }
   }
   
   libyuv::I420ToARGB(buffer->DataY(), buffer->StrideY(), buffer->DataU(),
@@ -226,3 +277,19 @@ if (!is_sender){
                      buffer->height());
 
 }
+
+void FakeMainWnd::VideoRenderer::LogFrameDelay(
+    const absl::optional<webrtc::FrameTag>& tag) {
+  if (!delay_file_)
+    return;
+  const int64_t render_time_utc_us = rtc::TimeUTCMicros();
+  if (!tag) {
+    ++untagged_frames_;
+    return;
+  }
+  fprintf(delay_file_, "%u,%lld,%lld,%.3f\n", tag->frame_id,
+          static_cast<long long>(tag->capture_time_utc_us),
+          static_cast<long long>(render_time_utc_us),
+          (render_time_utc_us - tag->capture_time_utc_us) /
+              static_cast<double>(rtc::kNumMicrosecsPerMillisec));
+}
@@ -17,10 +17,13 @@
 #include <memory>
 #include <string>
 
+#include "absl/types/optional.h"
 #include "api/media_stream_interface.h"
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
+#include "examples/peerconnection/localvideo/frame_tagger.h"
+#include "examples/peerconnection/localvideo/linux/async_yuv_writer.h"
 #include "examples/peerconnection/localvideo/main_wnd.h"
 #include "examples/peerconnection/localvideo/peer_connection_localvideo.h"
 
@@ -75,11 +78,18 @@ class FakeMainWnd : public MainWindow {
 
    protected:
     void SetSize(int width, int height);
+    // Logs the glass-to-glass delay of a rendered frame if it carried a
+    // FrameTag.
+    void LogFrameDelay(const absl::optional<webrtc::FrameTag>& tag);
     std::unique_ptr<uint8_t[]> image_;
     int width_;
     int height_;
     FakeMainWnd* main_wnd_;
-    FILE* file_;
+    std::unique_ptr<AsyncYuvWriter> recon_writer_;
+    // Source frame ID of every frame queued to `recon_writer_`.
+    FILE* recon_ids_file_ = nullptr;
+    FILE* delay_file_ = nullptr;
+    int64_t untagged_frames_ = 0;
     rtc::scoped_refptr<webrtc::VideoTrackInterface> rendered_track_;
   };
 
@@ -18,7 +18,9 @@
 #include "examples/peerconnection/localvideo/flag_defs.h"
 #include "examples/peerconnection/localvideo/linux/main_wnd.h"
 #include "examples/peerconnection/localvideo/linux/fake_wnd.h"
+#include "examples/peerconnection/localvideo/load_generator.h"
 #include "examples/peerconnection/localvideo/peer_connection_localvideo.h"
+#include "examples/peerconnection/localvideo/pipeline_trace_recorder.h"
 #include "rtc_base/physical_socket_server.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/thread.h"
@@ -27,10 +29,18 @@
 
 std::string local_video_filename;
 std::string recon_filename;
+int recon_queue_frames;
+bool recon_direct_io = false;
+std::string recon_frame_ids_filename;
 int local_video_width;
 int local_video_height;
-int local_video_fps;
+double local_video_fps;
+int local_video_read_ahead;
+std::string local_video_loop;
+bool local_video_preload = true;
 bool is_sender = false;
+bool frame_tagging_enabled = true;
+std::string delay_log_filename;
 bool is_GUI = false;
 class CustomSocketServer : public rtc::PhysicalSocketServer {
  public:
@@ -108,10 +118,21 @@ class CustomSocketServerNoGUi : public rtc::PhysicalSocketServer {
 int main(int argc, char* argv[]) {
   absl::ParseCommandLine(argc, argv);
 
+  if (!CheckLoadGeneratorFlags())
+    return -1;
+
   // InitFieldTrialsFromString stores the char*, so the char array must outlive
   // the application.
-  const std::string forced_field_trials =
-      absl::GetFlag(FLAGS_force_fieldtrials);
+  std::string forced_field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  if (!absl::GetFlag(FLAGS_pipeline_trace).empty()) {
+    if (!webrtc::PipelineTraceRecorder::Start(
+            absl::GetFlag(FLAGS_pipeline_trace))) {
+      return -1;
+    }
+    // Trials given on the command line take precedence.
+    forced_field_trials = webrtc::field_trial::MergeFieldTrialsStrings(
+        webrtc::PipelineTraceRecorder::kFieldTrials, forced_field_trials);
+  }
   webrtc::field_trial::InitFieldTrialsFromString(forced_field_trials.c_str());
 
   // Abort if the user specifies a port that is outside the allowed
@@ -125,12 +146,26 @@ int main(int argc, char* argv[]) {
 
   local_video_filename = absl::GetFlag(FLAGS_file);
   recon_filename = absl::GetFlag(FLAGS_recon);
+  recon_queue_frames = absl::GetFlag(FLAGS_recon_queue);
+  recon_direct_io = absl::GetFlag(FLAGS_recon_direct_io);
+  recon_frame_ids_filename = absl::GetFlag(FLAGS_recon_frame_ids);
   local_video_width = absl::GetFlag(FLAGS_width);
   local_video_height = absl::GetFlag(FLAGS_height);
   local_video_fps = absl::GetFlag(FLAGS_fps);
+  local_video_read_ahead = absl::GetFlag(FLAGS_read_ahead);
+  local_video_loop = absl::GetFlag(FLAGS_loop);
+  local_video_preload = absl::GetFlag(FLAGS_preload);
+  frame_tagging_enabled = absl::GetFlag(FLAGS_frame_tag);
+  delay_log_filename = absl::GetFlag(FLAGS_delay_log);
   is_GUI = absl::GetFlag(FLAGS_gui);
   
 
+  if (absl::GetFlag(FLAGS_streams) > 0) {
+    const int exit_code = RunLoadGeneratorFromFlags();
+    webrtc::PipelineTraceRecorder::Stop();
+    return exit_code;
+  }
+
   bool autocall = false;
   if (local_video_filename != "NONE") {
     is_sender = true;
@@ -209,5 +244,6 @@ int main(int argc, char* argv[]) {
     rtc::CleanupSSL();
   }
 
+  webrtc::PipelineTraceRecorder::Stop();
   return 0;
 }
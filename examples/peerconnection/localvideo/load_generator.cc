@@ -0,0 +1,711 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/load_generator.h"
+
+#include <stdio.h>
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/builtin_audio_encoder_factory.h"
+#include "api/create_peerconnection_factory.h"
+#include "api/jsep.h"
+#include "api/make_ref_counted.h"
+#include "api/set_local_description_observer_interface.h"
+#include "api/set_remote_description_observer_interface.h"
+#include "api/stats/rtc_stats_collector_callback.h"
+#include "api/stats/rtc_stats_report.h"
+#include "api/stats/rtcstats_objects.h"
+#include "api/test/create_network_emulation_manager.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
+#include "api/video_codecs/video_decoder_factory_template.h"
+#include "api/video_codecs/video_decoder_factory_template_dav1d_adapter.h"
+#include "api/video_codecs/video_decoder_factory_template_libvpx_vp8_adapter.h"
+#include "api/video_codecs/video_decoder_factory_template_libvpx_vp9_adapter.h"
+#include "api/video_codecs/video_decoder_factory_template_open_h264_adapter.h"
+#include "api/video_codecs/video_encoder_factory_template.h"
+#include "api/video_codecs/video_encoder_factory_template_libaom_av1_adapter.h"
+#include "api/video_codecs/video_encoder_factory_template_libvpx_vp8_adapter.h"
+#include "api/video_codecs/video_encoder_factory_template_libvpx_vp9_adapter.h"
+#include "api/video_codecs/video_encoder_factory_template_open_h264_adapter.h"
+#include "call/simulated_network.h"
+#include "call/trace_network_behavior.h"
+#include "examples/peerconnection/localvideo/capturer_track_source.h"
+#include "examples/peerconnection/localvideo/defaults.h"
+#include "examples/peerconnection/localvideo/frame_tagger.h"
+#include "examples/peerconnection/localvideo/pipeline_trace_recorder.h"
+#include "p2p/client/basic_port_allocator.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ssl_adapter.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/time_utils.h"
+
+extern std::string local_video_filename;
+extern bool is_sender;
+extern bool frame_tagging_enabled;
+
+ABSL_DECLARE_FLAG(int, streams);
+ABSL_DECLARE_FLAG(int, duration_s);
+ABSL_DECLARE_FLAG(int, report_interval_s);
+ABSL_DECLARE_FLAG(std::string, link_trace);
+ABSL_DECLARE_FLAG(int, link_queue_packets);
+ABSL_DECLARE_FLAG(int, link_delay_ms);
+ABSL_DECLARE_FLAG(int, link_loss_percent);
+ABSL_DECLARE_FLAG(int, link_burst_loss);
+
+namespace {
+
+// Upper bound on each signaling step of the in-process offer/answer.
+constexpr webrtc::TimeDelta kSignalingTimeout = webrtc::TimeDelta::Seconds(10);
+
+int64_t ProcessCpuTimeUs() {
+#if defined(WEBRTC_WIN)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time,
+                       &kernel_time, &user_time)) {
+    return 0;
+  }
+  // FILETIMEs count 100 ns units.
+  auto to_us = [](const FILETIME& time) {
+    return ((static_cast<int64_t>(time.dwHighDateTime) << 32) |
+            time.dwLowDateTime) /
+           10;
+  };
+  return to_us(kernel_time) + to_us(user_time);
+#else
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+             rtc::kNumMicrosecsPerSec +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#endif
+}
+
+absl::optional<std::vector<int64_t>> ReadTrace(const std::string& filename) {
+  webrtc::FileWrapper file = webrtc::FileWrapper::OpenReadOnly(filename);
+  if (!file.is_open()) {
+    RTC_LOG(LS_ERROR) << "Failed to open " << filename;
+    return absl::nullopt;
+  }
+  std::string contents;
+  char buffer[4096];
+  size_t read;
+  while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+    contents.append(buffer, read);
+  absl::optional<std::vector<int64_t>> trace =
+      webrtc::TraceNetworkBehavior::ParseTrace(contents);
+  if (!trace)
+    RTC_LOG(LS_ERROR) << filename << " is not a valid mahimahi trace.";
+  return trace;
+}
+
+// True if any --link_ flag is set, see --link_trace.
+bool LinkFlagsSet() {
+  return !absl::GetFlag(FLAGS_link_trace).empty() ||
+         absl::GetFlag(FLAGS_link_queue_packets) > 0 ||
+         absl::GetFlag(FLAGS_link_delay_ms) > 0 ||
+         absl::GetFlag(FLAGS_link_loss_percent) > 0 ||
+         absl::GetFlag(FLAGS_link_burst_loss) >= 0;
+}
+
+rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> CreateFactory(
+    rtc::Thread* network_thread,
+    rtc::Thread* worker_thread,
+    rtc::Thread* signaling_thread) {
+  return webrtc::CreatePeerConnectionFactory(
+      network_thread, worker_thread, signaling_thread,
+      nullptr /* default_adm */, webrtc::CreateBuiltinAudioEncoderFactory(),
+      webrtc::CreateBuiltinAudioDecoderFactory(),
+      std::make_unique<webrtc::VideoEncoderFactoryTemplate<
+          webrtc::LibvpxVp8EncoderTemplateAdapter,
+          webrtc::LibvpxVp9EncoderTemplateAdapter,
+          webrtc::OpenH264EncoderTemplateAdapter,
+          webrtc::LibaomAv1EncoderTemplateAdapter>>(),
+      std::make_unique<webrtc::VideoDecoderFactoryTemplate<
+          webrtc::LibvpxVp8DecoderTemplateAdapter,
+          webrtc::LibvpxVp9DecoderTemplateAdapter,
+          webrtc::OpenH264DecoderTemplateAdapter,
+          webrtc::Dav1dDecoderTemplateAdapter>>(),
+      nullptr /* audio_mixer */, nullptr /* audio_processing */);
+}
+
+class SetDescriptionObserver
+    : public webrtc::SetLocalDescriptionObserverInterface,
+      public webrtc::SetRemoteDescriptionObserverInterface {
+ public:
+  void OnSetLocalDescriptionComplete(webrtc::RTCError error) override {
+    OnComplete(std::move(error));
+  }
+  void OnSetRemoteDescriptionComplete(webrtc::RTCError error) override {
+    OnComplete(std::move(error));
+  }
+
+  bool Wait() {
+    if (!done_.Wait(kSignalingTimeout)) {
+      RTC_LOG(LS_ERROR) << "Timed out waiting for session description.";
+      return false;
+    }
+    if (!error_.ok()) {
+      RTC_LOG(LS_ERROR) << "Failed to set session description: "
+                        << error_.message();
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  void OnComplete(webrtc::RTCError error) {
+    error_ = std::move(error);
+    done_.Set();
+  }
+
+  webrtc::RTCError error_;
+  rtc::Event done_;
+};
+
+class StatsCallback : public webrtc::RTCStatsCollectorCallback {
+ public:
+  void OnStatsDelivered(
+      const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) override {
+    report_ = report;
+    done_.Set();
+  }
+
+  rtc::scoped_refptr<const webrtc::RTCStatsReport> Wait() {
+    done_.Wait(kSignalingTimeout);
+    return report_;
+  }
+
+ private:
+  rtc::scoped_refptr<const webrtc::RTCStatsReport> report_;
+  rtc::Event done_;
+};
+
+}  // namespace
+
+// One end of a stream. ICE candidates are handed straight to the other end,
+// which holds them back until it has a remote description to apply them to.
+class LoadGenerator::Peer : public webrtc::PeerConnectionObserver {
+ public:
+  Peer(std::string name,
+       std::function<void(rtc::scoped_refptr<webrtc::RtpReceiverInterface>)>
+           on_track)
+      : name_(std::move(name)), on_track_(std::move(on_track)) {}
+
+  // `network` is the emulated network to gather candidates on, or null to
+  // use the factory's default (real) network.
+  bool Initialize(webrtc::PeerConnectionFactoryInterface* factory,
+                  webrtc::EmulatedNetworkManagerInterface* network) {
+    webrtc::PeerConnectionInterface::RTCConfiguration config;
+    config.sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
+    config.media_config.video.timing_frame_info_observer =
+        webrtc::PipelineTraceRecorder::Get();
+    webrtc::PeerConnectionDependencies dependencies(this);
+    if (network) {
+      // Emulated endpoints only carry UDP.
+      auto allocator = std::make_unique<cricket::BasicPortAllocator>(
+          network->network_manager(), network->packet_socket_factory());
+      allocator->set_flags(allocator->flags() |
+                           cricket::PORTALLOCATOR_DISABLE_TCP);
+      dependencies.allocator = std::move(allocator);
+    }
+    auto result = factory->CreatePeerConnectionOrError(
+        config, std::move(dependencies));
+    if (!result.ok()) {
+      RTC_LOG(LS_ERROR) << name_ << ": CreatePeerConnection failed: "
+                        << result.error().message();
+      return false;
+    }
+    pc_ = result.MoveValue();
+    return true;
+  }
+
+  void set_remote(Peer* remote) { remote_ = remote; }
+  webrtc::PeerConnectionInterface* pc() { return pc_.get(); }
+
+  // Applies the implicit offer or answer and returns it serialized.
+  bool SetLocalDescription(std::string* sdp, webrtc::SdpType* type) {
+    auto observer = rtc::make_ref_counted<SetDescriptionObserver>();
+    pc_->SetLocalDescription(observer);
+    if (!observer->Wait())
+      return false;
+    const webrtc::SessionDescriptionInterface* desc = pc_->local_description();
+    *type = desc->GetType();
+    return desc->ToString(sdp);
+  }
+
+  bool SetRemoteDescription(webrtc::SdpType type, const std::string& sdp) {
+    webrtc::SdpParseError error;
+    std::unique_ptr<webrtc::SessionDescriptionInterface> desc =
+        webrtc::CreateSessionDescription(type, sdp, &error);
+    if (!desc) {
+      RTC_LOG(LS_ERROR) << name_ << ": Failed to parse SDP: "
+                        << error.description;
+      return false;
+    }
+    auto observer = rtc::make_ref_counted<SetDescriptionObserver>();
+    pc_->SetRemoteDescription(std::move(desc), observer);
+    if (!observer->Wait())
+      return false;
+
+    std::vector<std::unique_ptr<webrtc::IceCandidateInterface>> pending;
+    {
+      webrtc::MutexLock lock(&mutex_);
+      has_remote_description_ = true;
+      pending.swap(pending_candidates_);
+    }
+    for (auto& candidate : pending)
+      AddCandidate(std::move(candidate));
+    return true;
+  }
+
+  void AddRemoteCandidate(
+      std::unique_ptr<webrtc::IceCandidateInterface> candidate) {
+    {
+      webrtc::MutexLock lock(&mutex_);
+      if (!has_remote_description_) {
+        pending_candidates_.push_back(std::move(candidate));
+        return;
+      }
+    }
+    AddCandidate(std::move(candidate));
+  }
+
+  void Close() {
+    if (pc_)
+      pc_->Close();
+  }
+
+  // PeerConnectionObserver implementation.
+  void OnSignalingChange(
+      webrtc::PeerConnectionInterface::SignalingState new_state) override {}
+  void OnDataChannel(
+      rtc::scoped_refptr<webrtc::DataChannelInterface> channel) override {}
+  void OnIceGatheringChange(
+      webrtc::PeerConnectionInterface::IceGatheringState new_state) override {}
+  void OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver)
+      override {
+    if (on_track_)
+      on_track_(transceiver->receiver());
+  }
+  void OnIceConnectionChange(
+      webrtc::PeerConnectionInterface::IceConnectionState new_state) override {
+    RTC_LOG(LS_INFO) << name_ << ": ICE connection state "
+                     << webrtc::PeerConnectionInterface::AsString(new_state);
+  }
+  void OnIceCandidate(const webrtc::IceCandidateInterface* candidate) override {
+    std::string sdp;
+    if (!candidate->ToString(&sdp))
+      return;
+    webrtc::SdpParseError error;
+    std::unique_ptr<webrtc::IceCandidateInterface> copy(
+        webrtc::CreateIceCandidate(candidate->sdp_mid(),
+                                   candidate->sdp_mline_index(), sdp, &error));
+    if (copy && remote_)
+      remote_->AddRemoteCandidate(std::move(copy));
+  }
+
+ private:
+  void AddCandidate(std::unique_ptr<webrtc::IceCandidateInterface> candidate) {
+    pc_->AddIceCandidate(std::move(candidate), [this](webrtc::RTCError error) {
+      if (!error.ok()) {
+        RTC_LOG(LS_WARNING) << name_ << ": AddIceCandidate failed: "
+                            << error.message();
+      }
+    });
+  }
+
+  const std::string name_;
+  const std::function<void(rtc::scoped_refptr<webrtc::RtpReceiverInterface>)>
+      on_track_;
+  rtc::scoped_refptr<webrtc::PeerConnectionInterface> pc_;
+  Peer* remote_ = nullptr;
+  webrtc::Mutex mutex_;
+  bool has_remote_description_ RTC_GUARDED_BY(mutex_) = false;
+  std::vector<std::unique_ptr<webrtc::IceCandidateInterface>>
+      pending_candidates_ RTC_GUARDED_BY(mutex_);
+};
+
+// Receives the decoded frames of one stream and reports the end-to-end latency
+// of every frame that carries a tag.
+class LoadGenerator::StreamSink
+    : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+ public:
+  explicit StreamSink(LoadGenerator* generator) : generator_(generator) {}
+  ~StreamSink() override { Detach(); }
+
+  void Attach(rtc::scoped_refptr<webrtc::VideoTrackInterface> track) {
+    Detach();
+    track_ = std::move(track);
+    track_->AddOrUpdateSink(this, rtc::VideoSinkWants());
+  }
+
+  void Detach() {
+    if (track_)
+      track_->RemoveSink(this);
+    track_ = nullptr;
+  }
+
+  void OnFrame(const webrtc::VideoFrame& frame) override {
+    absl::optional<webrtc::FrameTag> tag =
+        webrtc::FrameTagger::Get()->TakeReceivedTag(frame.timestamp());
+    if (webrtc::PipelineTraceRecorder* trace =
+            webrtc::PipelineTraceRecorder::Get()) {
+      trace->OnFrameRendered(frame.timestamp(), tag);
+    }
+    if (!tag)
+      return;
+    generator_->OnFrameLatency(webrtc::TimeDelta::Micros(
+        rtc::TimeUTCMicros() - tag->capture_time_utc_us));
+  }
+
+ private:
+  LoadGenerator* const generator_;
+  rtc::scoped_refptr<webrtc::VideoTrackInterface> track_;
+};
+
+LoadGenerator::LoadGenerator(const Config& config) : config_(config) {
+  RTC_DCHECK_GT(config_.num_streams, 0);
+}
+
+LoadGenerator::~LoadGenerator() {
+  for (Stream& stream : streams_) {
+    stream.sink->Detach();
+    stream.sender->Close();
+    stream.receiver->Close();
+  }
+  streams_.clear();
+  video_track_ = nullptr;
+  receiver_factory_ = nullptr;
+  factory_ = nullptr;
+}
+
+bool LoadGenerator::CreateLink() {
+  const LinkConfig& link = *config_.link;
+  std::unique_ptr<webrtc::TraceNetworkBehavior> trace;
+  if (!link.trace_file.empty()) {
+    absl::optional<std::vector<int64_t>> opportunities_ms =
+        ReadTrace(link.trace_file);
+    if (!opportunities_ms)
+      return false;
+    trace = std::make_unique<webrtc::TraceNetworkBehavior>(
+        *std::move(opportunities_ms), link.queue_length_packets);
+  }
+
+  // The emulation follows the wall clock: the capturer, encoders and pacer
+  // all do, so there is nothing to gain from simulated time here.
+  emulation_ = webrtc::CreateNetworkEmulationManager();
+  std::vector<webrtc::EmulatedNetworkNode*> forward_nodes;
+  if (trace)
+    forward_nodes.push_back(emulation_->CreateEmulatedNode(std::move(trace)));
+  webrtc::BuiltInNetworkBehaviorConfig forward_config;
+  forward_config.queue_delay_ms = link.delay_ms;
+  forward_config.loss_percent = link.loss_percent;
+  forward_config.avg_burst_loss_length = link.avg_burst_loss_length;
+  forward_nodes.push_back(emulation_->CreateEmulatedNode(
+      std::make_unique<webrtc::SimulatedNetwork>(forward_config)));
+  webrtc::BuiltInNetworkBehaviorConfig reverse_config;
+  reverse_config.queue_delay_ms = link.delay_ms;
+  webrtc::EmulatedNetworkNode* reverse_node = emulation_->CreateEmulatedNode(
+      std::make_unique<webrtc::SimulatedNetwork>(reverse_config));
+
+  webrtc::EmulatedEndpointConfig endpoint_config;
+  endpoint_config.name = "senders";
+  webrtc::EmulatedEndpoint* sender =
+      emulation_->CreateEndpoint(endpoint_config);
+  endpoint_config.name = "receivers";
+  webrtc::EmulatedEndpoint* receiver =
+      emulation_->CreateEndpoint(endpoint_config);
+  emulation_->CreateRoute(sender, forward_nodes, receiver);
+  emulation_->CreateRoute(receiver, {reverse_node}, sender);
+  sender_network_ = emulation_->CreateEmulatedNetworkManagerInterface({sender});
+  receiver_network_ =
+      emulation_->CreateEmulatedNetworkManagerInterface({receiver});
+
+  RTC_LOG(LS_INFO) << "Emulated link: trace "
+                   << (link.trace_file.empty() ? "none" : link.trace_file)
+                   << ", delay " << link.delay_ms << " ms, loss "
+                   << link.loss_percent << "% (burst "
+                   << link.avg_burst_loss_length << ")";
+  return true;
+}
+
+bool LoadGenerator::CreateFactories() {
+  if (config_.link && !CreateLink())
+    return false;
+
+  worker_thread_ = rtc::Thread::Create();
+  worker_thread_->SetName("LoadGeneratorWorker", nullptr);
+  signaling_thread_ = rtc::Thread::Create();
+  signaling_thread_->SetName("LoadGeneratorSignaling", nullptr);
+  bool started = worker_thread_->Start() && signaling_thread_->Start();
+  if (!emulation_) {
+    network_thread_ = rtc::Thread::CreateWithSocketServer();
+    network_thread_->SetName("LoadGeneratorNetwork", nullptr);
+    started = started && network_thread_->Start();
+  }
+  if (!started) {
+    RTC_LOG(LS_ERROR) << "Failed to start PeerConnectionFactory threads.";
+    return false;
+  }
+
+  if (emulation_) {
+    // Each side needs its own factory, as the emulated networks come with
+    // their own network threads.
+    factory_ = CreateFactory(sender_network_->network_thread(),
+                             worker_thread_.get(), signaling_thread_.get());
+    receiver_factory_ =
+        CreateFactory(receiver_network_->network_thread(),
+                      worker_thread_.get(), signaling_thread_.get());
+  } else {
+    factory_ = CreateFactory(network_thread_.get(), worker_thread_.get(),
+                             signaling_thread_.get());
+    receiver_factory_ = factory_;
+  }
+  if (!factory_ || !receiver_factory_) {
+    RTC_LOG(LS_ERROR) << "Failed to create PeerConnectionFactory.";
+    return false;
+  }
+
+  // All senders share one capturer, so the file is read and converted once
+  // no matter how many streams are running.
+  rtc::scoped_refptr<CapturerTrackSource> source =
+      CapturerTrackSource::Create([this] { input_ended_.Set(); });
+  if (!source) {
+    RTC_LOG(LS_ERROR) << "Failed to open the local video source.";
+    return false;
+  }
+  video_track_ = factory_->CreateVideoTrack(source, kVideoLabel);
+  return true;
+}
+
+bool LoadGenerator::ConnectStream(Stream& stream) {
+  const std::string id = std::to_string(&stream - streams_.data());
+  StreamSink* sink = stream.sink.get();
+  stream.sender = std::make_unique<Peer>("sender" + id, nullptr);
+  stream.receiver = std::make_unique<Peer>(
+      "receiver" + id,
+      [sink](rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver) {
+        if (receiver->media_type() != cricket::MEDIA_TYPE_VIDEO)
+          return;
+        if (frame_tagging_enabled) {
+          receiver->SetDepacketizerToDecoderFrameTransformer(
+              webrtc::FrameTagger::Get()->CreateTransformer());
+        }
+        sink->Attach(rtc::scoped_refptr<webrtc::VideoTrackInterface>(
+            static_cast<webrtc::VideoTrackInterface*>(
+                receiver->track().get())));
+      });
+  if (!stream.sender->Initialize(factory_.get(), sender_network_) ||
+      !stream.receiver->Initialize(receiver_factory_.get(),
+                                   receiver_network_)) {
+    return false;
+  }
+  stream.sender->set_remote(stream.receiver.get());
+  stream.receiver->set_remote(stream.sender.get());
+
+  auto sender_or_error =
+      stream.sender->pc()->AddTrack(video_track_, {kStreamId + id});
+  if (!sender_or_error.ok()) {
+    RTC_LOG(LS_ERROR) << "Failed to add video track to stream " << id << ": "
+                      << sender_or_error.error().message();
+    return false;
+  }
+  if (frame_tagging_enabled) {
+    sender_or_error.value()->SetEncoderToPacketizerFrameTransformer(
+        webrtc::FrameTagger::Get()->CreateTransformer());
+  }
+
+  std::string sdp;
+  webrtc::SdpType type;
+  return stream.sender->SetLocalDescription(&sdp, &type) &&
+         stream.receiver->SetRemoteDescription(type, sdp) &&
+         stream.receiver->SetLocalDescription(&sdp, &type) &&
+         stream.sender->SetRemoteDescription(type, sdp);
+}
+
+void LoadGenerator::OnFrameLatency(webrtc::TimeDelta latency) {
+  webrtc::MutexLock lock(&latency_mutex_);
+  interval_latency_ms_.AddSample(latency.ms<double>());
+  total_latency_ms_.AddSample(latency.ms<double>());
+}
+
+LoadGenerator::Counters LoadGenerator::CollectCounters() {
+  Counters counters;
+  counters.time = webrtc::Timestamp::Micros(rtc::TimeMicros());
+  counters.cpu_us = ProcessCpuTimeUs();
+  for (Stream& stream : streams_) {
+    for (Peer* peer : {stream.sender.get(), stream.receiver.get()}) {
+      auto callback = rtc::make_ref_counted<StatsCallback>();
+      peer->pc()->GetStats(callback.get());
+      rtc::scoped_refptr<const webrtc::RTCStatsReport> report =
+          callback->Wait();
+      if (!report)
+        continue;
+      for (const auto* outbound :
+           report->GetStatsOfType<webrtc::RTCOutboundRtpStreamStats>()) {
+        counters.frames_encoded += outbound->frames_encoded.ValueOrDefault(0u);
+        counters.total_encode_time_s +=
+            outbound->total_encode_time.ValueOrDefault(0.0);
+      }
+      for (const auto* inbound :
+           report->GetStatsOfType<webrtc::RTCInboundRtpStreamStats>()) {
+        counters.frames_decoded += inbound->frames_decoded.ValueOrDefault(0u);
+        counters.total_decode_time_s +=
+            inbound->total_decode_time.ValueOrDefault(0.0);
+      }
+    }
+  }
+  return counters;
+}
+
+void LoadGenerator::Report(const Counters& from,
+                           const Counters& to,
+                           bool final) {
+  const double elapsed_s = (to.time - from.time).seconds<double>();
+  if (elapsed_s <= 0)
+    return;
+  const int64_t frames_encoded = to.frames_encoded - from.frames_encoded;
+  const int64_t frames_decoded = to.frames_decoded - from.frames_decoded;
+  const double cpu_percent = 100.0 * (to.cpu_us - from.cpu_us) /
+                             rtc::kNumMicrosecsPerSec / elapsed_s;
+
+  printf("%s %d streams over %.1f s: cpu %.1f%% (%.1f%%/stream)\n",
+         final ? "[total]" : "[interval]", config_.num_streams, elapsed_s,
+         cpu_percent, cpu_percent / config_.num_streams);
+  printf("  encode: %.1f fps (%.1f fps/stream), %.2f ms/frame\n",
+         frames_encoded / elapsed_s,
+         frames_encoded / elapsed_s / config_.num_streams,
+         frames_encoded > 0 ? 1000.0 *
+                                  (to.total_encode_time_s -
+                                   from.total_encode_time_s) /
+                                  frames_encoded
+                            : 0.0);
+  printf("  decode: %.1f fps (%.1f fps/stream), %.2f ms/frame\n",
+         frames_decoded / elapsed_s,
+         frames_decoded / elapsed_s / config_.num_streams,
+         frames_decoded > 0 ? 1000.0 *
+                                  (to.total_decode_time_s -
+                                   from.total_decode_time_s) /
+                                  frames_decoded
+                            : 0.0);
+
+  webrtc::MutexLock lock(&latency_mutex_);
+  webrtc::SamplesStatsCounter& latency =
+      final ? total_latency_ms_ : interval_latency_ms_;
+  if (latency.IsEmpty()) {
+    printf("  e2e latency: no tagged frames received\n");
+  } else {
+    printf(
+        "  e2e latency: %lld frames, p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, "
+        "max %.1f ms\n",
+        static_cast<long long>(latency.NumSamples()),
+        latency.GetPercentile(0.5), latency.GetPercentile(0.9),
+        latency.GetPercentile(0.99), latency.GetMax());
+  }
+  interval_latency_ms_ = webrtc::SamplesStatsCounter();
+  fflush(stdout);
+}
+
+bool LoadGenerator::Run() {
+  if (!CreateFactories())
+    return false;
+
+  streams_.resize(config_.num_streams);
+  for (Stream& stream : streams_) {
+    stream.sink = std::make_unique<StreamSink>(this);
+    if (!ConnectStream(stream)) {
+      RTC_LOG(LS_ERROR) << "Failed to connect stream "
+                        << &stream - streams_.data();
+      return false;
+    }
+  }
+  RTC_LOG(LS_INFO) << "Load generator running " << config_.num_streams
+                   << " streams for " << ToString(config_.duration);
+
+  const Counters start = CollectCounters();
+  Counters last = start;
+  bool input_ended = false;
+  while (!input_ended && last.time - start.time < config_.duration) {
+    const webrtc::TimeDelta remaining =
+        config_.duration - (last.time - start.time);
+    input_ended =
+        input_ended_.Wait(std::min(config_.report_interval, remaining));
+    Counters now = CollectCounters();
+    Report(last, now, /*final=*/false);
+    last = now;
+  }
+  if (input_ended) {
+    RTC_LOG(LS_INFO) << "Input played through after "
+                     << ToString(last.time - start.time);
+  }
+  Report(start, last, /*final=*/true);
+  return true;
+}
+
+bool CheckLoadGeneratorFlags() {
+  if (absl::GetFlag(FLAGS_streams) <= 0 && LinkFlagsSet()) {
+    fprintf(stderr,
+            "Error: the --link_ flags only apply to the load generator, "
+            "set --streams as well.\n");
+    return false;
+  }
+  return true;
+}
+
+int RunLoadGeneratorFromFlags() {
+  if (local_video_filename == "NONE") {
+    fprintf(stderr, "Error: --streams requires --file.\n");
+    return -1;
+  }
+  // Every stream of the load generator sends, the capturer only runs on
+  // senders.
+  is_sender = true;
+
+  LoadGenerator::Config config;
+  config.num_streams = absl::GetFlag(FLAGS_streams);
+  config.duration = webrtc::TimeDelta::Seconds(absl::GetFlag(FLAGS_duration_s));
+  config.report_interval =
+      webrtc::TimeDelta::Seconds(absl::GetFlag(FLAGS_report_interval_s));
+  if (LinkFlagsSet()) {
+    LoadGenerator::LinkConfig link;
+    link.trace_file = absl::GetFlag(FLAGS_link_trace);
+    link.queue_length_packets = absl::GetFlag(FLAGS_link_queue_packets);
+    link.delay_ms = absl::GetFlag(FLAGS_link_delay_ms);
+    link.loss_percent = absl::GetFlag(FLAGS_link_loss_percent);
+    link.avg_burst_loss_length = absl::GetFlag(FLAGS_link_burst_loss);
+    config.link = link;
+  }
+
+  rtc::InitializeSSL();
+  bool ok;
+  {
+    LoadGenerator load_generator(config);
+    ok = load_generator.Run();
+  }
+  rtc::CleanupSSL();
+  return ok ? 0 : 1;
+}
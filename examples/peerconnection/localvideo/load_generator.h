@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_LOCALVIDEO_LOAD_GENERATOR_H_
+#define EXAMPLES_PEERCONNECTION_LOCALVIDEO_LOAD_GENERATOR_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+
+#include "api/numerics/samples_stats_counter.h"
+#include "api/peer_connection_interface.h"
+#include "api/scoped_refptr.h"
+#include "api/test/network_emulation_manager.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/event.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
+
+// Headless, single process load generator. Streams the local video file over
+// `num_streams` sender/receiver PeerConnection pairs that all share one
+// PeerConnectionFactory and its network, worker and signaling threads.
+// Offer/answer and ICE candidates are exchanged in process, so no
+// peerconnection_server is needed.
+//
+// Every `report_interval` it prints the aggregate process CPU per stream,
+// encode and decode throughput and end-to-end latency percentiles (the latter
+// from in-band frame tags, see FrameTagger).
+//
+// If a link is configured, senders and receivers get separate factories on an
+// emulated network instead of loopback, and all streams share one bottleneck
+// that replays a mahimahi capacity trace with added delay and loss.
+class LoadGenerator {
+ public:
+  struct LinkConfig {
+    // mahimahi trace for the sender to receiver direction. Empty means
+    // unlimited capacity.
+    std::string trace_file;
+    // Drop-tail queue in front of the trace, 0 is unbounded like mm-link.
+    size_t queue_length_packets = 0;
+    // One way delay, applied in both directions.
+    int delay_ms = 0;
+    // Random loss on the sender to receiver direction, with bursts of
+    // `avg_burst_loss_length` packets on average (-1 for independent loss).
+    int loss_percent = 0;
+    int avg_burst_loss_length = -1;
+  };
+
+  struct Config {
+    int num_streams = 1;
+    webrtc::TimeDelta duration = webrtc::TimeDelta::Seconds(60);
+    webrtc::TimeDelta report_interval = webrtc::TimeDelta::Seconds(5);
+    absl::optional<LinkConfig> link;
+  };
+
+  explicit LoadGenerator(const Config& config);
+  ~LoadGenerator();
+
+  // Sets up all streams and blocks for `config.duration`, or until the input
+  // has been played through if it does not loop. Returns false if any stream
+  // failed to connect.
+  bool Run();
+
+ private:
+  class Peer;
+  class StreamSink;
+
+  struct Stream {
+    std::unique_ptr<Peer> sender;
+    std::unique_ptr<Peer> receiver;
+    std::unique_ptr<StreamSink> sink;
+  };
+
+  // Cumulative counters, summed over all streams.
+  struct Counters {
+    webrtc::Timestamp time = webrtc::Timestamp::Zero();
+    int64_t cpu_us = 0;
+    int64_t frames_encoded = 0;
+    double total_encode_time_s = 0;
+    int64_t frames_decoded = 0;
+    double total_decode_time_s = 0;
+  };
+
+  bool CreateLink();
+  bool CreateFactories();
+  bool ConnectStream(Stream& stream);
+  void OnFrameLatency(webrtc::TimeDelta latency);
+  Counters CollectCounters();
+  void Report(const Counters& from, const Counters& to, bool final);
+
+  const Config config_;
+  std::unique_ptr<webrtc::NetworkEmulationManager> emulation_;
+  webrtc::EmulatedNetworkManagerInterface* sender_network_ = nullptr;
+  webrtc::EmulatedNetworkManagerInterface* receiver_network_ = nullptr;
+  std::unique_ptr<rtc::Thread> network_thread_;
+  std::unique_ptr<rtc::Thread> worker_thread_;
+  std::unique_ptr<rtc::Thread> signaling_thread_;
+  // Senders use `factory_`, receivers `receiver_factory_`. They are the same
+  // factory unless the link is emulated.
+  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory_;
+  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> receiver_factory_;
+  rtc::scoped_refptr<webrtc::VideoTrackInterface> video_track_;
+  std::vector<Stream> streams_;
+
+  // Set by the capturer once a --loop=single input has been played through.
+  rtc::Event input_ended_;
+
+  webrtc::Mutex latency_mutex_;
+  webrtc::SamplesStatsCounter interval_latency_ms_
+      RTC_GUARDED_BY(latency_mutex_);
+  webrtc::SamplesStatsCounter total_latency_ms_ RTC_GUARDED_BY(latency_mutex_);
+};
+
+// Returns false, after printing an error, if load generator flags are set
+// without --streams.
+bool CheckLoadGeneratorFlags();
+
+// Runs a LoadGenerator configured from the --streams, --duration_s,
+// --report_interval_s and --link_* flags. Returns the process exit code.
+int RunLoadGeneratorFromFlags();
+
+#endif  // EXAMPLES_PEERCONNECTION_LOCALVIDEO_LOAD_GENERATOR_H_
@@ -20,6 +20,7 @@
 #include "absl/flags/parse.h"
 #include "examples/peerconnection/localvideo/conductor.h"
 #include "examples/peerconnection/localvideo/flag_defs.h"
+#include "examples/peerconnection/localvideo/load_generator.h"
 #include "examples/peerconnection/localvideo/main_wnd.h"
 #include "examples/peerconnection/localvideo/peer_connection_localvideo.h"
 #include "rtc_base/checks.h"
@@ -39,10 +40,18 @@
 
 std::string local_video_filename;
 std::string recon_filename;
+int recon_queue_frames;
+bool recon_direct_io = false;
+std::string recon_frame_ids_filename;
 int local_video_width;
 int local_video_height;
-int local_video_fps;
+double local_video_fps;
+int local_video_read_ahead;
+std::string local_video_loop;
+bool local_video_preload = true;
 bool is_sender = false;
+bool frame_tagging_enabled = true;
+std::string delay_log_filename;
 bool is_GUI = false;
 
 namespace {
@@ -115,9 +124,17 @@ int PASCAL wWinMain(HINSTANCE instance,
   
   local_video_filename = absl::GetFlag(FLAGS_file);
   recon_filename = absl::GetFlag(FLAGS_recon);
+  recon_queue_frames = absl::GetFlag(FLAGS_recon_queue);
+  recon_direct_io = absl::GetFlag(FLAGS_recon_direct_io);
+  recon_frame_ids_filename = absl::GetFlag(FLAGS_recon_frame_ids);
   local_video_width = absl::GetFlag(FLAGS_width);
   local_video_height = absl::GetFlag(FLAGS_height);
   local_video_fps = absl::GetFlag(FLAGS_fps);
+  local_video_read_ahead = absl::GetFlag(FLAGS_read_ahead);
+  local_video_loop = absl::GetFlag(FLAGS_loop);
+  local_video_preload = absl::GetFlag(FLAGS_preload);
+  frame_tagging_enabled = absl::GetFlag(FLAGS_frame_tag);
+  delay_log_filename = absl::GetFlag(FLAGS_delay_log);
   is_GUI = absl::GetFlag(FLAGS_gui);
 
 
@@ -147,6 +164,11 @@ int PASCAL wWinMain(HINSTANCE instance,
     return -1;
   }
 
+  if (!CheckLoadGeneratorFlags())
+    return -1;
+  if (absl::GetFlag(FLAGS_streams) > 0)
+    return RunLoadGeneratorFromFlags();
+
   if (is_GUI) {
     RTC_LOG(LS_ERROR) << "GUI is not supported on Windows.";
     return -1;
@@ -0,0 +1,158 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/pipeline_trace_recorder.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+namespace {
+
+// See FrameTagger, the same bound applies to frames waiting for render.
+constexpr size_t kMaxPendingFrames = 1024;
+
+// Column names, in Stage order.
+constexpr const char* kStageNames[] = {
+    "capture",       "adapter",        "encode_start", "encode_finish",
+    "packetized",    "pacer_exit",     "receive_start", "receive_finish",
+    "decode_start",  "decode_finish",  "render"};
+
+PipelineTraceRecorder* g_recorder = nullptr;
+
+absl::optional<int64_t> MsToUs(int64_t ms) {
+  if (ms < 0)
+    return absl::nullopt;
+  return ms * rtc::kNumMicrosecsPerMillisec;
+}
+
+}  // namespace
+
+bool PipelineTraceRecorder::Start(const std::string& filename) {
+  RTC_CHECK(!g_recorder) << "Pipeline trace already started";
+  FILE* file = fopen(filename.c_str(), "w");
+  if (!file) {
+    RTC_LOG(LS_ERROR) << "Failed to open " << filename;
+    return false;
+  }
+  fprintf(file, "frame_id,rtp_timestamp");
+  for (const char* name : kStageNames)
+    fprintf(file, ",%s_ms", name);
+  fprintf(file, "\n");
+
+  // Never deleted, decoder threads may call in until the process exits.
+  g_recorder = new PipelineTraceRecorder(file);
+  return true;
+}
+
+void PipelineTraceRecorder::Stop() {
+  if (!g_recorder)
+    return;
+  MutexLock lock(&g_recorder->mutex_);
+  if (!g_recorder->file_)
+    return;
+  g_recorder->LogSummary();
+  fclose(g_recorder->file_);
+  g_recorder->file_ = nullptr;
+}
+
+PipelineTraceRecorder* PipelineTraceRecorder::Get() {
+  return g_recorder;
+}
+
+PipelineTraceRecorder::PipelineTraceRecorder(FILE* file) : file_(file) {}
+
+void PipelineTraceRecorder::OnTimingFrameInfo(const TimingFrameInfo& info) {
+  MutexLock lock(&mutex_);
+  if (!file_)
+    return;
+  decoded_[info.rtp_timestamp] = info;
+  while (decoded_.size() > kMaxPendingFrames)
+    decoded_.erase(decoded_.begin());
+}
+
+void PipelineTraceRecorder::OnFrameRendered(
+    uint32_t rtp_timestamp,
+    const absl::optional<FrameTag>& tag) {
+  const int64_t render_time_us = rtc::TimeMicros();
+  MutexLock lock(&mutex_);
+  if (!file_)
+    return;
+  auto it = decoded_.find(rtp_timestamp);
+  if (it == decoded_.end())
+    return;
+  const TimingFrameInfo info = it->second;
+  decoded_.erase(it);
+
+  StageTimes times_us;
+  // Sender times are only valid for timing frames, and only comparable to
+  // ours once the sender clock has been estimated from RTCP.
+  if (!info.IsInvalid() && info.capture_time_ms >= 0) {
+    times_us[kCapture] = MsToUs(info.capture_time_ms);
+    if (tag)
+      times_us[kAdapter] = *times_us[kCapture] + tag->adapter_delay_us;
+    times_us[kEncodeStart] = MsToUs(info.encode_start_ms);
+    times_us[kEncodeFinish] = MsToUs(info.encode_finish_ms);
+    times_us[kPacketized] = MsToUs(info.packetization_finish_ms);
+    times_us[kPacerExit] = MsToUs(info.pacer_exit_ms);
+  } else {
+    ++frames_without_timing_;
+  }
+  times_us[kReceiveStart] = MsToUs(info.receive_start_ms);
+  times_us[kReceiveFinish] = MsToUs(info.receive_finish_ms);
+  times_us[kDecodeStart] = MsToUs(info.decode_start_ms);
+  times_us[kDecodeFinish] = MsToUs(info.decode_finish_ms);
+  times_us[kRender] = render_time_us;
+
+  for (int stage = 0; stage + 1 < kNumStages; ++stage) {
+    if (times_us[stage] && times_us[stage + 1]) {
+      stage_durations_us_[stage].Add(
+          static_cast<int>(*times_us[stage + 1] - *times_us[stage]));
+    }
+  }
+  WriteRow(tag ? absl::make_optional(tag->frame_id) : absl::nullopt,
+           rtp_timestamp, times_us);
+}
+
+void PipelineTraceRecorder::WriteRow(absl::optional<uint32_t> frame_id,
+                                     uint32_t rtp_timestamp,
+                                     const StageTimes& times_us) {
+  if (frame_id)
+    fprintf(file_, "%u", *frame_id);
+  fprintf(file_, ",%u", rtp_timestamp);
+  for (const absl::optional<int64_t>& time_us : times_us) {
+    if (time_us) {
+      fprintf(file_, ",%.3f",
+              *time_us / static_cast<double>(rtc::kNumMicrosecsPerMillisec));
+    } else {
+      fprintf(file_, ",");
+    }
+  }
+  fprintf(file_, "\n");
+}
+
+void PipelineTraceRecorder::LogSummary() {
+  RTC_LOG(LS_INFO) << "Pipeline trace: " << frames_without_timing_
+                   << " frames without sender timing.";
+  for (int stage = 0; stage + 1 < kNumStages; ++stage) {
+    const rtc::SampleCounter& durations = stage_durations_us_[stage];
+    absl::optional<int> avg = durations.Avg(/*min_required_samples=*/1);
+    if (!avg)
+      continue;
+    RTC_LOG(LS_INFO) << "  " << kStageNames[stage] << " -> "
+                     << kStageNames[stage + 1] << ": avg " << *avg
+                     << " us, max " << *durations.Max() << " us over "
+                     << durations.NumSamples() << " frames";
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_LOCALVIDEO_PIPELINE_TRACE_RECORDER_H_
+#define EXAMPLES_PEERCONNECTION_LOCALVIDEO_PIPELINE_TRACE_RECORDER_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <array>
+#include <map>
+#include <string>
+
+#include "absl/types/optional.h"
+#include "api/video/timing_frame_info_observer.h"
+#include "api/video/video_timing.h"
+#include "examples/peerconnection/localvideo/frame_tagger.h"
+#include "rtc_base/numerics/sample_counter.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Follows every received frame through the whole pipeline and writes one CSV
+// row per rendered frame with the time it reached each stage:
+//
+//   capture -> adapter -> encode start -> encode end -> packetized ->
+//   pacer exit -> first packet received -> frame complete -> decode start ->
+//   decode end -> render
+//
+// Sender side stages come from the video-timing RTP header extension, already
+// translated to the receiver clock by the decoder, so they are only present
+// for timing frames. `kFieldTrials` makes every frame a timing frame; it is
+// set along with --pipeline_trace, a sender in another process needs it in
+// --force_fieldtrials. The adapter stage comes from the in-band FrameTag.
+//
+// Receiving PeerConnections feed it by setting it as
+// RTCConfiguration::media_config.video.timing_frame_info_observer.
+//
+// All times are receiver clock milliseconds; a column is left empty if the
+// stage is unknown for that frame. A per-stage summary is logged on Stop().
+class PipelineTraceRecorder : public TimingFrameInfoObserver {
+ public:
+  static constexpr char kFieldTrials[] =
+      "WebRTC-VideoEncoderSettings/timing_frames_delay_ms:0/";
+
+  // Opens `filename` and creates the process wide recorder. Returns false if
+  // the file could not be opened.
+  static bool Start(const std::string& filename);
+  // Logs the stage summary and closes the trace. The recorder stays alive but
+  // ignores further frames, as decoders may still be running.
+  static void Stop();
+  // Returns the recorder, or null if Start() has not been called.
+  static PipelineTraceRecorder* Get();
+
+  // Called by the renderer for every frame, with the tag received for it.
+  void OnFrameRendered(uint32_t rtp_timestamp,
+                       const absl::optional<FrameTag>& tag);
+
+  // TimingFrameInfoObserver implementation.
+  void OnTimingFrameInfo(const TimingFrameInfo& info) override;
+
+ private:
+  enum Stage {
+    kCapture,
+    kAdapter,
+    kEncodeStart,
+    kEncodeFinish,
+    kPacketized,
+    kPacerExit,
+    kReceiveStart,
+    kReceiveFinish,
+    kDecodeStart,
+    kDecodeFinish,
+    kRender,
+    kNumStages
+  };
+  using StageTimes = std::array<absl::optional<int64_t>, kNumStages>;
+
+  explicit PipelineTraceRecorder(FILE* file);
+
+  void WriteRow(absl::optional<uint32_t> frame_id,
+                uint32_t rtp_timestamp,
+                const StageTimes& times_us)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void LogSummary() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  Mutex mutex_;
+  FILE* file_ RTC_GUARDED_BY(mutex_);
+  // Decoded but not yet rendered frames, by RTP timestamp. Bounded, so frames
+  // dropped between decoder and renderer do not accumulate.
+  std::map<uint32_t, TimingFrameInfo> decoded_ RTC_GUARDED_BY(mutex_);
+  // Time spent between consecutive stages, in microseconds.
+  std::array<rtc::SampleCounter, kNumStages - 1> stage_durations_us_
+      RTC_GUARDED_BY(mutex_);
+  int64_t frames_without_timing_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // EXAMPLES_PEERCONNECTION_LOCALVIDEO_PIPELINE_TRACE_RECORDER_H_
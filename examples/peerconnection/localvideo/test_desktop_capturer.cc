@@ -2,7 +2,12 @@
 
 #include "api/video/i420_buffer.h"
 #include "api/video/video_rotation.h"
+#include "common_video/include/video_frame_buffer.h"
+#include "examples/peerconnection/localvideo/frame_tagger.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+extern bool frame_tagging_enabled;
 
 namespace webrtc {
 
@@ -39,23 +44,73 @@ void TestDesktopCapturer::OnFrame(const VideoFrame& frame) {
     return;
   }
 
-  if (out_height != frame.height() || out_width != frame.width()) {
-    // Video adapter has requested a down-scale. Allocate a new buffer and
-    // return scaled version.
-    // For simplicity, only scale here without cropping.
-    rtc::scoped_refptr<I420Buffer> scaled_buffer =
-        I420Buffer::Create(out_width, out_height);
-    scaled_buffer->ScaleFrom(*frame.video_frame_buffer()->ToI420());
-    VideoFrame::Builder new_frame_builder =
-        VideoFrame::Builder()
-            .set_video_frame_buffer(scaled_buffer)
-            .set_rotation(kVideoRotation_0)
-            .set_timestamp_us(frame.timestamp_us())
-            .set_id(frame.id());
-    broadcaster_.OnFrame(new_frame_builder.build());
-  } else {
+  if (out_height == frame.height() && out_width == frame.width()) {
     // No adaptations needed, just return the frame as is.
+    RecordAdapterExit(frame);
     broadcaster_.OnFrame(frame);
+    return;
+  }
+
+  rtc::scoped_refptr<I420BufferInterface> adapted_buffer = CropAndScale(
+      frame.video_frame_buffer(), cropped_width, cropped_height, out_width,
+      out_height);
+  VideoFrame::Builder new_frame_builder =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(adapted_buffer)
+          .set_rotation(kVideoRotation_0)
+          .set_timestamp_us(frame.timestamp_us())
+          .set_timestamp_rtp(frame.timestamp())
+          .set_ntp_time_ms(frame.ntp_time_ms())
+          .set_capture_time_identifier(frame.capture_time_identifier())
+          .set_id(frame.id());
+  RecordAdapterExit(frame);
+  broadcaster_.OnFrame(new_frame_builder.build());
+}
+
+rtc::scoped_refptr<I420BufferInterface> TestDesktopCapturer::CropAndScale(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int cropped_width,
+    int cropped_height,
+    int out_width,
+    int out_height) {
+  rtc::scoped_refptr<I420BufferInterface> source = buffer->ToI420();
+  // Center crop. Offsets are kept even so the chroma planes line up.
+  const int offset_x = ((source->width() - cropped_width) / 2) & ~1;
+  const int offset_y = ((source->height() - cropped_height) / 2) & ~1;
+
+  if (out_width == cropped_width && out_height == cropped_height) {
+    // Crop only: a view into the source planes, no copy at all.
+    const int chroma_offset_x = offset_x / 2;
+    const int chroma_offset_y = offset_y / 2;
+    return WrapI420Buffer(
+        cropped_width, cropped_height,
+        source->DataY() + offset_y * source->StrideY() + offset_x,
+        source->StrideY(),
+        source->DataU() + chroma_offset_y * source->StrideU() +
+            chroma_offset_x,
+        source->StrideU(),
+        source->DataV() + chroma_offset_y * source->StrideV() +
+            chroma_offset_x,
+        source->StrideV(), [source] {});
+  }
+
+  // Scaled buffers are recycled once the encoders release them, so steady
+  // state adaptation does not allocate.
+  rtc::scoped_refptr<I420Buffer> scaled_buffer =
+      buffer_pool_.CreateI420Buffer(out_width, out_height);
+  if (!scaled_buffer) {
+    RTC_LOG(LS_WARNING) << "Adapted frame buffer pool exhausted, allocating.";
+    scaled_buffer = I420Buffer::Create(out_width, out_height);
+  }
+  scaled_buffer->CropAndScaleFrom(*source, offset_x, offset_y, cropped_width,
+                                  cropped_height);
+  return scaled_buffer;
+}
+
+void TestDesktopCapturer::RecordAdapterExit(const VideoFrame& frame) {
+  if (frame_tagging_enabled && frame.capture_time_identifier()) {
+    FrameTagger::Get()->OnFrameAdapted(*frame.capture_time_identifier(),
+                                       Timestamp::Micros(rtc::TimeMicros()));
   }
 }
 
@@ -1,8 +1,11 @@
 #ifndef EXAMPLES_LOCALVIDEO_CAPTURE_LOCALVIDEO_CAPTURER_SOURCE_TEST_H_
 #define EXAMPLES_LOCALVIDEO_CAPTURE_LOCALVIDEO_CAPTURER_SOURCE_TEST_H_
 
+#include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video/video_source_interface.h"
+#include "common_video/include/video_frame_buffer_pool.h"
 #include "media/base/video_adapter.h"
 #include "media/base/video_broadcaster.h"
 
@@ -25,9 +28,20 @@ class TestDesktopCapturer
 
  private:
   void UpdateVideoAdapter();
+  // Center crops `buffer` to `cropped_width` x `cropped_height` and scales the
+  // result to `out_width` x `out_height`, as requested by the video adapter.
+  rtc::scoped_refptr<I420BufferInterface> CropAndScale(
+      rtc::scoped_refptr<VideoFrameBuffer> buffer,
+      int cropped_width,
+      int cropped_height,
+      int out_width,
+      int out_height);
+  // Stamps the adapter stage of the frame's FrameTag, for latency tracing.
+  void RecordAdapterExit(const webrtc::VideoFrame& frame);
 
   rtc::VideoBroadcaster broadcaster_;
   cricket::VideoAdapter video_adapter_;
+  VideoFrameBufferPool buffer_pool_{/*zero_initialize=*/false};
 };
 
 }  // namespace webrtc
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "examples/peerconnection/localvideo/video_playlist.h"
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_tools/mapped_video_file_reader.h"
+
+namespace webrtc {
+
+absl::optional<VideoPlaylist::RepeatMode> VideoPlaylist::ParseRepeatMode(
+    absl::string_view mode) {
+  if (mode == "single")
+    return RepeatMode::kSingle;
+  if (mode == "repeat")
+    return RepeatMode::kRepeat;
+  if (mode == "pingpong")
+    return RepeatMode::kPingPong;
+  return absl::nullopt;
+}
+
+std::unique_ptr<VideoPlaylist> VideoPlaylist::Open(
+    const std::vector<std::string>& files,
+    int width,
+    int height,
+    RepeatMode repeat_mode,
+    size_t read_ahead_frames) {
+  std::vector<rtc::scoped_refptr<test::Video>> videos;
+  for (const std::string& file : files) {
+    rtc::scoped_refptr<test::Video> video = test::OpenMappedYuvOrY4mFile(
+        file, width, height, read_ahead_frames);
+    if (!video) {
+      RTC_LOG(LS_ERROR) << "Failed to open playlist entry " << file;
+      return nullptr;
+    }
+    RTC_LOG(LS_INFO) << "Playlist entry " << videos.size() << ": " << file
+                     << " " << video->width() << "x" << video->height() << ", "
+                     << video->number_of_frames() << " frames";
+    videos.push_back(std::move(video));
+  }
+  if (videos.empty()) {
+    RTC_LOG(LS_ERROR) << "Empty playlist";
+    return nullptr;
+  }
+  return std::unique_ptr<VideoPlaylist>(
+      new VideoPlaylist(std::move(videos), repeat_mode));
+}
+
+VideoPlaylist::VideoPlaylist(
+    std::vector<rtc::scoped_refptr<test::Video>> videos,
+    RepeatMode repeat_mode)
+    : videos_(std::move(videos)), repeat_mode_(repeat_mode) {
+  for (const auto& video : videos_)
+    number_of_frames_ += video->number_of_frames();
+  RTC_DCHECK_GT(number_of_frames_, 0);
+}
+
+void VideoPlaylist::Preload() {
+  if (!preloaded_frames_.empty())
+    return;
+  const int64_t start_ms = rtc::TimeMillis();
+  size_t bytes = 0;
+  preloaded_frames_.reserve(number_of_frames_);
+  for (const auto& video : videos_) {
+    for (size_t i = 0; i < video->number_of_frames(); ++i) {
+      rtc::scoped_refptr<I420BufferInterface> frame = video->GetFrame(i);
+      RTC_CHECK(frame) << "Failed to read frame " << i << " for preloading";
+      preloaded_frames_.push_back(I420Buffer::Copy(*frame));
+      bytes += frame->width() * frame->height() +
+               2 * frame->ChromaWidth() * frame->ChromaHeight();
+    }
+  }
+  videos_.clear();
+  RTC_LOG(LS_INFO) << "Preloaded " << preloaded_frames_.size() << " frames ("
+                   << bytes / (1024 * 1024) << " MiB) in "
+                   << rtc::TimeMillis() - start_ms << " ms";
+}
+
+rtc::scoped_refptr<I420BufferInterface> VideoPlaylist::NextFrame(
+    uint32_t* frame_id) {
+  absl::optional<size_t> index = WrapPosition(position_);
+  if (!index)
+    return nullptr;
+  ++position_;
+
+  *frame_id = static_cast<uint32_t>(*index);
+  if (!preloaded_frames_.empty())
+    return preloaded_frames_[*index];
+  size_t local_index = *index;
+  for (const auto& video : videos_) {
+    if (local_index < video->number_of_frames())
+      return video->GetFrame(local_index);
+    local_index -= video->number_of_frames();
+  }
+  RTC_DCHECK_NOTREACHED();
+  return nullptr;
+}
+
+absl::optional<size_t> VideoPlaylist::WrapPosition(int64_t position) const {
+  const int64_t num_frames = number_of_frames_;
+  switch (repeat_mode_) {
+    case RepeatMode::kSingle:
+      if (position >= num_frames)
+        return absl::nullopt;
+      return position;
+    case RepeatMode::kRepeat:
+      return position % num_frames;
+    case RepeatMode::kPingPong: {
+      if (num_frames == 1)
+        return 0;
+      const int64_t cycle_len = 2 * (num_frames - 1);
+      const int64_t wrapped = position % cycle_len;
+      return wrapped >= num_frames ? cycle_len - wrapped : wrapped;
+    }
+  }
+  RTC_DCHECK_NOTREACHED();
+  return absl::nullopt;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2024 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef EXAMPLES_PEERCONNECTION_LOCALVIDEO_VIDEO_PLAYLIST_H_
+#define EXAMPLES_PEERCONNECTION_LOCALVIDEO_VIDEO_PLAYLIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_tools/video_file_reader.h"
+#include "test/testsupport/frame_reader.h"
+
+namespace webrtc {
+
+// Plays back one or more .yuv/.y4m files as a single concatenated sequence.
+// Every file is memory mapped once and shared by all passes over it, so
+// looping a clip for hours costs no further file reads or allocations.
+class VideoPlaylist {
+ public:
+  using RepeatMode = test::YuvFrameReaderImpl::RepeatMode;
+
+  // Parses "single", "repeat" or "pingpong".
+  static absl::optional<RepeatMode> ParseRepeatMode(absl::string_view mode);
+
+  // Opens `files` in order. Raw .yuv files must all have the given
+  // `width` x `height`; .y4m files carry their own resolution. The
+  // `read_ahead_frames` window is applied to each file, see
+  // OpenMappedYuvFile().
+  static std::unique_ptr<VideoPlaylist> Open(
+      const std::vector<std::string>& files,
+      int width,
+      int height,
+      RepeatMode repeat_mode,
+      size_t read_ahead_frames);
+
+  // Copies every frame of the playlist into memory and blocks until done.
+  // Afterwards NextFrame() hands out these buffers, shared by every pass over
+  // the playlist and every sink, and the input files are no longer touched.
+  void Preload();
+
+  // Returns the next frame to deliver and its index in the concatenated
+  // sequence, or nullptr once a kSingle playlist has been played through.
+  rtc::scoped_refptr<I420BufferInterface> NextFrame(uint32_t* frame_id);
+
+  size_t number_of_frames() const { return number_of_frames_; }
+
+ private:
+  VideoPlaylist(std::vector<rtc::scoped_refptr<test::Video>> videos,
+                RepeatMode repeat_mode);
+
+  // Maps a playback position onto an index into the concatenated sequence.
+  absl::optional<size_t> WrapPosition(int64_t position) const;
+
+  // Cleared by Preload() once `preloaded_frames_` holds a copy of them.
+  std::vector<rtc::scoped_refptr<test::Video>> videos_;
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> preloaded_frames_;
+  const RepeatMode repeat_mode_;
+  size_t number_of_frames_ = 0;
+  int64_t position_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // EXAMPLES_PEERCONNECTION_LOCALVIDEO_VIDEO_PLAYLIST_H_
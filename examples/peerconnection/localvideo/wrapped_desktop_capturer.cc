@@ -1,19 +1,31 @@
 #include "examples/peerconnection/localvideo/wrapped_desktop_capturer.h"
 
 
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/str_split.h"
+#include "examples/peerconnection/localvideo/frame_tagger.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "third_party/libyuv/include/libyuv.h"
 
 extern std::string local_video_filename;
 extern int local_video_width;
 extern int local_video_height;
-extern int local_video_fps;
+extern double local_video_fps;
+extern int local_video_read_ahead;
+extern std::string local_video_loop;
+extern bool local_video_preload;
 extern bool is_sender;
+extern bool frame_tagging_enabled;
 namespace webrtc {
 
-WrappedDesktopCapturer::WrappedDesktopCapturer() : start_flag_(false) {}
+namespace {
+constexpr int kStatsLogIntervalSec = 10;
+}  // namespace
 
-rtc::scoped_refptr<webrtc::test::Video> video_d;
+WrappedDesktopCapturer::WrappedDesktopCapturer() : start_flag_(false) {}
 
 bool WrappedDesktopCapturer::Init() 
 {
@@ -22,10 +34,32 @@ bool WrappedDesktopCapturer::Init()
   {
     return true;
   }
-  // rtc::scoped_refptr<webrtc::test::Video> video;
-  video_d = webrtc::test::OpenYuvFile(local_video_filename, local_video_width, local_video_height);
-
-	
+  absl::optional<VideoPlaylist::RepeatMode> repeat_mode =
+      VideoPlaylist::ParseRepeatMode(local_video_loop);
+  if (!repeat_mode) {
+    RTC_LOG(LS_ERROR) << "Invalid loop mode: " << local_video_loop;
+    return false;
+  }
+  // A preloaded playlist is copied into memory below, read-ahead on the
+  // mapping would only compete with that.
+  const size_t read_ahead_frames =
+      local_video_preload ? 0 : std::max(local_video_read_ahead, 0);
+  playlist_ = VideoPlaylist::Open(
+      absl::StrSplit(local_video_filename, ',', absl::SkipEmpty()),
+      local_video_width, local_video_height, *repeat_mode, read_ahead_frames);
+  if (!playlist_) {
+    RTC_LOG(LS_ERROR) << "Failed to open " << local_video_filename;
+    return false;
+  }
+  // Blocks until every frame is in memory, so capture never waits on the
+  // disk once streaming has started.
+  if (local_video_preload)
+    playlist_->Preload();
+
+  if (local_video_fps <= 0) {
+    RTC_LOG(LS_ERROR) << "Invalid fps: " << local_video_fps;
+    return false;
+  }
   fps_ = local_video_fps;
 
  
@@ -33,8 +67,10 @@ bool WrappedDesktopCapturer::Init()
   return true;
 }
 
-WrappedDesktopCapturer* WrappedDesktopCapturer::Create() {
+WrappedDesktopCapturer* WrappedDesktopCapturer::Create(
+    std::function<void()> on_end_of_input) {
   std::unique_ptr<WrappedDesktopCapturer> dc(new WrappedDesktopCapturer());
+  dc->on_end_of_input_ = std::move(on_end_of_input);
   if (!dc->Init()) {
     RTC_LOG(LS_ERROR) << "Failed to create WrappedDesktopCapturer";
     return nullptr;
@@ -61,34 +97,64 @@ void WrappedDesktopCapturer::StartCapture() {
 
   // Start new thread to capture
   capture_thread_.reset(new std::thread([this]() {
-    // dc_->Start(this);
+    FrameClock frame_clock(fps_);
+    const int64_t stats_interval_frames =
+        std::max<int64_t>(static_cast<int64_t>(fps_ * kStatsLogIntervalSec), 1);
+    // Offset from the monotonic capture clock to wall clock time, used for the
+    // in-band capture timestamp the receiver compares against its own clock.
+    const int64_t utc_offset_us = rtc::TimeUTCMicros() - rtc::TimeMicros();
 
     while (start_flag_) {
-      // dc_->CaptureFrame();
-      std::this_thread::sleep_for(std::chrono::milliseconds(1000 / fps_));
-      int total_frame = video_d->number_of_frames();
-
-      if (frame_count_ >= total_frame) {
-        exit(0);
-        // frame_count_ = 0;
+      // Capture time is the scheduled deadline, not the (later) wake-up time.
+      const Timestamp capture_time = frame_clock.WaitForNextFrame();
+      uint32_t frame_id = 0;
+      rtc::scoped_refptr<webrtc::I420BufferInterface> frame_buffer =
+          playlist_->NextFrame(&frame_id);
+      if (!frame_buffer) {
+        LogFrameClockStats(frame_clock);
+        if (!on_end_of_input_)
+          exit(0);
+        on_end_of_input_();
+        return;
+      }
+      ++frame_count_;
+      if (frame_tagging_enabled) {
+        FrameTag tag;
+        tag.frame_id = frame_id;
+        tag.capture_time_utc_us = capture_time.us() + utc_offset_us;
+        FrameTagger::Get()->OnFrameCaptured(capture_time, tag);
       }
-        rtc::scoped_refptr<webrtc::I420BufferInterface> frame_buffer = video_d->GetFrame(frame_count_++);
-      
+
       webrtc::VideoFrame captureFrame =
-        webrtc::VideoFrame::Builder()
-        .set_video_frame_buffer(frame_buffer)
-        .set_timestamp_rtp(0)//set_ntp_time_ms
-              .set_ntp_time_ms(rtc::TimeMillis())
-        .set_timestamp_ms(rtc::TimeMillis())
-        .set_rotation(webrtc::kVideoRotation_0)
-        .build();
-        
-    // captureFrame.set_ntp_time_ms(0);
+          webrtc::VideoFrame::Builder()
+              .set_video_frame_buffer(frame_buffer)
+              .set_timestamp_rtp(0)
+              .set_ntp_time_ms(capture_time.ms())
+              .set_timestamp_us(capture_time.us())
+              .set_capture_time_identifier(capture_time)
+              .set_rotation(webrtc::kVideoRotation_0)
+              .build();
+
       TestDesktopCapturer::OnFrame(captureFrame);
+
+      if (frame_count_ % stats_interval_frames == 0)
+        LogFrameClockStats(frame_clock);
     }
+    LogFrameClockStats(frame_clock);
   }));
 }
 
+void WrappedDesktopCapturer::LogFrameClockStats(
+    const FrameClock& frame_clock) const {
+  const FrameClock::Stats stats = frame_clock.GetStats();
+  RTC_LOG(LS_INFO) << "Frame clock " << frame_clock.fps()
+                   << " fps: frames=" << stats.frames
+                   << " late_frames=" << stats.late_frames
+                   << " skipped_deadlines=" << stats.skipped_deadlines
+                   << " mean_lateness_us=" << stats.mean_lateness.us()
+                   << " max_lateness_us=" << stats.max_lateness.us();
+}
+
 void WrappedDesktopCapturer::StopCapture() {
   start_flag_ = false;
 
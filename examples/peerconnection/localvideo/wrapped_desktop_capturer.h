@@ -4,19 +4,25 @@
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
+#include "examples/peerconnection/localvideo/frame_clock.h"
 #include "examples/peerconnection/localvideo/test_desktop_capturer.h"
 #include "api/video/i420_buffer.h"
 
-#include <thread>
 #include <atomic>
-#include "rtc_tools/video_file_reader.h"
+#include <functional>
+#include <thread>
+#include "examples/peerconnection/localvideo/video_playlist.h"
 namespace webrtc {
 
 class WrappedDesktopCapturer : public TestDesktopCapturer,
                        public rtc::VideoSinkInterface<VideoFrame> {
  public:
 
-  static WrappedDesktopCapturer* Create();
+  // `on_end_of_input` is called on the capture thread once a non-looping
+  // input has been played through, after which no more frames are delivered.
+  // If it is null the process exits instead.
+  static WrappedDesktopCapturer* Create(
+      std::function<void()> on_end_of_input = nullptr);
 
   ~WrappedDesktopCapturer() override;
 
@@ -31,11 +37,16 @@ class WrappedDesktopCapturer : public TestDesktopCapturer,
   WrappedDesktopCapturer();
   bool Init();
   void Destory();
+  void LogFrameClockStats(const FrameClock& frame_clock) const;
 
 
 
-  size_t fps_;
+  double fps_;
   std::string window_title_;
+  std::function<void()> on_end_of_input_;
+
+  // Memory-mapped input files, frames are zero-copy views into the mappings.
+  std::unique_ptr<VideoPlaylist> playlist_;
 
   std::unique_ptr<std::thread> capture_thread_;
   std::atomic_bool start_flag_;
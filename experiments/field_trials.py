@@ -95,6 +95,9 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-PreventSsrcGroupsWithUnexpectedSize',
                'chromium:1459124',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-ReedSolomonFec',
+               'webrtc:5654',
+               date(2027, 4, 1)),
     FieldTrial('WebRTC-RtcEventLogEncodeDependencyDescriptor',
                'webrtc:14975',
                date(2024, 4, 1)),
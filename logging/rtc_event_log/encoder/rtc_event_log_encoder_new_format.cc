@@ -112,6 +112,9 @@ rtclog2::FrameDecodedEvents::Codec ConvertToProtoFormat(VideoCodecType codec) {
       return rtclog2::FrameDecodedEvents::CODEC_UNKNOWN;
     case VideoCodecType::kVideoCodecH265:
       return rtclog2::FrameDecodedEvents::CODEC_H265;
+    case VideoCodecType::kVideoCodecH266:
+      // The log format has no H266 codec value yet.
+      return rtclog2::FrameDecodedEvents::CODEC_UNKNOWN;
   }
   RTC_DCHECK_NOTREACHED();
   return rtclog2::FrameDecodedEvents::CODEC_UNKNOWN;
@@ -11,6 +11,10 @@
 #ifndef MEDIA_BASE_MEDIA_CONFIG_H_
 #define MEDIA_BASE_MEDIA_CONFIG_H_
 
+namespace webrtc {
+class TimingFrameInfoObserver;
+}  // namespace webrtc
+
 namespace cricket {
 
 // Construction-time settings, passed on when creating
@@ -65,6 +69,10 @@ struct MediaConfig {
 
     // Enables send packet batching from the egress RTP sender.
     bool enable_send_packet_batching = false;
+
+    // If set, receives the TimingFrameInfo of every frame decoded by the
+    // video receive streams. Must outlive the media channels.
+    webrtc::TimingFrameInfoObserver* timing_frame_info_observer = nullptr;
   } video;
 
   // Audio-specific config.
@@ -87,6 +95,8 @@ struct MediaConfig {
            video.rtcp_report_interval_ms == o.video.rtcp_report_interval_ms &&
            video.enable_send_packet_batching ==
                o.video.enable_send_packet_batching &&
+           video.timing_frame_info_observer ==
+               o.video.timing_frame_info_observer &&
            audio.rtcp_report_interval_ms == o.audio.rtcp_report_interval_ms;
   }
 
@@ -104,6 +104,7 @@ const char kVp9CodecName[] = "VP9";
 const char kAv1CodecName[] = "AV1";
 const char kH264CodecName[] = "H264";
 const char kH265CodecName[] = "H265";
+const char kH266CodecName[] = "H266";
 
 // RFC 6184 RTP Payload Format for H.264 video
 const char kH264FmtpProfileLevelId[] = "profile-level-id";
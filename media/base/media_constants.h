@@ -124,6 +124,7 @@ RTC_EXPORT extern const char kVp9CodecName[];
 RTC_EXPORT extern const char kAv1CodecName[];
 RTC_EXPORT extern const char kH264CodecName[];
 RTC_EXPORT extern const char kH265CodecName[];
+RTC_EXPORT extern const char kH266CodecName[];
 
 // RFC 6184 RTP Payload Format for H.264 video
 RTC_EXPORT extern const char kH264FmtpProfileLevelId[];
@@ -15,11 +15,13 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <numeric>
 #include <string>
 #include <utility>
 
 #include "absl/algorithm/container.h"
 #include "api/scoped_refptr.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_frame_buffer.h"
@@ -31,6 +33,7 @@
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/field_trial.h"
@@ -180,7 +183,8 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(
       width_(width),
       height_(height),
       is_keyframe_needed_(false),
-      is_paused_(is_paused) {
+      is_paused_(is_paused),
+      is_buffering_(false) {
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -194,7 +198,9 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(StreamContext&& rhs)
       width_(rhs.width_),
       height_(rhs.height_),
       is_keyframe_needed_(rhs.is_keyframe_needed_),
-      is_paused_(rhs.is_paused_) {
+      is_paused_(rhs.is_paused_),
+      is_buffering_(rhs.is_buffering_),
+      buffered_images_(std::move(rhs.buffered_images_)) {
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -227,11 +233,31 @@ bool SimulcastEncoderAdapter::StreamContext::ShouldDropFrame(
   return framerate_controller_->ShouldDropFrame(timestamp.us() * 1000);
 }
 
+void SimulcastEncoderAdapter::StreamContext::StartBufferingEncodedImages() {
+  RTC_DCHECK(buffered_images_.empty());
+  is_buffering_ = true;
+}
+
+void SimulcastEncoderAdapter::StreamContext::DeliverBufferedEncodedImages() {
+  RTC_CHECK(parent_);
+  is_buffering_ = false;
+  for (const auto& [encoded_image, codec_specific_info] : buffered_images_) {
+    parent_->OnEncodedImage(stream_idx_, encoded_image, &codec_specific_info);
+  }
+  buffered_images_.clear();
+}
+
 EncodedImageCallback::Result
 SimulcastEncoderAdapter::StreamContext::OnEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
+  if (is_buffering_) {
+    // Called on a worker queue, the image is passed on once the encoders of
+    // all streams are done with the frame.
+    buffered_images_.emplace_back(encoded_image, *codec_specific_info);
+    return Result(Result::OK, encoded_image.RtpTimestamp());
+  }
   return parent_->OnEncodedImage(stream_idx_, encoded_image,
                                  codec_specific_info);
 }
@@ -256,6 +282,7 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
       video_format_(format),
       total_streams_count_(0),
       bypass_mode_(false),
+      parallel_encoding_(false),
       encoded_complete_callback_(nullptr),
       experimental_boosted_screenshare_qp_(GetScreenshareBoostedQpValue()),
       boost_base_layer_quality_(RateControlSettings::ParseFromFieldTrials()
@@ -291,6 +318,7 @@ int SimulcastEncoderAdapter::Release() {
   }
 
   bypass_mode_ = false;
+  parallel_encoding_ = false;
 
   // It's legal to move the encoder to another queue now.
   encoder_queue_.Detach();
@@ -384,6 +412,10 @@ int SimulcastEncoderAdapter::InitEncode(
   std::vector<uint32_t> stream_start_bitrate_kbps =
       GetStreamStartBitratesKbps(codec_);
 
+  parallel_encoding_ = settings.parallel_simulcast_encoding &&
+                       settings.number_of_cores > 1 &&
+                       active_streams_count > 1;
+
   for (int stream_idx = 0; stream_idx < total_streams_count_; ++stream_idx) {
     if (!is_legacy_singlecast && !codec_.simulcastStream[stream_idx].active) {
       continue;
@@ -412,8 +444,10 @@ int SimulcastEncoderAdapter::InitEncode(
 
     // Intercept frame encode complete callback only for upper streams, where
     // we need to set a correct stream index. Set `parent` to nullptr for the
-    // lowest stream to bypass the callback.
-    SimulcastEncoderAdapter* parent = stream_idx > 0 ? this : nullptr;
+    // lowest stream to bypass the callback, unless the images of all streams
+    // need to be buffered for parallel encoding.
+    SimulcastEncoderAdapter* parent =
+        stream_idx > 0 || parallel_encoding_ ? this : nullptr;
 
     bool is_paused = stream_start_bitrate_kbps[stream_idx] == 0;
     stream_contexts_.emplace_back(
@@ -425,6 +459,20 @@ int SimulcastEncoderAdapter::InitEncode(
   // To save memory, don't store encoders that we don't use.
   DestroyStoredEncoders();
 
+  if (parallel_encoding_) {
+    // The encoder queue encodes one of the streams itself.
+    const size_t num_workers = std::min<size_t>(
+        stream_contexts_.size() - 1, settings.number_of_cores - 1);
+    if (!task_queue_factory_) {
+      task_queue_factory_ = CreateDefaultTaskQueueFactory();
+    }
+    while (encode_workers_.size() < num_workers) {
+      encode_workers_.push_back(task_queue_factory_->CreateTaskQueue(
+          "SimulcastEncodeWorker", TaskQueueFactory::Priority::HIGH));
+    }
+    encode_workers_.resize(num_workers);
+  }
+
   inited_.store(1);
   return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -478,6 +526,7 @@ int SimulcastEncoderAdapter::Encode(
   rtc::scoped_refptr<VideoFrameBuffer> src_buffer;
   int src_width = input_image.width();
   int src_height = input_image.height();
+  std::vector<PendingEncode> pending_encodes;
 
   for (auto& layer : stream_contexts_) {
     // Don't encode frames in resolutions that we don't intend to send.
@@ -537,10 +586,15 @@ int SimulcastEncoderAdapter::Encode(
     // correctly sample/scale the source texture.
     // TODO(perkj): ensure that works going forward, and figure out how this
     // affects webrtc:5683.
-    if ((layer.width() == src_width && layer.height() == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         layer.encoder().GetEncoderInfo().supports_native_handle)) {
+    const bool needs_scaling =
+        !((layer.width() == src_width && layer.height() == src_height) ||
+          (input_image.video_frame_buffer()->type() ==
+               VideoFrameBuffer::Type::kNative &&
+           layer.encoder().GetEncoderInfo().supports_native_handle));
+    if (parallel_encoding_) {
+      pending_encodes.push_back(
+          {&layer, std::move(stream_frame_types), needs_scaling});
+    } else if (!needs_scaling) {
       int ret = layer.encoder().Encode(input_image, &stream_frame_types);
       if (ret != WEBRTC_VIDEO_CODEC_OK) {
         return ret;
@@ -570,6 +624,99 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
+  if (parallel_encoding_) {
+    return EncodeInParallel(input_image, std::move(pending_encodes));
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int SimulcastEncoderAdapter::EncodeInParallel(
+    const VideoFrame& input_image,
+    std::vector<PendingEncode> pending_encodes) {
+  if (pending_encodes.empty()) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  // Handle the streams from the highest resolution to the lowest. The
+  // encoder queue encodes the highest resolution itself, as that is likely
+  // the slowest.
+  std::vector<size_t> order(pending_encodes.size());
+  std::iota(order.begin(), order.end(), 0);
+  absl::c_stable_sort(order, [&](size_t a, size_t b) {
+    const StreamContext& stream_a = *pending_encodes[a].stream;
+    const StreamContext& stream_b = *pending_encodes[b].stream;
+    return stream_a.width() * stream_a.height() >
+           stream_b.width() * stream_b.height();
+  });
+
+  // Scale the input once into a pyramid shared by all streams. Each stream is
+  // scaled from the smallest frame already scaled that is at least as large,
+  // rather than from the full resolution input.
+  std::vector<VideoFrame> frames(pending_encodes.size(), input_image);
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> pyramid;
+  for (size_t i : order) {
+    if (!pending_encodes[i].needs_scaling) {
+      continue;
+    }
+    const int width = pending_encodes[i].stream->width();
+    const int height = pending_encodes[i].stream->height();
+    rtc::scoped_refptr<VideoFrameBuffer> src_buffer =
+        input_image.video_frame_buffer();
+    for (const auto& buffer : pyramid) {
+      if (buffer->width() >= width && buffer->height() >= height) {
+        src_buffer = buffer;
+      }
+    }
+    rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
+        src_buffer->width() == width && src_buffer->height() == height
+            ? src_buffer
+            : src_buffer->Scale(width, height);
+    if (!dst_buffer) {
+      RTC_LOG(LS_ERROR) << "Failed to scale video frame";
+      return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+    }
+    pyramid.push_back(dst_buffer);
+
+    // UpdateRect is not propagated to lower simulcast layers currently.
+    frames[i].set_video_frame_buffer(dst_buffer);
+    frames[i].set_rotation(webrtc::kVideoRotation_0);
+    frames[i].set_update_rect(
+        VideoFrame::UpdateRect{0, 0, frames[i].width(), frames[i].height()});
+  }
+
+  std::vector<int> results(pending_encodes.size(), WEBRTC_VIDEO_CODEC_OK);
+  auto encode = [&](size_t i) {
+    PendingEncode& pending = pending_encodes[i];
+    results[i] = pending.stream->encoder().Encode(frames[i],
+                                                  &pending.frame_types);
+  };
+
+  for (PendingEncode& pending : pending_encodes) {
+    pending.stream->StartBufferingEncodedImages();
+  }
+  std::vector<rtc::Event> done(order.size() - 1);
+  for (size_t j = 1; j < order.size(); ++j) {
+    encode_workers_[(j - 1) % encode_workers_.size()]->PostTask(
+        [&encode, &done, i = order[j], j] {
+          encode(i);
+          done[j - 1].Set();
+        });
+  }
+  encode(order[0]);
+  for (rtc::Event& event : done) {
+    event.Wait(rtc::Event::kForever);
+  }
+
+  // Deliver the encoded images in stream order.
+  for (PendingEncode& pending : pending_encodes) {
+    pending.stream->DeliverBufferedEncodedImages();
+  }
+
+  for (int ret : results) {
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -577,7 +724,8 @@ int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   encoded_complete_callback_ = callback;
-  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0) {
+  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0 &&
+      !parallel_encoding_) {
     // Bypass frame encode complete callback for the lowest layer since there is
     // no need to override frame's spatial index.
     stream_contexts_.front().encoder().RegisterEncodeCompleteCallback(callback);
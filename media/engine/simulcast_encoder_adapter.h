@@ -23,6 +23,8 @@
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
@@ -38,6 +40,11 @@ namespace webrtc {
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // The object is created and destroyed on the worker thread, but all public
 // interfaces should be called from the encoder task queue.
+// If VideoEncoder::Settings::parallel_simulcast_encoding is set, the encoders
+// of the different streams encode each frame in parallel on a pool of worker
+// task queues, and the encoded images are delivered in stream order once all
+// streams are done. This requires the underlying encoders to deliver their
+// images from within Encode().
 class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
  public:
   // TODO(bugs.webrtc.org/11000): Remove when downstream usage is gone.
@@ -131,6 +138,11 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     void OnKeyframe(Timestamp timestamp);
     bool ShouldDropFrame(Timestamp timestamp);
 
+    // While buffering, encoded images are queued instead of being passed on
+    // to the parent, until DeliverBufferedEncodedImages() is called.
+    void StartBufferingEncodedImages();
+    void DeliverBufferedEncodedImages();
+
    private:
     SimulcastEncoderAdapter* const parent_;
     std::unique_ptr<EncoderContext> encoder_context_;
@@ -140,6 +152,15 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     const uint16_t height_;
     bool is_keyframe_needed_;
     bool is_paused_;
+    bool is_buffering_;
+    std::vector<std::pair<EncodedImage, CodecSpecificInfo>> buffered_images_;
+  };
+
+  // A frame to be encoded by the encoder of `stream`.
+  struct PendingEncode {
+    StreamContext* stream;
+    std::vector<VideoFrameType> frame_types;
+    bool needs_scaling;
   };
 
   bool Initialized() const;
@@ -165,6 +186,9 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   void OnDroppedFrame(size_t stream_idx);
 
+  int EncodeInParallel(const VideoFrame& input_image,
+                       std::vector<PendingEncode> pending_encodes);
+
   void OverrideFromFieldTrial(VideoEncoder::EncoderInfo* info) const;
 
   std::atomic<int> inited_;
@@ -174,6 +198,7 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   VideoCodec codec_;
   int total_streams_count_;
   bool bypass_mode_;
+  bool parallel_encoding_;
   std::vector<StreamContext> stream_contexts_;
   EncodedImageCallback* encoded_complete_callback_;
 
@@ -186,6 +211,12 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   // GetEncoderInfo(), which is const.
   mutable std::list<std::unique_ptr<EncoderContext>> cached_encoder_contexts_;
 
+  // Worker queues used in parallel encoding mode. Created on first use and
+  // kept across reinitializations.
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>>
+      encode_workers_;
+
   const absl::optional<unsigned int> experimental_boosted_screenshare_qp_;
   const bool boost_base_layer_quality_;
   const bool prefer_temporal_support_on_base_layer_;
@@ -29,6 +29,7 @@
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -463,6 +464,8 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
     last_encoded_image_width_ = encoded_image._encodedWidth;
     last_encoded_image_height_ = encoded_image._encodedHeight;
     last_encoded_image_simulcast_index_ = encoded_image.SimulcastIndex();
+    encoded_image_simulcast_indices_.push_back(
+        encoded_image.SimulcastIndex().value_or(-1));
 
     return Result(Result::OK, encoded_image.RtpTimestamp());
   }
@@ -578,6 +581,7 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
   absl::optional<int> last_encoded_image_width_;
   absl::optional<int> last_encoded_image_height_;
   absl::optional<int> last_encoded_image_simulcast_index_;
+  std::vector<int> encoded_image_simulcast_indices_;
   std::unique_ptr<SimulcastRateAllocator> rate_allocator_;
   bool use_fallback_factory_;
   SdpVideoFormat::Parameters sdp_video_parameters_;
@@ -1207,6 +1211,62 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       EncodesStreamsInParallelAndDeliversImagesInStreamOrder) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.startBitrate = 3000;
+  VideoEncoder::Settings settings(kCapabilities, /*number_of_cores=*/4,
+                                  /*max_payload_size=*/1200);
+  settings.parallel_simulcast_encoding = true;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, settings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  // The lowest stream can only finish once the highest stream has been
+  // encoded, which requires the streams to be encoded in parallel.
+  rtc::Event highest_stream_encoded;
+  EXPECT_CALL(*encoders[0], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_EQ(codec_.simulcastStream[0].width, frame.width());
+        EXPECT_TRUE(highest_stream_encoded.Wait(TimeDelta::Seconds(5)));
+        encoders[0]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[1], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_EQ(codec_.simulcastStream[1].width, frame.width());
+        encoders[1]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[2], Encode)
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_EQ(codec_.simulcastStream[2].width, frame.width());
+        encoders[2]->SendEncodedImage(frame.width(), frame.height());
+        highest_stream_encoded.Set();
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_timestamp_rtp(0)
+                               .set_timestamp_us(0)
+                               .set_rotation(kVideoRotation_0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  EXPECT_THAT(encoded_image_simulcast_indices_,
+              ::testing::ElementsAre(0, 1, 2));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestInitFailureCleansUpEncoders) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
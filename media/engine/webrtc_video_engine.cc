@@ -2862,6 +2862,7 @@ bool WebRtcVideoReceiveChannel::AddRecvStream(const StreamParams& sp,
   config.crypto_options = crypto_options_;
   config.enable_prerenderer_smoothing =
       video_config_.enable_prerenderer_smoothing;
+  config.timing_frame_info_observer = video_config_.timing_frame_info_observer;
   if (!sp.stream_ids().empty()) {
     config.sync_group = sp.stream_ids()[0];
   }
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string.h>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+// XORs the bytes of `src` starting at `offset` into `dsts`, 8 bytes at a time
+// as far as possible.
+void FecXorToManyFrom(size_t offset,
+                      rtc::ArrayView<const uint8_t> src,
+                      rtc::ArrayView<uint8_t* const> dsts) {
+  size_t i = offset;
+  for (; i + sizeof(uint64_t) <= src.size(); i += sizeof(uint64_t)) {
+    uint64_t s;
+    memcpy(&s, &src[i], sizeof(s));
+    for (uint8_t* dst : dsts) {
+      uint64_t d;
+      memcpy(&d, dst + i, sizeof(d));
+      d ^= s;
+      memcpy(dst + i, &d, sizeof(d));
+    }
+  }
+  for (; i < src.size(); ++i) {
+    for (uint8_t* dst : dsts) {
+      dst[i] ^= src[i];
+    }
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+size_t FecXorToMany_Sse2(rtc::ArrayView<const uint8_t> src,
+                         rtc::ArrayView<uint8_t* const> dsts) {
+  const size_t size = src.size() & ~size_t{15};
+  for (size_t i = 0; i < size; i += 16) {
+    const __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+    for (uint8_t* dst : dsts) {
+      __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+      _mm_storeu_si128(d, _mm_xor_si128(_mm_loadu_si128(d), s));
+    }
+  }
+  return size;
+}
+#endif
+
+internal::FecXorOptimization DetectOptimization() {
+  return internal::SupportedFecXorOptimizations().back();
+}
+
+}  // namespace
+
+void FecXor(rtc::ArrayView<const uint8_t> src, uint8_t* dst) {
+  FecXorToMany(src, rtc::ArrayView<uint8_t* const>(&dst, 1));
+}
+
+void FecXorToMany(rtc::ArrayView<const uint8_t> src,
+                  rtc::ArrayView<uint8_t* const> dsts) {
+  static const internal::FecXorOptimization optimization =
+      DetectOptimization();
+  internal::FecXorToMany(optimization, src, dsts);
+}
+
+namespace internal {
+
+std::vector<FecXorOptimization> SupportedFecXorOptimizations() {
+  std::vector<FecXorOptimization> optimizations = {FecXorOptimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kSSE2) != 0) {
+    optimizations.push_back(FecXorOptimization::kSse2);
+  }
+  if (GetCPUInfo(kAVX2) != 0) {
+    optimizations.push_back(FecXorOptimization::kAvx2);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(FecXorOptimization::kNeon);
+#endif
+  return optimizations;
+}
+
+void FecXorToMany(FecXorOptimization optimization,
+                  rtc::ArrayView<const uint8_t> src,
+                  rtc::ArrayView<uint8_t* const> dsts) {
+  size_t offset = 0;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case FecXorOptimization::kSse2:
+      offset = FecXorToMany_Sse2(src, dsts);
+      break;
+    case FecXorOptimization::kAvx2:
+      offset = FecXorToMany_Avx2(src, dsts);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case FecXorOptimization::kNeon:
+      offset = FecXorToMany_Neon(src, dsts);
+      break;
+#endif
+    case FecXorOptimization::kNone:
+      break;
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
+  FecXorToManyFrom(offset, src, dsts);
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// XORs `src` into `dst`, i.e. computes dst[i] ^= src[i] for every byte of
+// `src`. `dst` must have room for at least `src.size()` bytes.
+void FecXor(rtc::ArrayView<const uint8_t> src, uint8_t* dst);
+
+// XORs `src` into each of `dsts`. The result is the same as calling FecXor()
+// once per destination, but `src` is only read once. None of the destinations
+// may overlap `src` or each other.
+void FecXorToMany(rtc::ArrayView<const uint8_t> src,
+                  rtc::ArrayView<uint8_t* const> dsts);
+
+namespace internal {
+
+enum class FecXorOptimization { kNone, kSse2, kAvx2, kNeon };
+
+// Returns the optimizations that can be used on this CPU, the fastest last.
+// FecXor() and FecXorToMany() use the fastest one.
+std::vector<FecXorOptimization> SupportedFecXorOptimizations();
+
+// Same as FecXorToMany(), using the given optimization, which must be one of
+// SupportedFecXorOptimizations(). Exposed for tests and benchmarks.
+void FecXorToMany(FecXorOptimization optimization,
+                  rtc::ArrayView<const uint8_t> src,
+                  rtc::ArrayView<uint8_t* const> dsts);
+
+// Implementations of FecXorToMany() in separate build targets, as they need
+// their own compiler flags. XOR the bytes before `src.size()` rounded down to
+// a multiple of the vector size, and return the number of bytes XORed.
+size_t FecXorToMany_Avx2(rtc::ArrayView<const uint8_t> src,
+                         rtc::ArrayView<uint8_t* const> dsts);
+size_t FecXorToMany_Neon(rtc::ArrayView<const uint8_t> src,
+                         rtc::ArrayView<uint8_t* const> dsts);
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "api/array_view.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+namespace webrtc {
+namespace internal {
+
+size_t FecXorToMany_Avx2(rtc::ArrayView<const uint8_t> src,
+                         rtc::ArrayView<uint8_t* const> dsts) {
+  const size_t size = src.size() & ~size_t{31};
+  for (size_t i = 0; i < size; i += 32) {
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+    for (uint8_t* dst : dsts) {
+      __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+      _mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), s));
+    }
+  }
+  return size;
+}
+
+}  // namespace internal
+}  // namespace webrtc
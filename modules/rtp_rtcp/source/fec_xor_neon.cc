@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+
+#include "api/array_view.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+namespace webrtc {
+namespace internal {
+
+size_t FecXorToMany_Neon(rtc::ArrayView<const uint8_t> src,
+                         rtc::ArrayView<uint8_t* const> dsts) {
+  const size_t size = src.size() & ~size_t{15};
+  for (size_t i = 0; i < size; i += 16) {
+    const uint8x16_t s = vld1q_u8(&src[i]);
+    for (uint8_t* dst : dsts) {
+      vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), s));
+    }
+  }
+  return size;
+}
+
+}  // namespace internal
+}  // namespace webrtc
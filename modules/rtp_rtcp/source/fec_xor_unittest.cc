@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using internal::FecXorOptimization;
+
+std::vector<uint8_t> RandomBytes(size_t size, Random* random) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random->Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+class FecXorTest : public ::testing::TestWithParam<FecXorOptimization> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    FecXorTest,
+    ::testing::ValuesIn(internal::SupportedFecXorOptimizations()));
+
+TEST_P(FecXorTest, MatchesBytewiseXorForAllSizesAndAlignments) {
+  Random random(0x5eed);
+  constexpr size_t kNumDsts = 3;
+  for (size_t size : {0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 100, 1200}) {
+    for (size_t offset = 0; offset < 4; ++offset) {
+      const std::vector<uint8_t> src = RandomBytes(size + offset, &random);
+      std::vector<std::vector<uint8_t>> dsts;
+      std::vector<std::vector<uint8_t>> expected;
+      std::vector<uint8_t*> dst_ptrs;
+      for (size_t i = 0; i < kNumDsts; ++i) {
+        // Leave a byte after the end to check that it is not written.
+        dsts.push_back(RandomBytes(size + offset + 1, &random));
+        expected.push_back(dsts.back());
+        for (size_t j = 0; j < size; ++j) {
+          expected.back()[offset + j] ^= src[offset + j];
+        }
+      }
+      for (auto& dst : dsts) {
+        dst_ptrs.push_back(dst.data() + offset);
+      }
+
+      internal::FecXorToMany(
+          GetParam(), rtc::ArrayView<const uint8_t>(src).subview(offset),
+          dst_ptrs);
+
+      for (size_t i = 0; i < kNumDsts; ++i) {
+        EXPECT_EQ(dsts[i], expected[i]) << "size " << size << " offset "
+                                        << offset << " destination " << i;
+      }
+    }
+  }
+}
+
+TEST_P(FecXorTest, HandlesNoDestinations) {
+  const std::vector<uint8_t> src(100, 0xff);
+  internal::FecXorToMany(GetParam(), src, {});
+}
+
+TEST(FecXor, XorsIntoSingleDestination) {
+  const std::vector<uint8_t> src = {0x01, 0x02, 0x03, 0xf0};
+  std::vector<uint8_t> dst = {0x01, 0x00, 0x0f, 0x0f, 0x55};
+  FecXor(src, dst.data());
+  EXPECT_EQ(dst, std::vector<uint8_t>({0x00, 0x02, 0x0c, 0xff, 0x55}));
+}
+
+}  // namespace
+}  // namespace webrtc
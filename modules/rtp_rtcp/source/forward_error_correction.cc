@@ -13,12 +13,15 @@
 #include <string.h>
 
 #include <algorithm>
+#include <array>
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "api/array_view.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_03_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -206,47 +209,63 @@ void ForwardErrorCorrection::GenerateFecPayloads(
     const PacketList& media_packets,
     size_t num_fec_packets) {
   RTC_DCHECK(!media_packets.empty());
+  RTC_DCHECK_LE(num_fec_packets, kUlpfecMaxMediaPackets);
+  std::array<size_t, kUlpfecMaxMediaPackets> fec_header_sizes;
   for (size_t i = 0; i < num_fec_packets; ++i) {
-    Packet* const fec_packet = &generated_fec_packets_[i];
-    size_t pkt_mask_idx = i * packet_mask_size_;
     const size_t min_packet_mask_size = fec_header_writer_->MinPacketMaskSize(
-        &packet_masks_[pkt_mask_idx], packet_mask_size_);
-    const size_t fec_header_size =
+        &packet_masks_[i * packet_mask_size_], packet_mask_size_);
+    fec_header_sizes[i] =
         fec_header_writer_->FecHeaderSize(min_packet_mask_size);
+  }
 
-    size_t media_pkt_idx = 0;
-    auto media_packets_it = media_packets.cbegin();
-    uint16_t prev_seq_num =
-        ParseSequenceNumber((*media_packets_it)->data.data());
-    while (media_packets_it != media_packets.end()) {
-      Packet* const media_packet = media_packets_it->get();
-      // Should `media_packet` be protected by `fec_packet`?
-      if (packet_masks_[pkt_mask_idx] & (1 << (7 - media_pkt_idx))) {
-        size_t media_payload_length =
-            media_packet->data.size() - kRtpHeaderSize;
-
-        size_t fec_packet_length = fec_header_size + media_payload_length;
-        if (fec_packet_length > fec_packet->data.size()) {
-          size_t old_size = fec_packet->data.size();
-          fec_packet->data.SetSize(fec_packet_length);
-          memset(fec_packet->data.MutableData() + old_size, 0,
-                 fec_packet_length - old_size);
-        }
-        XorHeaders(*media_packet, fec_packet);
-        XorPayloads(*media_packet, media_payload_length, fec_header_size,
-                    fec_packet);
+  // Make a single pass over the media packets, XORing each of them into all
+  // the FEC packets that protect it at once.
+  std::array<uint8_t*, kUlpfecMaxMediaPackets> fec_payloads;
+  size_t mask_byte_idx = 0;
+  size_t media_pkt_idx = 0;
+  auto media_packets_it = media_packets.cbegin();
+  uint16_t prev_seq_num = ParseSequenceNumber((*media_packets_it)->data.data());
+  while (media_packets_it != media_packets.end()) {
+    Packet* const media_packet = media_packets_it->get();
+    const size_t media_payload_length =
+        media_packet->data.size() - kRtpHeaderSize;
+    size_t num_fec_payloads = 0;
+    for (size_t i = 0; i < num_fec_packets; ++i) {
+      // Should `media_packet` be protected by this FEC packet?
+      if (!(packet_masks_[i * packet_mask_size_ + mask_byte_idx] &
+            (1 << (7 - media_pkt_idx)))) {
+        continue;
       }
-      media_packets_it++;
-      if (media_packets_it != media_packets.end()) {
-        uint16_t seq_num =
-            ParseSequenceNumber((*media_packets_it)->data.data());
-        media_pkt_idx += static_cast<uint16_t>(seq_num - prev_seq_num);
-        prev_seq_num = seq_num;
+      Packet* const fec_packet = &generated_fec_packets_[i];
+      const size_t fec_packet_length =
+          fec_header_sizes[i] + media_payload_length;
+      RTC_DCHECK_LE(fec_packet_length, fec_packet->data.capacity());
+      if (fec_packet_length > fec_packet->data.size()) {
+        size_t old_size = fec_packet->data.size();
+        fec_packet->data.SetSize(fec_packet_length);
+        memset(fec_packet->data.MutableData() + old_size, 0,
+               fec_packet_length - old_size);
       }
-      pkt_mask_idx += media_pkt_idx / 8;
-      media_pkt_idx %= 8;
+      XorHeaders(*media_packet, fec_packet);
+      fec_payloads[num_fec_payloads++] =
+          fec_packet->data.MutableData() + fec_header_sizes[i];
+    }
+    FecXorToMany(
+        rtc::MakeArrayView(media_packet->data.cdata() + kRtpHeaderSize,
+                           media_payload_length),
+        rtc::MakeArrayView(fec_payloads.data(), num_fec_payloads));
+
+    media_packets_it++;
+    if (media_packets_it != media_packets.end()) {
+      uint16_t seq_num = ParseSequenceNumber((*media_packets_it)->data.data());
+      media_pkt_idx += static_cast<uint16_t>(seq_num - prev_seq_num);
+      prev_seq_num = seq_num;
     }
-    RTC_DCHECK_GT(fec_packet->data.size(), 0)
+    mask_byte_idx += media_pkt_idx / 8;
+    media_pkt_idx %= 8;
+  }
+  for (size_t i = 0; i < num_fec_packets; ++i) {
+    RTC_DCHECK_GT(generated_fec_packets_[i].data.size(), 0)
         << "Packet mask is wrong or poorly designed.";
   }
 }
@@ -635,11 +654,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
     dst->data.SetSize(new_size);
     memset(dst->data.MutableData() + old_size, 0, new_size - old_size);
   }
-  uint8_t* dst_data = dst->data.MutableData();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  FecXor(rtc::MakeArrayView(src.data.cdata() + kRtpHeaderSize, payload_length),
+         dst->data.MutableData() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -0,0 +1,190 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "benchmark/benchmark.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/source/fec_test_helper.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/gf256.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+using internal::FecXorOptimization;
+using internal::Gf256Optimization;
+
+constexpr size_t kPayloadSize = 1200;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFlexfecSsrc = 5678;
+
+class XorBuffers {
+ public:
+  explicit XorBuffers(size_t num_dsts)
+      : src_(kPayloadSize, 0x5a),
+        dsts_(num_dsts, std::vector<uint8_t>(kPayloadSize)) {
+    for (auto& dst : dsts_) {
+      dst_ptrs_.push_back(dst.data());
+    }
+  }
+
+  rtc::ArrayView<const uint8_t> src() const { return src_; }
+  rtc::ArrayView<uint8_t* const> dsts() const { return dst_ptrs_; }
+
+ private:
+  const std::vector<uint8_t> src_;
+  std::vector<std::vector<uint8_t>> dsts_;
+  std::vector<uint8_t*> dst_ptrs_;
+};
+
+// Arguments: number of destinations.
+void BM_FecXorToMany(benchmark::State& state,
+                     FecXorOptimization optimization) {
+  if (!absl::c_linear_search(internal::SupportedFecXorOptimizations(),
+                             optimization)) {
+    state.SkipWithError("Not supported on this CPU");
+    return;
+  }
+  XorBuffers buffers(state.range(0));
+  for (auto _ : state) {
+    internal::FecXorToMany(optimization, buffers.src(), buffers.dsts());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * kPayloadSize * state.range(0));
+}
+
+// Same work as BM_FecXorToMany, but with one pass over the source per
+// destination, i.e. computing one FEC packet at a time.
+void BM_FecXorOnePassPerDestination(benchmark::State& state) {
+  XorBuffers buffers(state.range(0));
+  for (auto _ : state) {
+    for (uint8_t* dst : buffers.dsts()) {
+      FecXor(buffers.src(), dst);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * kPayloadSize * state.range(0));
+}
+
+void ApplyXorSweep(benchmark::internal::Benchmark* b) {
+  b->ArgName("dsts")->Arg(1)->Arg(4)->Arg(16)->Arg(48);
+}
+
+BENCHMARK_CAPTURE(BM_FecXorToMany, Generic, FecXorOptimization::kNone)
+    ->Apply(ApplyXorSweep);
+BENCHMARK_CAPTURE(BM_FecXorToMany, SSE2, FecXorOptimization::kSse2)
+    ->Apply(ApplyXorSweep);
+BENCHMARK_CAPTURE(BM_FecXorToMany, AVX2, FecXorOptimization::kAvx2)
+    ->Apply(ApplyXorSweep);
+BENCHMARK_CAPTURE(BM_FecXorToMany, NEON, FecXorOptimization::kNeon)
+    ->Apply(ApplyXorSweep);
+BENCHMARK(BM_FecXorOnePassPerDestination)->Apply(ApplyXorSweep);
+
+// Arguments: number of media packets and protection factor (Q8).
+void BM_EncodeFec(benchmark::State& state, bool flexfec) {
+  const int num_media_packets = state.range(0);
+  const uint8_t protection_factor = state.range(1);
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      flexfec ? ForwardErrorCorrection::CreateFlexfec(kFlexfecSsrc, kMediaSsrc)
+              : ForwardErrorCorrection::CreateUlpfec(kMediaSsrc);
+  Random random(0x1234);
+  test::fec::MediaPacketGenerator generator(kPayloadSize, kPayloadSize,
+                                            kMediaSsrc, &random);
+  ForwardErrorCorrection::PacketList media_packets =
+      generator.ConstructMediaPackets(num_media_packets);
+
+  size_t num_fec_packets = 0;
+  for (auto _ : state) {
+    std::list<ForwardErrorCorrection::Packet*> fec_packets;
+    fec->EncodeFec(media_packets, protection_factor,
+                   /*num_important_packets=*/0,
+                   /*use_unequal_protection=*/false, kFecMaskRandom,
+                   &fec_packets);
+    num_fec_packets = fec_packets.size();
+    benchmark::DoNotOptimize(fec_packets);
+  }
+  state.counters["fec_packets"] = num_fec_packets;
+  state.SetBytesProcessed(state.iterations() * num_media_packets *
+                          kPayloadSize);
+}
+
+void ApplyEncodeSweep(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"media_packets", "protection"});
+  for (int num_media_packets : {12, 48}) {
+    for (int protection_factor : {64, 128, 255}) {
+      b->Args({num_media_packets, protection_factor});
+    }
+  }
+}
+
+BENCHMARK_CAPTURE(BM_EncodeFec, Ulpfec, /*flexfec=*/false)
+    ->Apply(ApplyEncodeSweep);
+BENCHMARK_CAPTURE(BM_EncodeFec, Flexfec, /*flexfec=*/true)
+    ->Apply(ApplyEncodeSweep);
+
+void BM_Gf256MulAdd(benchmark::State& state, Gf256Optimization optimization) {
+  if (!absl::c_linear_search(internal::SupportedGf256Optimizations(),
+                             optimization)) {
+    state.SkipWithError("Not supported on this CPU");
+    return;
+  }
+  const std::vector<uint8_t> src(kPayloadSize, 0x5a);
+  std::vector<uint8_t> dst(kPayloadSize);
+  for (auto _ : state) {
+    internal::Gf256MulAdd(optimization, /*coefficient=*/0x8e, src, dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * kPayloadSize);
+}
+
+BENCHMARK_CAPTURE(BM_Gf256MulAdd, Generic, Gf256Optimization::kNone);
+BENCHMARK_CAPTURE(BM_Gf256MulAdd, AVX2, Gf256Optimization::kAvx2);
+BENCHMARK_CAPTURE(BM_Gf256MulAdd, NEON, Gf256Optimization::kNeon);
+
+// Arguments: number of media packets and protection factor (Q8), as for
+// BM_EncodeFec.
+void BM_EncodeReedSolomon(benchmark::State& state) {
+  const int num_data = state.range(0);
+  const int num_parity =
+      ForwardErrorCorrection::NumFecPackets(num_data, state.range(1));
+  const ReedSolomonCode code(num_data, num_parity);
+  std::vector<std::vector<uint8_t>> shards(
+      num_data + num_parity, std::vector<uint8_t>(kPayloadSize, 0x5a));
+  std::vector<const uint8_t*> data;
+  std::vector<uint8_t*> parity;
+  for (int i = 0; i < num_data + num_parity; ++i) {
+    if (i < num_data) {
+      data.push_back(shards[i].data());
+    } else {
+      parity.push_back(shards[i].data());
+    }
+  }
+
+  for (auto _ : state) {
+    code.Encode(data, parity, kPayloadSize);
+    benchmark::ClobberMemory();
+  }
+  state.counters["fec_packets"] = num_parity;
+  state.SetBytesProcessed(state.iterations() * num_data * kPayloadSize);
+}
+
+BENCHMARK(BM_EncodeReedSolomon)->Apply(ApplyEncodeSweep);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include <array>
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+constexpr int kPolynomial = 0x11d;
+
+struct Gf256Tables {
+  // exp[i] = 2^i. Twice the size of the multiplicative group, so that
+  // exp[log[a] + log[b]] never needs a modulo.
+  std::array<uint8_t, 2 * 255> exp = {};
+  // log[a] for a != 0; log[0] is unused.
+  std::array<uint8_t, 256> log = {};
+};
+
+constexpr Gf256Tables MakeGf256Tables() {
+  Gf256Tables tables;
+  int x = 1;
+  for (int i = 0; i < 255; ++i) {
+    tables.exp[i] = static_cast<uint8_t>(x);
+    tables.exp[i + 255] = static_cast<uint8_t>(x);
+    tables.log[x] = static_cast<uint8_t>(i);
+    x <<= 1;
+    if (x & 0x100) {
+      x ^= kPolynomial;
+    }
+  }
+  return tables;
+}
+
+constexpr Gf256Tables kTables = MakeGf256Tables();
+
+internal::Gf256NibbleTables MakeNibbleTables(uint8_t coefficient) {
+  internal::Gf256NibbleTables tables;
+  for (int i = 0; i < 16; ++i) {
+    tables.low[i] = Gf256Mul(coefficient, i);
+    tables.high[i] = Gf256Mul(coefficient, i << 4);
+  }
+  return tables;
+}
+
+internal::Gf256Optimization DetectOptimization() {
+  return internal::SupportedGf256Optimizations().back();
+}
+
+}  // namespace
+
+uint8_t Gf256Mul(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  return kTables.exp[kTables.log[a] + kTables.log[b]];
+}
+
+uint8_t Gf256Inverse(uint8_t a) {
+  RTC_DCHECK_NE(a, 0);
+  return kTables.exp[255 - kTables.log[a]];
+}
+
+void Gf256MulAdd(uint8_t coefficient,
+                 rtc::ArrayView<const uint8_t> src,
+                 uint8_t* dst) {
+  static const internal::Gf256Optimization optimization =
+      DetectOptimization();
+  internal::Gf256MulAdd(optimization, coefficient, src, dst);
+}
+
+namespace internal {
+
+std::vector<Gf256Optimization> SupportedGf256Optimizations() {
+  std::vector<Gf256Optimization> optimizations = {Gf256Optimization::kNone};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (GetCPUInfo(kAVX2) != 0) {
+    optimizations.push_back(Gf256Optimization::kAvx2);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  optimizations.push_back(Gf256Optimization::kNeon);
+#endif
+  return optimizations;
+}
+
+void Gf256MulAdd(Gf256Optimization optimization,
+                 uint8_t coefficient,
+                 rtc::ArrayView<const uint8_t> src,
+                 uint8_t* dst) {
+  // Multiplying by 0 or 1 needs no tables.
+  if (coefficient == 0) {
+    return;
+  }
+  if (coefficient == 1) {
+    FecXor(src, dst);
+    return;
+  }
+
+  const Gf256NibbleTables tables = MakeNibbleTables(coefficient);
+  size_t offset = 0;
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Gf256Optimization::kAvx2:
+      offset = Gf256MulAdd_Avx2(tables, src, dst);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Gf256Optimization::kNeon:
+      offset = Gf256MulAdd_Neon(tables, src, dst);
+      break;
+#endif
+    case Gf256Optimization::kNone:
+      break;
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
+  for (size_t i = offset; i < src.size(); ++i) {
+    dst[i] ^= tables.low[src[i] & 0xf] ^ tables.high[src[i] >> 4];
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_GF256_H_
+#define MODULES_RTP_RTCP_SOURCE_GF256_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Arithmetic in GF(2^8), using the reduction polynomial
+// x^8 + x^4 + x^3 + x^2 + 1 (0x11d). Addition is XOR.
+
+uint8_t Gf256Mul(uint8_t a, uint8_t b);
+
+// Returns the multiplicative inverse of `a`, which must be non-zero.
+uint8_t Gf256Inverse(uint8_t a);
+
+// Computes dst[i] ^= coefficient * src[i] for every byte of `src`. `dst` must
+// have room for at least `src.size()` bytes and must not overlap `src`.
+void Gf256MulAdd(uint8_t coefficient,
+                 rtc::ArrayView<const uint8_t> src,
+                 uint8_t* dst);
+
+namespace internal {
+
+enum class Gf256Optimization { kNone, kAvx2, kNeon };
+
+// Returns the optimizations that can be used on this CPU, the fastest last.
+// Gf256MulAdd() uses the fastest one.
+std::vector<Gf256Optimization> SupportedGf256Optimizations();
+
+// Same as Gf256MulAdd(), using the given optimization, which must be one of
+// SupportedGf256Optimizations(). Exposed for tests and benchmarks.
+void Gf256MulAdd(Gf256Optimization optimization,
+                 uint8_t coefficient,
+                 rtc::ArrayView<const uint8_t> src,
+                 uint8_t* dst);
+
+// Products of a coefficient with the low and the high nibble of a byte, so
+// that coefficient * x == low[x & 0xf] ^ high[x >> 4]. This is the form used
+// by byte shuffle instructions.
+struct Gf256NibbleTables {
+  uint8_t low[16];
+  uint8_t high[16];
+};
+
+// Implementations of Gf256MulAdd() in separate build targets, as they need
+// their own compiler flags. Process the bytes before `src.size()` rounded down
+// to a multiple of the vector size, and return the number of bytes processed.
+size_t Gf256MulAdd_Avx2(const Gf256NibbleTables& tables,
+                        rtc::ArrayView<const uint8_t> src,
+                        uint8_t* dst);
+size_t Gf256MulAdd_Neon(const Gf256NibbleTables& tables,
+                        rtc::ArrayView<const uint8_t> src,
+                        uint8_t* dst);
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_GF256_H_
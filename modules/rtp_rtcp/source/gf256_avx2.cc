@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "api/array_view.h"
+#include "modules/rtp_rtcp/source/gf256.h"
+
+namespace webrtc {
+namespace internal {
+
+size_t Gf256MulAdd_Avx2(const Gf256NibbleTables& tables,
+                        rtc::ArrayView<const uint8_t> src,
+                        uint8_t* dst) {
+  // The shuffle looks up within each 128-bit lane, so both lanes get a copy of
+  // the tables.
+  const __m256i low = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.low)));
+  const __m256i high = _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.high)));
+  const __m256i nibble_mask = _mm256_set1_epi8(0x0f);
+
+  const size_t size = src.size() & ~size_t{31};
+  for (size_t i = 0; i < size; i += 32) {
+    const __m256i s =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&src[i]));
+    const __m256i product = _mm256_xor_si256(
+        _mm256_shuffle_epi8(low, _mm256_and_si256(s, nibble_mask)),
+        _mm256_shuffle_epi8(
+            high, _mm256_and_si256(_mm256_srli_epi64(s, 4), nibble_mask)));
+    __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+    _mm256_storeu_si256(d, _mm256_xor_si256(_mm256_loadu_si256(d), product));
+  }
+  return size;
+}
+
+}  // namespace internal
+}  // namespace webrtc
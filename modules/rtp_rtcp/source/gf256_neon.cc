@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+
+#include "api/array_view.h"
+#include "modules/rtp_rtcp/source/gf256.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+#if defined(__aarch64__)
+uint8x16_t Lookup(uint8x16_t table, uint8x16_t indices) {
+  return vqtbl1q_u8(table, indices);
+}
+#else
+uint8x16_t Lookup(uint8x16_t table, uint8x16_t indices) {
+  const uint8x8x2_t t = {{vget_low_u8(table), vget_high_u8(table)}};
+  return vcombine_u8(vtbl2_u8(t, vget_low_u8(indices)),
+                     vtbl2_u8(t, vget_high_u8(indices)));
+}
+#endif
+
+}  // namespace
+
+size_t Gf256MulAdd_Neon(const Gf256NibbleTables& tables,
+                        rtc::ArrayView<const uint8_t> src,
+                        uint8_t* dst) {
+  const uint8x16_t low = vld1q_u8(tables.low);
+  const uint8x16_t high = vld1q_u8(tables.high);
+  const uint8x16_t nibble_mask = vdupq_n_u8(0x0f);
+
+  const size_t size = src.size() & ~size_t{15};
+  for (size_t i = 0; i < size; i += 16) {
+    const uint8x16_t s = vld1q_u8(&src[i]);
+    const uint8x16_t product =
+        veorq_u8(Lookup(low, vandq_u8(s, nibble_mask)),
+                 Lookup(high, vshrq_n_u8(s, 4)));
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), product));
+  }
+  return size;
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/gf256.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using internal::Gf256Optimization;
+
+// Carry-less multiplication followed by reduction, one bit at a time.
+uint8_t SlowMul(uint8_t a, uint8_t b) {
+  int product = 0;
+  for (int bit = 0; bit < 8; ++bit) {
+    if (b & (1 << bit)) {
+      product ^= a << bit;
+    }
+  }
+  for (int bit = 14; bit >= 8; --bit) {
+    if (product & (1 << bit)) {
+      product ^= 0x11d << (bit - 8);
+    }
+  }
+  return product;
+}
+
+std::vector<uint8_t> RandomBytes(size_t size, Random* random) {
+  std::vector<uint8_t> bytes(size);
+  for (uint8_t& byte : bytes) {
+    byte = random->Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+TEST(Gf256, MultipliesAllPairs) {
+  for (int a = 0; a < 256; ++a) {
+    for (int b = 0; b < 256; ++b) {
+      ASSERT_EQ(Gf256Mul(a, b), SlowMul(a, b)) << a << " * " << b;
+    }
+  }
+}
+
+TEST(Gf256, InverseIsInverse) {
+  for (int a = 1; a < 256; ++a) {
+    EXPECT_EQ(Gf256Mul(a, Gf256Inverse(a)), 1) << a;
+  }
+}
+
+class Gf256MulAddTest : public ::testing::TestWithParam<Gf256Optimization> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    All,
+    Gf256MulAddTest,
+    ::testing::ValuesIn(internal::SupportedGf256Optimizations()));
+
+TEST_P(Gf256MulAddTest, MatchesBytewiseMulForAllSizesAndAlignments) {
+  Random random(0x5eed);
+  for (uint8_t coefficient : {0, 1, 2, 0x1d, 0x80, 0xff}) {
+    for (size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 100, 1200}) {
+      for (size_t offset = 0; offset < 3; ++offset) {
+        const std::vector<uint8_t> src = RandomBytes(size + offset, &random);
+        // Leave a byte after the end to check that it is not written.
+        std::vector<uint8_t> dst = RandomBytes(size + offset + 1, &random);
+        std::vector<uint8_t> expected = dst;
+        for (size_t i = 0; i < size; ++i) {
+          expected[offset + i] ^= SlowMul(coefficient, src[offset + i]);
+        }
+
+        internal::Gf256MulAdd(
+            GetParam(), coefficient,
+            rtc::ArrayView<const uint8_t>(src).subview(offset),
+            dst.data() + offset);
+
+        EXPECT_EQ(dst, expected) << "coefficient " << int{coefficient}
+                                 << " size " << size << " offset " << offset;
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
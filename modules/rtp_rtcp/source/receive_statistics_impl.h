@@ -12,12 +12,14 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/sequence_checker.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/include/receive_statistics.h"
@@ -26,6 +28,8 @@
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 #include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/synchronization/seq_lock.h"
+#include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
@@ -41,6 +45,52 @@ class StreamStatisticianImplInterface : public StreamStatistician {
   virtual void UpdateCounters(const RtpPacketReceived& packet) = 0;
 };
 
+// State of a stream that is updated by each received packet, and that its
+// statistics and report blocks are computed from.
+struct StreamReceiveState {
+  // `delta_internal_unix_epoch` maps internal timestamps to Unix epoch ones.
+  RtpReceiveStats ToStats(TimeDelta delta_internal_unix_epoch) const;
+  // Returns average loss over the stream life time.
+  absl::optional<int> FractionLostInPercent() const;
+
+  // Time of the last in-order packet, if any packet was received.
+  absl::optional<Timestamp> last_receive_time;
+  int64_t received_seq_first = -1;
+  int64_t received_seq_max = -1;
+  // Cumulative loss according to RFC 3550, which may be negative (and often is,
+  // if packets are reordered and there are non-RTX retransmissions).
+  int32_t cumulative_loss = 0;
+  uint32_t jitter_q4 = 0;
+  // The sample frequency of the last received packet.
+  int last_payload_type_frequency = 0;
+  // Set when the stream starts or restarts, to the sequence number that the
+  // next report block counts expected packets from.
+  int64_t report_seq_max = -1;
+  int num_report_seq_max_updates = 0;
+  StreamDataCounters receive_counters;
+};
+
+// State of a stream that is kept between its report blocks.
+struct StreamReportState {
+  // Appends a report block for `receive_state` unless the stream is inactive,
+  // and remembers the values it was computed from.
+  void MaybeAppendReportBlockAndReset(
+      uint32_t ssrc,
+      Timestamp now,
+      const StreamReceiveState& receive_state,
+      std::vector<rtcp::ReportBlock>& report_blocks);
+
+  // Counter values when we sent the last report.
+  int32_t last_report_cumulative_loss = 0;
+  int64_t last_report_seq_max = -1;
+  int num_report_seq_max_updates = 0;
+  // Offset added to outgoing rtcp reports, to make ensure that the reported
+  // cumulative loss is non-negative. Reports with negative values confuse some
+  // senders, in particular, our own loss-based bandwidth estimator.
+  int32_t cumulative_loss_rtcp_offset = 0;
+  bool cumulative_loss_is_capped = false;
+};
+
 // Thread-compatible implementation of StreamStatisticianImplInterface.
 class StreamStatisticianImpl : public StreamStatisticianImplInterface {
  public:
@@ -63,6 +113,8 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // Updates StreamStatistician for incoming packets.
   void UpdateCounters(const RtpPacketReceived& packet) override;
 
+  const StreamReceiveState& receive_state() const { return receive_state_; }
+
  private:
   bool IsRetransmitOfOldPacket(const RtpPacketReceived& packet,
                                Timestamp now) const;
@@ -73,8 +125,12 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   bool UpdateOutOfOrder(const RtpPacketReceived& packet,
                         int64_t sequence_number,
                         Timestamp now);
+  // Makes the next report block count expected packets from `seq_num`.
+  void SetReportSeqMax(int64_t seq_num);
   // Checks if this StreamStatistician received any rtp packets.
-  bool ReceivedRtpPacket() const { return last_receive_time_.has_value(); }
+  bool ReceivedRtpPacket() const {
+    return receive_state_.last_receive_time.has_value();
+  }
 
   const uint32_t ssrc_;
   Clock* const clock_;
@@ -84,84 +140,59 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // In number of packets or sequence numbers.
   int max_reordering_threshold_;
   bool enable_retransmit_detection_;
-  bool cumulative_loss_is_capped_;
 
-  // Stats on received RTP packets.
-  uint32_t jitter_q4_;
-  // Cumulative loss according to RFC 3550, which may be negative (and often is,
-  // if packets are reordered and there are non-RTX retransmissions).
-  int32_t cumulative_loss_;
-  // Offset added to outgoing rtcp reports, to make ensure that the reported
-  // cumulative loss is non-negative. Reports with negative values confuse some
-  // senders, in particular, our own loss-based bandwidth estimator.
-  int32_t cumulative_loss_rtcp_offset_;
+  StreamReceiveState receive_state_;
+  StreamReportState report_state_;
 
-  absl::optional<Timestamp> last_receive_time_;
   uint32_t last_received_timestamp_;
   RtpSequenceNumberUnwrapper seq_unwrapper_;
-  int64_t received_seq_first_;
-  int64_t received_seq_max_;
   // Assume that the other side restarted when there are two sequential packets
-  // with large jump from received_seq_max_.
+  // with large jump from received_seq_max.
   absl::optional<uint16_t> received_seq_out_of_order_;
-
-  // Current counter values.
-  StreamDataCounters receive_counters_;
-
-  // Counter values when we sent the last report.
-  int32_t last_report_cumulative_loss_;
-  int64_t last_report_seq_max_;
-
-  // The sample frequency of the last received packet.
-  int last_payload_type_frequency_;
 };
 
-// Thread-safe implementation of StreamStatisticianImplInterface.
-class StreamStatisticianLocked : public StreamStatisticianImplInterface {
+// Thread-safe implementation of StreamStatisticianImplInterface, for packets
+// that are all received on one sequence. Packets are counted without locking:
+// the state they update is published through a SeqLock, and the statistics
+// and report blocks are computed from a copy of it.
+class StreamStatisticianConcurrent : public StreamStatisticianImplInterface {
  public:
-  StreamStatisticianLocked(uint32_t ssrc,
-                           Clock* clock,
-                           int max_reordering_threshold)
-      : impl_(ssrc, clock, max_reordering_threshold) {}
-  ~StreamStatisticianLocked() override = default;
-
-  RtpReceiveStats GetStats() const override {
-    MutexLock lock(&stream_lock_);
-    return impl_.GetStats();
-  }
-  absl::optional<int> GetFractionLostInPercent() const override {
-    MutexLock lock(&stream_lock_);
-    return impl_.GetFractionLostInPercent();
-  }
-  StreamDataCounters GetReceiveStreamDataCounters() const override {
-    MutexLock lock(&stream_lock_);
-    return impl_.GetReceiveStreamDataCounters();
-  }
-  uint32_t BitrateReceived() const override {
-    MutexLock lock(&stream_lock_);
-    return impl_.BitrateReceived();
-  }
+  StreamStatisticianConcurrent(uint32_t ssrc,
+                               Clock* clock,
+                               int max_reordering_threshold);
+  ~StreamStatisticianConcurrent() override;
+
+  RtpReceiveStats GetStats() const override;
+  absl::optional<int> GetFractionLostInPercent() const override;
+  StreamDataCounters GetReceiveStreamDataCounters() const override;
+  uint32_t BitrateReceived() const override;
   void MaybeAppendReportBlockAndReset(
-      std::vector<rtcp::ReportBlock>& report_blocks) override {
-    MutexLock lock(&stream_lock_);
-    impl_.MaybeAppendReportBlockAndReset(report_blocks);
-  }
-  void SetMaxReorderingThreshold(int max_reordering_threshold) override {
-    MutexLock lock(&stream_lock_);
-    return impl_.SetMaxReorderingThreshold(max_reordering_threshold);
-  }
-  void EnableRetransmitDetection(bool enable) override {
-    MutexLock lock(&stream_lock_);
-    return impl_.EnableRetransmitDetection(enable);
-  }
-  void UpdateCounters(const RtpPacketReceived& packet) override {
-    MutexLock lock(&stream_lock_);
-    return impl_.UpdateCounters(packet);
-  }
+      std::vector<rtcp::ReportBlock>& report_blocks) override;
+  void SetMaxReorderingThreshold(int max_reordering_threshold) override;
+  void EnableRetransmitDetection(bool enable) override;
+  void UpdateCounters(const RtpPacketReceived& packet) override;
 
  private:
-  mutable Mutex stream_lock_;
-  StreamStatisticianImpl impl_ RTC_GUARDED_BY(&stream_lock_);
+  struct Snapshot {
+    StreamReceiveState receive_state;
+    // Receive bitrate as of the last packet.
+    uint32_t bitrate_bps = 0;
+  };
+
+  const uint32_t ssrc_;
+  Clock* const clock_;
+  const TimeDelta delta_internal_unix_epoch_;
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker packet_sequence_checker_{
+      SequenceChecker::kDetached};
+  StreamStatisticianImpl impl_ RTC_GUARDED_BY(packet_sequence_checker_);
+  // Applied to `impl_` by the next packet.
+  std::atomic<int> max_reordering_threshold_;
+  std::atomic<bool> enable_retransmit_detection_;
+
+  SeqLock<Snapshot> snapshot_;
+
+  Mutex report_lock_;
+  StreamReportState report_state_ RTC_GUARDED_BY(report_lock_);
 };
 
 // Thread-compatible implementation.
@@ -188,9 +219,10 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
                                  int max_reordering_threshold) override;
   void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
 
- private:
+  // Statisticians are only destroyed with this object.
   StreamStatisticianImplInterface* GetOrCreateStatistician(uint32_t ssrc);
 
+ private:
   Clock* const clock_;
   std::function<std::unique_ptr<StreamStatisticianImplInterface>(
       uint32_t ssrc,
@@ -206,7 +238,8 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
 };
 
 // Thread-safe implementation wrapping access to ReceiveStatisticsImpl with a
-// mutex.
+// mutex. Packets, which must all be received on one sequence, only take the
+// mutex for the first packet of each SSRC.
 class ReceiveStatisticsLocked : public ReceiveStatistics {
  public:
   explicit ReceiveStatisticsLocked(
@@ -221,10 +254,7 @@ class ReceiveStatisticsLocked : public ReceiveStatistics {
     MutexLock lock(&receive_statistics_lock_);
     return impl_.RtcpReportBlocks(max_blocks);
   }
-  void OnRtpPacket(const RtpPacketReceived& packet) override {
-    MutexLock lock(&receive_statistics_lock_);
-    return impl_.OnRtpPacket(packet);
-  }
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
   StreamStatistician* GetStatistician(uint32_t ssrc) const override {
     MutexLock lock(&receive_statistics_lock_);
     return impl_.GetStatistician(ssrc);
@@ -244,8 +274,18 @@ class ReceiveStatisticsLocked : public ReceiveStatistics {
   }
 
  private:
+  StreamStatisticianImplInterface* GetOrCreateStatisticianForPacket(
+      uint32_t ssrc);
+
   mutable Mutex receive_statistics_lock_;
   ReceiveStatisticsImpl impl_ RTC_GUARDED_BY(&receive_statistics_lock_);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker packet_sequence_checker_{
+      SequenceChecker::kDetached};
+  // The statisticians of `impl_` that packets were received for. They live as
+  // long as `impl_`, so they can be used without holding the mutex.
+  flat_map<uint32_t, StreamStatisticianImplInterface*> packet_statisticians_
+      RTC_GUARDED_BY(packet_sequence_checker_);
 };
 
 }  // namespace webrtc
@@ -10,12 +10,14 @@
 
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "api/units/time_delta.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -168,6 +170,19 @@ TEST_P(ReceiveStatisticsTest, TwoIncomingSsrcs) {
   EXPECT_EQ(3u, counters.transmitted.packets);
 }
 
+TEST_P(ReceiveStatisticsTest, BitrateIsZeroOnceStreamStops) {
+  receive_statistics_->OnRtpPacket(packet1_);
+  IncrementSequenceNumber(&packet1_);
+  clock_.AdvanceTimeMilliseconds(100);
+  receive_statistics_->OnRtpPacket(packet1_);
+  StreamStatistician* statistician =
+      receive_statistics_->GetStatistician(kSsrc1);
+  EXPECT_GT(statistician->BitrateReceived(), 0u);
+
+  clock_.AdvanceTimeMilliseconds(2000);
+  EXPECT_EQ(statistician->BitrateReceived(), 0u);
+}
+
 TEST_P(ReceiveStatisticsTest,
        RtcpReportBlocksReturnsMaxBlocksWhenThereAreMoreStatisticians) {
   RtpPacketReceived packet1 = CreateRtpPacket(kSsrc1, kPacketSize1);
@@ -898,5 +913,43 @@ TEST(ReviseJitterTest,
   EXPECT_EQ(GetJitter(*statistics), 172U);
 }
 
+TEST(ReceiveStatisticsTest, ReadsConsistentStatsWhilePacketsAreReceived) {
+  constexpr int kNumPackets = 20000;
+  SimulatedClock clock(0);
+  std::unique_ptr<ReceiveStatistics> receive_statistics =
+      ReceiveStatistics::Create(&clock);
+  RtpPacketReceived packet = CreateRtpPacket(kSsrc1, kPacketSize1);
+  receive_statistics->OnRtpPacket(packet);
+  StreamStatistician* statistician =
+      receive_statistics->GetStatistician(kSsrc1);
+
+  std::atomic<bool> done(false);
+  rtc::PlatformThread reader = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        while (!done.load()) {
+          StreamDataCounters counters =
+              statistician->GetReceiveStreamDataCounters();
+          EXPECT_EQ(counters.transmitted.header_bytes,
+                    12 * counters.transmitted.packets);
+          EXPECT_EQ(counters.transmitted.payload_bytes,
+                    (kPacketSize1 - 12) * counters.transmitted.packets);
+          for (const rtcp::ReportBlock& report_block :
+               receive_statistics->RtcpReportBlocks(1)) {
+            EXPECT_EQ(report_block.cumulative_lost(), 0);
+          }
+        }
+      },
+      "reader");
+  for (int i = 0; i < kNumPackets; ++i) {
+    IncrementSequenceNumber(&packet);
+    receive_statistics->OnRtpPacket(packet);
+  }
+  done.store(true);
+  reader.Finalize();
+
+  EXPECT_EQ(statistician->GetReceiveStreamDataCounters().transmitted.packets,
+            kNumPackets + 1u);
+}
+
 }  // namespace
 }  // namespace webrtc
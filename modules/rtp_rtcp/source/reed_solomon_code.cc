@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/gf256.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Inverts the `size` x `size` row-major `matrix` in place, by Gauss-Jordan
+// elimination.
+void InvertMatrix(std::vector<uint8_t>& matrix, size_t size) {
+  const size_t width = 2 * size;
+  // Augment with the identity matrix.
+  std::vector<uint8_t> augmented(size * width, 0);
+  for (size_t row = 0; row < size; ++row) {
+    memcpy(&augmented[row * width], &matrix[row * size], size);
+    augmented[row * width + size + row] = 1;
+  }
+
+  for (size_t col = 0; col < size; ++col) {
+    size_t pivot = col;
+    while (augmented[pivot * width + col] == 0) {
+      ++pivot;
+      // Square submatrices of a Cauchy matrix are never singular.
+      RTC_CHECK_LT(pivot, size);
+    }
+    uint8_t* pivot_row = &augmented[col * width];
+    if (pivot != col) {
+      std::swap_ranges(pivot_row, pivot_row + width,
+                       &augmented[pivot * width]);
+    }
+    const uint8_t scale = Gf256Inverse(pivot_row[col]);
+    for (size_t i = 0; i < width; ++i) {
+      pivot_row[i] = Gf256Mul(pivot_row[i], scale);
+    }
+    for (size_t row = 0; row < size; ++row) {
+      if (row != col) {
+        uint8_t* other_row = &augmented[row * width];
+        Gf256MulAdd(other_row[col],
+                    rtc::ArrayView<const uint8_t>(pivot_row, width), other_row);
+      }
+    }
+  }
+
+  for (size_t row = 0; row < size; ++row) {
+    memcpy(&matrix[row * size], &augmented[row * width + size], size);
+  }
+}
+
+}  // namespace
+
+ReedSolomonCode::ReedSolomonCode(int num_data, int num_parity)
+    : num_data_(num_data), num_parity_(num_parity) {
+  RTC_DCHECK_GT(num_data_, 0);
+  RTC_DCHECK_GE(num_parity_, 0);
+  RTC_DCHECK_LE(num_data_ + num_parity_, kMaxShards);
+}
+
+uint8_t ReedSolomonCode::Coefficient(int parity_index, int data_index) const {
+  RTC_DCHECK_LT(parity_index, num_parity_);
+  RTC_DCHECK_LT(data_index, num_data_);
+  // Row and column elements are distinct, so their sum is never zero.
+  return Gf256Inverse(static_cast<uint8_t>((num_data_ + parity_index) ^
+                                           data_index));
+}
+
+void ReedSolomonCode::Encode(rtc::ArrayView<const uint8_t* const> data,
+                             rtc::ArrayView<uint8_t* const> parity,
+                             size_t shard_size) const {
+  RTC_DCHECK_EQ(data.size(), num_data_);
+  RTC_DCHECK_EQ(parity.size(), num_parity_);
+  for (uint8_t* shard : parity) {
+    memset(shard, 0, shard_size);
+  }
+  for (int j = 0; j < num_data_; ++j) {
+    const rtc::ArrayView<const uint8_t> src(data[j], shard_size);
+    for (int r = 0; r < num_parity_; ++r) {
+      Gf256MulAdd(Coefficient(r, j), src, parity[r]);
+    }
+  }
+}
+
+bool ReedSolomonCode::Decode(rtc::ArrayView<const uint8_t* const> shards,
+                             size_t shard_size,
+                             rtc::ArrayView<uint8_t* const> recovered) const {
+  RTC_DCHECK_EQ(shards.size(), num_data_ + num_parity_);
+  RTC_DCHECK_EQ(recovered.size(), num_data_);
+
+  std::vector<int> lost;
+  for (int j = 0; j < num_data_; ++j) {
+    if (shards[j] == nullptr) {
+      lost.push_back(j);
+    }
+  }
+  if (lost.empty()) {
+    return true;
+  }
+  // Any `lost.size()` parity shards will do.
+  std::vector<int> parity_rows;
+  for (int r = 0; r < num_parity_ && parity_rows.size() < lost.size(); ++r) {
+    if (shards[num_data_ + r] != nullptr) {
+      parity_rows.push_back(r);
+    }
+  }
+  if (parity_rows.size() < lost.size()) {
+    return false;
+  }
+  const size_t num_lost = lost.size();
+
+  // Remove the contribution of the received data shards from the parity
+  // shards. What remains is the contribution of the lost ones only.
+  std::vector<std::vector<uint8_t>> syndromes(num_lost);
+  for (size_t t = 0; t < num_lost; ++t) {
+    const uint8_t* parity = shards[num_data_ + parity_rows[t]];
+    syndromes[t].assign(parity, parity + shard_size);
+  }
+  for (int j = 0; j < num_data_; ++j) {
+    if (shards[j] == nullptr) {
+      continue;
+    }
+    const rtc::ArrayView<const uint8_t> src(shards[j], shard_size);
+    for (size_t t = 0; t < num_lost; ++t) {
+      Gf256MulAdd(Coefficient(parity_rows[t], j), src, syndromes[t].data());
+    }
+  }
+
+  // syndromes = A * lost data, where A is a square submatrix of the Cauchy
+  // matrix, so the lost data is A^-1 * syndromes.
+  std::vector<uint8_t> matrix(num_lost * num_lost);
+  for (size_t t = 0; t < num_lost; ++t) {
+    for (size_t l = 0; l < num_lost; ++l) {
+      matrix[t * num_lost + l] = Coefficient(parity_rows[t], lost[l]);
+    }
+  }
+  InvertMatrix(matrix, num_lost);
+
+  for (size_t l = 0; l < num_lost; ++l) {
+    uint8_t* shard = recovered[lost[l]];
+    RTC_DCHECK(shard);
+    memset(shard, 0, shard_size);
+    for (size_t t = 0; t < num_lost; ++t) {
+      Gf256MulAdd(matrix[l * num_lost + t], syndromes[t], shard);
+    }
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Systematic Reed-Solomon erasure code over GF(2^8). `num_data` data shards
+// are protected by `num_parity` parity shards, and the data can be recovered
+// from any `num_data` of the `num_data + num_parity` shards, no matter which
+// ones are lost. Unlike the XOR based codes used by ULPFEC and FlexFEC, a
+// single group can therefore recover from a burst of up to `num_parity`
+// losses.
+//
+// Parity shard r is the sum over the data shards j of C(r, j) * data[j], where
+// C is the Cauchy matrix C(r, j) = 1 / ((num_data + r) + j) in GF(2^8). All
+// square submatrices of a Cauchy matrix are invertible, which is what makes
+// the code maximum distance separable.
+class ReedSolomonCode {
+ public:
+  // Number of elements of GF(2^8), which bounds `num_data + num_parity`.
+  static constexpr int kMaxShards = 256;
+
+  ReedSolomonCode(int num_data, int num_parity);
+
+  int num_data() const { return num_data_; }
+  int num_parity() const { return num_parity_; }
+
+  // Returns the coefficient of data shard `data_index` in parity shard
+  // `parity_index`.
+  uint8_t Coefficient(int parity_index, int data_index) const;
+
+  // Computes the `num_parity` shards in `parity` from the `num_data` shards in
+  // `data`. All shards are `shard_size` bytes.
+  void Encode(rtc::ArrayView<const uint8_t* const> data,
+              rtc::ArrayView<uint8_t* const> parity,
+              size_t shard_size) const;
+
+  // `shards` holds the `num_data` data shards followed by the `num_parity`
+  // parity shards, with nullptr for the lost ones. For every lost data shard
+  // j, writes the recovered shard to `recovered[j]`; the other entries of
+  // `recovered` are not used and may be nullptr. Returns false, without
+  // writing anything, if fewer than `num_data` shards are present.
+  bool Decode(rtc::ArrayView<const uint8_t* const> shards,
+              size_t shard_size,
+              rtc::ArrayView<uint8_t* const> recovered) const;
+
+ private:
+  const int num_data_;
+  const int num_parity_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_CODE_H_
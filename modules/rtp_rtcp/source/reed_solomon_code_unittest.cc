@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kShardSize = 100;
+
+class Shards {
+ public:
+  Shards(const ReedSolomonCode& code, Random* random)
+      : code_(code),
+        shards_(code.num_data() + code.num_parity(),
+                std::vector<uint8_t>(kShardSize)) {
+    for (int j = 0; j < code.num_data(); ++j) {
+      for (uint8_t& byte : shards_[j]) {
+        byte = random->Rand<uint8_t>();
+      }
+    }
+    std::vector<const uint8_t*> data;
+    std::vector<uint8_t*> parity;
+    for (int i = 0; i < code.num_data() + code.num_parity(); ++i) {
+      if (i < code.num_data()) {
+        data.push_back(shards_[i].data());
+      } else {
+        parity.push_back(shards_[i].data());
+      }
+    }
+    code.Encode(data, parity, kShardSize);
+  }
+
+  // Decodes with the shards for which `lost` is set missing, and checks that
+  // the lost data shards are recovered.
+  bool DecodeAndCheck(const std::vector<bool>& lost) const {
+    const int num_data = code_.num_data();
+    std::vector<const uint8_t*> received(shards_.size());
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      received[i] = lost[i] ? nullptr : shards_[i].data();
+    }
+    std::vector<std::vector<uint8_t>> recovered(
+        num_data, std::vector<uint8_t>(kShardSize));
+    std::vector<uint8_t*> recovered_ptrs;
+    for (auto& shard : recovered) {
+      recovered_ptrs.push_back(shard.data());
+    }
+    if (!code_.Decode(received, kShardSize, recovered_ptrs)) {
+      return false;
+    }
+    for (int j = 0; j < num_data; ++j) {
+      if (lost[j]) {
+        EXPECT_EQ(recovered[j], shards_[j]) << "data shard " << j;
+      }
+    }
+    return true;
+  }
+
+ private:
+  const ReedSolomonCode& code_;
+  std::vector<std::vector<uint8_t>> shards_;
+};
+
+TEST(ReedSolomonCodeTest, RecoversFromEveryLossPatternUpToNumParity) {
+  Random random(0x1234);
+  const ReedSolomonCode code(/*num_data=*/6, /*num_parity=*/3);
+  const Shards shards(code, &random);
+  const int num_shards = code.num_data() + code.num_parity();
+  for (int pattern = 0; pattern < (1 << num_shards); ++pattern) {
+    std::vector<bool> lost(num_shards);
+    int num_lost = 0;
+    for (int i = 0; i < num_shards; ++i) {
+      lost[i] = (pattern >> i) & 1;
+      num_lost += lost[i] ? 1 : 0;
+    }
+    EXPECT_EQ(shards.DecodeAndCheck(lost), num_lost <= code.num_parity())
+        << "loss pattern " << pattern;
+  }
+}
+
+TEST(ReedSolomonCodeTest, RecoversFromBurstsInLargeGroup) {
+  Random random(0x4321);
+  const ReedSolomonCode code(/*num_data=*/48, /*num_parity=*/12);
+  const Shards shards(code, &random);
+  const int num_shards = code.num_data() + code.num_parity();
+  for (int burst_length : {1, 5, 12}) {
+    for (int start = 0; start + burst_length <= num_shards; ++start) {
+      std::vector<bool> lost(num_shards, false);
+      for (int i = start; i < start + burst_length; ++i) {
+        lost[i] = true;
+      }
+      EXPECT_TRUE(shards.DecodeAndCheck(lost))
+          << "burst of " << burst_length << " at " << start;
+    }
+  }
+}
+
+TEST(ReedSolomonCodeTest, RecoversFromRandomLossesInMaximalCode) {
+  Random random(0x5678);
+  const ReedSolomonCode code(/*num_data=*/200, /*num_parity=*/56);
+  const Shards shards(code, &random);
+  const int num_shards = code.num_data() + code.num_parity();
+  for (int attempt = 0; attempt < 10; ++attempt) {
+    std::vector<bool> lost(num_shards, false);
+    for (int i = 0; i < code.num_parity(); ++i) {
+      lost[random.Rand(0, num_shards - 1)] = true;
+    }
+    EXPECT_TRUE(shards.DecodeAndCheck(lost));
+  }
+}
+
+TEST(ReedSolomonCodeTest, WithoutParityIsCopy) {
+  Random random(0x8765);
+  const ReedSolomonCode code(/*num_data=*/4, /*num_parity=*/0);
+  const Shards shards(code, &random);
+  EXPECT_TRUE(shards.DecodeAndCheck({false, false, false, false}));
+  EXPECT_FALSE(shards.DecodeAndCheck({false, true, false, false}));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,274 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_receiver.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Packets older than this, in media sequence numbers, are forgotten. Leaves
+// room for a full group and its FEC packets to be reordered.
+constexpr int64_t kMaxPacketAge =
+    4 * static_cast<int64_t>(ReedSolomonFecSender::kMaxMediaPackets);
+
+// How often to log the recovered packets to the text log.
+constexpr TimeDelta kPacketLogInterval = TimeDelta::Seconds(10);
+
+}  // namespace
+
+ReedSolomonFecReceiver::ReedSolomonFecReceiver(
+    Clock* clock,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    RecoveredPacketReceiver* recovered_packet_receiver)
+    : ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      recovered_packet_receiver_(recovered_packet_receiver),
+      clock_(clock) {
+  // It's OK to create this object on a different thread/task queue than
+  // the one used during main operation.
+  sequence_checker_.Detach();
+}
+
+ReedSolomonFecReceiver::~ReedSolomonFecReceiver() = default;
+
+void ReedSolomonFecReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+
+  // Recovered packets come from this object, possibly through the callback,
+  // and are already stored.
+  if (packet.recovered()) {
+    return;
+  }
+  if (packet.Ssrc() == ssrc_) {
+    AddFecPacket(packet);
+  } else if (packet.Ssrc() == protected_media_ssrc_) {
+    AddMediaPacket(packet);
+  } else {
+    return;
+  }
+  if (packet_counter_.first_packet_time.IsInfinite()) {
+    packet_counter_.first_packet_time = clock_->CurrentTime();
+  }
+  ++packet_counter_.num_packets;
+  packet_counter_.num_bytes += packet.size();
+  RemoveOldPackets();
+}
+
+FecPacketCounter ReedSolomonFecReceiver::GetPacketCounter() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return packet_counter_;
+}
+
+void ReedSolomonFecReceiver::AddMediaPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const int64_t seq_num = seq_num_unwrapper_.Unwrap(packet.SequenceNumber());
+  newest_seq_num_ = std::max(newest_seq_num_, seq_num);
+  if (media_packets_.find(seq_num) != media_packets_.end()) {
+    return;
+  }
+
+  // The sender protects the packets before the mutable extensions are
+  // written.
+  RtpPacketReceived packet_copy(packet);
+  packet_copy.ZeroMutableExtensions();
+  media_packets_.emplace(seq_num, packet_copy.Buffer());
+  extensions_ = packet.extension_manager();
+
+  // Find the group this packet belongs to, if its FEC is already received.
+  auto it = fec_groups_.upper_bound(seq_num);
+  if (it == fec_groups_.begin()) {
+    return;
+  }
+  --it;
+  if (seq_num < it->first + it->second.num_media_packets) {
+    TryRecover(it->first, it->second);
+  }
+}
+
+void ReedSolomonFecReceiver::AddFecPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  ReedSolomonFecHeader header;
+  if (!header.Parse(packet.payload()) ||
+      header.protected_ssrc != protected_media_ssrc_ ||
+      packet.payload_size() <= ReedSolomonFecHeader::kSize +
+                                   ReedSolomonFecHeader::kShardLengthSize) {
+    RTC_LOG(LS_WARNING) << "Malformed Reed-Solomon FEC packet, discarding.";
+    return;
+  }
+  ++packet_counter_.num_fec_packets;
+
+  const int64_t base_seq_num = seq_num_unwrapper_.Unwrap(header.base_seq_num);
+  newest_seq_num_ = std::max(newest_seq_num_,
+                             base_seq_num + header.num_media_packets - 1);
+  const size_t shard_size = packet.payload_size() - ReedSolomonFecHeader::kSize;
+  FecGroup& group = fec_groups_[base_seq_num];
+  if (group.parity.empty()) {
+    group.num_media_packets = header.num_media_packets;
+    group.shard_size = shard_size;
+    group.parity.resize(header.num_parity_packets);
+  } else if (group.num_media_packets != header.num_media_packets ||
+             group.parity.size() != header.num_parity_packets ||
+             group.shard_size != shard_size) {
+    RTC_LOG(LS_WARNING) << "Reed-Solomon FEC packet does not match the other "
+                           "packets of its group, discarding.";
+    return;
+  }
+  if (group.complete || group.parity[header.parity_index].size() > 0) {
+    return;
+  }
+  group.parity[header.parity_index] = packet.Buffer().Slice(
+      packet.headers_size() + ReedSolomonFecHeader::kSize, shard_size);
+  TryRecover(base_seq_num, group);
+}
+
+void ReedSolomonFecReceiver::TryRecover(int64_t base_seq_num,
+                                        FecGroup& group) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (group.complete) {
+    return;
+  }
+  const int num_media_packets = group.num_media_packets;
+  const int num_parity_packets = group.parity.size();
+  const size_t shard_size = group.shard_size;
+
+  int num_missing = 0;
+  for (int i = 0; i < num_media_packets; ++i) {
+    num_missing += media_packets_.count(base_seq_num + i) == 0 ? 1 : 0;
+  }
+  if (num_missing == 0) {
+    group.complete = true;
+    return;
+  }
+  int num_parity_received = 0;
+  for (const rtc::CopyOnWriteBuffer& parity : group.parity) {
+    num_parity_received += parity.size() == 0 ? 0 : 1;
+  }
+  if (num_parity_received < num_missing) {
+    return;
+  }
+
+  std::vector<const uint8_t*> shards(num_media_packets + num_parity_packets,
+                                     nullptr);
+  for (int r = 0; r < num_parity_packets; ++r) {
+    if (group.parity[r].size() > 0) {
+      shards[num_media_packets + r] = group.parity[r].cdata();
+    }
+  }
+  std::vector<uint8_t> media_shards(num_media_packets * shard_size, 0);
+  for (int i = 0; i < num_media_packets; ++i) {
+    auto it = media_packets_.find(base_seq_num + i);
+    if (it == media_packets_.end()) {
+      continue;
+    }
+    if (it->second.size() + ReedSolomonFecHeader::kShardLengthSize >
+        shard_size) {
+      // Not the packet that was protected.
+      return;
+    }
+    uint8_t* shard = &media_shards[i * shard_size];
+    ByteWriter<uint16_t>::WriteBigEndian(shard, it->second.size());
+    memcpy(shard + ReedSolomonFecHeader::kShardLengthSize, it->second.cdata(),
+           it->second.size());
+    shards[i] = shard;
+  }
+
+  std::vector<uint8_t> recovered_shards(num_media_packets * shard_size);
+  std::vector<uint8_t*> recovered(num_media_packets, nullptr);
+  for (int i = 0; i < num_media_packets; ++i) {
+    if (shards[i] == nullptr) {
+      recovered[i] = &recovered_shards[i * shard_size];
+    }
+  }
+  RTC_CHECK(ReedSolomonCode(num_media_packets, num_parity_packets)
+                .Decode(shards, shard_size, recovered));
+  group.complete = true;
+
+  // Store all recovered packets before returning any of them, as the callback
+  // may end up here again.
+  std::vector<RtpPacketReceived> recovered_packets;
+  for (int i = 0; i < num_media_packets; ++i) {
+    if (recovered[i] == nullptr) {
+      continue;
+    }
+    const size_t size = ByteReader<uint16_t>::ReadBigEndian(recovered[i]);
+    if (size < kRtpHeaderSize ||
+        size + ReedSolomonFecHeader::kShardLengthSize > shard_size) {
+      RTC_LOG(LS_WARNING) << "Invalid packet recovered by Reed-Solomon FEC.";
+      continue;
+    }
+    rtc::CopyOnWriteBuffer data(
+        recovered[i] + ReedSolomonFecHeader::kShardLengthSize, size);
+    RtpPacketReceived parsed_packet(&extensions_);
+    if (!parsed_packet.Parse(data) ||
+        parsed_packet.Ssrc() != protected_media_ssrc_ ||
+        seq_num_unwrapper_.PeekUnwrap(parsed_packet.SequenceNumber()) !=
+            base_seq_num + i) {
+      RTC_LOG(LS_WARNING) << "Invalid packet recovered by Reed-Solomon FEC.";
+      continue;
+    }
+    media_packets_.emplace(base_seq_num + i, std::move(data));
+    parsed_packet.set_recovered(true);
+    parsed_packet.set_payload_type_frequency(kVideoPayloadTypeFrequency);
+    recovered_packets.push_back(std::move(parsed_packet));
+  }
+
+  for (const RtpPacketReceived& packet : recovered_packets) {
+    ++packet_counter_.num_recovered_packets;
+    recovered_packet_receiver_->OnRecoveredPacket(packet);
+
+    // Periodically log the recovered packets at LS_INFO.
+    Timestamp now = clock_->CurrentTime();
+    bool should_log_periodically =
+        now - last_recovered_packet_ > kPacketLogInterval;
+    if (RTC_LOG_CHECK_LEVEL(LS_VERBOSE) || should_log_periodically) {
+      rtc::LoggingSeverity level =
+          should_log_periodically ? rtc::LS_INFO : rtc::LS_VERBOSE;
+      RTC_LOG_V(level) << "Recovered media packet with SSRC: " << packet.Ssrc()
+                       << " seq " << packet.SequenceNumber()
+                       << " from Reed-Solomon FEC stream with SSRC: " << ssrc_;
+      if (should_log_periodically) {
+        last_recovered_packet_ = now;
+      }
+    }
+  }
+}
+
+void ReedSolomonFecReceiver::RemoveOldPackets() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const int64_t oldest_seq_num = newest_seq_num_ - kMaxPacketAge;
+  media_packets_.erase(media_packets_.begin(),
+                       media_packets_.lower_bound(oldest_seq_num));
+  while (!fec_groups_.empty()) {
+    auto it = fec_groups_.begin();
+    if (it->first + it->second.num_media_packets > oldest_seq_num) {
+      break;
+    }
+    fec_groups_.erase(it);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_RECEIVER_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_RECEIVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "api/sequence_checker.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/include/recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/ulpfec_receiver.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Receiving end of ReedSolomonFecSender. Keeps the recently received media
+// packets, and as soon as any `media count` packets of a group have been
+// received, recovers the missing media packets of that group and returns them
+// through the callback.
+class ReedSolomonFecReceiver {
+ public:
+  ReedSolomonFecReceiver(Clock* clock,
+                         uint32_t ssrc,
+                         uint32_t protected_media_ssrc,
+                         RecoveredPacketReceiver* recovered_packet_receiver);
+  ~ReedSolomonFecReceiver();
+
+  // Inserts a received packet, which can be either media or FEC. All newly
+  // recovered packets are sent back through the callback.
+  void OnRtpPacket(const RtpPacketReceived& packet);
+
+  // Returns a counter describing the added and recovered packets.
+  FecPacketCounter GetPacketCounter() const;
+
+ private:
+  struct FecGroup {
+    int num_media_packets = 0;
+    size_t shard_size = 0;
+    // Parity shards, indexed by parity index. Empty if not received.
+    std::vector<rtc::CopyOnWriteBuffer> parity;
+    // Set once all media packets are received or recovered.
+    bool complete = false;
+  };
+
+  void AddMediaPacket(const RtpPacketReceived& packet);
+  void AddFecPacket(const RtpPacketReceived& packet);
+  // Recovers the missing media packets of the group starting at
+  // `base_seq_num`, if enough of its packets are received.
+  void TryRecover(int64_t base_seq_num, FecGroup& group);
+  // Forgets the packets too old to be of use.
+  void RemoveOldPackets();
+
+  // Config.
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  RecoveredPacketReceiver* const recovered_packet_receiver_;
+
+  // Logging and stats.
+  Clock* const clock_;
+  Timestamp last_recovered_packet_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::MinusInfinity();
+  FecPacketCounter packet_counter_ RTC_GUARDED_BY(sequence_checker_);
+
+  // Media sequence numbers, unwrapped.
+  RtpSequenceNumberUnwrapper seq_num_unwrapper_
+      RTC_GUARDED_BY(sequence_checker_);
+  int64_t newest_seq_num_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  // Received and recovered media packets, with mutable extensions zeroed as
+  // when they were protected.
+  std::map<int64_t, rtc::CopyOnWriteBuffer> media_packets_
+      RTC_GUARDED_BY(sequence_checker_);
+  // FEC groups, by base sequence number.
+  std::map<int64_t, FecGroup> fec_groups_ RTC_GUARDED_BY(sequence_checker_);
+  // Extensions of the protected stream, to parse recovered packets.
+  RtpHeaderExtensionMap extensions_ RTC_GUARDED_BY(sequence_checker_);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_RECEIVER_H_
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_receiver.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "modules/rtp_rtcp/mocks/mock_recovered_packet_receiver.h"
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::Property;
+
+constexpr int kFecPayloadType = 123;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFecSsrc = 5678;
+const char kNoMid[] = "";
+const std::vector<RtpExtension> kNoRtpHeaderExtensions;
+const std::vector<RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+
+RtpPacketReceived ToReceived(const RtpPacketToSend& packet) {
+  RtpPacketReceived received;
+  EXPECT_TRUE(received.Parse(packet.Buffer()));
+  return received;
+}
+
+class ReedSolomonFecReceiverTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecReceiverTest()
+      : clock_(1),
+        sender_(kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                kNoMid,
+                kNoRtpHeaderExtensions,
+                kNoRtpHeaderExtensionSizes,
+                /*rtp_state=*/nullptr,
+                &clock_),
+        receiver_(&clock_, kFecSsrc, kMediaSsrc, &recovered_packet_receiver_) {
+  }
+
+  // Sends a frame of `num_packets` media packets of different sizes, starting
+  // at `seq_num`, protected with `fec_rate`. Returns the media packets, then
+  // the FEC packets.
+  std::vector<RtpPacketReceived> SendFrame(uint16_t seq_num,
+                                           int num_packets,
+                                           int fec_rate) {
+    FecProtectionParams params;
+    params.fec_rate = fec_rate;
+    params.max_fec_frames = 1;
+    sender_.SetProtectionParameters(params, params);
+
+    std::vector<RtpPacketReceived> packets;
+    std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets;
+    for (int i = 0; i < num_packets; ++i) {
+      RtpPacketToSend packet(nullptr);
+      packet.SetPayloadType(96);
+      packet.SetSsrc(kMediaSsrc);
+      packet.SetSequenceNumber(seq_num + i);
+      packet.SetMarker(i == num_packets - 1);
+      const size_t payload_size = 200 + 37 * i;
+      uint8_t* payload = packet.AllocatePayload(payload_size);
+      for (size_t j = 0; j < payload_size; ++j) {
+        payload[j] = i * 7 + j;
+      }
+      sender_.AddPacketAndGenerateFec(packet);
+      packets.push_back(ToReceived(packet));
+      for (auto& fec_packet : sender_.GetFecPackets()) {
+        fec_packets.push_back(std::move(fec_packet));
+      }
+    }
+    for (const auto& fec_packet : fec_packets) {
+      packets.push_back(ToReceived(*fec_packet));
+    }
+    return packets;
+  }
+
+  SimulatedClock clock_;
+  ReedSolomonFecSender sender_;
+  ::testing::StrictMock<MockRecoveredPacketReceiver>
+      recovered_packet_receiver_;
+  ReedSolomonFecReceiver receiver_;
+};
+
+TEST_F(ReedSolomonFecReceiverTest, ReceivesWithoutLossWithoutRecovering) {
+  for (const RtpPacketReceived& packet :
+       SendFrame(/*seq_num=*/100, /*num_packets=*/10, /*fec_rate=*/64)) {
+    receiver_.OnRtpPacket(packet);
+  }
+  FecPacketCounter counter = receiver_.GetPacketCounter();
+  EXPECT_EQ(counter.num_packets, 13u);
+  EXPECT_EQ(counter.num_fec_packets, 3u);
+  EXPECT_EQ(counter.num_recovered_packets, 0u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversBurstAsLongAsNumberOfFecPackets) {
+  constexpr int kNumMediaPackets = 20;
+  // 25% overhead, i.e. 5 FEC packets.
+  std::vector<RtpPacketReceived> packets =
+      SendFrame(/*seq_num=*/100, kNumMediaPackets, /*fec_rate=*/64);
+  ASSERT_EQ(packets.size(), 25u);
+
+  constexpr int kFirstLost = 6;
+  constexpr int kNumLost = 5;
+  for (int i = kFirstLost; i < kFirstLost + kNumLost; ++i) {
+    EXPECT_CALL(recovered_packet_receiver_,
+                OnRecoveredPacket(Property(&RtpPacketReceived::Buffer,
+                                           Eq(packets[i].Buffer()))));
+  }
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (i < kFirstLost || i >= kFirstLost + kNumLost) {
+      receiver_.OnRtpPacket(packets[i]);
+    }
+  }
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 5u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, DoesNotRecoverBurstLongerThanFec) {
+  std::vector<RtpPacketReceived> packets =
+      SendFrame(/*seq_num=*/100, /*num_packets=*/20, /*fec_rate=*/64);
+  // Lose 5 media and 1 FEC packet.
+  for (size_t i = 0; i < packets.size() - 1; ++i) {
+    if (i < 6 || i >= 11) {
+      receiver_.OnRtpPacket(packets[i]);
+    }
+  }
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 0u);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversWhenFecArrivesBeforeMedia) {
+  std::vector<RtpPacketReceived> packets =
+      SendFrame(/*seq_num=*/100, /*num_packets=*/4, /*fec_rate=*/128);
+  ASSERT_EQ(packets.size(), 6u);
+  receiver_.OnRtpPacket(packets[4]);
+  receiver_.OnRtpPacket(packets[5]);
+  receiver_.OnRtpPacket(packets[0]);
+  EXPECT_CALL(recovered_packet_receiver_,
+              OnRecoveredPacket(Property(&RtpPacketReceived::Buffer,
+                                         Eq(packets[2].Buffer()))));
+  EXPECT_CALL(recovered_packet_receiver_,
+              OnRecoveredPacket(Property(&RtpPacketReceived::Buffer,
+                                         Eq(packets[3].Buffer()))));
+  receiver_.OnRtpPacket(packets[1]);
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoversAcrossSequenceNumberWrap) {
+  std::vector<RtpPacketReceived> packets =
+      SendFrame(/*seq_num=*/0xfffd, /*num_packets=*/6, /*fec_rate=*/128);
+  ASSERT_EQ(packets.size(), 9u);
+  EXPECT_CALL(recovered_packet_receiver_,
+              OnRecoveredPacket(Property(&RtpPacketReceived::SequenceNumber,
+                                         Eq(0xffff))));
+  EXPECT_CALL(recovered_packet_receiver_,
+              OnRecoveredPacket(Property(&RtpPacketReceived::SequenceNumber,
+                                         Eq(0))));
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (i != 2 && i != 3) {
+      receiver_.OnRtpPacket(packets[i]);
+    }
+  }
+}
+
+TEST_F(ReedSolomonFecReceiverTest, RecoveredPacketsAreMarkedAndNotReinserted) {
+  std::vector<RtpPacketReceived> packets =
+      SendFrame(/*seq_num=*/100, /*num_packets=*/2, /*fec_rate=*/128);
+  ASSERT_EQ(packets.size(), 3u);
+  EXPECT_CALL(recovered_packet_receiver_, OnRecoveredPacket)
+      .WillOnce([&](const RtpPacketReceived& packet) {
+        EXPECT_TRUE(packet.recovered());
+        // Fed back, like the receive stream does with recovered packets.
+        receiver_.OnRtpPacket(packet);
+      });
+  receiver_.OnRtpPacket(packets[0]);
+  receiver_.OnRtpPacket(packets[2]);
+  // Receiving the lost packet late does not recover anything again.
+  receiver_.OnRtpPacket(packets[1]);
+  EXPECT_EQ(receiver_.GetPacketCounter().num_recovered_packets, 1u);
+}
+
+}  // namespace
+}  // namespace webrtc
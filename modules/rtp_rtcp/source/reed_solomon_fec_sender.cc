@@ -0,0 +1,314 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/forward_error_correction.h"
+#include "modules/rtp_rtcp/source/reed_solomon_code.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Let first sequence number be in the first half of the interval.
+constexpr uint16_t kMaxInitRtpSeqNumber = 0x7fff;
+
+// Same clock as the protected video stream, as for FlexFEC.
+constexpr int kMsToRtpTimestamp = kVideoPayloadTypeFrequency / 1000;
+
+// How often to log the generated FEC packets to the text log.
+constexpr TimeDelta kPacketLogInterval = TimeDelta::Seconds(10);
+
+// Maximum excess overhead (actual - target), in Q8, for which a group is
+// protected at the end of a frame before `max_fec_frames` frames have been
+// added to it. Same as for ULPFEC and FlexFEC.
+constexpr int kMaxExcessOverhead = 50;
+
+RtpHeaderExtensionMap RegisterSupportedExtensions(
+    const std::vector<RtpExtension>& rtp_header_extensions) {
+  RtpHeaderExtensionMap map;
+  for (const auto& extension : rtp_header_extensions) {
+    if (extension.uri == TransportSequenceNumber::Uri()) {
+      map.Register<TransportSequenceNumber>(extension.id);
+    } else if (extension.uri == AbsoluteSendTime::Uri()) {
+      map.Register<AbsoluteSendTime>(extension.id);
+    } else if (extension.uri == TransmissionOffset::Uri()) {
+      map.Register<TransmissionOffset>(extension.id);
+    } else if (extension.uri == RtpMid::Uri()) {
+      map.Register<RtpMid>(extension.id);
+    } else {
+      RTC_LOG(LS_INFO)
+          << "ReedSolomonFecSender only supports RTP header extensions for "
+             "BWE and MID, so the extension "
+          << extension.ToString() << " will not be used.";
+    }
+  }
+  return map;
+}
+
+}  // namespace
+
+bool ReedSolomonFecHeader::Parse(rtc::ArrayView<const uint8_t> payload) {
+  if (payload.size() < kSize) {
+    return false;
+  }
+  protected_ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[0]);
+  base_seq_num = ByteReader<uint16_t>::ReadBigEndian(&payload[4]);
+  num_media_packets = payload[6];
+  num_parity_packets = payload[7];
+  parity_index = payload[8];
+  return num_media_packets > 0 && parity_index < num_parity_packets &&
+         num_media_packets + num_parity_packets <= ReedSolomonCode::kMaxShards;
+}
+
+void ReedSolomonFecHeader::Write(uint8_t* buffer) const {
+  ByteWriter<uint32_t>::WriteBigEndian(&buffer[0], protected_ssrc);
+  ByteWriter<uint16_t>::WriteBigEndian(&buffer[4], base_seq_num);
+  buffer[6] = num_media_packets;
+  buffer[7] = num_parity_packets;
+  buffer[8] = parity_index;
+  buffer[9] = 0;
+}
+
+ReedSolomonFecSender::ReedSolomonFecSender(
+    int payload_type,
+    uint32_t ssrc,
+    uint32_t protected_media_ssrc,
+    absl::string_view mid,
+    const std::vector<RtpExtension>& rtp_header_extensions,
+    rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+    const RtpState* rtp_state,
+    Clock* clock)
+    : clock_(clock),
+      random_(clock_->TimeInMicroseconds()),
+      payload_type_(payload_type),
+      // Reset RTP state if this is not the first time we are operating.
+      // Otherwise, randomize the initial timestamp offset and RTP sequence
+      // numbers. (This is not intended to be cryptographically strong.)
+      timestamp_offset_(rtp_state ? rtp_state->start_timestamp
+                                  : random_.Rand<uint32_t>()),
+      ssrc_(ssrc),
+      protected_media_ssrc_(protected_media_ssrc),
+      mid_(mid),
+      seq_num_(rtp_state ? rtp_state->sequence_number
+                         : random_.Rand(1, kMaxInitRtpSeqNumber)),
+      rtp_header_extension_map_(
+          RegisterSupportedExtensions(rtp_header_extensions)),
+      header_extensions_size_(
+          RtpHeaderExtensionSize(extension_sizes, rtp_header_extension_map_)),
+      fec_bitrate_(/*max_window_size=*/TimeDelta::Seconds(1)) {
+  RTC_DCHECK_GE(payload_type, 0);
+  RTC_DCHECK_LE(payload_type, 127);
+}
+
+ReedSolomonFecSender::~ReedSolomonFecSender() = default;
+
+void ReedSolomonFecSender::SetProtectionParameters(
+    const FecProtectionParams& delta_params,
+    const FecProtectionParams& key_params) {
+  RTC_DCHECK_GE(delta_params.fec_rate, 0);
+  RTC_DCHECK_LE(delta_params.fec_rate, 255);
+  RTC_DCHECK_GE(key_params.fec_rate, 0);
+  RTC_DCHECK_LE(key_params.fec_rate, 255);
+  // Applied from the next media packet on.
+  MutexLock lock(&mutex_);
+  pending_params_.emplace(Params{delta_params, key_params});
+}
+
+void ReedSolomonFecSender::AddPacketAndGenerateFec(
+    const RtpPacketToSend& packet) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  RTC_DCHECK_EQ(packet.Ssrc(), protected_media_ssrc_);
+  {
+    MutexLock lock(&mutex_);
+    if (pending_params_) {
+      current_params_ = *pending_params_;
+      pending_params_.reset();
+    }
+  }
+
+  // A group covers consecutive sequence numbers, so protect what we have if
+  // there is a gap.
+  if (!media_packets_.empty() &&
+      packet.SequenceNumber() !=
+          static_cast<uint16_t>(base_seq_num_ + media_packets_.size())) {
+    EncodeGroup();
+  }
+  if (media_packets_.empty()) {
+    base_seq_num_ = packet.SequenceNumber();
+  }
+  if (packet.is_key_frame()) {
+    media_contains_keyframe_ = true;
+  }
+  media_packets_.push_back(packet.Buffer());
+  const bool complete_frame = packet.Marker();
+  if (complete_frame) {
+    ++num_protected_frames_;
+  }
+
+  if (media_packets_.size() == kMaxMediaPackets ||
+      (complete_frame &&
+       (num_protected_frames_ >= CurrentParams().max_fec_frames ||
+        Overhead() - CurrentParams().fec_rate < kMaxExcessOverhead))) {
+    EncodeGroup();
+  }
+}
+
+const FecProtectionParams& ReedSolomonFecSender::CurrentParams() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  return media_contains_keyframe_ ? current_params_.keyframe_params
+                                  : current_params_.delta_params;
+}
+
+int ReedSolomonFecSender::Overhead() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  RTC_DCHECK(!media_packets_.empty());
+  const int num_media_packets = media_packets_.size();
+  const int num_fec_packets = ForwardErrorCorrection::NumFecPackets(
+      num_media_packets, CurrentParams().fec_rate);
+  return (num_fec_packets << 8) / num_media_packets;
+}
+
+void ReedSolomonFecSender::EncodeGroup() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  const int num_media_packets = media_packets_.size();
+  const int num_parity_packets = ForwardErrorCorrection::NumFecPackets(
+      num_media_packets, CurrentParams().fec_rate);
+
+  if (num_parity_packets > 0) {
+    size_t max_packet_size = 0;
+    for (const rtc::CopyOnWriteBuffer& packet : media_packets_) {
+      max_packet_size = std::max(max_packet_size, packet.size());
+    }
+    const size_t shard_size =
+        ReedSolomonFecHeader::kShardLengthSize + max_packet_size;
+
+    std::vector<uint8_t> media_shards(num_media_packets * shard_size, 0);
+    std::vector<const uint8_t*> data(num_media_packets);
+    for (int i = 0; i < num_media_packets; ++i) {
+      uint8_t* shard = &media_shards[i * shard_size];
+      ByteWriter<uint16_t>::WriteBigEndian(shard, media_packets_[i].size());
+      memcpy(shard + ReedSolomonFecHeader::kShardLengthSize,
+             media_packets_[i].cdata(), media_packets_[i].size());
+      data[i] = shard;
+    }
+
+    // Encode straight into the payloads of the FEC packets.
+    ReedSolomonFecHeader header;
+    header.protected_ssrc = protected_media_ssrc_;
+    header.base_seq_num = base_seq_num_;
+    header.num_media_packets = num_media_packets;
+    header.num_parity_packets = num_parity_packets;
+    std::vector<uint8_t*> parity(num_parity_packets);
+    for (int r = 0; r < num_parity_packets; ++r) {
+      std::unique_ptr<RtpPacketToSend> fec_packet = CreateFecPacket();
+      uint8_t* payload = fec_packet->AllocatePayload(
+          ReedSolomonFecHeader::kSize + shard_size);
+      header.parity_index = r;
+      header.Write(payload);
+      parity[r] = payload + ReedSolomonFecHeader::kSize;
+      generated_fec_packets_.push_back(std::move(fec_packet));
+    }
+    ReedSolomonCode(num_media_packets, num_parity_packets)
+        .Encode(data, parity, shard_size);
+  }
+
+  media_packets_.clear();
+  num_protected_frames_ = 0;
+  media_contains_keyframe_ = false;
+}
+
+std::unique_ptr<RtpPacketToSend> ReedSolomonFecSender::CreateFecPacket() {
+  auto fec_packet =
+      std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
+  fec_packet->set_packet_type(RtpPacketMediaType::kForwardErrorCorrection);
+  fec_packet->set_allow_retransmission(false);
+
+  // RTP header.
+  fec_packet->SetMarker(false);
+  fec_packet->SetPayloadType(payload_type_);
+  fec_packet->SetSequenceNumber(seq_num_++);
+  fec_packet->SetTimestamp(
+      timestamp_offset_ +
+      static_cast<uint32_t>(kMsToRtpTimestamp * clock_->TimeInMilliseconds()));
+  // Set "capture time" so that the TransmissionOffset header extension
+  // can be set by the RTPSender.
+  fec_packet->set_capture_time(clock_->CurrentTime());
+  fec_packet->SetSsrc(ssrc_);
+  // Reserve extensions, if registered. These will be set by the RTPSender.
+  fec_packet->ReserveExtension<AbsoluteSendTime>();
+  fec_packet->ReserveExtension<TransmissionOffset>();
+  fec_packet->ReserveExtension<TransportSequenceNumber>();
+  // Possibly include the MID header extension.
+  if (!mid_.empty()) {
+    // This is a no-op if the MID header extension is not registered.
+    fec_packet->SetExtension<RtpMid>(mid_);
+  }
+  return fec_packet;
+}
+
+std::vector<std::unique_ptr<RtpPacketToSend>>
+ReedSolomonFecSender::GetFecPackets() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets_to_send;
+  fec_packets_to_send.swap(generated_fec_packets_);
+
+  size_t total_fec_data_bytes = 0;
+  for (const auto& fec_packet : fec_packets_to_send) {
+    total_fec_data_bytes += fec_packet->size();
+  }
+
+  Timestamp now = clock_->CurrentTime();
+  if (!fec_packets_to_send.empty() &&
+      now - last_generated_packet_ > kPacketLogInterval) {
+    RTC_LOG(LS_VERBOSE) << "Generated " << fec_packets_to_send.size()
+                        << " Reed-Solomon FEC packets with payload type: "
+                        << payload_type_ << " and SSRC: " << ssrc_ << ".";
+    last_generated_packet_ = now;
+  }
+
+  MutexLock lock(&mutex_);
+  fec_bitrate_.Update(total_fec_data_bytes, now);
+
+  return fec_packets_to_send;
+}
+
+size_t ReedSolomonFecSender::MaxPacketOverhead() const {
+  return kRtpHeaderSize + header_extensions_size_ +
+         ReedSolomonFecHeader::kSize + ReedSolomonFecHeader::kShardLengthSize;
+}
+
+DataRate ReedSolomonFecSender::CurrentFecRate() const {
+  MutexLock lock(&mutex_);
+  return fec_bitrate_.Rate(clock_->CurrentTime()).value_or(DataRate::Zero());
+}
+
+absl::optional<RtpState> ReedSolomonFecSender::GetRtpState() {
+  RtpState rtp_state;
+  rtp_state.sequence_number = seq_num_;
+  rtp_state.start_timestamp = timestamp_offset_;
+  return rtp_state;
+}
+
+}  // namespace webrtc
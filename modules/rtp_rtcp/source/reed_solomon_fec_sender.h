@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_SENDER_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_SENDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/rtp_parameters.h"
+#include "api/units/timestamp.h"
+#include "modules/include/module_fec_types.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_header_extension_size.h"
+#include "modules/rtp_rtcp/source/video_fec_generator.h"
+#include "rtc_base/bitrate_tracker.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/race_checker.h"
+#include "rtc_base/random.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+
+class Clock;
+class RtpPacketToSend;
+
+// Header at the start of the payload of a Reed-Solomon FEC packet.
+//
+//  0                   1                   2                   3
+//  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// |                     protected media SSRC                      |
+// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// |   base media sequence number  |  media count  |  parity count |
+// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+// |  parity index |   reserved    |         parity shard ...
+// +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//
+// A group protects `media count` media packets with consecutive sequence
+// numbers, starting at `base media sequence number`, with `parity count` FEC
+// packets. Each media packet is turned into a shard holding its 16-bit
+// big-endian size followed by the whole RTP packet, zero padded to the size
+// of the largest shard of the group. The rest of the FEC packet is parity
+// shard `parity index` of ReedSolomonCode over those shards.
+struct ReedSolomonFecHeader {
+  static constexpr size_t kSize = 10;
+  // Size of the length field at the start of each media shard.
+  static constexpr size_t kShardLengthSize = 2;
+
+  // Returns false if `payload` does not start with a valid header.
+  bool Parse(rtc::ArrayView<const uint8_t> payload);
+  // Writes the `kSize` bytes of the header to `buffer`.
+  void Write(uint8_t* buffer) const;
+
+  uint32_t protected_ssrc = 0;
+  uint16_t base_seq_num = 0;
+  uint8_t num_media_packets = 0;
+  uint8_t num_parity_packets = 0;
+  uint8_t parity_index = 0;
+};
+
+// Generates Reed-Solomon FEC packets on a separate SSRC, in the same way as
+// FlexfecSender. Unlike the XOR based FlexFEC and ULPFEC, any `parity count`
+// lost packets of a group can be recovered, which makes it suitable for
+// channels with bursty losses.
+//
+// Note that this class is not thread safe, and thus requires external
+// synchronization.
+class ReedSolomonFecSender : public VideoFecGenerator {
+ public:
+  // Maximum number of media packets in a group. Bounds the delay before the
+  // FEC packets are sent and the amount of media the receiver must keep.
+  static constexpr size_t kMaxMediaPackets = 48;
+
+  ReedSolomonFecSender(int payload_type,
+                       uint32_t ssrc,
+                       uint32_t protected_media_ssrc,
+                       absl::string_view mid,
+                       const std::vector<RtpExtension>& rtp_header_extensions,
+                       rtc::ArrayView<const RtpExtensionSize> extension_sizes,
+                       const RtpState* rtp_state,
+                       Clock* clock);
+  ~ReedSolomonFecSender() override;
+
+  FecType GetFecType() const override {
+    return VideoFecGenerator::FecType::kReedSolomon;
+  }
+  absl::optional<uint32_t> FecSsrc() override { return ssrc_; }
+
+  // The FEC rate is the number of parity packets relative to the number of
+  // media packets in a group, in Q8. The mask type is ignored.
+  void SetProtectionParameters(const FecProtectionParams& delta_params,
+                               const FecProtectionParams& key_params) override;
+
+  void AddPacketAndGenerateFec(const RtpPacketToSend& packet) override;
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> GetFecPackets() override;
+
+  // The FEC packet carries a whole media packet, including its RTP header,
+  // under its own RTP header and the Reed-Solomon FEC header.
+  size_t MaxPacketOverhead() const override;
+
+  DataRate CurrentFecRate() const override;
+
+  absl::optional<RtpState> GetRtpState() override;
+
+ private:
+  struct Params {
+    FecProtectionParams delta_params;
+    FecProtectionParams keyframe_params;
+  };
+
+  const FecProtectionParams& CurrentParams() const;
+  // Actual overhead of the current group if it was protected now, in Q8.
+  int Overhead() const;
+  // Generates the FEC packets for the current group and starts a new one.
+  void EncodeGroup();
+  std::unique_ptr<RtpPacketToSend> CreateFecPacket();
+
+  // Utility.
+  Clock* const clock_;
+  Random random_;
+  Timestamp last_generated_packet_ = Timestamp::MinusInfinity();
+
+  // Config.
+  const int payload_type_;
+  const uint32_t timestamp_offset_;
+  const uint32_t ssrc_;
+  const uint32_t protected_media_ssrc_;
+  // MID value to send in the MID header extension.
+  const std::string mid_;
+  // Sequence number of next packet to generate.
+  uint16_t seq_num_;
+  const RtpHeaderExtensionMap rtp_header_extension_map_;
+  const size_t header_extensions_size_;
+
+  rtc::RaceChecker race_checker_;
+  Params current_params_ RTC_GUARDED_BY(race_checker_);
+  // Media packets of the current group.
+  std::vector<rtc::CopyOnWriteBuffer> media_packets_
+      RTC_GUARDED_BY(race_checker_);
+  uint16_t base_seq_num_ RTC_GUARDED_BY(race_checker_) = 0;
+  int num_protected_frames_ RTC_GUARDED_BY(race_checker_) = 0;
+  bool media_contains_keyframe_ RTC_GUARDED_BY(race_checker_) = false;
+  std::vector<std::unique_ptr<RtpPacketToSend>> generated_fec_packets_
+      RTC_GUARDED_BY(race_checker_);
+
+  mutable Mutex mutex_;
+  absl::optional<Params> pending_params_ RTC_GUARDED_BY(mutex_);
+  BitrateTracker fec_bitrate_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_FEC_SENDER_H_
@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_fec_sender.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kFecPayloadType = 123;
+constexpr uint32_t kMediaSsrc = 1234;
+constexpr uint32_t kFecSsrc = 5678;
+const char kNoMid[] = "";
+const std::vector<RtpExtension> kNoRtpHeaderExtensions;
+const std::vector<RtpExtensionSize> kNoRtpHeaderExtensionSizes;
+constexpr int64_t kInitialSimulatedClockTime = 1;
+
+RtpPacketToSend MediaPacket(uint16_t seq_num,
+                            bool marker,
+                            size_t payload_size) {
+  RtpPacketToSend packet(nullptr);
+  packet.SetPayloadType(96);
+  packet.SetSsrc(kMediaSsrc);
+  packet.SetSequenceNumber(seq_num);
+  packet.SetMarker(marker);
+  uint8_t* payload = packet.AllocatePayload(payload_size);
+  for (size_t i = 0; i < payload_size; ++i) {
+    payload[i] = seq_num + i;
+  }
+  return packet;
+}
+
+class ReedSolomonFecSenderTest : public ::testing::Test {
+ protected:
+  ReedSolomonFecSenderTest()
+      : clock_(kInitialSimulatedClockTime),
+        sender_(kFecPayloadType,
+                kFecSsrc,
+                kMediaSsrc,
+                kNoMid,
+                kNoRtpHeaderExtensions,
+                kNoRtpHeaderExtensionSizes,
+                /*rtp_state=*/nullptr,
+                &clock_) {}
+
+  void SetFecRate(int fec_rate, int max_fec_frames) {
+    FecProtectionParams params;
+    params.fec_rate = fec_rate;
+    params.max_fec_frames = max_fec_frames;
+    sender_.SetProtectionParameters(params, params);
+  }
+
+  SimulatedClock clock_;
+  ReedSolomonFecSender sender_;
+};
+
+TEST_F(ReedSolomonFecSenderTest, Ssrc) {
+  EXPECT_EQ(sender_.FecSsrc(), kFecSsrc);
+  EXPECT_EQ(sender_.GetFecType(), VideoFecGenerator::FecType::kReedSolomon);
+}
+
+TEST_F(ReedSolomonFecSenderTest, ProtectsFrameWithRequestedNumberOfPackets) {
+  // 50% overhead.
+  SetFecRate(/*fec_rate=*/128, /*max_fec_frames=*/1);
+  constexpr uint16_t kBaseSeqNum = 1000;
+  constexpr int kNumPackets = 8;
+  for (int i = 0; i < kNumPackets; ++i) {
+    sender_.AddPacketAndGenerateFec(MediaPacket(
+        kBaseSeqNum + i, /*marker=*/i == kNumPackets - 1, 100 + i));
+    if (i < kNumPackets - 1) {
+      EXPECT_TRUE(sender_.GetFecPackets().empty());
+    }
+  }
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender_.GetFecPackets();
+  ASSERT_EQ(fec_packets.size(), 4u);
+  for (size_t r = 0; r < fec_packets.size(); ++r) {
+    const RtpPacketToSend& fec_packet = *fec_packets[r];
+    EXPECT_EQ(fec_packet.Ssrc(), kFecSsrc);
+    EXPECT_EQ(fec_packet.PayloadType(), kFecPayloadType);
+    EXPECT_FALSE(fec_packet.Marker());
+    EXPECT_EQ(fec_packet.SequenceNumber(),
+              static_cast<uint16_t>(fec_packets[0]->SequenceNumber() + r));
+    EXPECT_EQ(fec_packet.packet_type(),
+              RtpPacketMediaType::kForwardErrorCorrection);
+
+    ReedSolomonFecHeader header;
+    ASSERT_TRUE(header.Parse(fec_packet.payload()));
+    EXPECT_EQ(header.protected_ssrc, kMediaSsrc);
+    EXPECT_EQ(header.base_seq_num, kBaseSeqNum);
+    EXPECT_EQ(header.num_media_packets, kNumPackets);
+    EXPECT_EQ(header.num_parity_packets, 4);
+    EXPECT_EQ(header.parity_index, r);
+    // The largest media packet, with its length.
+    EXPECT_EQ(fec_packet.payload_size(),
+              ReedSolomonFecHeader::kSize +
+                  ReedSolomonFecHeader::kShardLengthSize + kRtpHeaderSize +
+                  100 + kNumPackets - 1);
+    EXPECT_EQ(fec_packet.size() - (kRtpHeaderSize + 100 + kNumPackets - 1),
+              sender_.MaxPacketOverhead());
+  }
+  EXPECT_TRUE(sender_.GetFecPackets().empty());
+}
+
+TEST_F(ReedSolomonFecSenderTest, WaitsForMoreFramesWhenOverheadIsTooHigh) {
+  SetFecRate(/*fec_rate=*/30, /*max_fec_frames=*/3);
+  // A single parity packet for a single media packet is far more than asked
+  // for, so the group is extended up to `max_fec_frames`.
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(sender_.GetFecPackets().empty());
+    sender_.AddPacketAndGenerateFec(MediaPacket(i, /*marker=*/true, 100));
+  }
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender_.GetFecPackets();
+  ASSERT_EQ(fec_packets.size(), 1u);
+  ReedSolomonFecHeader header;
+  ASSERT_TRUE(header.Parse(fec_packets[0]->payload()));
+  EXPECT_EQ(header.num_media_packets, 3);
+}
+
+TEST_F(ReedSolomonFecSenderTest, LimitsGroupSize) {
+  SetFecRate(/*fec_rate=*/64, /*max_fec_frames=*/1);
+  const int kNumPackets = ReedSolomonFecSender::kMaxMediaPackets + 2;
+  for (int i = 0; i < kNumPackets; ++i) {
+    sender_.AddPacketAndGenerateFec(
+        MediaPacket(i, /*marker=*/i == kNumPackets - 1, 100));
+    std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+        sender_.GetFecPackets();
+    if (i == ReedSolomonFecSender::kMaxMediaPackets - 1) {
+      ASSERT_FALSE(fec_packets.empty());
+      ReedSolomonFecHeader header;
+      ASSERT_TRUE(header.Parse(fec_packets[0]->payload()));
+      EXPECT_EQ(header.base_seq_num, 0);
+      EXPECT_EQ(header.num_media_packets,
+                ReedSolomonFecSender::kMaxMediaPackets);
+    } else if (i == kNumPackets - 1) {
+      ASSERT_FALSE(fec_packets.empty());
+      ReedSolomonFecHeader header;
+      ASSERT_TRUE(header.Parse(fec_packets[0]->payload()));
+      EXPECT_EQ(header.base_seq_num, ReedSolomonFecSender::kMaxMediaPackets);
+      EXPECT_EQ(header.num_media_packets, 2);
+    } else {
+      EXPECT_TRUE(fec_packets.empty());
+    }
+  }
+}
+
+TEST_F(ReedSolomonFecSenderTest, ProtectsGroupOnSequenceNumberGap) {
+  SetFecRate(/*fec_rate=*/255, /*max_fec_frames=*/1);
+  sender_.AddPacketAndGenerateFec(MediaPacket(10, /*marker=*/false, 100));
+  sender_.AddPacketAndGenerateFec(MediaPacket(11, /*marker=*/false, 100));
+  EXPECT_TRUE(sender_.GetFecPackets().empty());
+  sender_.AddPacketAndGenerateFec(MediaPacket(20, /*marker=*/false, 100));
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender_.GetFecPackets();
+  ASSERT_EQ(fec_packets.size(), 2u);
+  ReedSolomonFecHeader header;
+  ASSERT_TRUE(header.Parse(fec_packets[0]->payload()));
+  EXPECT_EQ(header.base_seq_num, 10);
+  EXPECT_EQ(header.num_media_packets, 2);
+}
+
+TEST_F(ReedSolomonFecSenderTest, ContinuesFromRtpState) {
+  RtpState rtp_state;
+  rtp_state.sequence_number = 100;
+  rtp_state.start_timestamp = 200;
+  ReedSolomonFecSender sender(kFecPayloadType, kFecSsrc, kMediaSsrc, kNoMid,
+                              kNoRtpHeaderExtensions,
+                              kNoRtpHeaderExtensionSizes, &rtp_state, &clock_);
+  FecProtectionParams params;
+  params.fec_rate = 255;
+  params.max_fec_frames = 1;
+  sender.SetProtectionParameters(params, params);
+  sender.AddPacketAndGenerateFec(MediaPacket(1, /*marker=*/true, 100));
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> fec_packets =
+      sender.GetFecPackets();
+  ASSERT_EQ(fec_packets.size(), 1u);
+  EXPECT_EQ(fec_packets[0]->SequenceNumber(), 100);
+  EXPECT_EQ(sender.GetRtpState()->sequence_number, 101);
+  EXPECT_EQ(sender.GetRtpState()->start_timestamp, 200u);
+}
+
+}  // namespace
+}  // namespace webrtc
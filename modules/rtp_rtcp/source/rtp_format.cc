@@ -14,6 +14,12 @@
 
 #include "absl/types/variant.h"
 #include "modules/rtp_rtcp/source/rtp_format_h264.h"
+#ifdef RTC_ENABLE_H265
+#include "modules/rtp_rtcp/source/rtp_format_h265.h"
+#endif
+#ifdef RTC_ENABLE_H266
+#include "modules/rtp_rtcp/source/rtp_format_h266.h"
+#endif
 #include "modules/rtp_rtcp/source/rtp_format_video_generic.h"
 #include "modules/rtp_rtcp/source/rtp_format_vp8.h"
 #include "modules/rtp_rtcp/source/rtp_format_vp9.h"
@@ -57,7 +63,14 @@ std::unique_ptr<RtpPacketizer> RtpPacketizer::Create(
       return std::make_unique<RtpPacketizerAv1>(
           payload, limits, rtp_video_header.frame_type,
           rtp_video_header.is_last_frame_in_picture);
-    // TODO(bugs.webrtc.org/13485): Implement RtpPacketizerH265.
+#ifdef RTC_ENABLE_H265
+    case kVideoCodecH265:
+      return std::make_unique<RtpPacketizerH265>(payload, limits);
+#endif
+#ifdef RTC_ENABLE_H266
+    case kVideoCodecH266:
+      return std::make_unique<RtpPacketizerH266>(payload, limits);
+#endif
     default: {
       return std::make_unique<RtpPacketizerGeneric>(payload, limits,
                                                     rtp_video_header);
@@ -0,0 +1,30 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_format_h265.h"
+
+#include "common_video/h265/h265_sps_parser.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+absl::optional<Resolution> H265NalTraits::ParseSpsResolution(
+    rtc::ArrayView<const uint8_t> sps) {
+  absl::optional<H265SpsParser::SpsState> sps_state =
+      H265SpsParser::ParseSps(sps.data(), sps.size());
+  if (!sps_state) {
+    RTC_LOG(LS_WARNING) << "Failed to parse H265 SPS.";
+    return absl::nullopt;
+  }
+  return Resolution{.width = static_cast<int>(sps_state->width),
+                    .height = static_cast<int>(sps_state->height)};
+}
+
+}  // namespace webrtc
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H265_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H265_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/video/resolution.h"
+#include "api/video/video_codec_type.h"
+#include "common_video/h265/h265_common.h"
+#include "modules/rtp_rtcp/source/rtp_format_h26x.h"
+
+namespace webrtc {
+
+// Bit masks for the two byte NAL unit / RTP payload header
+// (F, Type, LayerId, TID), RFC 7798 section 1.1.4.
+constexpr uint8_t kH265TypeMask = 0x7E;
+constexpr uint8_t kH265TidMask = 0x07;
+
+// Bit masks for the FU header (S, E, FuType), RFC 7798 section 4.4.3.
+constexpr uint8_t kH265SBit = 0x80;
+constexpr uint8_t kH265EBit = 0x40;
+constexpr uint8_t kH265FuTypeMask = 0x3F;
+
+// Describes the H.265 NAL unit header for the code shared with H.266, see
+// rtp_format_h26x.h.
+struct H265NalTraits {
+  static constexpr char kName[] = "H265";
+  static constexpr VideoCodecType kCodecType = kVideoCodecH265;
+  static constexpr uint8_t kAp = H265::NaluType::kAP;
+  static constexpr uint8_t kFu = H265::NaluType::kFU;
+  static constexpr uint8_t kVps = H265::NaluType::kVps;
+  static constexpr uint8_t kSps = H265::NaluType::kSps;
+  static constexpr uint8_t kPps = H265::NaluType::kPps;
+  static constexpr bool kVpsRequired = true;
+  static constexpr uint8_t kFuSBit = kH265SBit;
+  static constexpr uint8_t kFuEBit = kH265EBit;
+  static constexpr uint8_t kFuPBit = 0;
+  static constexpr uint8_t kFuTypeMask = kH265FuTypeMask;
+
+  static std::vector<H265::NaluIndex> FindNaluIndices(
+      rtc::ArrayView<const uint8_t> buffer) {
+    return H265::FindNaluIndices(buffer.data(), buffer.size());
+  }
+  static uint8_t Type(uint16_t header) { return (header >> 9) & 0x3F; }
+  static uint8_t LayerId(uint16_t header) { return (header >> 3) & 0x3F; }
+  static uint8_t Tid(uint16_t header) { return header & kH265TidMask; }
+  static uint16_t WithType(uint16_t header, uint8_t type) {
+    return (header & ~(uint16_t{kH265TypeMask} << 8)) | (uint16_t{type} << 9);
+  }
+  static uint16_t Header(uint8_t type, uint8_t layer_id, uint8_t tid) {
+    return (uint16_t{type} << 9) | (uint16_t{layer_id} << 3) | tid;
+  }
+  static bool IsVcl(uint8_t type) { return type < H265::NaluType::kVps; }
+  static bool IsIrap(uint8_t type) {
+    return type >= H265::NaluType::kBlaWLp &&
+           type <= H265::NaluType::kRsvIrapVcl23;
+  }
+  static absl::optional<Resolution> ParseSpsResolution(
+      rtc::ArrayView<const uint8_t> sps);
+};
+
+using RtpPacketizerH265 = RtpPacketizerH26x<H265NalTraits>;
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H265_H_
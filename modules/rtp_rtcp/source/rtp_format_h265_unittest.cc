@@ -0,0 +1,416 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_format_h265.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "common_video/h265/h265_common.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::Eq;
+using ::testing::SizeIs;
+
+constexpr RtpPacketToSend::ExtensionManager* kNoExtensions = nullptr;
+constexpr size_t kMaxPayloadSize = 1200;
+constexpr size_t kLengthFieldLength = 2;
+constexpr size_t kNalHeaderSize = 2;
+constexpr size_t kFuHeaderSize = 3;
+constexpr RtpPacketizer::PayloadSizeLimits kNoLimits;
+
+// Builds a NAL unit header with the given type, LayerId and TID.
+std::vector<uint8_t> NalHeader(H265::NaluType type,
+                               uint8_t layer_id = 0,
+                               uint8_t tid = 1) {
+  return {static_cast<uint8_t>((type << 1) | (layer_id >> 5)),
+          static_cast<uint8_t>((layer_id << 3) | tid)};
+}
+
+// Creates Buffer that looks like nal unit of given size.
+rtc::Buffer GenerateNalUnit(size_t size,
+                            H265::NaluType type = H265::NaluType::kTrailR) {
+  RTC_CHECK_GE(size, kNalHeaderSize);
+  rtc::Buffer buffer(size);
+  std::vector<uint8_t> header = NalHeader(type);
+  buffer[0] = header[0];
+  buffer[1] = header[1];
+  for (size_t i = kNalHeaderSize; i < size; ++i) {
+    buffer[i] = static_cast<uint8_t>(i);
+  }
+  // Last byte shouldn't be 0, or it may be counted as part of next 4-byte start
+  // sequence.
+  buffer[size - 1] |= 0x10;
+  return buffer;
+}
+
+// Create frame consisting of given nalus.
+rtc::Buffer CreateFrame(rtc::ArrayView<const rtc::Buffer> nalus) {
+  static constexpr int kStartCodeSize = 3;
+  int frame_size = 0;
+  for (const rtc::Buffer& nalu : nalus) {
+    frame_size += (kStartCodeSize + nalu.size());
+  }
+  rtc::Buffer frame(frame_size);
+  size_t offset = 0;
+  for (const rtc::Buffer& nalu : nalus) {
+    // Insert nalu start code
+    frame[offset] = 0;
+    frame[offset + 1] = 0;
+    frame[offset + 2] = 1;
+    // Copy the nalu unit.
+    memcpy(frame.data() + offset + 3, nalu.data(), nalu.size());
+    offset += (kStartCodeSize + nalu.size());
+  }
+  return frame;
+}
+
+std::vector<RtpPacketToSend> FetchAllPackets(RtpPacketizerH265* packetizer) {
+  std::vector<RtpPacketToSend> result;
+  size_t num_packets = packetizer->NumPackets();
+  result.reserve(num_packets);
+  RtpPacketToSend packet(kNoExtensions);
+  while (packetizer->NextPacket(&packet)) {
+    result.push_back(packet);
+  }
+  EXPECT_THAT(result, SizeIs(num_packets));
+  return result;
+}
+
+TEST(RtpPacketizerH265Test, SingleNalu) {
+  const uint8_t frame[] = {0, 0, 1, H265::NaluType::kIdrWRadl << 1, 0x01,
+                           0xFF};
+
+  RtpPacketizerH265 packetizer(frame, kNoLimits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(1));
+  EXPECT_THAT(packets[0].payload(),
+              ElementsAre(H265::NaluType::kIdrWRadl << 1, 0x01, 0xFF));
+  EXPECT_TRUE(packets[0].Marker());
+}
+
+TEST(RtpPacketizerH265Test, SingleNaluTwoPackets) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = kMaxPayloadSize;
+  rtc::Buffer nalus[] = {GenerateNalUnit(kMaxPayloadSize),
+                         GenerateNalUnit(100)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(2));
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[1]));
+  EXPECT_FALSE(packets[0].Marker());
+  EXPECT_TRUE(packets[1].Marker());
+}
+
+TEST(RtpPacketizerH265Test,
+     SingleNaluFirstPacketReductionAppliesOnlyToFirstFragment) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 200;
+  limits.first_packet_reduction_len = 5;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/195),
+                         GenerateNalUnit(/*size=*/200),
+                         GenerateNalUnit(/*size=*/200)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(3));
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[1]));
+  EXPECT_THAT(packets[2].payload(), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH265Test,
+     SingleNaluLastPacketReductionAppliesOnlyToLastFragment) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 200;
+  limits.last_packet_reduction_len = 5;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/200),
+                         GenerateNalUnit(/*size=*/200),
+                         GenerateNalUnit(/*size=*/195)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(3));
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[1]));
+  EXPECT_THAT(packets[2].payload(), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH265Test, RejectsTooShortNalUnit) {
+  const uint8_t frame[] = {0, 0, 1, H265::NaluType::kTrailR << 1};
+
+  RtpPacketizerH265 packetizer(frame, kNoLimits);
+
+  EXPECT_EQ(packetizer.NumPackets(), 0u);
+}
+
+// Aggregation tests.
+TEST(RtpPacketizerH265Test, Ap) {
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/3, H265::NaluType::kVps),
+                         GenerateNalUnit(/*size=*/3, H265::NaluType::kSps),
+                         GenerateNalUnit(/*size=*/0x123)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, kNoLimits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(1));
+  auto payload = packets[0].payload();
+  EXPECT_EQ(payload.size(),
+            kNalHeaderSize + 3 * kLengthFieldLength + 3 + 3 + 0x123);
+
+  EXPECT_THAT(payload.subview(0, kNalHeaderSize),
+              ElementsAreArray(NalHeader(H265::NaluType::kAP)));
+  payload = payload.subview(kNalHeaderSize);
+  // 1st fragment.
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, 3));  // Size.
+  EXPECT_THAT(payload.subview(kLengthFieldLength, 3),
+              ElementsAreArray(nalus[0]));
+  payload = payload.subview(kLengthFieldLength + 3);
+  // 2nd fragment.
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, 3));  // Size.
+  EXPECT_THAT(payload.subview(kLengthFieldLength, 3),
+              ElementsAreArray(nalus[1]));
+  payload = payload.subview(kLengthFieldLength + 3);
+  // 3rd fragment.
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0x1, 0x23));  // Size.
+  EXPECT_THAT(payload.subview(kLengthFieldLength), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH265Test, ApFitsInPacketThatHeldLargerPayload) {
+  // FetchAllPackets() writes every packet into the same RtpPacketToSend, so
+  // the AP is built in a packet that still holds the 1100 byte NAL unit.
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/1100),
+                         GenerateNalUnit(/*size=*/400),
+                         GenerateNalUnit(/*size=*/400)};
+  rtc::Buffer frame = CreateFrame(nalus);
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = kMaxPayloadSize;
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(2));
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  EXPECT_EQ(packets[1].payload_size(),
+            kNalHeaderSize + 2 * (kLengthFieldLength + 400));
+}
+
+TEST(RtpPacketizerH265Test, ApHeaderUsesLowestLayerIdAndTid) {
+  rtc::Buffer nalus[] = {rtc::Buffer(3), rtc::Buffer(3)};
+  std::vector<uint8_t> header = NalHeader(H265::NaluType::kTrailR,
+                                          /*layer_id=*/5, /*tid=*/3);
+  memcpy(nalus[0].data(), header.data(), header.size());
+  nalus[0][2] = 0xFF;
+  header = NalHeader(H265::NaluType::kTrailR, /*layer_id=*/2, /*tid=*/4);
+  memcpy(nalus[1].data(), header.data(), header.size());
+  nalus[1][2] = 0xFF;
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, kNoLimits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(1));
+  EXPECT_THAT(packets[0].payload().subview(0, kNalHeaderSize),
+              ElementsAreArray(NalHeader(H265::NaluType::kAP, /*layer_id=*/2,
+                                         /*tid=*/3)));
+}
+
+TEST(RtpPacketizerH265Test, ApRespectsFirstPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1000;
+  limits.first_packet_reduction_len = 100;
+  const size_t kFirstFragmentSize =
+      limits.max_payload_len - limits.first_packet_reduction_len;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/kFirstFragmentSize),
+                         GenerateNalUnit(/*size=*/3),
+                         GenerateNalUnit(/*size=*/3)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(2));
+  // Expect 1st packet is single nalu.
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  // Expect 2nd packet is aggregate of last two fragments.
+  EXPECT_THAT(packets[1].payload().subview(kNalHeaderSize),
+              ElementsAre(0, 3, nalus[1][0], nalus[1][1], nalus[1][2],  //
+                          0, 3, nalus[2][0], nalus[2][1], nalus[2][2]));
+}
+
+TEST(RtpPacketizerH265Test, ApRespectsLastPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1000;
+  limits.last_packet_reduction_len = 100;
+  limits.single_packet_reduction_len = 100;
+  const size_t kLastFragmentSize =
+      limits.max_payload_len - limits.last_packet_reduction_len;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/3),
+                         GenerateNalUnit(/*size=*/3),
+                         GenerateNalUnit(/*size=*/kLastFragmentSize)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(2));
+  // Expect 1st packet is aggregate of 1st two fragments.
+  EXPECT_THAT(packets[0].payload().subview(kNalHeaderSize),
+              ElementsAre(0, 3, nalus[0][0], nalus[0][1], nalus[0][2],  //
+                          0, 3, nalus[1][0], nalus[1][1], nalus[1][2]));
+  // Expect 2nd packet is single nalu.
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH265Test, MixedApFu) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 100;
+  const size_t kFuPayloadSize = 70;
+  const size_t kFuNaluSize = kNalHeaderSize + 2 * kFuPayloadSize;
+  const size_t kApNaluSize = 20;
+  rtc::Buffer nalus[] = {
+      GenerateNalUnit(kFuNaluSize, H265::NaluType::kIdrWRadl),
+      GenerateNalUnit(kApNaluSize), GenerateNalUnit(kApNaluSize)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(3));
+  // First expect two FU packets.
+  std::vector<uint8_t> fu_header = NalHeader(H265::NaluType::kFU);
+  EXPECT_THAT(packets[0].payload().subview(0, kFuHeaderSize),
+              ElementsAre(fu_header[0], fu_header[1],
+                          kH265SBit | H265::NaluType::kIdrWRadl));
+  EXPECT_THAT(
+      packets[0].payload().subview(kFuHeaderSize),
+      ElementsAreArray(nalus[0].data() + kNalHeaderSize, kFuPayloadSize));
+
+  EXPECT_THAT(packets[1].payload().subview(0, kFuHeaderSize),
+              ElementsAre(fu_header[0], fu_header[1],
+                          kH265EBit | H265::NaluType::kIdrWRadl));
+  EXPECT_THAT(
+      packets[1].payload().subview(kFuHeaderSize),
+      ElementsAreArray(nalus[0].data() + kNalHeaderSize + kFuPayloadSize,
+                       kFuPayloadSize));
+
+  // Then expect one AP packet with two nal units.
+  EXPECT_THAT(packets[2].payload().subview(0, kNalHeaderSize),
+              ElementsAreArray(NalHeader(H265::NaluType::kAP)));
+  auto payload = packets[2].payload().subview(kNalHeaderSize);
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, kApNaluSize));
+  EXPECT_THAT(payload.subview(kLengthFieldLength, kApNaluSize),
+              ElementsAreArray(nalus[1]));
+  payload = payload.subview(kLengthFieldLength + kApNaluSize);
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, kApNaluSize));
+  EXPECT_THAT(payload.subview(kLengthFieldLength), ElementsAreArray(nalus[2]));
+}
+
+// Splits frame with payload size `frame_payload_size` without fragmentation,
+// Returns sizes of the payloads excluding fu headers.
+std::vector<int> TestFu(size_t frame_payload_size,
+                        const RtpPacketizer::PayloadSizeLimits& limits) {
+  rtc::Buffer nalu[] = {GenerateNalUnit(kNalHeaderSize + frame_payload_size)};
+  rtc::Buffer frame = CreateFrame(nalu);
+
+  RtpPacketizerH265 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  EXPECT_GE(packets.size(), 2u);  // Single packet indicates it is not FU.
+  std::vector<uint32_t> fu_header;
+  std::vector<int> payload_sizes;
+
+  for (const RtpPacketToSend& packet : packets) {
+    auto payload = packet.payload();
+    EXPECT_GT(payload.size(), kFuHeaderSize);
+    fu_header.push_back((payload[0] << 16) | (payload[1] << 8) | payload[2]);
+    payload_sizes.push_back(payload.size() - kFuHeaderSize);
+  }
+
+  EXPECT_TRUE(fu_header.front() & kH265SBit);
+  EXPECT_TRUE(fu_header.back() & kH265EBit);
+  // Clear S and E bits before testing all are duplicating same original header.
+  fu_header.front() &= ~kH265SBit;
+  fu_header.back() &= ~kH265EBit;
+  std::vector<uint8_t> payload_header = NalHeader(H265::NaluType::kFU);
+  EXPECT_THAT(fu_header, Each(Eq((payload_header[0] << 16) |
+                                 (payload_header[1] << 8) |
+                                 H265::NaluType::kTrailR)));
+
+  return payload_sizes;
+}
+
+// Fragmentation tests.
+TEST(RtpPacketizerH265Test, FuOddSize) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  EXPECT_THAT(TestFu(1200, limits), ElementsAre(600, 600));
+}
+
+TEST(RtpPacketizerH265Test, FuWithFirstPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  limits.first_packet_reduction_len = 4;
+  limits.single_packet_reduction_len = 4;
+  EXPECT_THAT(TestFu(1198, limits), ElementsAre(597, 601));
+}
+
+TEST(RtpPacketizerH265Test, FuWithLastPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  limits.last_packet_reduction_len = 4;
+  limits.single_packet_reduction_len = 4;
+  EXPECT_THAT(TestFu(1198, limits), ElementsAre(601, 597));
+}
+
+TEST(RtpPacketizerH265Test, FuEvenSize) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  EXPECT_THAT(TestFu(1201, limits), ElementsAre(600, 601));
+}
+
+TEST(RtpPacketizerH265Test, FuBig) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  // Generate 10 full sized packets, leave room for FU headers.
+  EXPECT_THAT(
+      TestFu(10 * (1200 - kFuHeaderSize), limits),
+      ElementsAre(1197, 1197, 1197, 1197, 1197, 1197, 1197, 1197, 1197, 1197));
+}
+
+}  // namespace
+}  // namespace webrtc
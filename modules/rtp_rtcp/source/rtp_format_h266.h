@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H266_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H266_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/video/resolution.h"
+#include "api/video/video_codec_type.h"
+#include "common_video/h264/h264_common.h"
+#include "common_video/h266/h266_common.h"
+#include "modules/rtp_rtcp/source/rtp_format_h26x.h"
+
+namespace webrtc {
+
+// Bit masks for the two byte NAL unit / RTP payload header
+// (F, Z, LayerId | Type, TID), RFC 9328 section 1.1.4.
+constexpr uint8_t kH266LayerIdMask = 0x3F;
+constexpr uint8_t kH266TypeMask = 0xF8;
+constexpr uint8_t kH266TidMask = 0x07;
+
+// Bit masks for the FU header (S, E, P, FuType), RFC 9328 section 4.3.3.
+constexpr uint8_t kH266SBit = 0x80;
+constexpr uint8_t kH266EBit = 0x40;
+constexpr uint8_t kH266PBit = 0x20;
+constexpr uint8_t kH266FuTypeMask = 0x1F;
+
+// Describes the H.266 NAL unit header for the code shared with H.265, see
+// rtp_format_h26x.h.
+struct H266NalTraits {
+  static constexpr char kName[] = "H266";
+  static constexpr VideoCodecType kCodecType = kVideoCodecH266;
+  static constexpr uint8_t kAp = kH266Ap;
+  static constexpr uint8_t kFu = kH266Fu;
+  static constexpr uint8_t kVps = kH266VpsNut;
+  static constexpr uint8_t kSps = kH266SpsNut;
+  static constexpr uint8_t kPps = kH266PpsNut;
+  // The VPS is optional in VVC.
+  static constexpr bool kVpsRequired = false;
+  static constexpr uint8_t kFuSBit = kH266SBit;
+  static constexpr uint8_t kFuEBit = kH266EBit;
+  static constexpr uint8_t kFuPBit = kH266PBit;
+  static constexpr uint8_t kFuTypeMask = kH266FuTypeMask;
+
+  // VVC uses the same start codes as AVC.
+  static std::vector<H264::NaluIndex> FindNaluIndices(
+      rtc::ArrayView<const uint8_t> buffer) {
+    return H264::FindNaluIndices(buffer.data(), buffer.size());
+  }
+  static uint8_t Type(uint16_t header) {
+    return H266Common::ParseNaluType(static_cast<uint8_t>(header));
+  }
+  static uint8_t LayerId(uint16_t header) {
+    return (header >> 8) & kH266LayerIdMask;
+  }
+  static uint8_t Tid(uint16_t header) { return header & kH266TidMask; }
+  static uint16_t WithType(uint16_t header, uint8_t type) {
+    return (header & ~uint16_t{kH266TypeMask}) | (uint16_t{type} << 3);
+  }
+  static uint16_t Header(uint8_t type, uint8_t layer_id, uint8_t tid) {
+    return (uint16_t{layer_id} << 8) | (uint16_t{type} << 3) | tid;
+  }
+  static bool IsVcl(uint8_t type) { return type <= kH266RsvIrap11; }
+  static bool IsIrap(uint8_t type) {
+    return type >= kH266IdrWRadlNut && type <= kH266RsvIrap11 &&
+           type != kH266GdrNut;
+  }
+  // There is no VVC SPS parser, so the resolution is left for the decoder to
+  // report.
+  static absl::optional<Resolution> ParseSpsResolution(
+      rtc::ArrayView<const uint8_t> sps) {
+    return absl::nullopt;
+  }
+};
+
+using RtpPacketizerH266 = RtpPacketizerH26x<H266NalTraits>;
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H266_H_
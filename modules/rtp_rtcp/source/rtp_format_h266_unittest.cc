@@ -0,0 +1,424 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtp_format_h266.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "common_video/h266/h266_common.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Each;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::Eq;
+using ::testing::SizeIs;
+
+constexpr RtpPacketToSend::ExtensionManager* kNoExtensions = nullptr;
+constexpr size_t kMaxPayloadSize = 1200;
+constexpr size_t kLengthFieldLength = 2;
+constexpr size_t kNalHeaderSize = 2;
+constexpr size_t kFuHeaderSize = 3;
+constexpr RtpPacketizer::PayloadSizeLimits kNoLimits;
+
+// Builds a NAL unit header with the given type, LayerId and TID.
+std::vector<uint8_t> NalHeader(H266NaluType type,
+                               uint8_t layer_id = 0,
+                               uint8_t tid = 1) {
+  return {layer_id, static_cast<uint8_t>((type << 3) | tid)};
+}
+
+// Creates Buffer that looks like nal unit of given size.
+rtc::Buffer GenerateNalUnit(size_t size,
+                            H266NaluType type = kH266TrailNut) {
+  RTC_CHECK_GE(size, kNalHeaderSize);
+  rtc::Buffer buffer(size);
+  std::vector<uint8_t> header = NalHeader(type);
+  buffer[0] = header[0];
+  buffer[1] = header[1];
+  for (size_t i = kNalHeaderSize; i < size; ++i) {
+    buffer[i] = static_cast<uint8_t>(i);
+  }
+  // Last byte shouldn't be 0, or it may be counted as part of next 4-byte start
+  // sequence.
+  buffer[size - 1] |= 0x10;
+  return buffer;
+}
+
+// Create frame consisting of given nalus.
+rtc::Buffer CreateFrame(rtc::ArrayView<const rtc::Buffer> nalus) {
+  static constexpr int kStartCodeSize = 3;
+  int frame_size = 0;
+  for (const rtc::Buffer& nalu : nalus) {
+    frame_size += (kStartCodeSize + nalu.size());
+  }
+  rtc::Buffer frame(frame_size);
+  size_t offset = 0;
+  for (const rtc::Buffer& nalu : nalus) {
+    // Insert nalu start code
+    frame[offset] = 0;
+    frame[offset + 1] = 0;
+    frame[offset + 2] = 1;
+    // Copy the nalu unit.
+    memcpy(frame.data() + offset + 3, nalu.data(), nalu.size());
+    offset += (kStartCodeSize + nalu.size());
+  }
+  return frame;
+}
+
+std::vector<RtpPacketToSend> FetchAllPackets(RtpPacketizerH266* packetizer) {
+  std::vector<RtpPacketToSend> result;
+  size_t num_packets = packetizer->NumPackets();
+  result.reserve(num_packets);
+  RtpPacketToSend packet(kNoExtensions);
+  while (packetizer->NextPacket(&packet)) {
+    result.push_back(packet);
+  }
+  EXPECT_THAT(result, SizeIs(num_packets));
+  return result;
+}
+
+TEST(RtpPacketizerH266Test, SingleNalu) {
+  const uint8_t frame[] = {0, 0, 1, 0x00, kH266IdrWRadlNut << 3 | 1, 0xFF};
+
+  RtpPacketizerH266 packetizer(frame, kNoLimits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(1));
+  EXPECT_THAT(packets[0].payload(),
+              ElementsAre(0x00, kH266IdrWRadlNut << 3 | 1, 0xFF));
+  EXPECT_TRUE(packets[0].Marker());
+}
+
+TEST(RtpPacketizerH266Test, SingleNaluTwoPackets) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = kMaxPayloadSize;
+  rtc::Buffer nalus[] = {GenerateNalUnit(kMaxPayloadSize),
+                         GenerateNalUnit(100)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(2));
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[1]));
+  EXPECT_FALSE(packets[0].Marker());
+  EXPECT_TRUE(packets[1].Marker());
+}
+
+TEST(RtpPacketizerH266Test,
+     SingleNaluFirstPacketReductionAppliesOnlyToFirstFragment) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 200;
+  limits.first_packet_reduction_len = 5;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/195),
+                         GenerateNalUnit(/*size=*/200),
+                         GenerateNalUnit(/*size=*/200)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(3));
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[1]));
+  EXPECT_THAT(packets[2].payload(), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH266Test,
+     SingleNaluLastPacketReductionAppliesOnlyToLastFragment) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 200;
+  limits.last_packet_reduction_len = 5;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/200),
+                         GenerateNalUnit(/*size=*/200),
+                         GenerateNalUnit(/*size=*/195)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(3));
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[1]));
+  EXPECT_THAT(packets[2].payload(), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH266Test, RejectsTooShortNalUnit) {
+  const uint8_t frame[] = {0, 0, 1, 0x00};
+
+  RtpPacketizerH266 packetizer(frame, kNoLimits);
+
+  EXPECT_EQ(packetizer.NumPackets(), 0u);
+}
+
+// Aggregation tests.
+TEST(RtpPacketizerH266Test, Ap) {
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/3, kH266VpsNut),
+                         GenerateNalUnit(/*size=*/3, kH266SpsNut),
+                         GenerateNalUnit(/*size=*/0x123)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, kNoLimits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(1));
+  auto payload = packets[0].payload();
+  EXPECT_EQ(payload.size(),
+            kNalHeaderSize + 3 * kLengthFieldLength + 3 + 3 + 0x123);
+
+  EXPECT_THAT(payload.subview(0, kNalHeaderSize),
+              ElementsAreArray(NalHeader(kH266Ap)));
+  payload = payload.subview(kNalHeaderSize);
+  // 1st fragment.
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, 3));  // Size.
+  EXPECT_THAT(payload.subview(kLengthFieldLength, 3),
+              ElementsAreArray(nalus[0]));
+  payload = payload.subview(kLengthFieldLength + 3);
+  // 2nd fragment.
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, 3));  // Size.
+  EXPECT_THAT(payload.subview(kLengthFieldLength, 3),
+              ElementsAreArray(nalus[1]));
+  payload = payload.subview(kLengthFieldLength + 3);
+  // 3rd fragment.
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0x1, 0x23));  // Size.
+  EXPECT_THAT(payload.subview(kLengthFieldLength), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH266Test, ApHeaderUsesLowestLayerIdAndTid) {
+  rtc::Buffer nalus[] = {rtc::Buffer(3), rtc::Buffer(3)};
+  std::vector<uint8_t> header = NalHeader(kH266TrailNut,
+                                          /*layer_id=*/5, /*tid=*/3);
+  memcpy(nalus[0].data(), header.data(), header.size());
+  nalus[0][2] = 0xFF;
+  header = NalHeader(kH266TrailNut, /*layer_id=*/2, /*tid=*/4);
+  memcpy(nalus[1].data(), header.data(), header.size());
+  nalus[1][2] = 0xFF;
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, kNoLimits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(1));
+  EXPECT_THAT(packets[0].payload().subview(0, kNalHeaderSize),
+              ElementsAreArray(NalHeader(kH266Ap, /*layer_id=*/2,
+                                         /*tid=*/3)));
+}
+
+TEST(RtpPacketizerH266Test, ApRespectsFirstPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1000;
+  limits.first_packet_reduction_len = 100;
+  const size_t kFirstFragmentSize =
+      limits.max_payload_len - limits.first_packet_reduction_len;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/kFirstFragmentSize),
+                         GenerateNalUnit(/*size=*/3),
+                         GenerateNalUnit(/*size=*/3)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(2));
+  // Expect 1st packet is single nalu.
+  EXPECT_THAT(packets[0].payload(), ElementsAreArray(nalus[0]));
+  // Expect 2nd packet is aggregate of last two fragments.
+  EXPECT_THAT(packets[1].payload().subview(kNalHeaderSize),
+              ElementsAre(0, 3, nalus[1][0], nalus[1][1], nalus[1][2],  //
+                          0, 3, nalus[2][0], nalus[2][1], nalus[2][2]));
+}
+
+TEST(RtpPacketizerH266Test, ApRespectsLastPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1000;
+  limits.last_packet_reduction_len = 100;
+  limits.single_packet_reduction_len = 100;
+  const size_t kLastFragmentSize =
+      limits.max_payload_len - limits.last_packet_reduction_len;
+  rtc::Buffer nalus[] = {GenerateNalUnit(/*size=*/3),
+                         GenerateNalUnit(/*size=*/3),
+                         GenerateNalUnit(/*size=*/kLastFragmentSize)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(2));
+  // Expect 1st packet is aggregate of 1st two fragments.
+  EXPECT_THAT(packets[0].payload().subview(kNalHeaderSize),
+              ElementsAre(0, 3, nalus[0][0], nalus[0][1], nalus[0][2],  //
+                          0, 3, nalus[1][0], nalus[1][1], nalus[1][2]));
+  // Expect 2nd packet is single nalu.
+  EXPECT_THAT(packets[1].payload(), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH266Test, MixedApFu) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 100;
+  const size_t kFuPayloadSize = 70;
+  const size_t kFuNaluSize = kNalHeaderSize + 2 * kFuPayloadSize;
+  const size_t kApNaluSize = 20;
+  rtc::Buffer nalus[] = {
+      GenerateNalUnit(kFuNaluSize, kH266IdrWRadlNut),
+      GenerateNalUnit(kApNaluSize), GenerateNalUnit(kApNaluSize)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(3));
+  // First expect two FU packets.
+  std::vector<uint8_t> fu_header = NalHeader(kH266Fu);
+  EXPECT_THAT(packets[0].payload().subview(0, kFuHeaderSize),
+              ElementsAre(fu_header[0], fu_header[1],
+                          kH266SBit | kH266IdrWRadlNut));
+  EXPECT_THAT(
+      packets[0].payload().subview(kFuHeaderSize),
+      ElementsAreArray(nalus[0].data() + kNalHeaderSize, kFuPayloadSize));
+
+  EXPECT_THAT(packets[1].payload().subview(0, kFuHeaderSize),
+              ElementsAre(fu_header[0], fu_header[1],
+                          kH266EBit | kH266IdrWRadlNut));
+  EXPECT_THAT(
+      packets[1].payload().subview(kFuHeaderSize),
+      ElementsAreArray(nalus[0].data() + kNalHeaderSize + kFuPayloadSize,
+                       kFuPayloadSize));
+
+  // Then expect one AP packet with two nal units.
+  EXPECT_THAT(packets[2].payload().subview(0, kNalHeaderSize),
+              ElementsAreArray(NalHeader(kH266Ap)));
+  auto payload = packets[2].payload().subview(kNalHeaderSize);
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, kApNaluSize));
+  EXPECT_THAT(payload.subview(kLengthFieldLength, kApNaluSize),
+              ElementsAreArray(nalus[1]));
+  payload = payload.subview(kLengthFieldLength + kApNaluSize);
+  EXPECT_THAT(payload.subview(0, kLengthFieldLength),
+              ElementsAre(0, kApNaluSize));
+  EXPECT_THAT(payload.subview(kLengthFieldLength), ElementsAreArray(nalus[2]));
+}
+
+TEST(RtpPacketizerH266Test, FuSetsPBitOnlyForLastVclNalu) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 100;
+  const size_t kNaluSize = kNalHeaderSize + 2 * 70;
+  rtc::Buffer nalus[] = {GenerateNalUnit(kNaluSize, kH266IdrWRadlNut),
+                         GenerateNalUnit(kNaluSize, kH266IdrWRadlNut),
+                         GenerateNalUnit(kNaluSize, kH266SuffixSeiNut)};
+  rtc::Buffer frame = CreateFrame(nalus);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  ASSERT_THAT(packets, SizeIs(6));
+  std::vector<uint8_t> fu_headers;
+  for (const RtpPacketToSend& packet : packets) {
+    fu_headers.push_back(packet.payload()[kNalHeaderSize]);
+  }
+  EXPECT_THAT(fu_headers,
+              ElementsAre(kH266SBit | kH266IdrWRadlNut,
+                          kH266EBit | kH266IdrWRadlNut,
+                          kH266SBit | kH266IdrWRadlNut,
+                          kH266EBit | kH266PBit | kH266IdrWRadlNut,
+                          kH266SBit | kH266SuffixSeiNut,
+                          kH266EBit | kH266SuffixSeiNut));
+}
+
+// Splits frame with payload size `frame_payload_size` without fragmentation,
+// Returns sizes of the payloads excluding fu headers.
+std::vector<int> TestFu(size_t frame_payload_size,
+                        const RtpPacketizer::PayloadSizeLimits& limits) {
+  rtc::Buffer nalu[] = {GenerateNalUnit(kNalHeaderSize + frame_payload_size)};
+  rtc::Buffer frame = CreateFrame(nalu);
+
+  RtpPacketizerH266 packetizer(frame, limits);
+  std::vector<RtpPacketToSend> packets = FetchAllPackets(&packetizer);
+
+  EXPECT_GE(packets.size(), 2u);  // Single packet indicates it is not FU.
+  std::vector<uint32_t> fu_header;
+  std::vector<int> payload_sizes;
+
+  for (const RtpPacketToSend& packet : packets) {
+    auto payload = packet.payload();
+    EXPECT_GT(payload.size(), kFuHeaderSize);
+    fu_header.push_back((payload[0] << 16) | (payload[1] << 8) | payload[2]);
+    payload_sizes.push_back(payload.size() - kFuHeaderSize);
+  }
+
+  EXPECT_TRUE(fu_header.front() & kH266SBit);
+  EXPECT_TRUE(fu_header.back() & kH266EBit);
+  // The only NAL unit is the last VCL NAL unit of the picture.
+  EXPECT_TRUE(fu_header.back() & kH266PBit);
+  // Clear S, E and P bits before testing all are duplicating same original
+  // header.
+  fu_header.front() &= ~kH266SBit;
+  fu_header.back() &= ~(kH266EBit | kH266PBit);
+  std::vector<uint8_t> payload_header = NalHeader(kH266Fu);
+  EXPECT_THAT(fu_header, Each(Eq((payload_header[0] << 16) |
+                                 (payload_header[1] << 8) |
+                                 kH266TrailNut)));
+
+  return payload_sizes;
+}
+
+// Fragmentation tests.
+TEST(RtpPacketizerH266Test, FuOddSize) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  EXPECT_THAT(TestFu(1200, limits), ElementsAre(600, 600));
+}
+
+TEST(RtpPacketizerH266Test, FuWithFirstPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  limits.first_packet_reduction_len = 4;
+  limits.single_packet_reduction_len = 4;
+  EXPECT_THAT(TestFu(1198, limits), ElementsAre(597, 601));
+}
+
+TEST(RtpPacketizerH266Test, FuWithLastPacketReduction) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  limits.last_packet_reduction_len = 4;
+  limits.single_packet_reduction_len = 4;
+  EXPECT_THAT(TestFu(1198, limits), ElementsAre(601, 597));
+}
+
+TEST(RtpPacketizerH266Test, FuEvenSize) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  EXPECT_THAT(TestFu(1201, limits), ElementsAre(600, 601));
+}
+
+TEST(RtpPacketizerH266Test, FuBig) {
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1200;
+  // Generate 10 full sized packets, leave room for FU headers.
+  EXPECT_THAT(
+      TestFu(10 * (1200 - kFuHeaderSize), limits),
+      ElementsAre(1197, 1197, 1197, 1197, 1197, 1197, 1197, 1197, 1197, 1197));
+}
+
+}  // namespace
+}  // namespace webrtc
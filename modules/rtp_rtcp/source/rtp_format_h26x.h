@@ -0,0 +1,391 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H26X_H_
+#define MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H26X_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <queue>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtp_format.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+// The RTP payload formats of H.265 (RFC 7798) and H.266 (RFC 9328) only differ
+// in the layout of their two byte NAL unit header, so the packetizer,
+// depacketizer and packet buffer are shared and take a `NalTraits` parameter
+// describing that header. See H265NalTraits and H266NalTraits.
+//
+// `NalTraits` provides:
+//   kName, kCodecType      For logging and RTPVideoHeader::codec.
+//   kAp, kFu               Payload types of aggregation and fragmentation
+//                          units.
+//   kVps, kSps, kPps       Parameter set NAL unit types.
+//   kVpsRequired           Whether a keyframe needs a VPS to be decodable.
+//   kFuSBit, kFuEBit,      Bit masks of the FU header. kFuPBit is 0 if the
+//   kFuPBit, kFuTypeMask   format has no P bit.
+//   FindNaluIndices()      Splits an Annex B bitstream into NAL units.
+//   Type(), LayerId(),     Fields of a NAL unit header read as a big endian
+//   Tid()                  uint16_t.
+//   WithType()             The header with its type field replaced.
+//   Header()               A header with the given fields and F (and Z) zero.
+//   IsVcl(), IsIrap()      Classify a NAL unit type.
+//   ParseSpsResolution()   The picture size of an SPS (without NAL header), if
+//                          it can be parsed.
+
+// The forbidden_zero_bit is the first bit of both NAL unit headers.
+constexpr uint16_t kH26xForbiddenBit = 0x8000;
+
+// Packetizes according to RFC 7798 / RFC 9328 with sprop-max-don-diff = 0,
+// i.e. without DONL fields. NAL units that fit are aggregated into APs, NAL
+// units that do not are split into FUs.
+template <typename NalTraits>
+class RtpPacketizerH26x : public RtpPacketizer {
+ public:
+  // Initialize with payload from encoder.
+  // The payload_data must be exactly one encoded access unit in Annex B
+  // format.
+  RtpPacketizerH26x(rtc::ArrayView<const uint8_t> payload,
+                    PayloadSizeLimits limits);
+
+  ~RtpPacketizerH26x() override = default;
+
+  RtpPacketizerH26x(const RtpPacketizerH26x&) = delete;
+  RtpPacketizerH26x& operator=(const RtpPacketizerH26x&) = delete;
+
+  size_t NumPackets() const override { return num_packets_left_; }
+
+  // Get the next payload with payload header.
+  // Write payload and set marker bit of the `packet`.
+  // Returns true on success, false otherwise.
+  bool NextPacket(RtpPacketToSend* rtp_packet) override;
+
+ private:
+  static constexpr size_t kNalHeaderSize = 2;
+  static constexpr size_t kFuHeaderSize = kNalHeaderSize + 1;
+  static constexpr size_t kLengthFieldSize = 2;
+
+  // A packet unit, to be put into an RTP packet:
+  // If a NAL unit is too large for an RTP packet, this packet unit will
+  // represent a FU packet of a single fragment of the NAL unit.
+  // If a NAL unit is small enough to fit within a single RTP packet, this
+  // packet unit may represent a single NAL unit or an AP, of which there may
+  // be multiple in a single RTP packet (if so, aggregated = true).
+  struct PacketUnit {
+    PacketUnit(rtc::ArrayView<const uint8_t> source_fragment,
+               bool first_fragment,
+               bool last_fragment,
+               bool aggregated,
+               uint16_t header,
+               bool last_vcl_nalu = false)
+        : source_fragment(source_fragment),
+          first_fragment(first_fragment),
+          last_fragment(last_fragment),
+          aggregated(aggregated),
+          header(header),
+          last_vcl_nalu(last_vcl_nalu) {}
+
+    rtc::ArrayView<const uint8_t> source_fragment;
+    bool first_fragment;
+    bool last_fragment;
+    bool aggregated;
+    // The two byte NAL unit header of the source NAL unit.
+    uint16_t header;
+    // True if the source NAL unit is the last VCL NAL unit of the picture,
+    // which sets the P bit in its last FU.
+    bool last_vcl_nalu;
+  };
+
+  bool GeneratePackets();
+  bool PacketizeFu(size_t fragment_index);
+  size_t PacketizeAp(size_t fragment_index);
+
+  void NextAggregatePacket(RtpPacketToSend* rtp_packet);
+  void NextFragmentPacket(RtpPacketToSend* rtp_packet);
+
+  const PayloadSizeLimits limits_;
+  size_t num_packets_left_ = 0;
+  std::deque<rtc::ArrayView<const uint8_t>> input_fragments_;
+  std::queue<PacketUnit> packets_;
+  // Index into `input_fragments_` of the last VCL NAL unit, if any.
+  absl::optional<size_t> last_vcl_index_;
+};
+
+template <typename NalTraits>
+RtpPacketizerH26x<NalTraits>::RtpPacketizerH26x(
+    rtc::ArrayView<const uint8_t> payload,
+    PayloadSizeLimits limits)
+    : limits_(limits) {
+  for (const auto& nalu : NalTraits::FindNaluIndices(payload)) {
+    input_fragments_.push_back(
+        payload.subview(nalu.payload_start_offset, nalu.payload_size));
+    if (nalu.payload_size >= kNalHeaderSize &&
+        NalTraits::IsVcl(NalTraits::Type(ByteReader<uint16_t>::ReadBigEndian(
+            payload.data() + nalu.payload_start_offset)))) {
+      last_vcl_index_ = input_fragments_.size() - 1;
+    }
+  }
+
+  if (!GeneratePackets()) {
+    // If failed to generate all the packets, discard already generated
+    // packets in case the caller would ignore return value and still try to
+    // call NextPacket().
+    num_packets_left_ = 0;
+    while (!packets_.empty()) {
+      packets_.pop();
+    }
+  }
+}
+
+template <typename NalTraits>
+bool RtpPacketizerH26x<NalTraits>::GeneratePackets() {
+  for (size_t i = 0; i < input_fragments_.size();) {
+    if (input_fragments_[i].size() < kNalHeaderSize) {
+      RTC_LOG(LS_ERROR) << NalTraits::kName << " NAL unit of size "
+                        << input_fragments_[i].size()
+                        << " is too short for its header.";
+      return false;
+    }
+    int fragment_len = input_fragments_[i].size();
+    int single_packet_capacity = limits_.max_payload_len;
+    if (input_fragments_.size() == 1)
+      single_packet_capacity -= limits_.single_packet_reduction_len;
+    else if (i == 0)
+      single_packet_capacity -= limits_.first_packet_reduction_len;
+    else if (i + 1 == input_fragments_.size())
+      single_packet_capacity -= limits_.last_packet_reduction_len;
+
+    if (fragment_len > single_packet_capacity) {
+      if (!PacketizeFu(i))
+        return false;
+      ++i;
+    } else {
+      i = PacketizeAp(i);
+    }
+  }
+  return true;
+}
+
+template <typename NalTraits>
+bool RtpPacketizerH26x<NalTraits>::PacketizeFu(size_t fragment_index) {
+  // Fragment payload into packets (FU).
+  rtc::ArrayView<const uint8_t> fragment = input_fragments_[fragment_index];
+
+  PayloadSizeLimits limits = limits_;
+  // Leave room for the payload header and the FU header.
+  limits.max_payload_len -= kFuHeaderSize;
+  // Update single/first/last packet reductions unless it is single/first/last
+  // fragment.
+  if (input_fragments_.size() != 1) {
+    // if this fragment is put into a single packet, it might still be the
+    // first or the last packet in the whole sequence of packets.
+    if (fragment_index == input_fragments_.size() - 1) {
+      limits.single_packet_reduction_len = limits_.last_packet_reduction_len;
+    } else if (fragment_index == 0) {
+      limits.single_packet_reduction_len = limits_.first_packet_reduction_len;
+    } else {
+      limits.single_packet_reduction_len = 0;
+    }
+  }
+  if (fragment_index != 0)
+    limits.first_packet_reduction_len = 0;
+  if (fragment_index != input_fragments_.size() - 1)
+    limits.last_packet_reduction_len = 0;
+
+  // Strip out the original header.
+  size_t payload_left = fragment.size() - kNalHeaderSize;
+  int offset = kNalHeaderSize;
+
+  std::vector<int> payload_sizes = SplitAboutEqually(payload_left, limits);
+  if (payload_sizes.empty())
+    return false;
+
+  const uint16_t header = ByteReader<uint16_t>::ReadBigEndian(fragment.data());
+  for (size_t i = 0; i < payload_sizes.size(); ++i) {
+    int packet_length = payload_sizes[i];
+    RTC_CHECK_GT(packet_length, 0);
+    packets_.push(PacketUnit(fragment.subview(offset, packet_length),
+                             /*first_fragment=*/i == 0,
+                             /*last_fragment=*/i == payload_sizes.size() - 1,
+                             false, header,
+                             /*last_vcl_nalu=*/fragment_index ==
+                                 last_vcl_index_));
+    offset += packet_length;
+    payload_left -= packet_length;
+  }
+  num_packets_left_ += payload_sizes.size();
+  RTC_CHECK_EQ(0, payload_left);
+  return true;
+}
+
+template <typename NalTraits>
+size_t RtpPacketizerH26x<NalTraits>::PacketizeAp(size_t fragment_index) {
+  // Aggregate fragments into one packet (AP).
+  size_t payload_size_left = limits_.max_payload_len;
+  int aggregated_fragments = 0;
+  size_t fragment_headers_length = 0;
+  rtc::ArrayView<const uint8_t> fragment = input_fragments_[fragment_index];
+  RTC_CHECK_GE(payload_size_left, fragment.size());
+  ++num_packets_left_;
+
+  const bool has_first_fragment = fragment_index == 0;
+  auto payload_size_needed = [&] {
+    size_t fragment_size = fragment.size() + fragment_headers_length;
+    bool has_last_fragment = fragment_index == input_fragments_.size() - 1;
+    if (has_first_fragment && has_last_fragment) {
+      return fragment_size + limits_.single_packet_reduction_len;
+    } else if (has_first_fragment) {
+      return fragment_size + limits_.first_packet_reduction_len;
+    } else if (has_last_fragment) {
+      return fragment_size + limits_.last_packet_reduction_len;
+    } else {
+      return fragment_size;
+    }
+  };
+
+  while (payload_size_left >= payload_size_needed()) {
+    RTC_CHECK_GE(fragment.size(), kNalHeaderSize);
+    packets_.push(PacketUnit(fragment, aggregated_fragments == 0, false, true,
+                             ByteReader<uint16_t>::ReadBigEndian(
+                                 fragment.data())));
+    payload_size_left -= fragment.size();
+    payload_size_left -= fragment_headers_length;
+
+    fragment_headers_length = kLengthFieldSize;
+    // If we are going to try to aggregate more fragments into this packet
+    // we need to add the AP payload header and a length field for the first
+    // NALU of this packet.
+    if (aggregated_fragments == 0)
+      fragment_headers_length += kNalHeaderSize + kLengthFieldSize;
+    ++aggregated_fragments;
+
+    // Next fragment.
+    ++fragment_index;
+    if (fragment_index == input_fragments_.size())
+      break;
+    fragment = input_fragments_[fragment_index];
+    if (fragment.size() < kNalHeaderSize)
+      break;
+  }
+  RTC_CHECK_GT(aggregated_fragments, 0);
+  packets_.back().last_fragment = true;
+  return fragment_index;
+}
+
+template <typename NalTraits>
+bool RtpPacketizerH26x<NalTraits>::NextPacket(RtpPacketToSend* rtp_packet) {
+  RTC_DCHECK(rtp_packet);
+  if (packets_.empty()) {
+    return false;
+  }
+
+  PacketUnit packet = packets_.front();
+  if (packet.first_fragment && packet.last_fragment) {
+    // Single NAL unit packet.
+    size_t bytes_to_send = packet.source_fragment.size();
+    uint8_t* buffer = rtp_packet->AllocatePayload(bytes_to_send);
+    memcpy(buffer, packet.source_fragment.data(), bytes_to_send);
+    packets_.pop();
+    input_fragments_.pop_front();
+  } else if (packet.aggregated) {
+    NextAggregatePacket(rtp_packet);
+  } else {
+    NextFragmentPacket(rtp_packet);
+  }
+  rtp_packet->SetMarker(packets_.empty());
+  --num_packets_left_;
+  return true;
+}
+
+template <typename NalTraits>
+void RtpPacketizerH26x<NalTraits>::NextAggregatePacket(
+    RtpPacketToSend* rtp_packet) {
+  // Reserve maximum available payload, set actual payload size later.
+  size_t payload_capacity = rtp_packet->MaxPayloadSize();
+  RTC_CHECK_GE(payload_capacity, kNalHeaderSize);
+  uint8_t* buffer = rtp_packet->AllocatePayload(payload_capacity);
+  RTC_DCHECK(buffer);
+  PacketUnit* packet = &packets_.front();
+  RTC_CHECK(packet->first_fragment);
+  // The AP payload header carries the F bit if any aggregated NAL unit has
+  // it, and the lowest LayerId and TID of all of them (RFC 7798 4.4.2,
+  // RFC 9328 4.3.2).
+  bool forbidden_bit = false;
+  uint8_t layer_id = NalTraits::LayerId(packet->header);
+  uint8_t tid = NalTraits::Tid(packet->header);
+  size_t index = kNalHeaderSize;
+  bool is_last_fragment = packet->last_fragment;
+  while (packet->aggregated) {
+    rtc::ArrayView<const uint8_t> fragment = packet->source_fragment;
+    RTC_CHECK_LE(index + kLengthFieldSize + fragment.size(), payload_capacity);
+    forbidden_bit |= (packet->header & kH26xForbiddenBit) != 0;
+    layer_id = std::min(layer_id, NalTraits::LayerId(packet->header));
+    tid = std::min(tid, NalTraits::Tid(packet->header));
+    // Add NAL unit length field.
+    ByteWriter<uint16_t>::WriteBigEndian(&buffer[index], fragment.size());
+    index += kLengthFieldSize;
+    // Add NAL unit.
+    memcpy(&buffer[index], fragment.data(), fragment.size());
+    index += fragment.size();
+    packets_.pop();
+    input_fragments_.pop_front();
+    if (is_last_fragment)
+      break;
+    packet = &packets_.front();
+    is_last_fragment = packet->last_fragment;
+  }
+  RTC_CHECK(is_last_fragment);
+  // AP payload header.
+  const uint16_t ap_header = (forbidden_bit ? kH26xForbiddenBit : 0) |
+                             NalTraits::Header(NalTraits::kAp, layer_id, tid);
+  ByteWriter<uint16_t>::WriteBigEndian(buffer, ap_header);
+  rtp_packet->SetPayloadSize(index);
+}
+
+template <typename NalTraits>
+void RtpPacketizerH26x<NalTraits>::NextFragmentPacket(
+    RtpPacketToSend* rtp_packet) {
+  PacketUnit* packet = &packets_.front();
+  // NAL unit fragmented over multiple packets (FU).
+  // We do not send original NALU header, so it will be replaced by the
+  // payload header and FU header of every packet.
+  const uint16_t payload_header =
+      NalTraits::WithType(packet->header, NalTraits::kFu);
+  uint8_t fu_header = NalTraits::Type(packet->header);
+  fu_header |= (packet->first_fragment ? NalTraits::kFuSBit : 0);
+  fu_header |= (packet->last_fragment ? NalTraits::kFuEBit : 0);
+  fu_header |=
+      (packet->last_fragment && packet->last_vcl_nalu ? NalTraits::kFuPBit : 0);
+  rtc::ArrayView<const uint8_t> fragment = packet->source_fragment;
+  uint8_t* buffer =
+      rtp_packet->AllocatePayload(kFuHeaderSize + fragment.size());
+  ByteWriter<uint16_t>::WriteBigEndian(buffer, payload_header);
+  buffer[kNalHeaderSize] = fu_header;
+  memcpy(buffer + kFuHeaderSize, fragment.data(), fragment.size());
+  if (packet->last_fragment)
+    input_fragments_.pop_front();
+  packets_.pop();
+}
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H26X_H_
@@ -707,6 +707,51 @@ TEST(RtpPacketTest, ParseSecondPacketWithFewerExtensions) {
   EXPECT_FALSE(packet.HasExtension<AudioLevel>());
 }
 
+TEST(RtpPacketTest, CopiesAndParsesManyExtensions) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(1);
+  extensions.Register<AbsoluteSendTime>(2);
+  extensions.Register<TransportSequenceNumber>(3);
+  extensions.Register<VideoOrientation>(4);
+  extensions.Register<VideoContentTypeExtension>(5);
+  extensions.Register<RtpStreamId>(6);
+  extensions.Register<RepairedRtpStreamId>(7);
+  extensions.Register<RtpMid>(8);
+  extensions.Register<AudioLevel>(9);
+  extensions.Register<VideoFrameTrackingIdExtension>(10);
+  RtpPacketToSend packet(&extensions);
+  EXPECT_TRUE(packet.SetExtension<TransmissionOffset>(kTimeOffset));
+  EXPECT_TRUE(packet.SetExtension<AbsoluteSendTime>(0x123456));
+  EXPECT_TRUE(packet.SetExtension<TransportSequenceNumber>(kSeqNum));
+  EXPECT_TRUE(packet.SetExtension<VideoOrientation>(kVideoRotation_90));
+  EXPECT_TRUE(packet.SetExtension<VideoContentTypeExtension>(
+      VideoContentType::SCREENSHARE));
+  EXPECT_TRUE(packet.SetExtension<RtpStreamId>(kStreamId));
+  EXPECT_TRUE(packet.SetExtension<RepairedRtpStreamId>(kStreamId));
+  EXPECT_TRUE(packet.SetExtension<RtpMid>(kMid));
+  EXPECT_TRUE(packet.SetExtension<AudioLevel>(kVoiceActive, kAudioLevel));
+  EXPECT_TRUE(packet.SetExtension<VideoFrameTrackingIdExtension>(kSeqNum));
+
+  // Copies keep all the extensions.
+  RtpPacketToSend copy = packet;
+  EXPECT_EQ(copy.GetExtension<TransmissionOffset>(), kTimeOffset);
+  EXPECT_EQ(copy.GetExtension<VideoFrameTrackingIdExtension>(), kSeqNum);
+
+  RtpPacketReceived parsed(&extensions);
+  ASSERT_TRUE(parsed.Parse(copy.Buffer()));
+  EXPECT_EQ(parsed.GetExtension<TransmissionOffset>(), kTimeOffset);
+  EXPECT_EQ(parsed.GetExtension<AbsoluteSendTime>(), 0x123456u);
+  EXPECT_EQ(parsed.GetExtension<TransportSequenceNumber>(), kSeqNum);
+  EXPECT_EQ(parsed.GetExtension<VideoOrientation>(), kVideoRotation_90);
+  EXPECT_EQ(parsed.GetExtension<VideoContentTypeExtension>(),
+            VideoContentType::SCREENSHARE);
+  EXPECT_EQ(parsed.GetExtension<RtpStreamId>(), kStreamId);
+  EXPECT_EQ(parsed.GetExtension<RepairedRtpStreamId>(), kStreamId);
+  EXPECT_EQ(parsed.GetExtension<RtpMid>(), kMid);
+  EXPECT_TRUE(parsed.HasExtension<AudioLevel>());
+  EXPECT_EQ(parsed.GetExtension<VideoFrameTrackingIdExtension>(), kSeqNum);
+}
+
 TEST(RtpPacketTest, ParseWith2ExtensionsInvalidPadding) {
   RtpPacketToSend::ExtensionManager extensions;
   extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
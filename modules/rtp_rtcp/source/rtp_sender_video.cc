@@ -93,8 +93,9 @@ bool IsBaseLayer(const RTPVideoHeader& video_header) {
       // layers for H264.
       break;
     case kVideoCodecH265:
-      // TODO(bugs.webrtc.org/13485): Implement logic for H265 once WebRTC
-      // supports temporal layers for H265.
+    case kVideoCodecH266:
+      // TODO(bugs.webrtc.org/13485): Implement logic for H265 and H266 once
+      // WebRTC supports temporal layers for them.
       break;
     default:
       break;
@@ -180,8 +181,8 @@ void RTPSenderVideo::LogAndSendToNetwork(
         packetized_payload_size += packet->payload_size();
       }
     }
-    // AV1 and H264 packetizers may produce less packetized bytes than
-    // unpacketized.
+    // AV1, H264, H265 and H266 packetizers may produce less packetized bytes
+    // than unpacketized.
     if (packetized_payload_size >= encoder_output_size) {
       post_encode_overhead_bitrate_.Update(
           packetized_payload_size - encoder_output_size, clock_->CurrentTime());
@@ -464,6 +465,87 @@ bool RTPSenderVideo::SendVideo(int payload_type,
                                RTPVideoHeader video_header,
                                TimeDelta expected_retransmission_time,
                                std::vector<uint32_t> csrcs) {
+  RTC_CHECK_RUNS_SERIALIZED(&send_checker_);
+  if (frame_in_progress_) {
+    RTC_LOG(LS_WARNING) << "Frame " << frame_in_progress_->rtp_timestamp
+                        << " ended without its last part.";
+  }
+  bool sent = SendVideoInternal(
+      payload_type, codec_type, rtp_timestamp, capture_time, payload,
+      encoder_output_size, std::move(video_header),
+      expected_retransmission_time, std::move(csrcs),
+      /*first_part=*/true, /*last_part=*/true);
+  frame_in_progress_ = absl::nullopt;
+  return sent;
+}
+
+bool RTPSenderVideo::SendVideoPart(int payload_type,
+                                   absl::optional<VideoCodecType> codec_type,
+                                   uint32_t rtp_timestamp,
+                                   Timestamp capture_time,
+                                   rtc::ArrayView<const uint8_t> payload,
+                                   RTPVideoHeader video_header,
+                                   TimeDelta expected_retransmission_time,
+                                   bool last_part) {
+  RTC_CHECK_RUNS_SERIALIZED(&send_checker_);
+  if (!SupportsFrameParts(codec_type)) {
+    RTC_DCHECK_NOTREACHED();
+    return false;
+  }
+  if (frame_in_progress_ &&
+      frame_in_progress_->rtp_timestamp != rtp_timestamp) {
+    RTC_LOG(LS_WARNING) << "Frame " << frame_in_progress_->rtp_timestamp
+                        << " ended without its last part.";
+    frame_in_progress_ = absl::nullopt;
+  }
+  bool sent = SendVideoInternal(
+      payload_type, codec_type, rtp_timestamp, capture_time, payload,
+      payload.size(), std::move(video_header), expected_retransmission_time,
+      /*csrcs=*/{}, /*first_part=*/!frame_in_progress_, last_part);
+  if (!sent || last_part) {
+    // The rest of a frame that failed to send is useless to the receiver.
+    frame_in_progress_ = absl::nullopt;
+  }
+  return sent;
+}
+
+bool RTPSenderVideo::SupportsFrameParts(
+    absl::optional<VideoCodecType> codec_type) const {
+  if (frame_encryptor_ != nullptr || frame_transformer_delegate_) {
+    return false;
+  }
+  // Raw packetization and the NAL unit based formats packetize each part on
+  // its own. The payload descriptors of the other formats describe the
+  // position of the packet within the whole frame.
+  if (!codec_type.has_value()) {
+    return true;
+  }
+  switch (*codec_type) {
+    case kVideoCodecH264:
+#ifdef RTC_ENABLE_H265
+    case kVideoCodecH265:
+#endif
+#ifdef RTC_ENABLE_H266
+    case kVideoCodecH266:
+#endif
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool RTPSenderVideo::SendVideoInternal(
+    int payload_type,
+    absl::optional<VideoCodecType> codec_type,
+    uint32_t rtp_timestamp,
+    Timestamp capture_time,
+    rtc::ArrayView<const uint8_t> payload,
+    size_t encoder_output_size,
+    RTPVideoHeader video_header,
+    TimeDelta expected_retransmission_time,
+    std::vector<uint32_t> csrcs,
+    bool first_part,
+    bool last_part) {
   TRACE_EVENT_ASYNC_STEP1(
       "webrtc", "Video", capture_time.ms_or(0), "Send", "type",
       std::string(VideoFrameTypeToString(video_header.frame_type)));
@@ -479,38 +561,46 @@ bool RTPSenderVideo::SendVideo(int payload_type,
     return false;
   }
 
-  int32_t retransmission_settings = retransmission_settings_;
-  if (codec_type == VideoCodecType::kVideoCodecH264) {
-    // Backward compatibility for older receivers without temporal layer logic.
-    retransmission_settings = kRetransmitBaseLayer | kRetransmitHigherLayers;
-  }
   const uint8_t temporal_id = GetTemporalId(video_header);
-  // TODO(bugs.webrtc.org/10714): retransmission_settings_ should generally be
-  // replaced by expected_retransmission_time.IsFinite().
-  const bool allow_retransmission =
-      expected_retransmission_time.IsFinite() &&
-      AllowRetransmission(temporal_id, retransmission_settings,
-                          expected_retransmission_time);
-
-  MaybeUpdateCurrentPlayoutDelay(video_header);
-  if (video_header.frame_type == VideoFrameType::kVideoFrameKey) {
-    if (current_playout_delay_.has_value()) {
-      // Force playout delay on key-frames, if set.
-      playout_delay_pending_ = true;
+  if (first_part) {
+    int32_t retransmission_settings = retransmission_settings_;
+    if (codec_type == VideoCodecType::kVideoCodecH264) {
+      // Backward compatibility for older receivers without temporal layer
+      // logic.
+      retransmission_settings = kRetransmitBaseLayer | kRetransmitHigherLayers;
     }
-    if (allocation_) {
-      // Send the bitrate allocation on every key frame.
-      send_allocation_ = SendVideoLayersAllocation::kSendWithResolution;
+    frame_in_progress_.emplace();
+    frame_in_progress_->rtp_timestamp = rtp_timestamp;
+    // TODO(bugs.webrtc.org/10714): retransmission_settings_ should generally
+    // be replaced by expected_retransmission_time.IsFinite().
+    frame_in_progress_->allow_retransmission =
+        expected_retransmission_time.IsFinite() &&
+        AllowRetransmission(temporal_id, retransmission_settings,
+                            expected_retransmission_time);
+    frame_in_progress_->first_frame = first_frame_sent_();
+
+    MaybeUpdateCurrentPlayoutDelay(video_header);
+    if (video_header.frame_type == VideoFrameType::kVideoFrameKey) {
+      if (current_playout_delay_.has_value()) {
+        // Force playout delay on key-frames, if set.
+        playout_delay_pending_ = true;
+      }
+      if (allocation_) {
+        // Send the bitrate allocation on every key frame.
+        send_allocation_ = SendVideoLayersAllocation::kSendWithResolution;
+      }
     }
-  }
 
-  if (video_structure_ != nullptr && video_header.generic) {
-    active_decode_targets_tracker_.OnFrame(
-        video_structure_->decode_target_protected_by_chain,
-        video_header.generic->active_decode_targets,
-        video_header.frame_type == VideoFrameType::kVideoFrameKey,
-        video_header.generic->frame_id, video_header.generic->chain_diffs);
+    if (video_structure_ != nullptr && video_header.generic) {
+      active_decode_targets_tracker_.OnFrame(
+          video_structure_->decode_target_protected_by_chain,
+          video_header.generic->active_decode_targets,
+          video_header.frame_type == VideoFrameType::kVideoFrameKey,
+          video_header.generic->frame_id, video_header.generic->chain_diffs);
+    }
   }
+  RTC_DCHECK(frame_in_progress_);
+  const bool allow_retransmission = frame_in_progress_->allow_retransmission;
 
   // No FEC protection for upper temporal layers, if used.
   const bool use_fec = fec_type_.has_value() &&
@@ -534,9 +624,13 @@ bool RTPSenderVideo::SendVideo(int payload_type,
   if (capture_time.IsFinite())
     single_packet->set_capture_time(capture_time);
 
-  // Construct the absolute capture time extension if not provided.
-  if (!video_header.absolute_capture_time.has_value() &&
-      capture_time.IsFinite()) {
+  // The absolute capture time extension is only sent in the first packet of
+  // the frame.
+  if (!first_part) {
+    video_header.absolute_capture_time = absl::nullopt;
+  } else if (!video_header.absolute_capture_time.has_value() &&
+             capture_time.IsFinite()) {
+    // Construct the absolute capture time extension if not provided.
     video_header.absolute_capture_time.emplace();
     video_header.absolute_capture_time->absolute_capture_timestamp =
         Int64MsToUQ32x32(
@@ -559,10 +653,12 @@ bool RTPSenderVideo::SendVideo(int payload_type,
   auto middle_packet = std::make_unique<RtpPacketToSend>(*single_packet);
   auto last_packet = std::make_unique<RtpPacketToSend>(*single_packet);
   // Simplest way to estimate how much extensions would occupy is to set them.
+  // When the frame is sent in parts, only the first packet of the first part
+  // and the last packet of the last part carry the frame boundaries.
   AddRtpHeaderExtensions(video_header,
-                         /*first_packet=*/true, /*last_packet=*/true,
+                         /*first_packet=*/first_part, /*last_packet=*/last_part,
                          single_packet.get());
-  if (video_structure_ != nullptr &&
+  if (first_part && video_structure_ != nullptr &&
       single_packet->IsRegistered<RtpDependencyDescriptorExtension>() &&
       !single_packet->HasExtension<RtpDependencyDescriptorExtension>()) {
     RTC_DCHECK_EQ(video_header.frame_type, VideoFrameType::kVideoFrameKey);
@@ -575,13 +671,13 @@ bool RTPSenderVideo::SendVideo(int payload_type,
   }
 
   AddRtpHeaderExtensions(video_header,
-                         /*first_packet=*/true, /*last_packet=*/false,
+                         /*first_packet=*/first_part, /*last_packet=*/false,
                          first_packet.get());
   AddRtpHeaderExtensions(video_header,
                          /*first_packet=*/false, /*last_packet=*/false,
                          middle_packet.get());
   AddRtpHeaderExtensions(video_header,
-                         /*first_packet=*/false, /*last_packet=*/true,
+                         /*first_packet=*/false, /*last_packet=*/last_part,
                          last_packet.get());
 
   RTC_DCHECK_GT(packet_capacity, single_packet->headers_size());
@@ -650,7 +746,7 @@ bool RTPSenderVideo::SendVideo(int payload_type,
   if (num_packets == 0)
     return false;
 
-  bool first_frame = first_frame_sent_();
+  const bool first_frame = frame_in_progress_->first_frame;
   std::vector<std::unique_ptr<RtpPacketToSend>> rtp_packets;
   for (size_t i = 0; i < num_packets; ++i) {
     std::unique_ptr<RtpPacketToSend> packet;
@@ -673,10 +769,14 @@ bool RTPSenderVideo::SendVideo(int payload_type,
       expected_payload_capacity = limits.max_payload_len;
     }
 
-    packet->set_first_packet_of_frame(i == 0);
+    packet->set_first_packet_of_frame(first_part && i == 0);
 
     if (!packetizer->NextPacket(packet.get()))
       return false;
+    if (!last_part) {
+      // The packetizer marks the end of the part, not of the frame.
+      packet->SetMarker(false);
+    }
     RTC_DCHECK_LE(packet->payload_size(), expected_payload_capacity);
 
     packet->set_allow_retransmission(allow_retransmission);
@@ -708,11 +808,11 @@ bool RTPSenderVideo::SendVideo(int payload_type,
     }
 
     if (first_frame) {
-      if (i == 0) {
+      if (first_part && i == 0) {
         RTC_LOG(LS_INFO)
             << "Sent first RTP packet of the first video frame (pre-pacer)";
       }
-      if (i == num_packets - 1) {
+      if (last_part && i == num_packets - 1) {
         RTC_LOG(LS_INFO)
             << "Sent last RTP packet of the first video frame (pre-pacer)";
       }
@@ -721,6 +821,10 @@ bool RTPSenderVideo::SendVideo(int payload_type,
 
   LogAndSendToNetwork(std::move(rtp_packets), encoder_output_size);
 
+  if (!last_part) {
+    return true;
+  }
+
   // Update details about the last sent frame.
   last_rotation_ = video_header.rotation;
 
@@ -114,6 +114,27 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
                         RTPVideoHeader video_header,
                         TimeDelta expected_retransmission_time);
 
+  // Sends a self-contained part of a frame, e.g. a slice, before the rest of
+  // the frame is available. All parts of a frame must be sent in decoding
+  // order with the same `rtp_timestamp` and `video_header`, and `last_part`
+  // set on the final one. The marker bit and the end of frame signalling of
+  // the header extensions are only set on the last packet of the last part.
+  // Must only be used if SupportsFrameParts() returns true for `codec_type`.
+  // Calls to this method are assumed to be externally serialized.
+  bool SendVideoPart(int payload_type,
+                     absl::optional<VideoCodecType> codec_type,
+                     uint32_t rtp_timestamp,
+                     Timestamp capture_time,
+                     rtc::ArrayView<const uint8_t> payload,
+                     RTPVideoHeader video_header,
+                     TimeDelta expected_retransmission_time,
+                     bool last_part);
+
+  // Returns true if frames of `codec_type` can be sent in parts. This requires
+  // a packetization format in which every part is packetized on its own, and
+  // no frame transformer or frame encryptor, which need the complete frame.
+  bool SupportsFrameParts(absl::optional<VideoCodecType> codec_type) const;
+
   // Configures video structures produced by encoder to send using the
   // dependency descriptor rtp header extension. Next call to SendVideo should
   // have video_header.frame_type == kVideoFrameKey.
@@ -166,6 +187,25 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
     kDontSend
   };
 
+  // Decisions made once per frame, when sending its first part.
+  struct FrameInProgress {
+    uint32_t rtp_timestamp = 0;
+    bool allow_retransmission = false;
+    bool first_frame = false;
+  };
+
+  bool SendVideoInternal(int payload_type,
+                         absl::optional<VideoCodecType> codec_type,
+                         uint32_t rtp_timestamp,
+                         Timestamp capture_time,
+                         rtc::ArrayView<const uint8_t> payload,
+                         size_t encoder_output_size,
+                         RTPVideoHeader video_header,
+                         TimeDelta expected_retransmission_time,
+                         std::vector<uint32_t> csrcs,
+                         bool first_part,
+                         bool last_part);
+
   void SetVideoStructureInternal(
       const FrameDependencyStructure* video_structure);
   void SetVideoLayersAllocationInternal(VideoLayersAllocation allocation);
@@ -209,6 +249,9 @@ class RTPSenderVideo : public RTPVideoFrameSenderInterface {
   SendVideoLayersAllocation send_allocation_ RTC_GUARDED_BY(send_checker_);
   absl::optional<VideoLayersAllocation> last_full_sent_allocation_
       RTC_GUARDED_BY(send_checker_);
+  // Set while the parts of a frame are being sent with SendVideoPart().
+  absl::optional<FrameInProgress> frame_in_progress_
+      RTC_GUARDED_BY(send_checker_);
 
   // Current target playout delay.
   absl::optional<VideoPlayoutDelay> current_playout_delay_
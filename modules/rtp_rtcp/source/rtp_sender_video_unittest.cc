@@ -1439,6 +1439,96 @@ TEST_F(RtpSenderVideoTest, SendRawVideo) {
   EXPECT_THAT(sent_payload, ElementsAreArray(kPayload));
 }
 
+TEST_F(RtpSenderVideoTest, SupportsFramePartsOfIndependentlyPacketizedCodecs) {
+  EXPECT_TRUE(rtp_sender_video_->SupportsFrameParts(absl::nullopt));
+  EXPECT_TRUE(rtp_sender_video_->SupportsFrameParts(kVideoCodecH264));
+  EXPECT_FALSE(rtp_sender_video_->SupportsFrameParts(kVideoCodecGeneric));
+  EXPECT_FALSE(rtp_sender_video_->SupportsFrameParts(kVideoCodecVP8));
+  EXPECT_FALSE(rtp_sender_video_->SupportsFrameParts(kVideoCodecVP9));
+  EXPECT_FALSE(rtp_sender_video_->SupportsFrameParts(kVideoCodecAV1));
+}
+
+TEST_F(RtpSenderVideoTest, SetsMarkerOnlyOnLastPacketOfLastFramePart) {
+  const uint8_t kPayloadType = 111;
+  const uint8_t kParts[3][5] = {
+      {11, 12, 13, 14, 15}, {21, 22, 23, 24, 25}, {31, 32, 33, 34, 35}};
+
+  RTPVideoHeader video_header;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(rtp_sender_video_->SendVideoPart(
+        kPayloadType, absl::nullopt, kTimestamp, fake_clock_.CurrentTime(),
+        kParts[i], video_header, TimeDelta::PlusInfinity(),
+        /*last_part=*/i == 2));
+    // Each part is sent as soon as it is available.
+    ASSERT_EQ(transport_.packets_sent(), i + 1);
+  }
+
+  for (int i = 0; i < 3; ++i) {
+    const RtpPacketReceived& packet = transport_.sent_packets()[i];
+    EXPECT_EQ(packet.Timestamp(), kTimestamp);
+    EXPECT_EQ(packet.SequenceNumber(), kSeqNum + i);
+    EXPECT_EQ(packet.Marker(), i == 2);
+    EXPECT_THAT(packet.payload(), ElementsAreArray(kParts[i]));
+  }
+}
+
+TEST_F(RtpSenderVideoTest, SetsDependencyDescriptorFrameBoundariesOverParts) {
+  const int64_t kFrameId = 100000;
+  const uint8_t kPart[100] = {};
+  rtp_module_->RegisterRtpHeaderExtension(
+      RtpDependencyDescriptorExtension::Uri(), kDependencyDescriptorId);
+  FrameDependencyStructure video_structure;
+  video_structure.num_decode_targets = 1;
+  video_structure.templates = {FrameDependencyTemplate().Dtis("S")};
+  rtp_sender_video_->SetVideoStructure(&video_structure);
+
+  RTPVideoHeader hdr;
+  RTPVideoHeader::GenericDescriptorInfo& generic = hdr.generic.emplace();
+  generic.frame_id = kFrameId;
+  generic.decode_target_indications = {DecodeTargetIndication::kSwitch};
+  hdr.frame_type = VideoFrameType::kVideoFrameKey;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(rtp_sender_video_->SendVideoPart(
+        kPayload, absl::nullopt, kTimestamp, fake_clock_.CurrentTime(), kPart,
+        hdr, kDefaultExpectedRetransmissionTime, /*last_part=*/i == 2));
+  }
+
+  ASSERT_EQ(transport_.packets_sent(), 3);
+  for (int i = 0; i < 3; ++i) {
+    DependencyDescriptor descriptor;
+    ASSERT_TRUE(transport_.sent_packets()[i]
+                    .GetExtension<RtpDependencyDescriptorExtension>(
+                        &video_structure, &descriptor));
+    EXPECT_EQ(descriptor.first_packet_in_frame, i == 0);
+    EXPECT_EQ(descriptor.last_packet_in_frame, i == 2);
+    EXPECT_EQ(descriptor.attached_structure != nullptr, i == 0);
+    EXPECT_EQ(descriptor.frame_number, kFrameId & 0xFFFF);
+  }
+}
+
+TEST_F(RtpSenderVideoTest, StartsNewFrameWhenPartOfNextFrameArrives) {
+  const uint8_t kPayloadType = 111;
+  const uint8_t kPart[] = {1, 2, 3};
+
+  RTPVideoHeader video_header;
+  video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  ASSERT_TRUE(rtp_sender_video_->SendVideoPart(
+      kPayloadType, absl::nullopt, kTimestamp, fake_clock_.CurrentTime(),
+      kPart, video_header, TimeDelta::PlusInfinity(), /*last_part=*/false));
+  // The last part of the first frame never arrives.
+  video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+  ASSERT_TRUE(rtp_sender_video_->SendVideoPart(
+      kPayloadType, absl::nullopt, kTimestamp + 3000,
+      fake_clock_.CurrentTime(), kPart, video_header,
+      TimeDelta::PlusInfinity(), /*last_part=*/true));
+
+  ASSERT_EQ(transport_.packets_sent(), 2);
+  EXPECT_FALSE(transport_.sent_packets()[0].Marker());
+  EXPECT_EQ(transport_.sent_packets()[1].Timestamp(), kTimestamp + 3000);
+  EXPECT_TRUE(transport_.sent_packets()[1].Marker());
+}
+
 class RtpSenderVideoWithFrameTransformerTest : public ::testing::Test {
  public:
   RtpSenderVideoWithFrameTransformerTest()
@@ -1505,6 +1595,15 @@ TEST_F(RtpSenderVideoWithFrameTransformerTest,
   rtp_sender_video = nullptr;
 }
 
+TEST_F(RtpSenderVideoWithFrameTransformerTest,
+       DoesNotSupportFramePartsWithFrameTransformer) {
+  auto mock_frame_transformer =
+      rtc::make_ref_counted<NiceMock<MockFrameTransformer>>();
+  std::unique_ptr<RTPSenderVideo> rtp_sender_video =
+      CreateSenderWithFrameTransformer(mock_frame_transformer);
+  EXPECT_FALSE(rtp_sender_video->SupportsFrameParts(kVideoCodecH264));
+}
+
 TEST_F(RtpSenderVideoWithFrameTransformerTest,
        SendEncodedImageTransformsFrame) {
   auto mock_frame_transformer =
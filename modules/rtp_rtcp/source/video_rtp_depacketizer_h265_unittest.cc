@@ -0,0 +1,269 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_h265.h"
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "common_video/h265/h265_common.h"
+#include "modules/rtp_rtcp/source/rtp_format_h265.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+// PayloadHdr/NAL unit header bytes with LayerId 0 and TID 1.
+constexpr uint8_t kTrailR = H265::NaluType::kTrailR << 1;
+constexpr uint8_t kIdrWRadl = H265::NaluType::kIdrWRadl << 1;
+constexpr uint8_t kVps = H265::NaluType::kVps << 1;
+constexpr uint8_t kSps = H265::NaluType::kSps << 1;
+constexpr uint8_t kPps = H265::NaluType::kPps << 1;
+constexpr uint8_t kAp = H265::NaluType::kAP << 1;
+constexpr uint8_t kFu = H265::NaluType::kFU << 1;
+constexpr uint8_t kTid1 = 0x01;
+
+// 1280x720 SPS produced by libx265, including its NAL unit header.
+constexpr uint8_t kSps720p[] = {
+    kSps, kTid1, 0x01, 0x04, 0x08, 0x00, 0x00, 0x03, 0x00, 0x9d,
+    0x08, 0x00,  0x00, 0x03, 0x00, 0x00, 0x5d, 0xb0, 0x02, 0x80,
+    0x80, 0x2d,  0x16, 0x59, 0x59, 0xa4, 0x93, 0x2b, 0x80, 0x40,
+    0x00, 0x00,  0x03, 0x00, 0x40, 0x00, 0x00, 0x07, 0x82};
+
+TEST(VideoRtpDepacketizerH265Test, SingleNalu) {
+  uint8_t packet[] = {kIdrWRadl, kTid1, 0xFF};
+  rtc::CopyOnWriteBuffer rtp_payload(packet);
+
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_payload, rtp_payload);
+  // The payload is passed on without being copied.
+  EXPECT_EQ(parsed->video_payload.cdata(), rtp_payload.cdata());
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(parsed->video_header.codec, kVideoCodecH265);
+  EXPECT_TRUE(parsed->video_header.is_first_packet_in_frame);
+}
+
+TEST(VideoRtpDepacketizerH265Test, SingleNaluSpsWithResolution) {
+  rtc::CopyOnWriteBuffer rtp_payload(kSps720p);
+
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameDelta);
+  EXPECT_EQ(parsed->video_header.width, 1280u);
+  EXPECT_EQ(parsed->video_header.height, 720u);
+}
+
+TEST(VideoRtpDepacketizerH265Test, ApKey) {
+  // clang-format off
+  const uint8_t packet[] = {kAp, kTid1,
+                            0, 3, kVps, kTid1, 0xAA,
+                            0, 3, kPps, kTid1, 0xBB,
+                            0, 3, kIdrWRadl, kTid1, 0xCC};
+  // clang-format on
+  rtc::CopyOnWriteBuffer rtp_payload(packet);
+
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_payload, rtp_payload);
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_TRUE(parsed->video_header.is_first_packet_in_frame);
+}
+
+TEST(VideoRtpDepacketizerH265Test, ApDelta) {
+  // clang-format off
+  const uint8_t packet[] = {kAp, kTid1,
+                            0, 3, kTrailR, kTid1, 0xAA,
+                            0, 4, kTrailR, kTid1, 0xBB, 0xCC};
+  // clang-format on
+  rtc::CopyOnWriteBuffer rtp_payload(packet);
+
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameDelta);
+}
+
+TEST(VideoRtpDepacketizerH265Test, ApSpsWithResolution) {
+  std::vector<uint8_t> packet = {kAp, kTid1, 0, sizeof(kSps720p)};
+  packet.insert(packet.end(), std::begin(kSps720p), std::end(kSps720p));
+  packet.insert(packet.end(), {0, 3, kIdrWRadl, kTid1, 0xCC});
+  rtc::CopyOnWriteBuffer rtp_payload(packet);
+
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(parsed->video_header.width, 1280u);
+  EXPECT_EQ(parsed->video_header.height, 720u);
+}
+
+TEST(VideoRtpDepacketizerH265Test, Fu) {
+  // clang-format off
+  const uint8_t packet1[] = {kFu, kTid1,
+                             kH265SBit | H265::NaluType::kIdrWRadl,
+                             0x01, 0x02};
+  const uint8_t packet2[] = {kFu, kTid1, H265::NaluType::kIdrWRadl,
+                             0x03};
+  const uint8_t packet3[] = {kFu, kTid1,
+                             kH265EBit | H265::NaluType::kIdrWRadl,
+                             0x04, 0x05};
+  // clang-format on
+
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed1 =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(packet1));
+  ASSERT_TRUE(parsed1);
+  EXPECT_EQ(parsed1->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_TRUE(parsed1->video_header.is_first_packet_in_frame);
+
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed2 =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(packet2));
+  ASSERT_TRUE(parsed2);
+  EXPECT_FALSE(parsed2->video_header.is_first_packet_in_frame);
+
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed3 =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(packet3));
+  ASSERT_TRUE(parsed3);
+  EXPECT_FALSE(parsed3->video_header.is_first_packet_in_frame);
+
+  const rtc::ArrayView<const uint8_t> payloads[] = {
+      parsed1->video_payload, parsed2->video_payload, parsed3->video_payload};
+  rtc::scoped_refptr<EncodedImageBuffer> frame =
+      depacketizer.AssembleFrame(payloads);
+  ASSERT_TRUE(frame);
+  EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+              ElementsAre(0, 0, 0, 1, kIdrWRadl, kTid1, 0x01, 0x02, 0x03,
+                          0x04, 0x05));
+}
+
+TEST(VideoRtpDepacketizerH265Test, AssembleFrameFromMixedPackets) {
+  // clang-format off
+  const uint8_t ap[] = {kAp, kTid1,
+                        0, 3, kVps, kTid1, 0xAA,
+                        0, 4, kSps, kTid1, 0xBB, 0xBC};
+  const uint8_t single[] = {kPps, kTid1, 0xCC};
+  const uint8_t fu1[] = {kFu, kTid1, kH265SBit | H265::NaluType::kIdrWRadl,
+                         0xDD};
+  const uint8_t fu2[] = {kFu, kTid1, kH265EBit | H265::NaluType::kIdrWRadl,
+                         0xEE};
+  // clang-format on
+  const rtc::ArrayView<const uint8_t> payloads[] = {ap, single, fu1, fu2};
+
+  VideoRtpDepacketizerH265 depacketizer;
+  rtc::scoped_refptr<EncodedImageBuffer> frame =
+      depacketizer.AssembleFrame(payloads);
+  ASSERT_TRUE(frame);
+  // clang-format off
+  const uint8_t kExpected[] = {0, 0, 0, 1, kVps, kTid1, 0xAA,
+                               0, 0, 0, 1, kSps, kTid1, 0xBB, 0xBC,
+                               0, 0, 0, 1, kPps, kTid1, 0xCC,
+                               0, 0, 0, 1, kIdrWRadl, kTid1, 0xDD, 0xEE};
+  // clang-format on
+  EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+              ElementsAreArray(kExpected));
+}
+
+TEST(VideoRtpDepacketizerH265Test, RoundTripsPacketizedFrame) {
+  std::vector<uint8_t> frame = {0, 0, 0, 1, kVps, kTid1, 0xAA,
+                                0, 0, 0, 1, kIdrWRadl, kTid1};
+  for (int i = 0; i < 3000; ++i) {
+    frame.push_back(0x10 | (i & 0x0F));
+  }
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1000;
+  RtpPacketizerH265 packetizer(frame, limits);
+
+  VideoRtpDepacketizerH265 depacketizer;
+  std::vector<rtc::CopyOnWriteBuffer> payloads;
+  RtpPacketToSend rtp_packet(/*extensions=*/nullptr);
+  while (packetizer.NextPacket(&rtp_packet)) {
+    absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+        depacketizer.Parse(rtp_packet.PayloadBuffer());
+    ASSERT_TRUE(parsed);
+    payloads.push_back(parsed->video_payload);
+  }
+  ASSERT_GT(payloads.size(), 3u);
+
+  std::vector<rtc::ArrayView<const uint8_t>> payload_views(payloads.begin(),
+                                                           payloads.end());
+  rtc::scoped_refptr<EncodedImageBuffer> assembled =
+      depacketizer.AssembleFrame(payload_views);
+  ASSERT_TRUE(assembled);
+  EXPECT_THAT(rtc::MakeArrayView(assembled->data(), assembled->size()),
+              ElementsAreArray(frame));
+}
+
+TEST(VideoRtpDepacketizerH265Test, EmptyPayload) {
+  rtc::CopyOnWriteBuffer empty;
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(empty));
+}
+
+TEST(VideoRtpDepacketizerH265Test, TruncatedPayloadHeader) {
+  const uint8_t kPayload[] = {kTrailR};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, TruncatedFuNalu) {
+  const uint8_t kPayload[] = {kFu, kTid1, kH265SBit | H265::NaluType::kTrailR};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, EmptyApRejected) {
+  const uint8_t kPayload[] = {kAp, kTid1};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, ApPacketWithTruncatedNalUnits) {
+  const uint8_t kPayload[] = {kAp, kTid1, 0, 5, kTrailR, kTid1, 0xAA};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, TruncationJustAfterSingleApNalu) {
+  const uint8_t kPayload[] = {kAp, kTid1, 0, 3, kTrailR, kTid1, 0xAA, 0};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, PaciRejected) {
+  const uint8_t kPayload[] = {50 << 1, kTid1, 0x00, 0x00};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+}  // namespace
+}  // namespace webrtc
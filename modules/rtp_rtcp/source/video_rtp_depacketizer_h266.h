@@ -0,0 +1,23 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H266_H_
+#define MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H266_H_
+
+#include "modules/rtp_rtcp/source/rtp_format_h266.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_h26x.h"
+
+namespace webrtc {
+
+using VideoRtpDepacketizerH266 = VideoRtpDepacketizerH26x<H266NalTraits>;
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H266_H_
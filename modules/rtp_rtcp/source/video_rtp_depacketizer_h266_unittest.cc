@@ -0,0 +1,272 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_h266.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "common_video/h266/h266_common.h"
+#include "modules/rtp_rtcp/source/rtp_format_h266.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+// First PayloadHdr/NAL unit header byte: F = 0, Z = 0, LayerId 0.
+constexpr uint8_t kLayer0 = 0x00;
+// Second PayloadHdr/NAL unit header byte for the given type with TID 1.
+constexpr uint8_t TypeByte(H266NaluType type) {
+  return static_cast<uint8_t>(type << 3 | 1);
+}
+constexpr uint8_t kTrail = TypeByte(kH266TrailNut);
+constexpr uint8_t kIdrWRadl = TypeByte(kH266IdrWRadlNut);
+constexpr uint8_t kCra = TypeByte(kH266CraNut);
+constexpr uint8_t kGdr = TypeByte(kH266GdrNut);
+constexpr uint8_t kVps = TypeByte(kH266VpsNut);
+constexpr uint8_t kSps = TypeByte(kH266SpsNut);
+constexpr uint8_t kPps = TypeByte(kH266PpsNut);
+constexpr uint8_t kAp = TypeByte(kH266Ap);
+constexpr uint8_t kFu = TypeByte(kH266Fu);
+
+TEST(VideoRtpDepacketizerH266Test, SingleNalu) {
+  uint8_t packet[] = {kLayer0, kIdrWRadl, 0xFF};
+  rtc::CopyOnWriteBuffer rtp_payload(packet);
+
+  VideoRtpDepacketizerH266 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_payload, rtp_payload);
+  // The payload is passed on without being copied.
+  EXPECT_EQ(parsed->video_payload.cdata(), rtp_payload.cdata());
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(parsed->video_header.codec, kVideoCodecH266);
+  EXPECT_TRUE(parsed->video_header.is_first_packet_in_frame);
+}
+
+TEST(VideoRtpDepacketizerH266Test, CraIsKeyFrameGdrIsNot) {
+  const uint8_t cra[] = {kLayer0, kCra, 0xFF};
+  const uint8_t gdr[] = {kLayer0, kGdr, 0xFF};
+
+  VideoRtpDepacketizerH266 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(cra));
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+
+  parsed = depacketizer.Parse(rtc::CopyOnWriteBuffer(gdr));
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameDelta);
+}
+
+TEST(VideoRtpDepacketizerH266Test, ApKey) {
+  // clang-format off
+  const uint8_t packet[] = {kLayer0, kAp,
+                            0, 3, kLayer0, kSps, 0xAA,
+                            0, 3, kLayer0, kPps, 0xBB,
+                            0, 3, kLayer0, kIdrWRadl, 0xCC};
+  // clang-format on
+  rtc::CopyOnWriteBuffer rtp_payload(packet);
+
+  VideoRtpDepacketizerH266 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_payload, rtp_payload);
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_TRUE(parsed->video_header.is_first_packet_in_frame);
+}
+
+TEST(VideoRtpDepacketizerH266Test, ApDelta) {
+  // clang-format off
+  const uint8_t packet[] = {kLayer0, kAp,
+                            0, 3, kLayer0, kTrail, 0xAA,
+                            0, 4, kLayer0, kTrail, 0xBB, 0xCC};
+  // clang-format on
+  rtc::CopyOnWriteBuffer rtp_payload(packet);
+
+  VideoRtpDepacketizerH266 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtp_payload);
+  ASSERT_TRUE(parsed);
+
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameDelta);
+}
+
+TEST(VideoRtpDepacketizerH266Test, Fu) {
+  // clang-format off
+  const uint8_t packet1[] = {kLayer0, kFu, kH266SBit | kH266IdrWRadlNut,
+                             0x01, 0x02};
+  const uint8_t packet2[] = {kLayer0, kFu, kH266IdrWRadlNut, 0x03};
+  const uint8_t packet3[] = {kLayer0, kFu,
+                             kH266EBit | kH266PBit | kH266IdrWRadlNut,
+                             0x04, 0x05};
+  // clang-format on
+
+  VideoRtpDepacketizerH266 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed1 =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(packet1));
+  ASSERT_TRUE(parsed1);
+  EXPECT_EQ(parsed1->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_TRUE(parsed1->video_header.is_first_packet_in_frame);
+
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed2 =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(packet2));
+  ASSERT_TRUE(parsed2);
+  EXPECT_FALSE(parsed2->video_header.is_first_packet_in_frame);
+
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed3 =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(packet3));
+  ASSERT_TRUE(parsed3);
+  EXPECT_FALSE(parsed3->video_header.is_first_packet_in_frame);
+
+  const rtc::ArrayView<const uint8_t> payloads[] = {
+      parsed1->video_payload, parsed2->video_payload, parsed3->video_payload};
+  rtc::scoped_refptr<EncodedImageBuffer> frame =
+      depacketizer.AssembleFrame(payloads);
+  ASSERT_TRUE(frame);
+  EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+              ElementsAre(0, 0, 0, 1, kLayer0, kIdrWRadl, 0x01, 0x02, 0x03,
+                          0x04, 0x05));
+}
+
+TEST(VideoRtpDepacketizerH266Test, FuRestoresLayerIdAndTid) {
+  // LayerId 5 and TID 3 are carried in the payload header only.
+  const uint8_t packet1[] = {0x05, kH266Fu << 3 | 3,
+                             kH266SBit | kH266TrailNut, 0x01};
+  const uint8_t packet2[] = {0x05, kH266Fu << 3 | 3,
+                             kH266EBit | kH266TrailNut, 0x02};
+  const rtc::ArrayView<const uint8_t> payloads[] = {packet1, packet2};
+
+  VideoRtpDepacketizerH266 depacketizer;
+  rtc::scoped_refptr<EncodedImageBuffer> frame =
+      depacketizer.AssembleFrame(payloads);
+  ASSERT_TRUE(frame);
+  EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+              ElementsAre(0, 0, 0, 1, 0x05, kH266TrailNut << 3 | 3, 0x01,
+                          0x02));
+}
+
+TEST(VideoRtpDepacketizerH266Test, AssembleFrameFromMixedPackets) {
+  // clang-format off
+  const uint8_t ap[] = {kLayer0, kAp,
+                        0, 3, kLayer0, kVps, 0xAA,
+                        0, 4, kLayer0, kSps, 0xBB, 0xBC};
+  const uint8_t single[] = {kLayer0, kPps, 0xCC};
+  const uint8_t fu1[] = {kLayer0, kFu, kH266SBit | kH266IdrWRadlNut, 0xDD};
+  const uint8_t fu2[] = {kLayer0, kFu, kH266EBit | kH266IdrWRadlNut, 0xEE};
+  // clang-format on
+  const rtc::ArrayView<const uint8_t> payloads[] = {ap, single, fu1, fu2};
+
+  VideoRtpDepacketizerH266 depacketizer;
+  rtc::scoped_refptr<EncodedImageBuffer> frame =
+      depacketizer.AssembleFrame(payloads);
+  ASSERT_TRUE(frame);
+  // clang-format off
+  const uint8_t kExpected[] = {0, 0, 0, 1, kLayer0, kVps, 0xAA,
+                               0, 0, 0, 1, kLayer0, kSps, 0xBB, 0xBC,
+                               0, 0, 0, 1, kLayer0, kPps, 0xCC,
+                               0, 0, 0, 1, kLayer0, kIdrWRadl, 0xDD, 0xEE};
+  // clang-format on
+  EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+              ElementsAreArray(kExpected));
+}
+
+TEST(VideoRtpDepacketizerH266Test, RoundTripsPacketizedFrame) {
+  std::vector<uint8_t> frame = {0, 0, 0, 1, kLayer0, kSps,      0xAA,
+                                0, 0, 0, 1, kLayer0, kIdrWRadl};
+  for (int i = 0; i < 3000; ++i) {
+    frame.push_back(0x10 | (i & 0x0F));
+  }
+  RtpPacketizer::PayloadSizeLimits limits;
+  limits.max_payload_len = 1000;
+  RtpPacketizerH266 packetizer(frame, limits);
+
+  VideoRtpDepacketizerH266 depacketizer;
+  std::vector<rtc::CopyOnWriteBuffer> payloads;
+  RtpPacketToSend rtp_packet(/*extensions=*/nullptr);
+  while (packetizer.NextPacket(&rtp_packet)) {
+    absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+        depacketizer.Parse(rtp_packet.PayloadBuffer());
+    ASSERT_TRUE(parsed);
+    payloads.push_back(parsed->video_payload);
+  }
+  ASSERT_GT(payloads.size(), 3u);
+
+  std::vector<rtc::ArrayView<const uint8_t>> payload_views(payloads.begin(),
+                                                           payloads.end());
+  rtc::scoped_refptr<EncodedImageBuffer> assembled =
+      depacketizer.AssembleFrame(payload_views);
+  ASSERT_TRUE(assembled);
+  EXPECT_THAT(rtc::MakeArrayView(assembled->data(), assembled->size()),
+              ElementsAreArray(frame));
+}
+
+TEST(VideoRtpDepacketizerH266Test, EmptyPayload) {
+  rtc::CopyOnWriteBuffer empty;
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(empty));
+}
+
+TEST(VideoRtpDepacketizerH266Test, TruncatedPayloadHeader) {
+  const uint8_t kPayload[] = {kLayer0};
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH266Test, TruncatedFuNalu) {
+  const uint8_t kPayload[] = {kLayer0, kFu, kH266SBit | kH266TrailNut};
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH266Test, FuCarryingApRejected) {
+  const uint8_t kPayload[] = {kLayer0, kFu, kH266SBit | kH266Ap, 0xAA};
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH266Test, EmptyApRejected) {
+  const uint8_t kPayload[] = {kLayer0, kAp};
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH266Test, ApPacketWithTruncatedNalUnits) {
+  const uint8_t kPayload[] = {kLayer0, kAp, 0, 5, kLayer0, kTrail, 0xAA};
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH266Test, TruncationJustAfterSingleApNalu) {
+  const uint8_t kPayload[] = {kLayer0, kAp, 0, 3, kLayer0, kTrail, 0xAA, 0};
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+TEST(VideoRtpDepacketizerH266Test, UnspecifiedPayloadTypeRejected) {
+  const uint8_t kPayload[] = {kLayer0, TypeByte(kH266UnspecifiedNut), 0x00};
+  VideoRtpDepacketizerH266 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayload)));
+}
+
+}  // namespace
+}  // namespace webrtc
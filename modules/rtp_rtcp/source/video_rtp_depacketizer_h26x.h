@@ -0,0 +1,229 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H26X_H_
+#define MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H26X_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "api/video/resolution.h"
+#include "api/video/video_frame_type.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+// Depacketizes RFC 7798 / RFC 9328 payloads without DONL fields (single NAL
+// unit, AP and FU packets), see rtp_format_h26x.h for `NalTraits`. Parse()
+// only validates the payload and fills in the video header; the payload itself
+// is passed on untouched. The Annex B bitstream is built by AssembleFrame(),
+// which writes start codes, unpacks APs and joins FUs directly into the frame
+// buffer, so every payload byte is copied once.
+template <typename NalTraits>
+class VideoRtpDepacketizerH26x : public VideoRtpDepacketizer {
+ public:
+  ~VideoRtpDepacketizerH26x() override = default;
+
+  absl::optional<ParsedRtpPayload> Parse(
+      rtc::CopyOnWriteBuffer rtp_payload) override;
+  rtc::scoped_refptr<EncodedImageBuffer> AssembleFrame(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads)
+      override;
+
+ private:
+  static constexpr size_t kNalHeaderSize = 2;
+  static constexpr size_t kFuHeaderSize = kNalHeaderSize + 1;
+  static constexpr size_t kLengthFieldSize = 2;
+  static constexpr uint8_t kStartCode[] = {0, 0, 0, 1};
+
+  static uint8_t NaluType(rtc::ArrayView<const uint8_t> nalu) {
+    return NalTraits::Type(ByteReader<uint16_t>::ReadBigEndian(nalu.data()));
+  }
+
+  // Calls `nalu_callback` with every NAL unit (including its header) that is
+  // aggregated in the AP `payload`. Returns false if the AP is malformed.
+  template <typename NaluCallback>
+  static bool ForEachAggregatedNalu(rtc::ArrayView<const uint8_t> payload,
+                                    NaluCallback nalu_callback);
+
+  // Updates `video_header` with what can be learned from the (unfragmented)
+  // NAL unit `nalu`.
+  static void InspectNalu(rtc::ArrayView<const uint8_t> nalu,
+                          RTPVideoHeader& video_header);
+};
+
+template <typename NalTraits>
+template <typename NaluCallback>
+bool VideoRtpDepacketizerH26x<NalTraits>::ForEachAggregatedNalu(
+    rtc::ArrayView<const uint8_t> payload,
+    NaluCallback nalu_callback) {
+  size_t offset = kNalHeaderSize;
+  if (payload.size() <= offset)
+    return false;
+  while (offset < payload.size()) {
+    if (payload.size() - offset < kLengthFieldSize)
+      return false;
+    const size_t nalu_size =
+        ByteReader<uint16_t>::ReadBigEndian(&payload[offset]);
+    offset += kLengthFieldSize;
+    if (nalu_size < kNalHeaderSize || nalu_size > payload.size() - offset)
+      return false;
+    nalu_callback(payload.subview(offset, nalu_size));
+    offset += nalu_size;
+  }
+  return true;
+}
+
+template <typename NalTraits>
+void VideoRtpDepacketizerH26x<NalTraits>::InspectNalu(
+    rtc::ArrayView<const uint8_t> nalu,
+    RTPVideoHeader& video_header) {
+  const uint8_t type = NaluType(nalu);
+  if (NalTraits::IsIrap(type)) {
+    video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  } else if (type == NalTraits::kSps) {
+    absl::optional<Resolution> resolution =
+        NalTraits::ParseSpsResolution(nalu.subview(kNalHeaderSize));
+    if (resolution) {
+      video_header.width = resolution->width;
+      video_header.height = resolution->height;
+    }
+  }
+}
+
+template <typename NalTraits>
+absl::optional<VideoRtpDepacketizer::ParsedRtpPayload>
+VideoRtpDepacketizerH26x<NalTraits>::Parse(rtc::CopyOnWriteBuffer rtp_payload) {
+  if (rtp_payload.size() < kNalHeaderSize) {
+    RTC_LOG(LS_ERROR) << NalTraits::kName << " payload truncated.";
+    return absl::nullopt;
+  }
+  rtc::ArrayView<const uint8_t> payload(rtp_payload.cdata(),
+                                        rtp_payload.size());
+
+  absl::optional<ParsedRtpPayload> parsed_payload(absl::in_place);
+  RTPVideoHeader& video_header = parsed_payload->video_header;
+  video_header.codec = NalTraits::kCodecType;
+  video_header.width = 0;
+  video_header.height = 0;
+  video_header.simulcastIdx = 0;
+  video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+  // Frame boundaries cannot be told from the payload alone; the packet buffer
+  // determines them from RTP timestamps and the marker bit.
+  video_header.is_first_packet_in_frame = true;
+
+  const uint8_t nal_type = NaluType(payload);
+  if (nal_type == NalTraits::kAp) {
+    if (!ForEachAggregatedNalu(
+            payload, [&](auto nalu) { InspectNalu(nalu, video_header); })) {
+      RTC_LOG(LS_ERROR) << "AP packet with incorrect NALU packet lengths.";
+      return absl::nullopt;
+    }
+  } else if (nal_type == NalTraits::kFu) {
+    if (payload.size() <= kFuHeaderSize) {
+      RTC_LOG(LS_ERROR) << "FU NAL unit truncated.";
+      return absl::nullopt;
+    }
+    const uint8_t fu_header = payload[kNalHeaderSize];
+    const bool first_fragment = (fu_header & NalTraits::kFuSBit) != 0;
+    const uint8_t original_type = fu_header & NalTraits::kFuTypeMask;
+    if (original_type == NalTraits::kAp || original_type == NalTraits::kFu) {
+      RTC_LOG(LS_WARNING) << "Unexpected AP or FU inside FU.";
+      return absl::nullopt;
+    }
+    video_header.is_first_packet_in_frame = first_fragment;
+    if (first_fragment && NalTraits::IsIrap(original_type))
+      video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  } else if (nal_type > NalTraits::kFu) {
+    // PACI, reserved and unspecified payload types.
+    RTC_LOG(LS_WARNING) << "Unsupported " << NalTraits::kName
+                        << " payload type " << static_cast<int>(nal_type);
+    return absl::nullopt;
+  } else {
+    InspectNalu(payload, video_header);
+  }
+
+  parsed_payload->video_payload = std::move(rtp_payload);
+  return parsed_payload;
+}
+
+template <typename NalTraits>
+rtc::scoped_refptr<EncodedImageBuffer>
+VideoRtpDepacketizerH26x<NalTraits>::AssembleFrame(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> rtp_payloads) {
+  // The payloads were validated by Parse(), so only sizes need computing
+  // before the single copy into the frame buffer.
+  size_t frame_size = 0;
+  for (rtc::ArrayView<const uint8_t> payload : rtp_payloads) {
+    const uint8_t nal_type = NaluType(payload);
+    if (nal_type == NalTraits::kAp) {
+      ForEachAggregatedNalu(payload, [&](auto nalu) {
+        frame_size += sizeof(kStartCode) + nalu.size();
+      });
+    } else if (nal_type == NalTraits::kFu) {
+      frame_size += payload.size() - kFuHeaderSize;
+      if (payload[kNalHeaderSize] & NalTraits::kFuSBit)
+        frame_size += sizeof(kStartCode) + kNalHeaderSize;
+    } else {
+      frame_size += sizeof(kStartCode) + payload.size();
+    }
+  }
+
+  rtc::scoped_refptr<EncodedImageBuffer> bitstream =
+      EncodedImageBuffer::Create(frame_size);
+  uint8_t* write_at = bitstream->data();
+  auto append = [&](rtc::ArrayView<const uint8_t> data) {
+    memcpy(write_at, data.data(), data.size());
+    write_at += data.size();
+  };
+  for (rtc::ArrayView<const uint8_t> payload : rtp_payloads) {
+    const uint8_t nal_type = NaluType(payload);
+    if (nal_type == NalTraits::kAp) {
+      ForEachAggregatedNalu(payload, [&](auto nalu) {
+        append(kStartCode);
+        append(nalu);
+      });
+    } else if (nal_type == NalTraits::kFu) {
+      const uint8_t fu_header = payload[kNalHeaderSize];
+      if (fu_header & NalTraits::kFuSBit) {
+        // Restore the original NAL unit header from the payload header and
+        // the FU type.
+        uint8_t nal_header[kNalHeaderSize];
+        ByteWriter<uint16_t>::WriteBigEndian(
+            nal_header, NalTraits::WithType(
+                            ByteReader<uint16_t>::ReadBigEndian(payload.data()),
+                            fu_header & NalTraits::kFuTypeMask));
+        append(kStartCode);
+        append(nal_header);
+      }
+      append(payload.subview(kFuHeaderSize));
+    } else {
+      append(kStartCode);
+      append(payload);
+    }
+  }
+  RTC_DCHECK_EQ(write_at - bitstream->data(), bitstream->size());
+  return bitstream;
+}
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H26X_H_
@@ -23,6 +23,7 @@
 #include "api/field_trials_view.h"
 #include "api/scoped_refptr.h"
 #include "api/transport/field_trial_based_config.h"
+#include "api/units/time_delta.h"
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame.h"
@@ -34,9 +35,12 @@
 #include "modules/video_coding/svc/create_scalability_structure.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
 #include "modules/video_coding/svc/scalable_video_controller_no_layering.h"
+#include "modules/video_coding/utility/encode_speed_controller.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/time_utils.h"
 #include "third_party/libaom/source/libaom/aom/aom_codec.h"
 #include "third_party/libaom/source/libaom/aom/aom_encoder.h"
 #include "third_party/libaom/source/libaom/aom/aomcx.h"
@@ -61,6 +65,14 @@ constexpr int kLagInFrames = 0;  // No look ahead.
 constexpr int kRtpTicksPerSecond = 90000;
 constexpr double kMinimumFrameRate = 1.0;
 
+// Range of real-time speeds used when the speed is adapted to the encode time.
+// A static speed outside of this range is still used as is when no adaptation
+// is needed.
+constexpr int kMinAdaptiveCpuSpeed = 6;
+constexpr int kMaxAdaptiveCpuSpeed = 10;
+// Max number of steps slower than the static speed the adaptation may use.
+constexpr int kMaxAdaptiveSpeedDecrease = 2;
+
 aom_superblock_size_t GetSuperblockSize(int width, int height, int threads) {
   int resolution = width * height;
   if (threads >= 4 && resolution >= 960 * 540 && resolution < 1920 * 1080)
@@ -100,6 +112,12 @@ class LibaomAv1Encoder final : public VideoEncoder {
   // Determine number of encoder threads to use.
   int NumberOfThreads(int width, int height, int number_of_cores);
 
+  // Returns `cpu_speed_` adapted to the encode time if `speed_controller_` is
+  // enabled.
+  int AdaptedCpuSpeed() const;
+  // Applies a new setting of `speed_controller_` to the encoder.
+  void ApplyEncodeSpeedSetting();
+
   bool SvcEnabled() const { return svc_params_.has_value(); }
   // Fills svc_params_ memeber value. Returns false on error.
   bool SetSvcParams(ScalableVideoController::StreamLayersConfig svc_config);
@@ -125,6 +143,11 @@ class LibaomAv1Encoder final : public VideoEncoder {
   EncodedImageCallback* encoded_image_callback_;
   int64_t timestamp_;
   const LibaomAv1EncoderInfoSettings encoder_info_override_;
+  // Static cpu_speed setting, based on resolution and complexity.
+  int cpu_speed_;
+  // Adapts the speed and number of threads to the measured encode time, if
+  // enabled through VideoEncoder::Settings::target_encode_time_fraction.
+  std::unique_ptr<EncodeSpeedController> speed_controller_;
   // TODO(webrtc:15225): Kill switch for disabling frame dropping. Remove it
   // after frame dropping is fully rolled out.
   bool disable_frame_dropping_;
@@ -167,6 +190,7 @@ LibaomAv1Encoder::LibaomAv1Encoder(
       frame_for_encode_(nullptr),
       encoded_image_callback_(nullptr),
       timestamp_(0),
+      cpu_speed_(0),
       disable_frame_dropping_(absl::StartsWith(
           trials.Lookup("WebRTC-LibaomAv1Encoder-DisableFrameDropping"),
           "Enabled")) {}
@@ -232,6 +256,26 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   cfg_.g_h = encoder_settings_.height;
   cfg_.g_threads =
       NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
+  cpu_speed_ = GetCpuSpeed(cfg_.g_w, cfg_.g_h);
+  if (settings.target_encode_time_fraction.has_value()) {
+    // The number of threads may be lowered and raised again, but never above
+    // the initial number, for which the tiles and superblock size are chosen.
+    EncodeSpeedController::Config speed_config;
+    speed_config.target_encode_time_fraction =
+        *settings.target_encode_time_fraction;
+    speed_config.min_speed_offset =
+        std::min(0, std::max(-kMaxAdaptiveSpeedDecrease,
+                             kMinAdaptiveCpuSpeed - cpu_speed_));
+    speed_config.max_speed_offset =
+        std::max(0, kMaxAdaptiveCpuSpeed - cpu_speed_);
+    speed_config.min_num_threads = 1;
+    speed_config.max_num_threads = cfg_.g_threads;
+    speed_controller_ = std::make_unique<EncodeSpeedController>(
+        speed_config,
+        EncodeSpeedController::Setting{
+            .speed_offset = 0,
+            .num_threads = static_cast<int>(cfg_.g_threads)});
+  }
   cfg_.g_timebase.num = 1;
   cfg_.g_timebase.den = kRtpTicksPerSecond;
   cfg_.rc_target_bitrate = encoder_settings_.startBitrate;  // kilobits/sec.
@@ -272,8 +316,7 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   inited_ = true;
 
   // Set control parameters
-  SET_ENCODER_PARAM_OR_RETURN_ERROR(AOME_SET_CPUUSED,
-                                    GetCpuSpeed(cfg_.g_w, cfg_.g_h));
+  SET_ENCODER_PARAM_OR_RETURN_ERROR(AOME_SET_CPUUSED, cpu_speed_);
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ENABLE_CDEF, 1);
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ENABLE_TPL_MODEL, 0);
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_DELTAQ_MODE, 0);
@@ -528,9 +571,32 @@ int32_t LibaomAv1Encoder::Release() {
     inited_ = false;
   }
   rates_configured_ = false;
+  speed_controller_.reset();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+int LibaomAv1Encoder::AdaptedCpuSpeed() const {
+  if (!speed_controller_ || speed_controller_->setting().speed_offset == 0) {
+    return cpu_speed_;
+  }
+  return rtc::SafeClamp(cpu_speed_ + speed_controller_->setting().speed_offset,
+                        std::min(cpu_speed_, kMinAdaptiveCpuSpeed),
+                        kMaxAdaptiveCpuSpeed);
+}
+
+void LibaomAv1Encoder::ApplyEncodeSpeedSetting() {
+  SetEncoderControlParameters(AOME_SET_CPUUSED, AdaptedCpuSpeed());
+  const unsigned int num_threads = speed_controller_->setting().num_threads;
+  if (cfg_.g_threads != num_threads) {
+    cfg_.g_threads = num_threads;
+    aom_codec_err_t error_code = aom_codec_enc_config_set(&ctx_, &cfg_);
+    if (error_code != AOM_CODEC_OK) {
+      RTC_LOG(LS_WARNING) << "Error configuring encoder, error code: "
+                          << error_code;
+    }
+  }
+}
+
 void LibaomAv1Encoder::MaybeRewrapImgWithFormat(const aom_img_fmt_t fmt) {
   if (!frame_for_encode_) {
     frame_for_encode_ =
@@ -639,6 +705,7 @@ int32_t LibaomAv1Encoder::Encode(
 
   const size_t num_spatial_layers =
       svc_params_ ? svc_params_->number_spatial_layers : 1;
+  TimeDelta encode_time = TimeDelta::Zero();
   auto next_layer_frame = layer_frames.begin();
   for (size_t i = 0; i < num_spatial_layers; ++i) {
     // The libaom AV1 encoder requires that `aom_codec_encode` is called for
@@ -669,8 +736,10 @@ int32_t LibaomAv1Encoder::Encode(
     // Encode a frame. The presentation timestamp `pts` should not use real
     // timestamps from frames or the wall clock, as that can cause the rate
     // controller to misbehave.
+    const int64_t encode_start_us = rtc::TimeMicros();
     aom_codec_err_t ret =
         aom_codec_encode(&ctx_, frame_for_encode_, timestamp_, duration, flags);
+    encode_time += TimeDelta::Micros(rtc::TimeMicros() - encode_start_us);
     if (ret != AOM_CODEC_OK) {
       RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::Encode returned " << ret
                           << " on aom_codec_encode.";
@@ -763,6 +832,16 @@ int32_t LibaomAv1Encoder::Encode(
     }
   }
 
+  if (speed_controller_ &&
+      speed_controller_->OnFrameEncoded(
+          encode_time, TimeDelta::Seconds(1) / encoder_settings_.maxFramerate,
+          absl::c_any_of(layer_frames,
+                         [](const auto& layer_frame) {
+                           return layer_frame.IsKeyframe();
+                         }))) {
+    ApplyEncodeSpeedSetting();
+  }
+
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -843,6 +922,13 @@ VideoEncoder::EncoderInfo LibaomAv1Encoder::GetEncoderInfo() const {
     info.resolution_bitrate_limits =
         encoder_info_override_.resolution_bitrate_limits();
   }
+  if (speed_controller_) {
+    info.encode_speed = EncodeSpeedStats{
+        .speed = AdaptedCpuSpeed(),
+        .num_threads = speed_controller_->setting().num_threads,
+        .encode_time_fraction = speed_controller_->encode_time_fraction(),
+        .num_adaptations = speed_controller_->num_adaptations()};
+  }
   return info;
 }
 
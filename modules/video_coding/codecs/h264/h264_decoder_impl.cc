@@ -305,6 +305,14 @@ bool H264DecoderImpl::Configure(const Settings& settings) {
   // a pointer `this`.
   av_context_->opaque = this;
 
+  // In chunk mode FFmpeg accepts a frame as a sequence of packets of whole NAL
+  // units, and outputs it once all of its macroblocks have been decoded.
+  frame_parts_enabled_ = settings.frame_parts_enabled();
+  if (frame_parts_enabled_) {
+    av_context_->flags2 |= AV_CODEC_FLAG2_CHUNKS;
+  }
+  last_output_rtp_timestamp_ = absl::nullopt;
+
   const AVCodec* codec = avcodec_find_decoder(av_context_->codec_id);
   if (!codec) {
     // This is an indication that FFmpeg has not been initialized or it has not
@@ -347,6 +355,25 @@ int32_t H264DecoderImpl::RegisterDecodeCompleteCallback(
 int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
                                 bool /*missing_frames*/,
                                 int64_t /*render_time_ms*/) {
+  return DecodeChunk(input_image, /*last_part=*/true);
+}
+
+int32_t H264DecoderImpl::DecodePart(const EncodedImage& input_part,
+                                    bool last_part) {
+  if (!frame_parts_enabled_) {
+    RTC_LOG(LS_ERROR) << "Frame parts are not enabled.";
+    ReportError();
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  return DecodeChunk(input_part, last_part);
+}
+
+void H264DecoderImpl::DiscardFrameParts() {
+  ++discarded_frame_parts_;
+}
+
+int32_t H264DecoderImpl::DecodeChunk(const EncodedImage& input_image,
+                                     bool last_part) {
   if (!IsInitialized()) {
     ReportError();
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
@@ -377,7 +404,12 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   packet->size = static_cast<int>(input_image.size());
-  int64_t frame_timestamp_us = input_image.ntp_time_ms_ * 1000;  // ms -> μs
+  // Parts of a frame don't carry its NTP time, so frames are identified by
+  // their RTP timestamp instead when frame parts are enabled.
+  int64_t frame_timestamp_us =
+      frame_parts_enabled_
+          ? (int64_t{discarded_frame_parts_} << 32 | input_image.RtpTimestamp())
+          : input_image.ntp_time_ms_ * 1000;  // ms -> μs
   av_context_->reordered_opaque = frame_timestamp_us;
 
   int result = avcodec_send_packet(av_context_.get(), packet.get());
@@ -388,7 +420,23 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
 
+  // TODO(sakal): Maybe it is possible to get QP directly from FFmpeg.
+  h264_bitstream_parser_.ParseBitstream(input_image);
+
   result = avcodec_receive_frame(av_context_.get(), av_frame_.get());
+  // A frame of which only leading parts were decoded is output, concealed,
+  // when the next frame starts. Drop it.
+  while (frame_parts_enabled_ && result == 0 &&
+         av_frame_->reordered_opaque != frame_timestamp_us) {
+    av_frame_unref(av_frame_.get());
+    result = avcodec_receive_frame(av_context_.get(), av_frame_.get());
+  }
+  if (frame_parts_enabled_ && result == AVERROR(EAGAIN) &&
+      (!last_part ||
+       last_output_rtp_timestamp_ == input_image.RtpTimestamp())) {
+    // More of the frame is needed, or it has been output already.
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
   if (result < 0) {
     RTC_LOG(LS_ERROR) << "avcodec_receive_frame error: " << result;
     ReportError();
@@ -399,8 +447,6 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
   // the input one.
   RTC_DCHECK_EQ(av_frame_->reordered_opaque, frame_timestamp_us);
 
-  // TODO(sakal): Maybe it is possible to get QP directly from FFmpeg.
-  h264_bitstream_parser_.ParseBitstream(input_image);
   absl::optional<int> qp = h264_bitstream_parser_.GetLastSliceQp();
 
   // Obtain the `video_frame` containing the decoded image.
@@ -620,6 +666,7 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
   // TODO(nisse): Timestamp and rotation are all zero here. Change decoder
   // interface to pass a VideoFrameBuffer instead of a VideoFrame?
   decoded_image_callback_->Decoded(decoded_frame, absl::nullopt, qp);
+  last_output_rtp_timestamp_ = input_image.RtpTimestamp();
 
   // Stop referencing it, possibly freeing `input_frame`.
   av_frame_unref(av_frame_.get());
@@ -628,6 +675,12 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+VideoDecoder::DecoderInfo H264DecoderImpl::GetDecoderInfo() const {
+  DecoderInfo info = H264Decoder::GetDecoderInfo();
+  info.supports_frame_parts = frame_parts_enabled_;
+  return info;
+}
+
 const char* H264DecoderImpl::ImplementationName() const {
   return "FFmpeg";
 }
@@ -23,6 +23,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 
 // CAVEAT: According to ffmpeg docs for avcodec_send_packet, ffmpeg requires a
@@ -70,10 +71,19 @@ class H264DecoderImpl : public H264Decoder {
   int32_t Decode(const EncodedImage& input_image,
                  bool /*missing_frames*/,
                  int64_t render_time_ms = -1) override;
+  // Only supported if frame parts are enabled in the settings, in which case
+  // FFmpeg is run in chunk mode.
+  int32_t DecodePart(const EncodedImage& input_part, bool last_part) override;
+  void DiscardFrameParts() override;
 
+  DecoderInfo GetDecoderInfo() const override;
   const char* ImplementationName() const override;
 
  private:
+  // Decodes a complete frame, or part of one if frame parts are enabled.
+  // Output is only expected when `last_part` is set.
+  int32_t DecodeChunk(const EncodedImage& input_image, bool last_part);
+
   // Called by FFmpeg when it needs a frame buffer to store decoded frames in.
   // The `VideoFrame` returned by FFmpeg at `Decode` originate from here. Their
   // buffers are reference counted and freed by FFmpeg using `AVFreeBuffer2`.
@@ -99,6 +109,15 @@ class H264DecoderImpl : public H264Decoder {
   bool has_reported_init_;
   bool has_reported_error_;
 
+  bool frame_parts_enabled_ = false;
+  // RTP timestamp of the last frame passed to `decoded_image_callback_`. With
+  // frame parts FFmpeg may output a frame before its last part is decoded.
+  absl::optional<uint32_t> last_output_rtp_timestamp_;
+  // Number of DiscardFrameParts() calls, wrapping. Pictures are tagged with it
+  // next to their RTP timestamp, so that the concealed picture FFmpeg outputs
+  // for discarded parts is not taken for the frame that replaces them.
+  uint16_t discarded_frame_parts_ = 0;
+
   webrtc::H264BitstreamParser h264_bitstream_parser_;
 };
 
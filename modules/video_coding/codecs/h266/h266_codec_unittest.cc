@@ -9,27 +9,373 @@
  */
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "absl/types/optional.h"
+#include "api/numerics/samples_stats_counter.h"
+#include "api/test/metrics/global_metrics_logger_and_exporter.h"
+#include "api/test/metrics/metric.h"
+#include "api/units/time_delta.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame_buffer.h"
+#include "api/video/video_frame.h"
 #include "api/video_codecs/video_codec.h"
 #include "api/video_codecs/video_decoder.h"
 #include "api/video_codecs/video_encoder.h"
 #include "media/base/media_constants.h"
-#include "modules/video_coding/codecs/h266/vvdec_h266_decoder.h"
-#include "modules/video_coding/codecs/h266/vvenc_h266_encoder.h"
+#include "modules/video_coding/codecs/test/encoded_video_frame_producer.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/time_utils.h"
+#include "test/gmock.h"
 #include "test/gtest.h"
 
+#if defined(RTC_USE_VVENC_H266_ENCODER)
+#include "modules/video_coding/codecs/h266/vvenc_h266_encoder.h"
+#endif
+#if defined(RTC_USE_VVDEC_H266_DECODER)
+#include "modules/video_coding/codecs/h266/vvdec_h266_decoder.h"
+#endif
+
 namespace webrtc {
+namespace {
+
+using ::testing::Ge;
+using ::testing::Le;
+using ::testing::SizeIs;
 
 #if defined(RTC_USE_VVENC_H266_ENCODER)
+VideoCodec DefaultCodecSettings() {
+  VideoCodec codec_settings;
+  codec_settings.codecType = kVideoCodecH266;
+  codec_settings.width = 320;
+  codec_settings.height = 180;
+  codec_settings.maxFramerate = 30;
+  codec_settings.startBitrate = 500;
+  codec_settings.maxBitrate = 1000;
+  return codec_settings;
+}
+
+VideoEncoder::Settings EncoderSettings(int number_of_cores) {
+  return VideoEncoder::Settings(
+      VideoEncoder::Capabilities(/*loss_notification=*/false), number_of_cores,
+      /*max_payload_size=*/1200);
+}
+
+std::unique_ptr<VideoEncoder> CreateEncoder() {
+  return std::make_unique<VVencH266Encoder>(
+      cricket::CreateVideoCodec(cricket::kH266CodecName));
+}
+
 TEST(H266CodecTest, EncoderIsSupported) {
   EXPECT_EQ(VVencH266Encoder::IsSupported(), true);
 }
+
+TEST(H266CodecTest, EncoderInitAndRelease) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  EXPECT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(encoder->Release(), WEBRTC_VIDEO_CODEC_OK);
+}
+
+TEST(H266CodecTest, EncoderRejectsOtherCodecTypes) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  codec_settings.codecType = kVideoCodecH265;
+  EXPECT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_ERR_PARAMETER);
+}
+
+TEST(H266CodecTest, EncoderOutputsEveryFrameInOrderOnSingleCore) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  ASSERT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  // Without frame threading every frame is output from its own Encode() call.
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodedVideoFrameProducer(*encoder)
+          .SetNumInputFrames(5)
+          .SetRtpTimestamp(1000)
+          .Encode();
+  ASSERT_THAT(encoded_frames, SizeIs(5));
+  EXPECT_EQ(encoded_frames[0].encoded_image._frameType,
+            VideoFrameType::kVideoFrameKey);
+  for (size_t i = 0; i < encoded_frames.size(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(encoded_frames[i].encoded_image.RtpTimestamp(), 1000 + i * 3000);
+    EXPECT_EQ(encoded_frames[i].codec_specific_info.codecType,
+              kVideoCodecH266);
+    EXPECT_GT(encoded_frames[i].encoded_image.size(), 0u);
+    if (i > 0) {
+      EXPECT_EQ(encoded_frames[i].encoded_image._frameType,
+                VideoFrameType::kVideoFrameDelta);
+    }
+  }
+}
+
+TEST(H266CodecTest, EncoderProducesKeyFrameOnRequest) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  ASSERT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  EncodedVideoFrameProducer producer(*encoder);
+  ASSERT_THAT(producer.SetNumInputFrames(3).Encode(), SizeIs(3));
+
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      producer.SetNumInputFrames(1).ForceKeyFrame().Encode();
+  ASSERT_THAT(encoded_frames, SizeIs(1));
+  EXPECT_EQ(encoded_frames[0].encoded_image._frameType,
+            VideoFrameType::kVideoFrameKey);
+}
+
+TEST(H266CodecTest, EncoderDrainsFrameThreadedPipelineOnKeyFrameRequest) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  codec_settings.width = 640;
+  codec_settings.height = 360;
+  ASSERT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(8)),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  EncodedVideoFrameProducer producer(*encoder);
+  producer.SetResolution({640, 360}).SetRtpTimestamp(1000);
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      producer.SetNumInputFrames(5).Encode();
+  EXPECT_THAT(encoded_frames, SizeIs(Le(5u)));
+
+  // Frames still in the pipeline are output before the key frame.
+  for (auto& frame : producer.SetNumInputFrames(1).ForceKeyFrame().Encode()) {
+    encoded_frames.push_back(std::move(frame));
+  }
+  ASSERT_THAT(encoded_frames, SizeIs(Ge(5u)));
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(encoded_frames[i].encoded_image.RtpTimestamp(), 1000 + i * 3000);
+  }
+  if (encoded_frames.size() == 6) {
+    EXPECT_EQ(encoded_frames[5].encoded_image._frameType,
+              VideoFrameType::kVideoFrameKey);
+  }
+}
+
+TEST(H266CodecTest, EncoderReportsEncodeLatency) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  ASSERT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_FALSE(encoder->GetEncoderInfo().encode_latency.has_value());
+
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodedVideoFrameProducer(*encoder).SetNumInputFrames(2).Encode();
+  ASSERT_THAT(encoded_frames, SizeIs(2));
+  absl::optional<TimeDelta> latency = encoder->GetEncoderInfo().encode_latency;
+  ASSERT_TRUE(latency.has_value());
+  EXPECT_GE(*latency, TimeDelta::Zero());
+  EXPECT_EQ(latency->ms(),
+            encoded_frames[1].encoded_image.video_timing().encode_finish_ms -
+                encoded_frames[1].encoded_image.video_timing().encode_start_ms);
+}
+
+TEST(H266CodecTest, EncoderAppliesRatesWhileRunning) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  ASSERT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_OK);
+  EncodedVideoFrameProducer producer(*encoder);
+  ASSERT_THAT(producer.SetNumInputFrames(2).Encode(), SizeIs(2));
+
+  VideoEncoder::RateControlParameters rate_parameters;
+  rate_parameters.framerate_fps = 30;
+  rate_parameters.bitrate.SetBitrate(0, 0, 200'000);
+  encoder->SetRates(rate_parameters);
+  EXPECT_THAT(producer.SetNumInputFrames(2).Encode(), SizeIs(2));
+}
+
+TEST(H266CodecTest, EncoderDropsFramesWhilePaused) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  ASSERT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  VideoEncoder::RateControlParameters rate_parameters;
+  rate_parameters.framerate_fps = 30;
+  encoder->SetRates(rate_parameters);
+
+  class NoFramesExpected : public EncodedImageCallback {
+    Result OnEncodedImage(const EncodedImage&,
+                          const CodecSpecificInfo*) override {
+      ADD_FAILURE() << "Unexpected encoded frame.";
+      return Result(Result::Error::OK);
+    }
+  } callback;
+  encoder->RegisterEncodeCompleteCallback(&callback);
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(I420Buffer::Create(320, 180))
+                         .set_timestamp_rtp(1000)
+                         .build();
+  EXPECT_EQ(encoder->Encode(frame, nullptr), WEBRTC_VIDEO_CODEC_NO_OUTPUT);
+}
 #endif
 
 #if defined(RTC_USE_VVDEC_H266_DECODER)
+VideoDecoder::Settings DecoderSettings(int number_of_cores) {
+  VideoDecoder::Settings settings;
+  settings.set_codec_type(kVideoCodecH266);
+  settings.set_number_of_cores(number_of_cores);
+  return settings;
+}
+
+// Keeps the decoded frames alive until the test drops them.
+class DecodedFrames : public DecodedImageCallback {
+ public:
+  int32_t Decoded(VideoFrame& frame) override {
+    frames.push_back(frame);
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  void Decoded(VideoFrame& frame,
+               absl::optional<int32_t> decode_time_ms,
+               absl::optional<uint8_t> qp) override {
+    Decoded(frame);
+  }
+
+  std::vector<VideoFrame> frames;
+};
+
 TEST(H266CodecTest, DecoderIsSupported) {
   EXPECT_EQ(VVdecH266Decoder::IsSupported(), true);
 }
+
+TEST(H266CodecTest, DecoderRequiresConfigure) {
+  VVdecH266Decoder decoder;
+  DecodedFrames decoded;
+  decoder.RegisterDecodeCompleteCallback(&decoded);
+  EncodedImage image;
+  const uint8_t kData[] = {0, 0, 1, 0};
+  image.SetEncodedData(EncodedImageBuffer::Create(kData, sizeof(kData)));
+  EXPECT_EQ(decoder.Decode(image, /*render_time_ms=*/0),
+            WEBRTC_VIDEO_CODEC_UNINITIALIZED);
+}
+#endif
+
+#if defined(RTC_USE_VVENC_H266_ENCODER) && defined(RTC_USE_VVDEC_H266_DECODER)
+std::vector<EncodedVideoFrameProducer::EncodedFrame> EncodeFrames(
+    int num_frames) {
+  std::unique_ptr<VideoEncoder> encoder = CreateEncoder();
+  VideoCodec codec_settings = DefaultCodecSettings();
+  EXPECT_EQ(encoder->InitEncode(&codec_settings, EncoderSettings(1)),
+            WEBRTC_VIDEO_CODEC_OK);
+  return EncodedVideoFrameProducer(*encoder)
+      .SetNumInputFrames(num_frames)
+      .SetRtpTimestamp(1000)
+      .Encode();
+}
+
+TEST(H266CodecTest, DecodesEncodedFramesWithoutCopying) {
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodeFrames(3);
+  ASSERT_THAT(encoded_frames, SizeIs(3));
+
+  VVdecH266Decoder decoder;
+  DecodedFrames decoded;
+  ASSERT_TRUE(decoder.Configure(DecoderSettings(4)));
+  decoder.RegisterDecodeCompleteCallback(&decoded);
+  for (const auto& frame : encoded_frames) {
+    EXPECT_EQ(decoder.Decode(frame.encoded_image, /*render_time_ms=*/0),
+              WEBRTC_VIDEO_CODEC_OK);
+  }
+  ASSERT_THAT(decoded.frames, SizeIs(3));
+  for (size_t i = 0; i < decoded.frames.size(); ++i) {
+    SCOPED_TRACE(i);
+    const VideoFrame& frame = decoded.frames[i];
+    EXPECT_EQ(frame.timestamp(),
+              encoded_frames[i].encoded_image.RtpTimestamp());
+    // VVenC codes 10 bit samples, which are exposed as they are.
+    ASSERT_EQ(frame.video_frame_buffer()->type(),
+              VideoFrameBuffer::Type::kI010);
+    EXPECT_NE(frame.video_frame_buffer()->ToI420(), nullptr);
+  }
+  EXPECT_EQ(decoder.Release(), WEBRTC_VIDEO_CODEC_OK);
+}
+
+TEST(H266CodecTest, DecodedFramesOutliveDecoder) {
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodeFrames(1);
+  ASSERT_THAT(encoded_frames, SizeIs(1));
+
+  DecodedFrames decoded;
+  {
+    VVdecH266Decoder decoder;
+    ASSERT_TRUE(decoder.Configure(DecoderSettings(1)));
+    decoder.RegisterDecodeCompleteCallback(&decoded);
+    EXPECT_EQ(decoder.Decode(encoded_frames[0].encoded_image,
+                             /*render_time_ms=*/0),
+              WEBRTC_VIDEO_CODEC_OK);
+  }
+  ASSERT_THAT(decoded.frames, SizeIs(1));
+  const I010BufferInterface* buffer =
+      decoded.frames[0].video_frame_buffer()->GetI010();
+  ASSERT_NE(buffer, nullptr);
+  EXPECT_GT(buffer->width(), 0);
+  // The picture memory stays valid after the decoder is destroyed.
+  EXPECT_LT(buffer->DataY()[0], 1 << 10);
+  decoded.frames.clear();
+}
+
+TEST(H266CodecTest, DecoderReusesReleasedBuffers) {
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodeFrames(4);
+  ASSERT_THAT(encoded_frames, SizeIs(4));
+
+  VVdecH266Decoder decoder;
+  DecodedFrames decoded;
+  ASSERT_TRUE(decoder.Configure(DecoderSettings(1)));
+  decoder.RegisterDecodeCompleteCallback(&decoded);
+  std::vector<const VideoFrameBuffer*> buffers;
+  for (const auto& frame : encoded_frames) {
+    ASSERT_EQ(decoder.Decode(frame.encoded_image, /*render_time_ms=*/0),
+              WEBRTC_VIDEO_CODEC_OK);
+    ASSERT_THAT(decoded.frames, SizeIs(1));
+    buffers.push_back(decoded.frames[0].video_frame_buffer().get());
+    decoded.frames.clear();
+  }
+  for (const VideoFrameBuffer* buffer : buffers) {
+    EXPECT_EQ(buffer, buffers[0]);
+  }
+}
+
+TEST(H266CodecTest, DecodeTimePercentiles) {
+  constexpr int kNumFrames = 60;
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodeFrames(kNumFrames);
+  ASSERT_THAT(encoded_frames, SizeIs(kNumFrames));
+
+  VVdecH266Decoder decoder;
+  DecodedFrames decoded;
+  ASSERT_TRUE(decoder.Configure(DecoderSettings(4)));
+  decoder.RegisterDecodeCompleteCallback(&decoded);
+  SamplesStatsCounter decode_time_ms;
+  for (const auto& frame : encoded_frames) {
+    int64_t start_us = rtc::TimeMicros();
+    ASSERT_EQ(decoder.Decode(frame.encoded_image, /*render_time_ms=*/0),
+              WEBRTC_VIDEO_CODEC_OK);
+    decode_time_ms.AddSample(
+        static_cast<double>(rtc::TimeMicros() - start_us) /
+        rtc::kNumMicrosecsPerMillisec);
+    decoded.frames.clear();
+  }
+  ASSERT_EQ(decode_time_ms.NumSamples(), static_cast<size_t>(kNumFrames));
+
+  for (double percentile : {0.5, 0.9, 0.99}) {
+    test::GetGlobalMetricsLogger()->LogSingleValueMetric(
+        "vvdec_decode_time_p" +
+            std::to_string(static_cast<int>(percentile * 100)),
+        "h266_320x180", decode_time_ms.GetPercentile(percentile),
+        test::Unit::kMilliseconds,
+        test::ImprovementDirection::kSmallerIsBetter);
+  }
+}
 #endif
 
-}  // namespace webrtc
\ No newline at end of file
+}  // namespace
+}  // namespace webrtc
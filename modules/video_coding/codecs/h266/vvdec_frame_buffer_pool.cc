@@ -0,0 +1,205 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/h266/vvdec_frame_buffer_pool.h"
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+#include "vvdec/vvdec.h"
+
+namespace webrtc {
+namespace {
+
+// More buffers in use than this means the application holds on to decoded
+// frames, which keeps VVdeC allocating new pictures.
+constexpr size_t kMaxReasonableNumBuffers = 68;
+
+// Exposes the planes of a VVdeC picture as `Interface`. The picture is handed
+// back to its decoder when another picture is wrapped or on destruction.
+template <typename Interface, typename Sample>
+class PictureBuffer : public Interface {
+ public:
+  void Wrap(rtc::scoped_refptr<VVdecDecoderInstance> instance,
+            vvdecFrame* frame) {
+    if (frame_) {
+      instance_->UnrefFrame(frame_);
+    }
+    instance_ = std::move(instance);
+    frame_ = frame;
+  }
+
+  bool has_picture() const { return frame_ != nullptr; }
+
+  int width() const override { return frame_->width; }
+  int height() const override { return frame_->height; }
+  const Sample* DataY() const override { return Plane(0); }
+  const Sample* DataU() const override { return Plane(1); }
+  const Sample* DataV() const override { return Plane(2); }
+  int StrideY() const override { return Stride(0); }
+  int StrideU() const override { return Stride(1); }
+  int StrideV() const override { return Stride(2); }
+
+ protected:
+  ~PictureBuffer() override { Wrap(nullptr, nullptr); }
+
+ private:
+  const Sample* Plane(int index) const {
+    RTC_DCHECK(frame_);
+    return reinterpret_cast<const Sample*>(frame_->planes[index].ptr);
+  }
+  // VVdeC strides are in bytes, VideoFrameBuffer strides in samples.
+  int Stride(int index) const {
+    RTC_DCHECK(frame_);
+    return frame_->planes[index].stride / sizeof(Sample);
+  }
+
+  rtc::scoped_refptr<VVdecDecoderInstance> instance_;
+  vvdecFrame* frame_ = nullptr;
+};
+
+template <typename Buffer>
+rtc::scoped_refptr<rtc::RefCountedObject<Buffer>> GetAvailableBuffer(
+    std::vector<rtc::scoped_refptr<rtc::RefCountedObject<Buffer>>>& buffers) {
+  for (const auto& buffer : buffers) {
+    if (buffer->HasOneRef()) {
+      return buffer;
+    }
+  }
+  buffers.emplace_back(new rtc::RefCountedObject<Buffer>());
+  if (buffers.size() > kMaxReasonableNumBuffers) {
+    RTC_LOG(LS_WARNING) << buffers.size()
+                        << " buffers have been allocated by a "
+                           "VVdecFrameBufferPool (exceeding what is "
+                           "considered reasonable, "
+                        << kMaxReasonableNumBuffers << ").";
+  }
+  return buffers.back();
+}
+
+template <typename Buffer>
+void ReturnUnused(
+    std::vector<rtc::scoped_refptr<rtc::RefCountedObject<Buffer>>>& buffers) {
+  for (const auto& buffer : buffers) {
+    if (buffer->HasOneRef() && buffer->has_picture()) {
+      buffer->Wrap(nullptr, nullptr);
+    }
+  }
+}
+
+template <typename Buffer>
+int CountInUse(
+    const std::vector<rtc::scoped_refptr<rtc::RefCountedObject<Buffer>>>&
+        buffers) {
+  int count = 0;
+  for (const auto& buffer : buffers) {
+    if (!buffer->HasOneRef()) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+class VVdecFrameBufferPool::I420PictureBuffer
+    : public PictureBuffer<I420BufferInterface, uint8_t> {};
+
+class VVdecFrameBufferPool::I010PictureBuffer
+    : public PictureBuffer<I010BufferInterface, uint16_t> {
+ public:
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    rtc::scoped_refptr<I420Buffer> i420_buffer =
+        I420Buffer::Create(width(), height());
+    int res = libyuv::I010ToI420(
+        DataY(), StrideY(), DataU(), StrideU(), DataV(), StrideV(),
+        i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+        i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+        i420_buffer->MutableDataV(), i420_buffer->StrideV(), width(),
+        height());
+    RTC_DCHECK_EQ(res, 0);
+    return i420_buffer;
+  }
+};
+
+VVdecDecoderInstance::VVdecDecoderInstance(vvdecDecoder* decoder)
+    : decoder_(decoder) {
+  RTC_DCHECK(decoder_);
+}
+
+VVdecDecoderInstance::~VVdecDecoderInstance() {
+  vvdec_decoder_close(decoder_);
+}
+
+void VVdecDecoderInstance::UnrefFrame(vvdecFrame* frame) {
+  MutexLock lock(&unref_lock_);
+  vvdec_frame_unref(decoder_, frame);
+}
+
+VVdecFrameBufferPool::VVdecFrameBufferPool() = default;
+
+VVdecFrameBufferPool::~VVdecFrameBufferPool() {
+  ClearPool();
+}
+
+void VVdecFrameBufferPool::SetDecoderInstance(
+    rtc::scoped_refptr<VVdecDecoderInstance> instance) {
+  RTC_DCHECK(i420_buffers_.empty());
+  RTC_DCHECK(i010_buffers_.empty());
+  instance_ = std::move(instance);
+}
+
+void VVdecFrameBufferPool::ReturnUnusedPictures() {
+  ReturnUnused(i420_buffers_);
+  ReturnUnused(i010_buffers_);
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> VVdecFrameBufferPool::WrapFrame(
+    vvdecFrame* frame) {
+  RTC_DCHECK(instance_);
+  if (frame->colorFormat != VVDEC_CF_YUV420_PLANAR || frame->numPlanes != 3) {
+    RTC_LOG(LS_ERROR) << "Unsupported VVdeC color format "
+                      << frame->colorFormat;
+    return nullptr;
+  }
+  const uint32_t bytes_per_sample = frame->planes[0].bytesPerSample;
+  if (frame->bitDepth == 8 && bytes_per_sample == 1) {
+    auto buffer = GetAvailableBuffer(i420_buffers_);
+    buffer->Wrap(instance_, frame);
+    return buffer;
+  }
+  if (frame->bitDepth == 10 && bytes_per_sample == 2) {
+    auto buffer = GetAvailableBuffer(i010_buffers_);
+    buffer->Wrap(instance_, frame);
+    return buffer;
+  }
+  RTC_LOG(LS_ERROR) << "Unsupported VVdeC picture with " << frame->bitDepth
+                    << " bit samples stored in " << bytes_per_sample
+                    << " bytes";
+  return nullptr;
+}
+
+int VVdecFrameBufferPool::GetNumBuffersInUse() const {
+  return CountInUse(i420_buffers_) + CountInUse(i010_buffers_);
+}
+
+void VVdecFrameBufferPool::ClearPool() {
+  ReturnUnusedPictures();
+  i420_buffers_.clear();
+  i010_buffers_.clear();
+  instance_ = nullptr;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_CODECS_H266_VVDEC_FRAME_BUFFER_POOL_H_
+#define MODULES_VIDEO_CODING_CODECS_H266_VVDEC_FRAME_BUFFER_POOL_H_
+
+#include <vector>
+
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+struct vvdecDecoder;
+struct vvdecFrame;
+
+namespace webrtc {
+
+// An open VVdeC decoder. Decoded pictures live in memory owned by the
+// decoder, so it is closed only once nothing references it anymore: neither
+// the VVdecH266Decoder nor any buffer still wrapping one of its pictures.
+class VVdecDecoderInstance final
+    : public rtc::RefCountedNonVirtual<VVdecDecoderInstance> {
+ public:
+  explicit VVdecDecoderInstance(vvdecDecoder* decoder);
+  VVdecDecoderInstance(const VVdecDecoderInstance&) = delete;
+  VVdecDecoderInstance& operator=(const VVdecDecoderInstance&) = delete;
+  ~VVdecDecoderInstance();
+
+  vvdecDecoder* decoder() const { return decoder_; }
+
+  // Hands `frame` back to the decoder.
+  void UnrefFrame(vvdecFrame* frame);
+
+ private:
+  vvdecDecoder* const decoder_;
+  // Frames are handed back on the decoding thread while the decoder is in
+  // use, and from whichever thread drops the last reference to a buffer
+  // afterwards.
+  Mutex unref_lock_;
+};
+
+// Exposes decoded VVdeC pictures as VideoFrameBuffers without copying them,
+// in the spirit of Vp9FrameBufferPool. VVdeC keeps a picture out of its
+// picture pool until it is unreferenced, so a picture is handed back once the
+// buffer wrapping it is referenced only by this pool. The buffer object is
+// then reused for a later picture, and steady-state decoding allocates
+// nothing.
+//
+// 4:2:0 pictures with 8 bit samples are exposed as I420 buffers, and with 10
+// bit samples as I010 buffers.
+//
+// Not thread safe, except that buffers handed out may be released on any
+// thread.
+class VVdecFrameBufferPool {
+ public:
+  class I420PictureBuffer;
+  class I010PictureBuffer;
+
+  VVdecFrameBufferPool();
+  VVdecFrameBufferPool(const VVdecFrameBufferPool&) = delete;
+  VVdecFrameBufferPool& operator=(const VVdecFrameBufferPool&) = delete;
+  ~VVdecFrameBufferPool();
+
+  // Wraps pictures decoded by `instance` from now on. Buffers wrapping
+  // pictures of a previous instance must have been cleared with ClearPool().
+  void SetDecoderInstance(rtc::scoped_refptr<VVdecDecoderInstance> instance);
+
+  // Hands pictures no longer referenced outside the pool back to the decoder.
+  // Called before decoding, so the decoder can reuse their memory.
+  void ReturnUnusedPictures();
+
+  // Wraps `frame`, which must have been decoded by the current decoder
+  // instance. Returns nullptr for unsupported picture formats, in which case
+  // `frame` is not taken over.
+  rtc::scoped_refptr<VideoFrameBuffer> WrapFrame(vvdecFrame* frame);
+
+  // Gets the number of buffers currently referenced outside the pool.
+  int GetNumBuffersInUse() const;
+
+  // Hands back all unused pictures and forgets all buffers. Buffers still in
+  // use hand back their picture, and keep the decoder instance open, until
+  // they are no longer referenced.
+  void ClearPool();
+
+ private:
+  rtc::scoped_refptr<VVdecDecoderInstance> instance_;
+  std::vector<rtc::scoped_refptr<rtc::RefCountedObject<I420PictureBuffer>>>
+      i420_buffers_;
+  std::vector<rtc::scoped_refptr<rtc::RefCountedObject<I010PictureBuffer>>>
+      i010_buffers_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_CODECS_H266_VVDEC_FRAME_BUFFER_POOL_H_
@@ -11,164 +11,177 @@
 #include "modules/video_coding/codecs/h266/vvdec_h266_decoder.h"
 
 #include <algorithm>
-#include <limits>
-#include <memory>
-#include <string>
 #include <utility>
-#include <vector>
 
-#include "api/video/color_space.h"
-#include "api/video/i420_buffer.h"
-#include "common_video/libyuv/include/webrtc_libyuv.h"
-#include "media/base/media_constants.h"
+#include "api/make_ref_counted.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+#include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
-#include "system_wrappers/include/field_trial.h"
-#include "third_party/libyuv/include/libyuv/convert.h"
-#include "third_party/libyuv/include/libyuv/scale.h"
-
-// VVdeC library headers
 #include "vvdec/vvdec.h"
-#include "vvdec/vvdecDecl.h"
 
 namespace webrtc {
-
 namespace {
-// H.266 start code (0x00, 0x00, 0x01)
-const uint8_t kH266StartCode[] = {0x00, 0x00, 0x01};
-const size_t kH266StartCodeSize = sizeof(kH266StartCode);
 
-// Default decoding parameters
-constexpr size_t kMaxDecodingThreads = 8;
-constexpr size_t kInitialBufferSize = 1024 * 1024;  // 1MB
+constexpr char kVVdecName[] = "VVdeC";
+
+// VVdeC does not scale beyond this for real-time resolutions.
+constexpr int kMaxDecodingThreads = 8;
+
+// Access units whose picture has not been output after this many further
+// access units are assumed to have been dropped by the decoder.
+constexpr size_t kMaxPendingFrames = 16;
+
 }  // namespace
 
-VVdecH266Decoder::VVdecH266Decoder()
-    : config_(nullptr),
-      decoder_(nullptr),
-      decoded_image_callback_(nullptr),
-      initialized_(false),
-      decode_buffer_(nullptr),
-      decode_buffer_size_(0) {
-  RTC_LOG(LS_INFO) << "Creating VVdecH266Decoder";
-}
+VVdecH266Decoder::VVdecH266Decoder() = default;
 
 VVdecH266Decoder::~VVdecH266Decoder() {
   Release();
 }
 
 bool VVdecH266Decoder::IsSupported() {
-  // Check if the VVdeC library is available
-  // This will return true since we've enabled the VVdeC dependency
   return true;
 }
 
-int32_t VVdecH266Decoder::InitDecode(const VideoCodec* codec_settings,
-                                     int32_t number_of_cores) {
-  if (initialized_) {
-    Release();
-  }
-
-  // Allocate decode buffer
-  decode_buffer_size_ = kInitialBufferSize;
-  decode_buffer_.reset(new uint8_t[decode_buffer_size_]);
-
-  // In a real implementation:
-  // 1. Initialize the VVdeC decoder
-  // 2. Configure the decoder with the provided settings
-  // 3. Allocate necessary resources
-
-  // For this placeholder, we'll just log the initialization
-  RTC_LOG(LS_INFO) << "Initializing H.266 decoder with " << number_of_cores << " cores";
+bool VVdecH266Decoder::Configure(const Settings& settings) {
+  Release();
 
-  if (!ConfigureDecoder(number_of_cores)) {
-    Release();
-    return WEBRTC_VIDEO_CODEC_ERROR;
+  vvdecParams params;
+  vvdec_params_default(&params);
+  // Zero threads decodes on the calling thread only.
+  params.threads = settings.number_of_cores() > 1
+                       ? std::min(settings.number_of_cores(),
+                                  kMaxDecodingThreads)
+                       : 0;
+  // Output each picture from the call that decodes it instead of parsing
+  // ahead, which would add a frame of latency per parsed access unit.
+  params.parseDelay = 0;
+  params.logLevel = VVDEC_SILENT;
+
+  vvdecDecoder* decoder = vvdec_decoder_open(&params);
+  if (decoder == nullptr) {
+    RTC_LOG(LS_ERROR) << "Failed to open VVdeC decoder with "
+                      << params.threads << " threads";
+    return false;
   }
-
-  initialized_ = true;
-  return WEBRTC_VIDEO_CODEC_OK;
+  instance_ = rtc::make_ref_counted<VVdecDecoderInstance>(decoder);
+  frame_buffer_pool_.SetDecoderInstance(instance_);
+  return true;
 }
 
-bool VVdecH266Decoder::ConfigureDecoder(int32_t number_of_cores) {
-  // In a real implementation:
-  // 1. Create and configure a vvdec_config structure
-  // 2. Set decoding parameters based on number_of_cores
-  // 3. Initialize the decoder with the configuration
-
-  // For this placeholder, we'll just log the configuration
-  RTC_LOG(LS_INFO) << "Configuring H.266 decoder with " 
-                  << std::min(static_cast<size_t>(number_of_cores), kMaxDecodingThreads)
-                  << " threads";
-
-  return true;  // Placeholder success
+int32_t VVdecH266Decoder::RegisterDecodeCompleteCallback(
+    DecodedImageCallback* callback) {
+  decoded_image_callback_ = callback;
+  return WEBRTC_VIDEO_CODEC_OK;
 }
 
 int32_t VVdecH266Decoder::Release() {
-  if (initialized_) {
-    // In a real implementation:
-    // 1. Clean up the VVdeC decoder
-    // 2. Free allocated resources
-
-    RTC_LOG(LS_INFO) << "Releasing H.266 decoder";
-    decode_buffer_.reset();
-    decode_buffer_size_ = 0;
-    initialized_ = false;
-  }
+  // Buffers still referenced by the application keep the decoder open until
+  // they are released.
+  frame_buffer_pool_.ClearPool();
+  instance_ = nullptr;
+  pending_frames_.clear();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
-int32_t VVdecH266Decoder::RegisterDecodeCompleteCallback(
-    DecodedImageCallback* callback) {
-  decoded_image_callback_ = callback;
-  return WEBRTC_VIDEO_CODEC_OK;
+VideoDecoder::DecoderInfo VVdecH266Decoder::GetDecoderInfo() const {
+  DecoderInfo info;
+  info.implementation_name = kVVdecName;
+  info.is_hardware_accelerated = false;
+  return info;
+}
+
+const char* VVdecH266Decoder::ImplementationName() const {
+  return kVVdecName;
 }
 
 int32_t VVdecH266Decoder::Decode(const EncodedImage& input_image,
-                                bool missing_frames,
-                                int64_t render_time_ms) {
-  if (!initialized_ || !decoded_image_callback_) {
+                                 int64_t /*render_time_ms*/) {
+  if (!instance_ || decoded_image_callback_ == nullptr) {
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
-
   if (input_image.size() == 0) {
     return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
   }
 
-  // In a real implementation:
-  // 1. Process the input data (handle fragmentation, etc.)
-  // 2. Call the VVdeC decoding function
-  // 3. Convert the decoded frame to the format expected by WebRTC
-  // 4. Pass the decoded frame to the callback
-
-  // For this placeholder, we'll just log the decoding request
-  RTC_LOG(LS_INFO) << "Decoding H.266 frame, size: " << input_image.size()
-                  << ", frame timestamp: " << input_image.Timestamp();
-
-  // Placeholder: In a real implementation, this would be the actual decoded frame
-  // For now, we'll just create a dummy VideoFrame
-  rtc::scoped_refptr<I420Buffer> i420_buffer =
-      I420Buffer::Create(input_image._encodedWidth, input_image._encodedHeight);
-  
-  // Fill with black
-  i420_buffer->InitializeData();
-  
-  VideoFrame decoded_frame = VideoFrame::Builder()
-                                .set_video_frame_buffer(i420_buffer)
-                                .set_timestamp_rtp(input_image.Timestamp())
-                                .set_timestamp_ms(render_time_ms)
-                                .set_rotation(kVideoRotation_0)
-                                .build();
-
-  // In a real implementation, this would be the callback with actual decoded frame
-  // decoded_image_callback_->Decoded(decoded_frame, absl::nullopt, absl::nullopt);
+  // Let the decoder reuse pictures the application is done with.
+  frame_buffer_pool_.ReturnUnusedPictures();
 
-  return WEBRTC_VIDEO_CODEC_OK;
+  if (pending_frames_.size() >= kMaxPendingFrames) {
+    pending_frames_.pop_front();
+  }
+  PendingFrame pending_frame = {input_image.RtpTimestamp(),
+                                input_image.ntp_time_ms_, absl::nullopt,
+                                rtc::TimeMillis()};
+  if (input_image.ColorSpace()) {
+    pending_frame.color_space = *input_image.ColorSpace();
+  }
+  pending_frames_.push_back(std::move(pending_frame));
+
+  vvdecAccessUnit access_unit;
+  vvdec_accessUnit_default(&access_unit);
+  // VVdeC only reads the payload.
+  access_unit.payload = const_cast<uint8_t*>(input_image.data());
+  access_unit.payloadSize = static_cast<int>(input_image.size());
+  access_unit.payloadUsedSize = access_unit.payloadSize;
+  access_unit.cts = input_image.RtpTimestamp();
+  access_unit.ctsValid = true;
+
+  vvdecFrame* frame = nullptr;
+  int ret = vvdec_decode(instance_->decoder(), &access_unit, &frame);
+  if (ret != VVDEC_OK && ret != VVDEC_TRY_AGAIN) {
+    RTC_LOG(LS_WARNING) << "VVdeC failed to decode access unit: " << ret
+                        << " (" << vvdec_get_last_error(instance_->decoder())
+                        << ")";
+    if (frame != nullptr) {
+      instance_->UnrefFrame(frame);
+    }
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  if (frame == nullptr) {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  return DeliverFrame(frame);
 }
 
-const char* VVdecH266Decoder::ImplementationName() const {
-  return "VVdeC H.266";
+int32_t VVdecH266Decoder::DeliverFrame(vvdecFrame* frame) {
+  // Pictures are output in decoding order, so the metadata of access units
+  // that did not produce a picture precedes that of `frame`.
+  while (!pending_frames_.empty() && frame->ctsValid &&
+         pending_frames_.front().rtp_timestamp !=
+             static_cast<uint32_t>(frame->cts)) {
+    pending_frames_.pop_front();
+  }
+  if (pending_frames_.empty()) {
+    RTC_LOG(LS_WARNING) << "VVdeC output a picture for an unknown frame.";
+    instance_->UnrefFrame(frame);
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  PendingFrame pending_frame = std::move(pending_frames_.front());
+  pending_frames_.pop_front();
+
+  rtc::scoped_refptr<VideoFrameBuffer> buffer =
+      frame_buffer_pool_.WrapFrame(frame);
+  if (!buffer) {
+    instance_->UnrefFrame(frame);
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+
+  VideoFrame decoded_frame = VideoFrame::Builder()
+                                 .set_video_frame_buffer(buffer)
+                                 .set_timestamp_rtp(pending_frame.rtp_timestamp)
+                                 .set_ntp_time_ms(pending_frame.ntp_time_ms)
+                                 .set_color_space(pending_frame.color_space)
+                                 .build();
+  decoded_image_callback_->Decoded(
+      decoded_frame,
+      static_cast<int32_t>(rtc::TimeMillis() - pending_frame.decode_start_ms),
+      absl::nullopt);
+  return WEBRTC_VIDEO_CODEC_OK;
 }
 
-}  // namespace webrtc
\ No newline at end of file
+}  // namespace webrtc
@@ -11,59 +11,64 @@
 #ifndef MODULES_VIDEO_CODING_CODECS_H266_VVDEC_H266_DECODER_H_
 #define MODULES_VIDEO_CODING_CODECS_H266_VVDEC_H266_DECODER_H_
 
-#include <memory>
-#include <string>
+#include <stdint.h>
 
+#include <deque>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/video/color_space.h"
 #include "api/video_codecs/video_decoder.h"
-#include "common_video/h266/h266_common.h"
+#include "modules/video_coding/codecs/h266/vvdec_frame_buffer_pool.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/system/rtc_export.h"
 
-// Forward declaration for VVdeC library types
-struct vvdec_config;
-struct vvdec_decoder;
+struct vvdecFrame;
 
 namespace webrtc {
 
-// VVdeC H.266 decoder implementation
+// VVdeC H.266 decoder implementation. Decoding is spread over up to one
+// thread per core, and decoded pictures are delivered without being copied
+// out of the decoder's picture memory.
 class RTC_EXPORT VVdecH266Decoder : public VideoDecoder {
  public:
   VVdecH266Decoder();
+  VVdecH266Decoder(const VVdecH266Decoder&) = delete;
+  VVdecH266Decoder& operator=(const VVdecH266Decoder&) = delete;
   ~VVdecH266Decoder() override;
 
-  int32_t InitDecode(const VideoCodec* codec_settings,
-                     int32_t number_of_cores) override;
-  int32_t Release() override;
-
-  int32_t RegisterDecodeCompleteCallback(
-      DecodedImageCallback* callback) override;
+  bool Configure(const Settings& settings) override;
   int32_t Decode(const EncodedImage& input_image,
-                 bool missing_frames,
                  int64_t render_time_ms) override;
+  int32_t RegisterDecodeCompleteCallback(
+      DecodedImageCallback* callback) override;
+  int32_t Release() override;
 
+  DecoderInfo GetDecoderInfo() const override;
   const char* ImplementationName() const override;
 
   static bool IsSupported();
 
  private:
-  // Configures the decoder with the settings provided by InitDecode
-  bool ConfigureDecoder(int32_t number_of_cores);
-
-  // Decoder configuration
-  vvdec_config* config_;
-  vvdec_decoder* decoder_;
-
-  // Decoded image callback
-  DecodedImageCallback* decoded_image_callback_;
-
-  // Indicates if the decoder is initialized
-  bool initialized_;
-
-  // Buffer for storing partial NAL units
-  std::unique_ptr<uint8_t[]> decode_buffer_;
-  size_t decode_buffer_size_;
+  // Metadata of an access unit passed to the decoder whose picture has not
+  // been output yet.
+  struct PendingFrame {
+    uint32_t rtp_timestamp;
+    int64_t ntp_time_ms;
+    absl::optional<ColorSpace> color_space;
+    int64_t decode_start_ms;
+  };
+
+  // Delivers `frame` to the callback, or hands it back to the decoder if it
+  // can not be delivered.
+  int32_t DeliverFrame(vvdecFrame* frame);
+
+  rtc::scoped_refptr<VVdecDecoderInstance> instance_;
+  VVdecFrameBufferPool frame_buffer_pool_;
+  std::deque<PendingFrame> pending_frames_;
+  DecodedImageCallback* decoded_image_callback_ = nullptr;
 };
 
 }  // namespace webrtc
 
-#endif  // MODULES_VIDEO_CODING_CODECS_H266_VVDEC_H266_DECODER_H_
\ No newline at end of file
+#endif  // MODULES_VIDEO_CODING_CODECS_H266_VVDEC_H266_DECODER_H_
@@ -10,23 +10,22 @@
 
 #include "modules/video_coding/codecs/h266/vvenc_h266_encoder.h"
 
-#include <algorithm>
-#include <limits>
+#include <stdint.h>
+
 #include <memory>
-#include <string>
 #include <utility>
 #include <vector>
 
-#include "api/video/color_space.h"
+#include "absl/algorithm/container.h"
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
-#include "common_video/libyuv/include/webrtc_libyuv.h"
-#include "media/base/media_constants.h"
+#include "api/video/video_frame_buffer.h"
+#include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
-#include "system_wrappers/include/field_trial.h"
-#include "third_party/libyuv/include/libyuv/convert.h"
-#include "third_party/libyuv/include/libyuv/scale.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
 
 // VVenC library headers
 #include "vvenc/vvenc.h"
@@ -35,28 +34,90 @@
 namespace webrtc {
 
 namespace {
-// H.266 start code (0x00, 0x00, 0x01)
-const uint8_t kH266StartCode[] = {0x00, 0x00, 0x01};
-const size_t kH266StartCodeSize = sizeof(kH266StartCode);
-
-// Default encoding parameters
-constexpr int kDefaultQp = 30;
-constexpr int kDefaultGopSize = 30;
-constexpr int kDefaultIntraPeriod = 1000;  // In milliseconds
-constexpr int kDefaultMaxBitrate = 5000000;  // 5 Mbps
+// Pictures are passed to VVenC as 16 bit samples. Widening the 8 bit input
+// straight to the internal bit depth spares the encoder a second pass.
+constexpr int kBitDepth = 10;
+// Scale factor for libyuv::Convert8To16Plane to produce `kBitDepth` samples.
+constexpr int kBitDepthScale = 1 << kBitDepth;
+
+// Initial QP, only used until rate control has seen the first pictures.
+constexpr int kDefaultQp = 32;
 constexpr int kDefaultTargetBitrate = 2000000;  // 2 Mbps
 constexpr int kDefaultFramerate = 30;
+
+// QP scaling thresholds. VVC quantizer steps match those of H.264 within the
+// H.264 QP range, so the same thresholds apply.
+constexpr int kLowH266QpThreshold = 24;
+constexpr int kHighH266QpThreshold = 37;
+
+// Returns the number of encoder threads. VVenC splits a picture into WPP
+// rows and tiles, which pay off from 360p on; the limits match the ones used
+// for the other software encoders.
+int NumberOfThreads(int width, int height, int number_of_cores) {
+  if (width * height > 1280 * 720 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 640 * 360 && number_of_cores > 4) {
+    return 4;
+  } else if (width * height >= 320 * 180 && number_of_cores > 2) {
+    return 2;
+  }
+  return 1;
+}
+
+// Returns the number of tile columns for `num_threads` encoder threads. WPP
+// alone keeps only about two CTU rows busy at the start and end of a picture,
+// so wider pictures are additionally split into tile columns.
+int NumberOfTileColumns(int num_threads) {
+  if (num_threads >= 8) {
+    return 4;
+  } else if (num_threads >= 4) {
+    return 2;
+  }
+  return 1;
+}
+
+// Returns how many pictures may be encoded concurrently. Every additional
+// picture in flight delays the output by one frame, so frame threading is
+// only enabled when there are enough threads to keep two pictures busy.
+int NumberOfParallelFrames(int num_threads) {
+  return num_threads >= 4 ? 2 : 1;
+}
+
+// Returns the VVenC preset for the requested encoder complexity. By default
+// camera content uses the fastest preset and screen content, which is mostly
+// static, the next slower one.
+vvencPresetMode PresetForComplexity(VideoCodecComplexity complexity,
+                                    VideoCodecMode mode) {
+  switch (complexity) {
+    case VideoCodecComplexity::kComplexityLow:
+      return VVENC_FASTER;
+    case VideoCodecComplexity::kComplexityNormal:
+      return mode == VideoCodecMode::kScreensharing ? VVENC_FAST
+                                                    : VVENC_FASTER;
+    case VideoCodecComplexity::kComplexityHigh:
+      return VVENC_FAST;
+    case VideoCodecComplexity::kComplexityHigher:
+      return VVENC_MEDIUM;
+    case VideoCodecComplexity::kComplexityMax:
+      return VVENC_SLOW;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
 }  // namespace
 
 VVencH266Encoder::VVencH266Encoder(const cricket::VideoCodec& codec)
     : codec_(codec),
+      number_of_cores_(1),
       encoder_(nullptr),
-      config_(nullptr),
+      input_picture_(nullptr),
+      access_unit_(nullptr),
       encoded_image_callback_(nullptr),
       target_bitrate_bps_(kDefaultTargetBitrate),
-      max_bitrate_bps_(kDefaultMaxBitrate),
       framerate_fps_(kDefaultFramerate),
-      frames_since_keyframe_(0),
+      rates_configured_(false),
+      reopen_required_(false),
+      next_sequence_number_(0),
       initialized_(false) {
   RTC_LOG(LS_INFO) << "Creating VVencH266Encoder";
 }
@@ -66,8 +127,8 @@ VVencH266Encoder::~VVencH266Encoder() {
 }
 
 bool VVencH266Encoder::IsSupported() {
-  // Check if the VVenC library is available
-  // This will return true since we've enabled the VVenC dependency
+  // This file is only built when VVenC is linked in, see
+  // rtc_use_vvenc_h266_encoder.
   return true;
 }
 
@@ -85,23 +146,23 @@ int32_t VVencH266Encoder::InitEncode(const VideoCodec* codec_settings,
     return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
   }
 
-  codec_settings_ = *codec_settings;
-  encoder_settings_ = settings;
+  if (settings.number_of_cores < 1) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+
+  Release();
 
-  // In a real implementation:
-  // 1. Initialize the VVenC encoder
-  // 2. Configure the encoder with the provided settings
-  // 3. Allocate necessary resources
+  codec_settings_ = *codec_settings;
+  number_of_cores_ = settings.number_of_cores;
 
-  // For this placeholder, we'll just log the initialization
   RTC_LOG(LS_INFO) << "Initializing H.266 encoder with resolution: "
-                  << codec_settings_.width << "x" << codec_settings_.height
-                  << ", framerate: " << codec_settings_.maxFramerate;
+                   << codec_settings_.width << "x" << codec_settings_.height
+                   << ", framerate: " << codec_settings_.maxFramerate;
 
   framerate_fps_ = codec_settings_.maxFramerate;
   target_bitrate_bps_ = codec_settings_.startBitrate * 1000;
-  max_bitrate_bps_ = codec_settings_.maxBitrate * 1000;
-  frames_since_keyframe_ = 0;
+  // Until SetRates() is called the start bitrate is used.
+  rates_configured_ = target_bitrate_bps_ > 0;
 
   if (!ConfigureEncoder()) {
     Release();
@@ -113,35 +174,104 @@ int32_t VVencH266Encoder::InitEncode(const VideoCodec* codec_settings,
 }
 
 bool VVencH266Encoder::ConfigureEncoder() {
-  // In a real implementation:
-  // 1. Create and configure a vvenc_config structure
-  // 2. Set encoding parameters based on codec_settings_
-  // 3. Initialize the encoder with the configuration
+  RTC_DCHECK(!encoder_);
+  const int width = codec_settings_.width;
+  const int height = codec_settings_.height;
+
+  config_ = std::make_unique<vvenc_config>();
+  vvenc_init_default(
+      config_.get(), width, height, framerate_fps_, target_bitrate_bps_,
+      kDefaultQp,
+      PresetForComplexity(codec_settings_.GetVideoEncoderComplexity(),
+                          codec_settings_.mode));
+  SetEncoderPreset(config_.get(), codec_settings_.mode);
+
+  config_->m_verbosity = VVENC_SILENT;
+  config_->m_internChromaFormat = VVENC_CHROMA_420;
+  config_->m_inputBitDepth[0] = kBitDepth;
+  config_->m_internalBitDepth[0] = kBitDepth;
+  config_->m_RCNumPasses = 1;
+
+  const int num_threads = NumberOfThreads(width, height, number_of_cores_);
+  config_->m_numThreads = num_threads;
+  config_->m_entropyCodingSyncEnabled = num_threads > 1;
+  config_->m_entryPointsPresent = num_threads > 1;
+  const int num_tile_columns = NumberOfTileColumns(num_threads);
+  config_->m_picPartitionFlag = num_tile_columns > 1;
+  config_->m_numTileCols = num_tile_columns;
+  config_->m_numTileRows = 1;
+  config_->m_maxParallelFrames = NumberOfParallelFrames(num_threads);
 
-  // For this placeholder, we'll just log the configuration
   RTC_LOG(LS_INFO) << "Configuring H.266 encoder with bitrate: "
-                  << target_bitrate_bps_ << " bps, framerate: "
-                  << framerate_fps_ << " fps";
+                   << target_bitrate_bps_ << " bps, framerate: "
+                   << framerate_fps_ << " fps, threads: " << num_threads
+                   << ", tile columns: " << num_tile_columns
+                   << ", parallel frames: " << config_->m_maxParallelFrames;
+
+  encoder_ = vvenc_encoder_create();
+  if (!encoder_) {
+    RTC_LOG(LS_ERROR) << "Failed to create VVenC encoder.";
+    return false;
+  }
+  int ret = vvenc_encoder_open(encoder_, config_.get());
+  if (ret != VVENC_OK) {
+    RTC_LOG(LS_ERROR) << "Failed to open VVenC encoder: "
+                      << vvenc_get_last_error(encoder_);
+    DestroyEncoder();
+    return false;
+  }
 
-  return true;  // Placeholder success
+  // The input picture and the access unit are reused for every frame.
+  input_picture_ = vvenc_YUVBuffer_alloc();
+  vvenc_YUVBuffer_alloc_buffer(input_picture_, VVENC_CHROMA_420, width,
+                               height);
+  access_unit_ = vvenc_accessUnit_alloc();
+  vvenc_accessUnit_alloc_payload(access_unit_, width * height);
+
+  next_sequence_number_ = 0;
+  reopen_required_ = false;
+  return true;
 }
 
-void VVencH266Encoder::SetEncoderPreset(vvenc_config* config, 
+void VVencH266Encoder::DestroyEncoder() {
+  if (encoder_) {
+    vvenc_encoder_close(encoder_);
+    encoder_ = nullptr;
+  }
+  if (input_picture_) {
+    vvenc_YUVBuffer_free(input_picture_, /*freePicBuffer=*/true);
+    input_picture_ = nullptr;
+  }
+  if (access_unit_) {
+    vvenc_accessUnit_free(access_unit_, /*freePayload=*/true);
+    access_unit_ = nullptr;
+  }
+  config_.reset();
+  pending_frames_.clear();
+}
+
+void VVencH266Encoder::SetEncoderPreset(vvenc_config* config,
                                         VideoCodecMode mode) {
-  // In a real implementation:
-  // Set the encoder preset based on the codec mode (realtime, quality, etc.)
-  
-  // For this placeholder, we'll just log the mode
-  RTC_LOG(LS_INFO) << "Setting H.266 encoder preset for mode: "
-                  << (mode == VideoCodecMode::kRealtimeVideo ? "realtime" : "quality");
+  // Code pictures in output order so that every picture can be sent as soon
+  // as it is encoded: no reordering (and hence no B pictures referencing
+  // future pictures), no lookahead and no temporal filtering, which needs
+  // future pictures as well.
+  config->m_picReordering = false;
+  config->m_LookAhead = 0;
+  config->m_vvencMCTF.MCTF = 0;
+  // Periodic refreshes use IDR pictures, which are complete key frames for
+  // the receiver. Key frames requested by the receiver are handled by
+  // Encode().
+  config->m_DecodingRefreshType = VVENC_DRT_IDR;
+  // Perceptual QP adaptation costs encode time and fights the rate
+  // controller on camera content; screen content benefits from it.
+  config->m_usePerceptQPA = mode == VideoCodecMode::kScreensharing;
 }
 
 int32_t VVencH266Encoder::Release() {
+  DestroyEncoder();
+  encode_latency_ = absl::nullopt;
   if (initialized_) {
-    // In a real implementation:
-    // 1. Clean up the VVenC encoder
-    // 2. Free allocated resources
-
     RTC_LOG(LS_INFO) << "Releasing H.266 encoder";
     initialized_ = false;
   }
@@ -154,26 +284,45 @@ int32_t VVencH266Encoder::RegisterEncodeCompleteCallback(
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
-int32_t VVencH266Encoder::SetRates(const RateControlParameters& parameters) {
+void VVencH266Encoder::SetRates(const RateControlParameters& parameters) {
   if (!initialized_) {
-    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+    RTC_LOG(LS_WARNING) << "SetRates() while encoder is not initialized";
+    return;
   }
 
-  if (parameters.framerate_fps <= 0 || parameters.bitrate.get_sum_bps() <= 0) {
-    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  if (parameters.framerate_fps < 1.0) {
+    RTC_LOG(LS_WARNING) << "Invalid framerate: " << parameters.framerate_fps;
+    return;
   }
 
-  target_bitrate_bps_ = parameters.bitrate.get_sum_bps();
-  framerate_fps_ = parameters.framerate_fps;
-
-  // In a real implementation:
-  // Update the encoder's bitrate and framerate settings
-
-  RTC_LOG(LS_INFO) << "H.266 encoder rate control updated: "
-                  << target_bitrate_bps_ << " bps, "
-                  << framerate_fps_ << " fps";
+  if (parameters.bitrate.get_sum_bps() == 0) {
+    // Encoder paused, drop all frames until the bitrate is restored.
+    rates_configured_ = false;
+    return;
+  }
 
-  return WEBRTC_VIDEO_CODEC_OK;
+  rates_configured_ = true;
+  const uint32_t framerate_fps =
+      static_cast<uint32_t>(parameters.framerate_fps + 0.5);
+  if (target_bitrate_bps_ == parameters.bitrate.get_sum_bps() &&
+      framerate_fps_ == framerate_fps) {
+    return;
+  }
+  target_bitrate_bps_ = parameters.bitrate.get_sum_bps();
+  framerate_fps_ = framerate_fps;
+
+  // Rate control accepts a new target without restarting the encoder, so the
+  // update takes effect on the next picture. The frame rate sets the bit
+  // budget per picture.
+  config_->m_RCTargetBitrate = target_bitrate_bps_;
+  config_->m_FrameRate = framerate_fps_;
+  config_->m_FrameScale = 1;
+  int ret = vvenc_reconfig(encoder_, config_.get());
+  if (ret != VVENC_OK) {
+    RTC_LOG(LS_WARNING) << "VVenC rejected the rate update, reopening: "
+                        << vvenc_get_last_error(encoder_);
+    reopen_required_ = true;
+  }
 }
 
 int32_t VVencH266Encoder::Encode(
@@ -183,68 +332,156 @@ int32_t VVencH266Encoder::Encode(
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
 
+  if (!rates_configured_) {
+    return WEBRTC_VIDEO_CODEC_NO_OUTPUT;
+  }
+
   if (input_image.width() != codec_settings_.width ||
       input_image.height() != codec_settings_.height) {
-    return WEBRTC_VIDEO_CODEC_ERR_SIZE;
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
   }
 
-  bool force_key_frame = false;
-  if (frame_types && !frame_types->empty()) {
-    force_key_frame = (*frame_types)[0] == VideoFrameType::kVideoFrameKey;
+  const bool keyframe_required =
+      frame_types != nullptr &&
+      absl::c_linear_search(*frame_types, VideoFrameType::kVideoFrameKey);
+
+  // VVenC has no way to request an IDR picture for a single input picture.
+  // The first picture after opening the encoder is always an IDR picture, so
+  // a key frame is produced by draining the pipeline and reopening.
+  if ((keyframe_required && next_sequence_number_ > 0) || reopen_required_) {
+    int32_t result = FlushEncoder();
+    if (result != WEBRTC_VIDEO_CODEC_OK) {
+      return result;
+    }
+    DestroyEncoder();
+    if (!ConfigureEncoder()) {
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
   }
 
-  // In a real implementation:
-  // 1. Convert the input frame to the format expected by VVenC
-  // 2. Set encoding parameters (QP, frame type, etc.)
-  // 3. Call the VVenC encoding function
-  // 4. Process the encoded data and pass it to the callback
-
-  // For this placeholder, we'll just log the encoding request
-  RTC_LOG(LS_INFO) << "Encoding H.266 frame, force key frame: " << force_key_frame
-                  << ", frame timestamp: " << input_image.timestamp();
-
-  frames_since_keyframe_++;
+  rtc::scoped_refptr<I420BufferInterface> buffer =
+      input_image.video_frame_buffer()->ToI420();
+  if (!buffer) {
+    RTC_LOG(LS_ERROR) << "Failed to convert "
+                      << VideoFrameBufferTypeToString(
+                             input_image.video_frame_buffer()->type())
+                      << " image to I420. Can't encode frame.";
+    return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+  }
 
-  // Placeholder: In a real implementation, this would be the actual encoded data
-  // For now, we'll just create a dummy EncodedImage
-  EncodedImage encoded_image;
-  encoded_image._encodedWidth = input_image.width();
-  encoded_image._encodedHeight = input_image.height();
-  encoded_image.SetTimestamp(input_image.timestamp());
-  encoded_image.capture_time_ms_ = input_image.render_time_ms();
-  encoded_image._frameType = force_key_frame ? VideoFrameType::kVideoFrameKey 
-                                            : VideoFrameType::kVideoFrameDelta;
-  
-  // Set codec specific info
-  CodecSpecificInfo codec_specific;
-  codec_specific.codecType = kVideoCodecH266;
+  // Widen the planes straight into the picture owned by the encoder; VVenC
+  // copies the picture into its own buffers before vvenc_encode() returns.
+  const uint8_t* const src_planes[] = {buffer->DataY(), buffer->DataU(),
+                                       buffer->DataV()};
+  const int src_strides[] = {buffer->StrideY(), buffer->StrideU(),
+                             buffer->StrideV()};
+  for (int i = 0; i < 3; ++i) {
+    const auto& plane = input_picture_->planes[i];
+    libyuv::Convert8To16Plane(src_planes[i], src_strides[i],
+                              reinterpret_cast<uint16_t*>(plane.ptr),
+                              plane.stride, kBitDepthScale, plane.width,
+                              plane.height);
+  }
+  input_picture_->sequenceNumber = next_sequence_number_;
+  input_picture_->cts = next_sequence_number_;
+  input_picture_->ctsValid = true;
+
+  pending_frames_.push_back({next_sequence_number_, input_image.timestamp(),
+                             input_image.render_time_ms(), rtc::TimeMillis(),
+                             input_image.rotation(),
+                             input_image.color_space()});
+  ++next_sequence_number_;
+
+  bool encode_done = false;
+  int ret = vvenc_encode(encoder_, input_picture_, access_unit_, &encode_done);
+  if (ret != VVENC_OK) {
+    RTC_LOG(LS_ERROR) << "VVenC failed to encode frame: "
+                      << vvenc_get_last_error(encoder_);
+    pending_frames_.pop_back();
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
 
-  // In a real implementation, this would be the callback with actual encoded data
-  // encoded_image_callback_->OnEncodedImage(encoded_image, &codec_specific);
+  return DeliverAccessUnit();
+}
 
+int32_t VVencH266Encoder::FlushEncoder() {
+  bool encode_done = false;
+  while (!encode_done && !pending_frames_.empty()) {
+    int ret = vvenc_encode(encoder_, nullptr, access_unit_, &encode_done);
+    if (ret != VVENC_OK) {
+      RTC_LOG(LS_ERROR) << "VVenC failed to flush: "
+                        << vvenc_get_last_error(encoder_);
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    int32_t result = DeliverAccessUnit();
+    if (result != WEBRTC_VIDEO_CODEC_OK) {
+      return result;
+    }
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
-void VVencH266Encoder::EncoderCallback(void* encoder,
-                                      void* param,
-                                      const uint8_t* encoded_data,
-                                      size_t encoded_size,
-                                      bool is_keyframe) {
-  // This would be called by the VVenC library when encoding is complete
-  // In a real implementation, this would process the encoded data and
-  // pass it to the EncodedImageCallback
+int32_t VVencH266Encoder::DeliverAccessUnit() {
+  if (access_unit_->payloadUsedSize <= 0) {
+    // The picture is still in the pipeline.
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  // Pictures are output in input order, but skip entries the encoder did not
+  // produce output for rather than attaching the wrong timestamps.
+  while (!pending_frames_.empty() &&
+         pending_frames_.front().sequence_number < access_unit_->cts) {
+    pending_frames_.pop_front();
+  }
+  if (pending_frames_.empty() ||
+      pending_frames_.front().sequence_number != access_unit_->cts) {
+    RTC_LOG(LS_WARNING) << "Dropping H.266 access unit for unknown picture "
+                        << access_unit_->cts;
+    vvenc_accessUnit_reset(access_unit_);
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  const PendingFrame frame = std::move(pending_frames_.front());
+  pending_frames_.pop_front();
+
+  encoded_image_.SetEncodedData(EncodedImageBuffer::Create(
+      access_unit_->payload, access_unit_->payloadUsedSize));
+  encoded_image_._encodedWidth = codec_settings_.width;
+  encoded_image_._encodedHeight = codec_settings_.height;
+  encoded_image_.SetRtpTimestamp(frame.rtp_timestamp);
+  encoded_image_.capture_time_ms_ = frame.capture_time_ms;
+  encoded_image_.rotation_ = frame.rotation;
+  encoded_image_.SetColorSpace(frame.color_space);
+  encoded_image_.content_type_ =
+      codec_settings_.mode == VideoCodecMode::kScreensharing
+          ? VideoContentType::SCREENSHARE
+          : VideoContentType::UNSPECIFIED;
+  encoded_image_._frameType = access_unit_->rap
+                                  ? VideoFrameType::kVideoFrameKey
+                                  : VideoFrameType::kVideoFrameDelta;
+  const int64_t encode_finish_ms = rtc::TimeMillis();
+  encoded_image_.SetEncodeTime(frame.encode_start_ms, encode_finish_ms);
+  encode_latency_ = TimeDelta::Millis(encode_finish_ms - frame.encode_start_ms);
+  vvenc_accessUnit_reset(access_unit_);
+
+  CodecSpecificInfo codec_specific;
+  codec_specific.codecType = kVideoCodecH266;
+  encoded_image_callback_->OnEncodedImage(encoded_image_, &codec_specific);
+  return WEBRTC_VIDEO_CODEC_OK;
 }
 
 VideoEncoder::EncoderInfo VVencH266Encoder::GetEncoderInfo() const {
   EncoderInfo info;
   info.supports_native_handle = false;
   info.implementation_name = "VVenC H.266";
-  info.scaling_settings = VideoEncoder::ScalingSettings(kLowH266QpThreshold,
-                                                       kHighH266QpThreshold);
+  // VVenC does not report the QP of a coded picture; it is parsed from the
+  // slice headers by the QpParser instead.
+  info.scaling_settings =
+      VideoEncoder::ScalingSettings(kLowH266QpThreshold, kHighH266QpThreshold);
   info.is_hardware_accelerated = false;
-  info.has_internal_source = false;
   info.supports_simulcast = false;
+  info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420};
+  info.encode_latency = encode_latency_;
   return info;
 }
 
-}  // namespace webrtc
\ No newline at end of file
+}  // namespace webrtc
@@ -11,22 +11,35 @@
 #ifndef MODULES_VIDEO_CODING_CODECS_H266_VVENC_H266_ENCODER_H_
 #define MODULES_VIDEO_CODING_CODECS_H266_VVENC_H266_ENCODER_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/units/time_delta.h"
+#include "api/video/color_space.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_rotation.h"
 #include "api/video_codecs/video_encoder.h"
 #include "common_video/h266/h266_common.h"
+#include "media/base/codec.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/system/rtc_export.h"
 
-// Forward declaration for VVenC library types
+// Forward declarations for VVenC library types.
 struct vvenc_config;
-struct vvenc_encoder;
+struct vvencAccessUnit;
+struct vvencEncoder;
+struct vvencYUVBuffer;
 
 namespace webrtc {
 
-// VVenC H.266 encoder implementation
+// VVenC H.266 encoder implementation. The encoder is configured for low
+// delay: pictures are coded in output order without lookahead, and with
+// several cores WPP, tiles and frame threading are enabled. With frame
+// threading the encoded image for a frame may be delivered from a later call
+// to Encode().
 class RTC_EXPORT VVencH266Encoder : public VideoEncoder {
  public:
   explicit VVencH266Encoder(const cricket::VideoCodec& codec);
@@ -38,7 +51,7 @@ class RTC_EXPORT VVencH266Encoder : public VideoEncoder {
 
   int32_t RegisterEncodeCompleteCallback(
       EncodedImageCallback* callback) override;
-  int32_t SetRates(const RateControlParameters& parameters) override;
+  void SetRates(const RateControlParameters& parameters) override;
   int32_t Encode(const VideoFrame& input_image,
                  const std::vector<VideoFrameType>* frame_types) override;
 
@@ -47,38 +60,60 @@ class RTC_EXPORT VVencH266Encoder : public VideoEncoder {
   static bool IsSupported();
 
  private:
-  // Configures the encoder with the settings provided by InitEncode
+  // Metadata of a frame that has been passed to the encoder but whose encoded
+  // image has not been delivered yet.
+  struct PendingFrame {
+    uint64_t sequence_number;
+    uint32_t rtp_timestamp;
+    int64_t capture_time_ms;
+    int64_t encode_start_ms;
+    VideoRotation rotation;
+    absl::optional<ColorSpace> color_space;
+  };
+
+  // Creates and opens the encoder with the settings provided by InitEncode.
+  // The first picture encoded after this is an IDR picture.
   bool ConfigureEncoder();
 
-  // Converts from VideoCodecMode to appropriate encoder preset
+  // Closes the encoder and frees the input picture and access unit.
+  void DestroyEncoder();
+
+  // Applies the low delay settings for `mode` on top of a VVenC preset.
   void SetEncoderPreset(vvenc_config* config, VideoCodecMode mode);
 
-  // Callback function for VVenC encoder
-  static void EncoderCallback(void* encoder,
-                              void* param,
-                              const uint8_t* encoded_data,
-                              size_t encoded_size,
-                              bool is_keyframe);
+  // Drains the frames remaining in the encoder pipeline.
+  int32_t FlushEncoder();
+
+  // Passes the picture in `access_unit_`, if any, to the callback.
+  int32_t DeliverAccessUnit();
 
   // Encoder configuration
   VideoCodec codec_settings_;
-  Settings encoder_settings_;
   cricket::VideoCodec codec_;
+  int number_of_cores_;
 
   // VVenC encoder state
-  vvenc_encoder* encoder_;
-  vvenc_config* config_;
+  vvencEncoder* encoder_;
+  std::unique_ptr<vvenc_config> config_;
+  vvencYUVBuffer* input_picture_;
+  vvencAccessUnit* access_unit_;
 
   // Encoded image callback
   EncodedImageCallback* encoded_image_callback_;
+  EncodedImage encoded_image_;
 
   // Rate control state
   uint32_t target_bitrate_bps_;
-  uint32_t max_bitrate_bps_;
   uint32_t framerate_fps_;
+  bool rates_configured_;
+  // Set when the encoder rejected a rate update and has to be reopened.
+  bool reopen_required_;
 
-  // Frame counter for determining when to insert keyframes
-  uint32_t frames_since_keyframe_;
+  // Sequence number of the next input picture, reset when the encoder is
+  // opened.
+  uint64_t next_sequence_number_;
+  std::deque<PendingFrame> pending_frames_;
+  absl::optional<TimeDelta> encode_latency_;
 
   // Indicates if the encoder is initialized
   bool initialized_;
@@ -86,4 +121,4 @@ class RTC_EXPORT VVencH266Encoder : public VideoEncoder {
 
 }  // namespace webrtc
 
-#endif  // MODULES_VIDEO_CODING_CODECS_H266_VVENC_H266_ENCODER_H_
\ No newline at end of file
+#endif  // MODULES_VIDEO_CODING_CODECS_H266_VVENC_H266_ENCODER_H_
@@ -0,0 +1,403 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Throughput benchmark of the software video codecs built into WebRTC.
+//
+// Every available codec is swept across resolution, number of cores given to
+// the codec and encoder complexity, which is the speed preset of the
+// encoders. For each configuration the benchmark reports the frame rate of
+// the encode and decode pipeline, the 50th and 99th percentile of the
+// per-frame encode and decode latency, and the peak resident set size of the
+// process while the configuration ran.
+//
+// Pass --benchmark_format=json, or --benchmark_out=<file> together with
+// --benchmark_out_format=json, for machine-readable results, and e.g.
+// --benchmark_filter=VP9 to run a single codec.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/numerics/samples_stats_counter.h"
+#include "api/test/create_frame_generator.h"
+#include "api/test/frame_generator_interface.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_bitrate_allocation.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+#include "api/video_codecs/scalability_mode.h"
+#include "api/video_codecs/video_codec.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_encoder.h"
+#include "benchmark/benchmark.h"
+#include "media/base/media_constants.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/video_coding/codecs/vp8/include/vp8.h"
+#include "modules/video_coding/codecs/vp9/include/vp9.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/time_utils.h"
+#include "test/video_codec_settings.h"
+
+#if defined(RTC_USE_LIBAOM_AV1_ENCODER) && \
+    defined(RTC_DAV1D_IN_INTERNAL_DECODER_FACTORY)
+#include "modules/video_coding/codecs/av1/dav1d_decoder.h"
+#include "modules/video_coding/codecs/av1/libaom_av1_encoder.h"
+#endif
+#if defined(WEBRTC_USE_H264)
+#include "modules/video_coding/codecs/h264/include/h264.h"
+#endif
+#if defined(RTC_USE_VVENC_H266_ENCODER) && defined(RTC_USE_VVDEC_H266_DECODER)
+#include "media/base/codec.h"
+#include "modules/video_coding/codecs/h266/vvdec_h266_decoder.h"
+#include "modules/video_coding/codecs/h266/vvenc_h266_encoder.h"
+#endif
+
+#if defined(WEBRTC_MAC)
+#include <sys/resource.h>
+#endif
+
+namespace webrtc {
+namespace {
+
+constexpr int kFramerate = 30;
+constexpr uint32_t kRtpTicksPerFrame = kVideoPayloadTypeFrequency / kFramerate;
+// Five seconds of video per configuration, which gives stable percentiles
+// and includes the key frame.
+constexpr int kNumFrames = 5 * kFramerate;
+// Distinct input pictures, cycled through while encoding.
+constexpr int kNumInputFrames = kFramerate;
+constexpr size_t kMaxPayloadSize = 1200;
+
+struct CodecFactory {
+  VideoCodecType codec_type;
+  std::unique_ptr<VideoEncoder> (*create_encoder)();
+  std::unique_ptr<VideoDecoder> (*create_decoder)();
+};
+
+// 0.1 bits per pixel, which is typical for real-time video.
+int TargetBitrateBps(int width, int height) {
+  return width * height * kFramerate / 10;
+}
+
+// Resets the peak resident set size of the process so that PeakRssBytes()
+// covers only what happens from now on. Where this is not supported the peak
+// covers the lifetime of the process.
+void ResetPeakRss() {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  FILE* file = fopen("/proc/self/clear_refs", "w");
+  if (file) {
+    fputs("5", file);
+    fclose(file);
+  }
+#endif
+}
+
+absl::optional<int64_t> PeakRssBytes() {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  FILE* file = fopen("/proc/self/status", "r");
+  if (!file) {
+    return absl::nullopt;
+  }
+  absl::optional<int64_t> peak_rss_bytes;
+  char line[256];
+  long peak_rss_kb = 0;  // NOLINT(runtime/int)
+  while (fgets(line, sizeof(line), file)) {
+    if (sscanf(line, "VmHWM: %ld kB", &peak_rss_kb) == 1) {
+      peak_rss_bytes = int64_t{peak_rss_kb} * 1024;
+      break;
+    }
+  }
+  fclose(file);
+  return peak_rss_bytes;
+#elif defined(WEBRTC_MAC)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return absl::nullopt;
+  }
+  return usage.ru_maxrss;
+#else
+  return absl::nullopt;
+#endif
+}
+
+// Collects encoded images and the time from the Encode() call of their frame
+// to their delivery, which includes any time the frame spends queued in a
+// frame-threaded encoder.
+class EncodeCallback : public EncodedImageCallback {
+ public:
+  void OnEncodeStart(uint32_t rtp_timestamp) {
+    encode_start_us_[rtp_timestamp] = rtc::TimeMicros();
+  }
+
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info) override {
+    auto it = encode_start_us_.find(encoded_image.RtpTimestamp());
+    if (it != encode_start_us_.end()) {
+      latency_ms_.AddSample((rtc::TimeMicros() - it->second) /
+                            static_cast<double>(rtc::kNumMicrosecsPerMillisec));
+      encode_start_us_.erase(it);
+    }
+    encoded_images_.push_back(encoded_image);
+    return Result(Result::OK);
+  }
+
+  std::vector<EncodedImage> TakeEncodedImages() {
+    return std::move(encoded_images_);
+  }
+  SamplesStatsCounter& latency_ms() { return latency_ms_; }
+
+ private:
+  std::map<uint32_t, int64_t> encode_start_us_;
+  std::vector<EncodedImage> encoded_images_;
+  SamplesStatsCounter latency_ms_;
+};
+
+// Measures the time from the Decode() call of an encoded image to the
+// delivery of its decoded frame.
+class DecodeCallback : public DecodedImageCallback {
+ public:
+  void OnDecodeStart(uint32_t rtp_timestamp) {
+    decode_start_us_[rtp_timestamp] = rtc::TimeMicros();
+  }
+
+  int32_t Decoded(VideoFrame& decoded_image) override {
+    auto it = decode_start_us_.find(decoded_image.timestamp());
+    if (it != decode_start_us_.end()) {
+      latency_ms_.AddSample((rtc::TimeMicros() - it->second) /
+                            static_cast<double>(rtc::kNumMicrosecsPerMillisec));
+      decode_start_us_.erase(it);
+    }
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  SamplesStatsCounter& latency_ms() { return latency_ms_; }
+
+ private:
+  std::map<uint32_t, int64_t> decode_start_us_;
+  SamplesStatsCounter latency_ms_;
+};
+
+void ReportLatency(benchmark::State& state,
+                   const char* name,
+                   SamplesStatsCounter& latency_ms) {
+  if (latency_ms.IsEmpty()) {
+    return;
+  }
+  state.counters[std::string(name) + "_p50_ms"] = latency_ms.GetPercentile(0.5);
+  state.counters[std::string(name) + "_p99_ms"] =
+      latency_ms.GetPercentile(0.99);
+}
+
+// Arguments: picture width (the height follows from a 16:9 aspect ratio),
+// number of cores and encoder complexity.
+void BM_EncodeDecode(benchmark::State& state, CodecFactory factory) {
+  const int width = state.range(0);
+  const int height = width * 9 / 16;
+  const int number_of_cores = state.range(1);
+  const auto complexity = static_cast<VideoCodecComplexity>(state.range(2));
+
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> input_buffers;
+  std::unique_ptr<test::FrameGeneratorInterface> frame_generator =
+      test::CreateSquareFrameGenerator(
+          width, height, test::FrameGeneratorInterface::OutputType::kI420,
+          absl::nullopt);
+  for (int i = 0; i < kNumInputFrames; ++i) {
+    input_buffers.push_back(frame_generator->NextFrame().buffer);
+  }
+
+  VideoCodec codec_settings;
+  test::CodecSettings(factory.codec_type, &codec_settings);
+  codec_settings.width = width;
+  codec_settings.height = height;
+  codec_settings.maxFramerate = kFramerate;
+  codec_settings.startBitrate = TargetBitrateBps(width, height) / 1000;
+  codec_settings.maxBitrate = 2 * codec_settings.startBitrate;
+  codec_settings.SetScalabilityMode(ScalabilityMode::kL1T1);
+  codec_settings.SetVideoEncoderComplexity(complexity);
+
+  VideoDecoder::Settings decoder_settings;
+  decoder_settings.set_codec_type(factory.codec_type);
+  decoder_settings.set_number_of_cores(number_of_cores);
+  decoder_settings.set_max_render_resolution({width, height});
+
+  ResetPeakRss();
+  std::unique_ptr<VideoEncoder> encoder = factory.create_encoder();
+  std::unique_ptr<VideoDecoder> decoder = factory.create_decoder();
+  EncodeCallback encode_callback;
+  DecodeCallback decode_callback;
+  if (encoder->InitEncode(&codec_settings,
+                          VideoEncoder::Settings(
+                              VideoEncoder::Capabilities(
+                                  /*loss_notification=*/false),
+                              number_of_cores, kMaxPayloadSize)) !=
+      WEBRTC_VIDEO_CODEC_OK) {
+    state.SkipWithError("Failed to initialize the encoder.");
+    return;
+  }
+  encoder->RegisterEncodeCompleteCallback(&encode_callback);
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, TargetBitrateBps(width, height));
+  encoder->SetRates(
+      VideoEncoder::RateControlParameters(bitrate_allocation, kFramerate));
+  if (!decoder->Configure(decoder_settings)) {
+    state.SkipWithError("Failed to configure the decoder.");
+    return;
+  }
+  decoder->RegisterDecodeCompleteCallback(&decode_callback);
+
+  const std::vector<VideoFrameType> key_frame_type = {
+      VideoFrameType::kVideoFrameKey};
+  const std::vector<VideoFrameType> delta_frame_type = {
+      VideoFrameType::kVideoFrameDelta};
+  int frame_index = 0;
+  const int64_t start_us = rtc::TimeMicros();
+  for (auto _ : state) {
+    const uint32_t rtp_timestamp = frame_index * kRtpTicksPerFrame;
+    VideoFrame frame =
+        VideoFrame::Builder()
+            .set_video_frame_buffer(
+                input_buffers[frame_index % input_buffers.size()])
+            .set_timestamp_rtp(rtp_timestamp)
+            .build();
+    encode_callback.OnEncodeStart(rtp_timestamp);
+    if (encoder->Encode(frame, frame_index == 0 ? &key_frame_type
+                                               : &delta_frame_type) !=
+        WEBRTC_VIDEO_CODEC_OK) {
+      state.SkipWithError("Failed to encode a frame.");
+      break;
+    }
+    for (const EncodedImage& encoded_image :
+         encode_callback.TakeEncodedImages()) {
+      decode_callback.OnDecodeStart(encoded_image.RtpTimestamp());
+      if (decoder->Decode(encoded_image, /*render_time_ms=*/0) !=
+          WEBRTC_VIDEO_CODEC_OK) {
+        state.SkipWithError("Failed to decode a frame.");
+        break;
+      }
+    }
+    ++frame_index;
+  }
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  encoder->Release();
+  decoder->Release();
+
+  if (elapsed_us > 0) {
+    state.counters["fps"] =
+        frame_index * static_cast<double>(rtc::kNumMicrosecsPerSec) /
+        elapsed_us;
+  }
+  ReportLatency(state, "encode", encode_callback.latency_ms());
+  ReportLatency(state, "decode", decode_callback.latency_ms());
+  absl::optional<int64_t> peak_rss_bytes = PeakRssBytes();
+  if (peak_rss_bytes) {
+    state.counters["peak_rss_mb"] = *peak_rss_bytes / (1024.0 * 1024.0);
+  }
+}
+
+void ApplySweep(benchmark::internal::Benchmark* benchmark) {
+  benchmark
+      ->ArgsProduct({
+          {320, 640, 1280, 1920},
+          {1, 2, 4, 8},
+          {static_cast<int>(VideoCodecComplexity::kComplexityLow),
+           static_cast<int>(VideoCodecComplexity::kComplexityNormal),
+           static_cast<int>(VideoCodecComplexity::kComplexityHigh),
+           static_cast<int>(VideoCodecComplexity::kComplexityHigher)},
+      })
+      ->ArgNames({"width", "cores", "complexity"})
+      ->Iterations(kNumFrames)
+      ->UseRealTime()
+      ->Unit(benchmark::kMillisecond);
+}
+
+std::unique_ptr<VideoEncoder> CreateVp8Encoder() {
+  return VP8Encoder::Create();
+}
+std::unique_ptr<VideoDecoder> CreateVp8Decoder() {
+  return VP8Decoder::Create();
+}
+
+BENCHMARK_CAPTURE(BM_EncodeDecode,
+                  VP8,
+                  CodecFactory{kVideoCodecVP8, &CreateVp8Encoder,
+                               &CreateVp8Decoder})
+    ->Apply(ApplySweep);
+
+#if defined(RTC_ENABLE_VP9)
+std::unique_ptr<VideoEncoder> CreateVp9Encoder() {
+  return VP9Encoder::Create();
+}
+std::unique_ptr<VideoDecoder> CreateVp9Decoder() {
+  return VP9Decoder::Create();
+}
+
+BENCHMARK_CAPTURE(BM_EncodeDecode,
+                  VP9,
+                  CodecFactory{kVideoCodecVP9, &CreateVp9Encoder,
+                               &CreateVp9Decoder})
+    ->Apply(ApplySweep);
+#endif
+
+#if defined(RTC_USE_LIBAOM_AV1_ENCODER) && \
+    defined(RTC_DAV1D_IN_INTERNAL_DECODER_FACTORY)
+std::unique_ptr<VideoEncoder> CreateAv1Encoder() {
+  return CreateLibaomAv1Encoder();
+}
+std::unique_ptr<VideoDecoder> CreateAv1Decoder() {
+  return CreateDav1dDecoder();
+}
+
+BENCHMARK_CAPTURE(BM_EncodeDecode,
+                  AV1,
+                  CodecFactory{kVideoCodecAV1, &CreateAv1Encoder,
+                               &CreateAv1Decoder})
+    ->Apply(ApplySweep);
+#endif
+
+#if defined(WEBRTC_USE_H264)
+std::unique_ptr<VideoEncoder> CreateH264Encoder() {
+  return H264Encoder::Create();
+}
+std::unique_ptr<VideoDecoder> CreateH264Decoder() {
+  return H264Decoder::Create();
+}
+
+BENCHMARK_CAPTURE(BM_EncodeDecode,
+                  H264,
+                  CodecFactory{kVideoCodecH264, &CreateH264Encoder,
+                               &CreateH264Decoder})
+    ->Apply(ApplySweep);
+#endif
+
+#if defined(RTC_USE_VVENC_H266_ENCODER) && defined(RTC_USE_VVDEC_H266_DECODER)
+std::unique_ptr<VideoEncoder> CreateH266Encoder() {
+  return std::make_unique<VVencH266Encoder>(
+      cricket::CreateVideoCodec(cricket::kH266CodecName));
+}
+std::unique_ptr<VideoDecoder> CreateH266Decoder() {
+  return std::make_unique<VVdecH266Decoder>();
+}
+
+BENCHMARK_CAPTURE(BM_EncodeDecode,
+                  H266,
+                  CodecFactory{kVideoCodecH266, &CreateH266Encoder,
+                               &CreateH266Decoder})
+    ->Apply(ApplySweep);
+#endif
+
+}  // namespace
+}  // namespace webrtc
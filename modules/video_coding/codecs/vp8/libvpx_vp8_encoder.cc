@@ -39,6 +39,8 @@
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
@@ -73,6 +75,14 @@ constexpr int kRtpTicksPerMs = kRtpTicksPerSecond / 1000;
 // send keyframe requests to recover.
 constexpr TimeDelta kDefaultMaxFrameDropInterval = TimeDelta::Seconds(2);
 
+// Range of real-time speeds, as magnitude of VP8E_SET_CPUUSED, used when the
+// speed is adapted to the encode time. A static speed outside of this range is
+// still used as is when no adaptation is needed.
+constexpr int kMinAdaptiveCpuSpeed = 4;
+constexpr int kMaxAdaptiveCpuSpeed = 16;
+// Max number of steps slower than the static speed the adaptation may use.
+constexpr int kMaxAdaptiveSpeedDecrease = 2;
+
 // VP8 denoiser states.
 enum denoiserState : uint32_t {
   kDenoiserOff,
@@ -347,6 +357,7 @@ int LibvpxVp8Encoder::Release() {
   config_overrides_.clear();
   send_stream_.clear();
   cpu_speed_.clear();
+  speed_controller_.reset();
 
   for (auto it = raw_images_.rbegin(); it != raw_images_.rend(); ++it) {
     libvpx_->img_free(&*it);
@@ -668,6 +679,25 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
         static_cast<unsigned int>(settings.encoder_thread_limit.value()));
   }
 
+  if (settings.target_encode_time_fraction.has_value()) {
+    // libvpx creates the VP8 encoder threads on initialization, so only the
+    // speed is adapted.
+    const int speed = -cpu_speed_[0];
+    EncodeSpeedController::Config speed_config;
+    speed_config.target_encode_time_fraction =
+        *settings.target_encode_time_fraction;
+    speed_config.min_speed_offset = std::min(
+        0, std::max(-kMaxAdaptiveSpeedDecrease, kMinAdaptiveCpuSpeed - speed));
+    speed_config.max_speed_offset = std::max(0, kMaxAdaptiveCpuSpeed - speed);
+    speed_config.min_num_threads = vpx_configs_[0].g_threads;
+    speed_config.max_num_threads = vpx_configs_[0].g_threads;
+    speed_controller_ = std::make_unique<EncodeSpeedController>(
+        speed_config,
+        EncodeSpeedController::Setting{
+            .speed_offset = 0,
+            .num_threads = static_cast<int>(vpx_configs_[0].g_threads)});
+  }
+
   // Creating a wrapper to the image - setting image data to NULL.
   // Actual pointer will be set in encode. Setting align to 1, as it
   // is meaningless (no memory allocation is done here).
@@ -777,6 +807,17 @@ int LibvpxVp8Encoder::GetCpuSpeed(int width, int height) {
 #endif
 }
 
+int LibvpxVp8Encoder::AdaptedCpuSpeed(size_t encoder_idx) const {
+  const int cpu_speed = cpu_speed_[encoder_idx];
+  if (!speed_controller_ || speed_controller_->setting().speed_offset == 0) {
+    return cpu_speed;
+  }
+  // Real-time speeds are negative, the larger the magnitude the faster.
+  return -rtc::SafeClamp(-cpu_speed + speed_controller_->setting().speed_offset,
+                         std::min(-cpu_speed, kMinAdaptiveCpuSpeed),
+                         kMaxAdaptiveCpuSpeed);
+}
+
 int LibvpxVp8Encoder::NumberOfThreads(int width, int height, int cpus) {
 #if defined(WEBRTC_ANDROID)
   if (width * height >= 320 * 180) {
@@ -870,7 +911,8 @@ int LibvpxVp8Encoder::InitAndSetControlSettings() {
     libvpx_->codec_control(
         &(encoders_[i]), VP8E_SET_STATIC_THRESHOLD,
         codec_.mode == VideoCodecMode::kScreensharing ? 100u : 1u);
-    libvpx_->codec_control(&(encoders_[i]), VP8E_SET_CPUUSED, cpu_speed_[i]);
+    libvpx_->codec_control(&(encoders_[i]), VP8E_SET_CPUUSED,
+                           AdaptedCpuSpeed(i));
     libvpx_->codec_control(
         &(encoders_[i]), VP8E_SET_TOKEN_PARTITIONS,
         static_cast<vp8e_token_partitions>(kTokenPartitions));
@@ -1120,6 +1162,7 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
 
   int error = WEBRTC_VIDEO_CODEC_OK;
   int num_tries = 0;
+  TimeDelta encode_time = TimeDelta::Zero();
   // If the first try returns WEBRTC_VIDEO_CODEC_TARGET_BITRATE_OVERSHOOT
   // the frame must be reencoded with the same parameters again because
   // target bitrate is exceeded and encoder state has been reset.
@@ -1130,8 +1173,10 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Note we must pass 0 for `flags` field in encode call below since they are
     // set above in `libvpx_interface_->vpx_codec_control_` function for each
     // encoder/spatial layer.
+    const int64_t encode_start_us = rtc::TimeMicros();
     error = libvpx_->codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
                                   duration, 0, VPX_DL_REALTIME);
+    encode_time += TimeDelta::Micros(rtc::TimeMicros() - encode_start_us);
     // Reset specific intra frame thresholds, following the key frame.
     if (send_key_frame) {
       libvpx_->codec_control(&(encoders_[0]), VP8E_SET_MAX_INTRA_BITRATE_PCT,
@@ -1142,6 +1187,15 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
     // Examines frame timestamps only.
     error = GetEncodedPartitions(frame, retransmission_allowed);
   }
+  if (speed_controller_ &&
+      speed_controller_->OnFrameEncoded(
+          encode_time, TimeDelta::Seconds(1) / codec_.maxFramerate,
+          send_key_frame)) {
+    for (size_t i = 0; i < encoders_.size(); ++i) {
+      libvpx_->codec_control(&(encoders_[i]), VP8E_SET_CPUUSED,
+                             AdaptedCpuSpeed(i));
+    }
+  }
   // TODO(sprang): Shouldn't we use the frame timestamp instead?
   timestamp_ += duration;
   return error;
@@ -1332,6 +1386,13 @@ VideoEncoder::EncoderInfo LibvpxVp8Encoder::GetEncoderInfo() const {
   }
   info.preferred_pixel_formats = {VideoFrameBuffer::Type::kI420,
                                   VideoFrameBuffer::Type::kNV12};
+  if (speed_controller_) {
+    info.encode_speed = EncodeSpeedStats{
+        .speed = AdaptedCpuSpeed(0),
+        .num_threads = speed_controller_->setting().num_threads,
+        .encode_time_fraction = speed_controller_->encode_time_fraction(),
+        .num_adaptations = speed_controller_->num_adaptations()};
+  }
 
   if (inited_) {
     // `encoder_idx` is libvpx index where 0 is highest resolution.
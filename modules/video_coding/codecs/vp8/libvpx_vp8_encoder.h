@@ -26,6 +26,7 @@
 #include "modules/video_coding/codecs/interface/libvpx_interface.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/utility/encode_speed_controller.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
 #include "modules/video_coding/utility/vp8_constants.h"
 #include "rtc_base/experiments/cpu_speed_experiment.h"
@@ -71,6 +72,10 @@ class LibvpxVp8Encoder : public VideoEncoder {
   // Get the cpu_speed setting for encoder based on resolution and/or platform.
   int GetCpuSpeed(int width, int height);
 
+  // The cpu_speed setting for encoder `encoder_idx`, adapted to the encode
+  // time if `speed_controller_` is enabled.
+  int AdaptedCpuSpeed(size_t encoder_idx) const;
+
   // Determine number of encoder threads to use.
   int NumberOfThreads(int width, int height, int number_of_cores);
 
@@ -128,6 +133,9 @@ class LibvpxVp8Encoder : public VideoEncoder {
   std::vector<bool> key_frame_request_;
   std::vector<bool> send_stream_;
   std::vector<int> cpu_speed_;
+  // Adapts the speed to the measured encode time, if enabled through
+  // VideoEncoder::Settings::target_encode_time_fraction.
+  std::unique_ptr<EncodeSpeedController> speed_controller_;
   std::vector<vpx_image_t> raw_images_;
   std::vector<EncodedImage> encoded_images_;
   std::vector<vpx_codec_ctx_t> encoders_;
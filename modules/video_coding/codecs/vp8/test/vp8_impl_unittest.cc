@@ -26,6 +26,7 @@
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/codecs/vp8/libvpx_vp8_encoder.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
+#include "rtc_base/fake_clock.h"
 #include "rtc_base/time_utils.h"
 #include "test/field_trial.h"
 #include "test/mappable_native_buffer.h"
@@ -635,6 +636,49 @@ TEST_F(TestVp8Impl, KeepsTimestampOnReencode) {
   encoder.Encode(NextInputFrame(), &delta_frame);
 }
 
+TEST_F(TestVp8Impl, IncreasesSpeedWhenEncodingTakesTooLong) {
+  rtc::ScopedFakeClock clock;
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
+                           VP8Encoder::Settings());
+  ON_CALL(*vpx, img_wrap)
+      .WillByDefault(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt,
+                               unsigned int d_w, unsigned int d_h,
+                               unsigned int stride_align,
+                               unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  // Every frame takes almost the whole frame interval to encode.
+  ON_CALL(*vpx, codec_encode).WillByDefault(Invoke([&clock] {
+    clock.AdvanceTime(TimeDelta::Seconds(1) / kFramerateFps * 0.9);
+    return VPX_CODEC_OK;
+  }));
+
+  VideoEncoder::Settings settings = kSettings;
+  settings.target_encode_time_fraction = 0.5;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, settings));
+  MockEncodedImageCallback callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+  ASSERT_TRUE(encoder.GetEncoderInfo().encode_speed.has_value());
+  const int initial_speed = encoder.GetEncoderInfo().encode_speed->speed;
+  EXPECT_EQ(encoder.GetEncoderInfo().encode_speed->num_adaptations, 0);
+
+  auto delta_frame =
+      std::vector<VideoFrameType>{VideoFrameType::kVideoFrameDelta};
+  for (int i = 0; i < 2 * kFramerateFps; ++i) {
+    encoder.Encode(NextInputFrame(), &delta_frame);
+  }
+
+  // Real-time VP8 speeds are negative, faster the lower they are.
+  EXPECT_LT(encoder.GetEncoderInfo().encode_speed->speed, initial_speed);
+  EXPECT_GT(encoder.GetEncoderInfo().encode_speed->num_adaptations, 0);
+}
+
 TEST(LibvpxVp8EncoderTest, GetEncoderInfoReturnsStaticInformation) {
   auto* const vpx = new NiceMock<MockLibvpxInterface>();
   LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
@@ -650,6 +694,7 @@ TEST(LibvpxVp8EncoderTest, GetEncoderInfoReturnsStaticInformation) {
   EXPECT_THAT(info.preferred_pixel_formats,
               testing::UnorderedElementsAre(VideoFrameBuffer::Type::kNV12,
                                             VideoFrameBuffer::Type::kI420));
+  EXPECT_FALSE(info.encode_speed.has_value());
 }
 
 TEST(LibvpxVp8EncoderTest, RequestedResolutionAlignmentFromFieldTrial) {
@@ -40,6 +40,7 @@
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -67,6 +68,14 @@ const int kMaxAllowedPidDiff = 30;
 constexpr int kLowVp9QpThreshold = 149;
 constexpr int kHighVp9QpThreshold = 205;
 
+// Range of real-time speeds used when the speed is adapted to the encode time.
+// A static speed outside of this range is still used as is when no adaptation
+// is needed.
+constexpr int kMinAdaptiveSpeed = 5;
+constexpr int kMaxAdaptiveSpeed = 9;
+// Max number of steps slower than the static speed the adaptation may use.
+constexpr int kMaxAdaptiveSpeedDecrease = 2;
+
 std::pair<size_t, size_t> GetActiveLayers(
     const VideoBitrateAllocation& allocation) {
   for (size_t sl_idx = 0; sl_idx < kMaxSpatialLayers; ++sl_idx) {
@@ -295,6 +304,7 @@ int LibvpxVp9Encoder::Release() {
     libvpx_->img_free(raw_);
     raw_ = nullptr;
   }
+  speed_controller_.reset();
   inited_ = false;
   return ret_val;
 }
@@ -753,7 +763,55 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
   }
   ref_buf_ = {};
 
-  return InitAndSetControlSettings(inst);
+  ret_val = InitAndSetControlSettings(inst);
+  if (ret_val != WEBRTC_VIDEO_CODEC_OK) {
+    return ret_val;
+  }
+
+  if (settings.target_encode_time_fraction.has_value()) {
+    // libvpx only creates the worker threads the first time they are needed,
+    // so the number of threads may be lowered and raised again, but never
+    // above the initial number.
+    const int speed =
+        performance_flags_by_spatial_index_.rbegin()->base_layer_speed;
+    EncodeSpeedController::Config speed_config;
+    speed_config.target_encode_time_fraction =
+        *settings.target_encode_time_fraction;
+    speed_config.min_speed_offset = std::min(
+        0, std::max(-kMaxAdaptiveSpeedDecrease, kMinAdaptiveSpeed - speed));
+    speed_config.max_speed_offset = std::max(0, kMaxAdaptiveSpeed - speed);
+    speed_config.min_num_threads = 1;
+    speed_config.max_num_threads = config_->g_threads;
+    speed_controller_ = std::make_unique<EncodeSpeedController>(
+        speed_config,
+        EncodeSpeedController::Setting{
+            .speed_offset = 0,
+            .num_threads = static_cast<int>(config_->g_threads)});
+  }
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int LibvpxVp9Encoder::AdaptedSpeed(int speed) const {
+  if (!speed_controller_ || speed_controller_->setting().speed_offset == 0) {
+    return speed;
+  }
+  return rtc::SafeClamp(speed + speed_controller_->setting().speed_offset,
+                        std::min(speed, kMinAdaptiveSpeed), kMaxAdaptiveSpeed);
+}
+
+void LibvpxVp9Encoder::ApplyEncodeSpeedSetting() {
+  // Speeds are updated when the new config is set before the next frame, or
+  // per frame when using per layer speeds with SVC.
+  config_->g_threads = speed_controller_->setting().num_threads;
+  config_changed_ = true;
+  libvpx_->codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
+                         static_cast<int>((config_->g_threads >> 1)));
+  if (!is_svc_ && performance_flags_.use_per_layer_speed) {
+    libvpx_->codec_control(
+        encoder_, VP8E_SET_CPUUSED,
+        AdaptedSpeed(
+            performance_flags_by_spatial_index_.rbegin()->base_layer_speed));
+  }
 }
 
 int LibvpxVp9Encoder::NumberOfThreads(int width,
@@ -858,8 +916,8 @@ int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
 
   if (performance_flags_.use_per_layer_speed) {
     for (int si = 0; si < num_spatial_layers_; ++si) {
-      svc_params_.speed_per_layer[si] =
-          performance_flags_by_spatial_index_[si].base_layer_speed;
+      svc_params_.speed_per_layer[si] = AdaptedSpeed(
+          performance_flags_by_spatial_index_[si].base_layer_speed);
       svc_params_.loopfilter_ctrl[si] =
           performance_flags_by_spatial_index_[si].deblock_mode;
     }
@@ -886,7 +944,8 @@ int LibvpxVp9Encoder::InitAndSetControlSettings(const VideoCodec* inst) {
   if (!is_svc_ || !performance_flags_.use_per_layer_speed) {
     libvpx_->codec_control(
         encoder_, VP8E_SET_CPUUSED,
-        performance_flags_by_spatial_index_.rbegin()->base_layer_speed);
+        AdaptedSpeed(
+            performance_flags_by_spatial_index_.rbegin()->base_layer_speed));
   }
 
   if (num_spatial_layers_ > 1) {
@@ -1100,10 +1159,10 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
     // Update speed settings that might depend on temporal index.
     bool speed_updated = false;
     for (int sl_idx = 0; sl_idx < num_spatial_layers_; ++sl_idx) {
-      const int target_speed =
+      const int target_speed = AdaptedSpeed(
           layer_id.temporal_layer_id_per_spatial[sl_idx] == 0
               ? performance_flags_by_spatial_index_[sl_idx].base_layer_speed
-              : performance_flags_by_spatial_index_[sl_idx].high_layer_speed;
+              : performance_flags_by_spatial_index_[sl_idx].high_layer_speed);
       if (svc_params_.speed_per_layer[sl_idx] != target_speed) {
         svc_params_.speed_per_layer[sl_idx] = target_speed;
         speed_updated = true;
@@ -1136,10 +1195,10 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                       svc_params_.scaling_factor_den[i];
           int height = (svc_params_.scaling_factor_num[i] * config_->g_h) /
                        svc_params_.scaling_factor_den[i];
-          int speed =
+          int speed = AdaptedSpeed(
               std::prev(performance_flags_.settings_by_resolution.lower_bound(
                             width * height))
-                  ->second.base_layer_speed;
+                  ->second.base_layer_speed);
           libvpx_->codec_control(encoder_, VP8E_SET_CPUUSED, speed);
           break;
         }
@@ -1255,8 +1314,11 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                          .GetTargetRate())
           : codec_.maxFramerate;
   uint32_t duration = static_cast<uint32_t>(90000 / target_framerate_fps);
+  const int64_t encode_start_us = rtc::TimeMicros();
   const vpx_codec_err_t rv = libvpx_->codec_encode(
       encoder_, raw_, timestamp_, duration, flags, VPX_DL_REALTIME);
+  const TimeDelta encode_time =
+      TimeDelta::Micros(rtc::TimeMicros() - encode_start_us);
   if (rv != VPX_CODEC_OK) {
     RTC_LOG(LS_ERROR) << "Encoding error: " << libvpx_->codec_err_to_string(rv)
                       << "\n"
@@ -1267,6 +1329,13 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
   }
   timestamp_ += duration;
 
+  if (speed_controller_ &&
+      speed_controller_->OnFrameEncoded(
+          encode_time, TimeDelta::Seconds(1) / target_framerate_fps,
+          (flags & VPX_EFLAG_FORCE_KF) != 0)) {
+    ApplyEncodeSpeedSetting();
+  }
+
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -1847,6 +1916,14 @@ VideoEncoder::EncoderInfo LibvpxVp9Encoder::GetEncoderInfo() const {
     info.resolution_bitrate_limits =
         encoder_info_override_.resolution_bitrate_limits();
   }
+  if (speed_controller_) {
+    info.encode_speed = EncodeSpeedStats{
+        .speed = AdaptedSpeed(
+            performance_flags_by_spatial_index_.rbegin()->base_layer_speed),
+        .num_threads = speed_controller_->setting().num_threads,
+        .encode_time_fraction = speed_controller_->encode_time_fraction(),
+        .num_adaptations = speed_controller_->num_adaptations()};
+  }
   return info;
 }
 
@@ -28,6 +28,7 @@
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
+#include "modules/video_coding/utility/encode_speed_controller.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
@@ -231,6 +232,15 @@ class LibvpxVp9Encoder : public VP9Encoder {
       const FieldTrialsView& trials);
   static PerformanceFlags GetDefaultPerformanceFlags();
 
+  // Returns `speed` adapted to the encode time if `speed_controller_` is
+  // enabled.
+  int AdaptedSpeed(int speed) const;
+  // Applies a new setting of `speed_controller_` to the encoder.
+  void ApplyEncodeSpeedSetting();
+  // Adapts the speed and number of threads to the measured encode time, if
+  // enabled through VideoEncoder::Settings::target_encode_time_fraction.
+  std::unique_ptr<EncodeSpeedController> speed_controller_;
+
   int num_steady_state_frames_;
   // Only set config when this flag is set.
   bool config_changed_;
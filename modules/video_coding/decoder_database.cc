@@ -117,6 +117,15 @@ VCMGenericDecoder* VCMDecoderDatabase::GetDecoder(
   return &*current_decoder_;
 }
 
+VCMGenericDecoder* VCMDecoderDatabase::GetCurrentDecoder(
+    uint8_t payload_type) {
+  RTC_DCHECK_RUN_ON(&decoder_sequence_checker_);
+  if (!current_decoder_.has_value() || current_payload_type_ != payload_type) {
+    return nullptr;
+  }
+  return &*current_decoder_;
+}
+
 void VCMDecoderDatabase::CreateAndInitDecoder(const EncodedFrame& frame) {
   uint8_t payload_type = frame.PayloadType();
   RTC_DLOG(LS_INFO) << "Initializing decoder with payload type '"
@@ -52,6 +52,10 @@ class VCMDecoderDatabase {
       const EncodedFrame& frame,
       VCMDecodedFrameCallback* decoded_frame_callback);
 
+  // Returns the decoder in use if it decodes `payload_type`, without creating
+  // or reconfiguring one, otherwise nullptr.
+  VCMGenericDecoder* GetCurrentDecoder(uint8_t payload_type);
+
  private:
   void CreateAndInitDecoder(const EncodedFrame& frame)
       RTC_RUN_ON(decoder_sequence_checker_);
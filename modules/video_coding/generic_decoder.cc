@@ -19,6 +19,8 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
+#include "api/make_ref_counted.h"
+#include "api/video/encoded_image.h"
 #include "api/video/video_timing.h"
 #include "api/video_codecs/video_decoder.h"
 #include "modules/include/module_common_types_public.h"
@@ -36,6 +38,26 @@ namespace {
 
 constexpr size_t kDecoderFrameMemoryLength = 10;
 
+// The end of an encoded frame, from `offset` on, without copying it.
+class EncodedImageBufferTail : public EncodedImageBufferInterface {
+ public:
+  EncodedImageBufferTail(rtc::scoped_refptr<EncodedImageBufferInterface> buffer,
+                         size_t offset,
+                         size_t size)
+      : buffer_(std::move(buffer)), offset_(offset), size_(size) {
+    RTC_DCHECK_LE(offset_ + size_, buffer_->size());
+  }
+
+  const uint8_t* data() const override { return buffer_->data() + offset_; }
+  uint8_t* data() override { return buffer_->data() + offset_; }
+  size_t size() const override { return size_; }
+
+ private:
+  const rtc::scoped_refptr<EncodedImageBufferInterface> buffer_;
+  const size_t offset_;
+  const size_t size_;
+};
+
 }
 
 VCMDecodedFrameCallback::VCMDecodedFrameCallback(
@@ -200,6 +222,9 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
 
   timing_frame_info.flags = frame_info->timing.flags;
   timing_frame_info.decode_start_ms = frame_info->decode_start->ms();
+  timing_frame_info.first_slice_decode_start_ms =
+      frame_info->first_part_decode_start.value_or(*frame_info->decode_start)
+          .ms();
   timing_frame_info.decode_finish_ms = now.ms();
   timing_frame_info.render_time_ms =
       frame_info->render_time ? frame_info->render_time->ms() : -1;
@@ -216,6 +241,7 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
       "WebRTC.Video.GenericDecoder.DecodeDelay",
       timing_frame_info.decode_finish_ms - timing_frame_info.decode_start_ms);
   _timing->SetTimingFrameInfo(timing_frame_info);
+  _receiveCallback->OnTimingFrameInfo(timing_frame_info);
 
   decodedImage.set_timestamp_us(
       frame_info->render_time ? frame_info->render_time->us() : -1);
@@ -289,14 +315,56 @@ int32_t VCMGenericDecoder::Decode(const VCMEncodedFrame& frame, Timestamp now) {
   return Decode(frame, now, frame.RenderTimeMs());
 }
 
+int32_t VCMGenericDecoder::DecodePart(const EncodedImage& part,
+                                      Timestamp now) {
+  TRACE_EVENT1("webrtc", "VCMGenericDecoder::DecodePart", "timestamp",
+               part.RtpTimestamp());
+  if (!decoder_info_.supports_frame_parts) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  if (!frame_in_parts_ ||
+      frame_in_parts_->rtp_timestamp != part.RtpTimestamp()) {
+    if (frame_in_parts_) {
+      decoder_->DiscardFrameParts();
+    }
+    frame_in_parts_ = FrameInParts{.rtp_timestamp = part.RtpTimestamp(),
+                                   .first_part_decode_start = now,
+                                   .size = 0};
+  }
+  frame_in_parts_->size += part.size();
+  int32_t ret = decoder_->DecodePart(part, /*last_part=*/false);
+  if (ret < WEBRTC_VIDEO_CODEC_OK) {
+    // The rest of the frame is still passed on once it is complete, so that
+    // the error is handled like any other decode error.
+    RTC_LOG(LS_WARNING) << "Failed to decode part of frame with timestamp "
+                        << part.RtpTimestamp() << ", error code: " << ret;
+  }
+  return ret;
+}
+
 int32_t VCMGenericDecoder::Decode(const EncodedImage& frame,
                                   Timestamp now,
                                   int64_t render_time_ms) {
   TRACE_EVENT1("webrtc", "VCMGenericDecoder::Decode", "timestamp",
                frame.RtpTimestamp());
+  absl::optional<FrameInParts> frame_in_parts =
+      std::exchange(frame_in_parts_, absl::nullopt);
+  if (frame_in_parts &&
+      (frame_in_parts->rtp_timestamp != frame.RtpTimestamp() ||
+       frame_in_parts->size >= frame.size() || !frame.GetEncodedData())) {
+    // The frame is not the continuation of the parts passed so far, or it
+    // can't be told which of its bytes are, so it is decoded as a whole.
+    decoder_->DiscardFrameParts();
+    frame_in_parts = absl::nullopt;
+  }
+
   FrameInfo frame_info;
   frame_info.rtp_timestamp = frame.RtpTimestamp();
   frame_info.decode_start = now;
+  if (frame_in_parts) {
+    frame_info.first_part_decode_start =
+        frame_in_parts->first_part_decode_start;
+  }
   frame_info.render_time =
       render_time_ms >= 0
           ? absl::make_optional(Timestamp::Millis(render_time_ms))
@@ -318,7 +386,17 @@ int32_t VCMGenericDecoder::Decode(const EncodedImage& frame,
   frame_info.frame_type = frame.FrameType();
   _callback->Map(std::move(frame_info));
 
-  int32_t ret = decoder_->Decode(frame, render_time_ms);
+  int32_t ret;
+  if (frame_in_parts) {
+    // Only the data that has not already been passed in parts remains.
+    EncodedImage last_part = frame;
+    last_part.SetEncodedData(rtc::make_ref_counted<EncodedImageBufferTail>(
+        frame.GetEncodedData(), frame_in_parts->size,
+        frame.size() - frame_in_parts->size));
+    ret = decoder_->DecodePart(last_part, /*last_part=*/true);
+  } else {
+    ret = decoder_->Decode(frame, render_time_ms);
+  }
   VideoDecoder::DecoderInfo decoder_info = decoder_->GetDecoderInfo();
   if (decoder_info != decoder_info_) {
     RTC_LOG(LS_INFO) << "Changed decoder implementation to: "
@@ -41,6 +41,9 @@ struct FrameInfo {
   // once all inputs to this field use Timestamp instead of an integer.
   absl::optional<Timestamp> render_time;
   absl::optional<Timestamp> decode_start;
+  // Set if leading parts of the frame were passed to the decoder before the
+  // frame was complete.
+  absl::optional<Timestamp> first_part_decode_start;
   VideoRotation rotation;
   VideoContentType content_type;
   EncodedImage::Timing timing;
@@ -108,6 +111,12 @@ class VCMGenericDecoder {
   int32_t Decode(const VCMEncodedFrame& inputFrame, Timestamp now);
   int32_t Decode(const EncodedFrame& inputFrame, Timestamp now);
 
+  // Passes `part`, a leading part of a frame that is still being received, to
+  // a decoder that supports frame parts. Parts of the same frame must be
+  // passed in order. The rest of the frame is passed on when the complete
+  // frame is decoded.
+  int32_t DecodePart(const EncodedImage& part, Timestamp now);
+
   /**
    * Set decode callback. Deregistering while decoding is illegal.
    */
@@ -118,6 +127,13 @@ class VCMGenericDecoder {
   }
 
  private:
+  // A frame whose leading parts have been passed to the decoder.
+  struct FrameInParts {
+    uint32_t rtp_timestamp;
+    Timestamp first_part_decode_start;
+    size_t size;
+  };
+
   int32_t Decode(const EncodedImage& frame,
                  Timestamp now,
                  int64_t render_time_ms);
@@ -125,6 +141,7 @@ class VCMGenericDecoder {
   VideoDecoder* const decoder_;
   VideoContentType _last_keyframe_content_type;
   VideoDecoder::DecoderInfo decoder_info_;
+  absl::optional<FrameInParts> frame_in_parts_;
 };
 
 }  // namespace webrtc
@@ -17,8 +17,10 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/rtp_packet_infos.h"
+#include "api/video/encoded_image.h"
 #include "api/video_codecs/video_decoder.h"
 #include "common_video/test/utilities.h"
+#include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/timing/timing.h"
 #include "system_wrappers/include/clock.h"
 #include "test/fake_decoder.h"
@@ -57,9 +59,18 @@ class ReceiveCallback : public VCMReceiveCallback {
 
   uint32_t frames_dropped() const { return frames_dropped_; }
 
+  void OnTimingFrameInfo(const TimingFrameInfo& timing_frame_info) override {
+    timing_frame_infos_.push_back(timing_frame_info);
+  }
+
+  const std::vector<TimingFrameInfo>& timing_frame_infos() const {
+    return timing_frame_infos_;
+  }
+
  private:
   std::vector<VideoFrame> frames_;
   uint32_t frames_dropped_ = 0;
+  std::vector<TimingFrameInfo> timing_frame_infos_;
 };
 
 class GenericDecoderTest : public ::testing::Test {
@@ -188,5 +199,171 @@ TEST_F(GenericDecoderTest, IsLowLatencyStreamActivatedByPlayoutDelay) {
   EXPECT_TRUE(decoded_frame->render_parameters().use_low_latency_rendering);
 }
 
+TEST_F(GenericDecoderTest, ReportsTimingFrameInfoOfEveryFrame) {
+  for (int i = 0; i < 3; ++i) {
+    EncodedFrame encoded_frame;
+    encoded_frame.SetRtpTimestamp(90000 * i);
+    generic_decoder_.Decode(encoded_frame, clock_->CurrentTime());
+    time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  }
+
+  const std::vector<TimingFrameInfo>& infos =
+      user_callback_.timing_frame_infos();
+  ASSERT_EQ(infos.size(), 3u);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(infos[i].rtp_timestamp, 90000u * i);
+    EXPECT_LE(infos[i].decode_start_ms, infos[i].decode_finish_ms);
+  }
+}
+
+class FramePartsDecoder : public test::FakeDecoder {
+ public:
+  struct Part {
+    size_t size;
+    bool last_part;
+  };
+
+  DecoderInfo GetDecoderInfo() const override {
+    DecoderInfo info = FakeDecoder::GetDecoderInfo();
+    info.supports_frame_parts = true;
+    return info;
+  }
+
+  int32_t Decode(const EncodedImage& input, int64_t render_time_ms) override {
+    ++num_complete_frames;
+    return FakeDecoder::Decode(input, render_time_ms);
+  }
+
+  int32_t DecodePart(const EncodedImage& input_part, bool last_part) override {
+    parts.push_back({input_part.size(), last_part});
+    return last_part ? FakeDecoder::Decode(input_part, /*render_time_ms=*/-1)
+                     : WEBRTC_VIDEO_CODEC_OK;
+  }
+
+  void DiscardFrameParts() override { ++num_discarded_frames; }
+
+  int num_complete_frames = 0;
+  int num_discarded_frames = 0;
+  std::vector<Part> parts;
+};
+
+class GenericDecoderFramePartsTest : public GenericDecoderTest {
+ protected:
+  GenericDecoderFramePartsTest() : parts_generic_decoder_(&parts_decoder_) {}
+
+  void SetUp() override {
+    GenericDecoderTest::SetUp();
+    parts_generic_decoder_.RegisterDecodeCompleteCallback(&vcm_callback_);
+    VideoDecoder::Settings settings;
+    settings.set_codec_type(kVideoCodecH264);
+    settings.set_frame_parts_enabled(true);
+    parts_generic_decoder_.Configure(settings);
+  }
+
+  static EncodedImage CreatePart(uint32_t rtp_timestamp, size_t size) {
+    EncodedImage part;
+    part.SetRtpTimestamp(rtp_timestamp);
+    part.SetEncodedData(EncodedImageBuffer::Create(size));
+    return part;
+  }
+
+  static EncodedFrame CreateFrame(uint32_t rtp_timestamp, size_t size) {
+    EncodedFrame frame;
+    frame.SetRtpTimestamp(rtp_timestamp);
+    frame.SetEncodedData(EncodedImageBuffer::Create(size));
+    return frame;
+  }
+
+  FramePartsDecoder parts_decoder_;
+  VCMGenericDecoder parts_generic_decoder_;
+};
+
+TEST_F(GenericDecoderFramePartsTest, PassesRestOfFrameAsLastPart) {
+  EXPECT_EQ(parts_generic_decoder_.DecodePart(CreatePart(90000, 3),
+                                              clock_->CurrentTime()),
+            WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(parts_generic_decoder_.DecodePart(CreatePart(90000, 4),
+                                              clock_->CurrentTime()),
+            WEBRTC_VIDEO_CODEC_OK);
+  EXPECT_EQ(parts_generic_decoder_.Decode(CreateFrame(90000, 10),
+                                          clock_->CurrentTime()),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  EXPECT_EQ(parts_decoder_.num_complete_frames, 0);
+  EXPECT_EQ(parts_decoder_.num_discarded_frames, 0);
+  ASSERT_EQ(parts_decoder_.parts.size(), 3u);
+  EXPECT_EQ(parts_decoder_.parts[0].size, 3u);
+  EXPECT_FALSE(parts_decoder_.parts[0].last_part);
+  EXPECT_EQ(parts_decoder_.parts[1].size, 4u);
+  EXPECT_FALSE(parts_decoder_.parts[1].last_part);
+  EXPECT_EQ(parts_decoder_.parts[2].size, 3u);
+  EXPECT_TRUE(parts_decoder_.parts[2].last_part);
+  absl::optional<VideoFrame> decoded_frame = user_callback_.PopLastFrame();
+  ASSERT_TRUE(decoded_frame.has_value());
+  EXPECT_EQ(decoded_frame->timestamp(), 90000u);
+}
+
+TEST_F(GenericDecoderFramePartsTest, ReportsFirstSliceDecodeStart) {
+  const Timestamp first_part_time = clock_->CurrentTime();
+  parts_generic_decoder_.DecodePart(CreatePart(90000, 3), first_part_time);
+  time_controller_.AdvanceTime(TimeDelta::Millis(5));
+  const Timestamp frame_time = clock_->CurrentTime();
+  parts_generic_decoder_.Decode(CreateFrame(90000, 10), frame_time);
+  parts_generic_decoder_.Decode(CreateFrame(180000, 10), frame_time);
+
+  const std::vector<TimingFrameInfo>& infos =
+      user_callback_.timing_frame_infos();
+  ASSERT_EQ(infos.size(), 2u);
+  EXPECT_EQ(infos[0].first_slice_decode_start_ms, first_part_time.ms());
+  EXPECT_EQ(infos[0].decode_start_ms, frame_time.ms());
+  EXPECT_EQ(infos[1].first_slice_decode_start_ms, frame_time.ms());
+  EXPECT_EQ(infos[1].decode_start_ms, frame_time.ms());
+}
+
+TEST_F(GenericDecoderFramePartsTest, DecodesCompleteFrameOfOtherTimestamp) {
+  parts_generic_decoder_.DecodePart(CreatePart(90000, 3),
+                                    clock_->CurrentTime());
+  EXPECT_EQ(parts_generic_decoder_.Decode(CreateFrame(180000, 10),
+                                          clock_->CurrentTime()),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  EXPECT_EQ(parts_decoder_.num_complete_frames, 1);
+  EXPECT_EQ(parts_decoder_.num_discarded_frames, 1);
+  ASSERT_EQ(parts_decoder_.parts.size(), 1u);
+  EXPECT_FALSE(parts_decoder_.parts[0].last_part);
+}
+
+TEST_F(GenericDecoderFramePartsTest, DiscardsPartsCoveringCompleteFrame) {
+  parts_generic_decoder_.DecodePart(CreatePart(90000, 6),
+                                    clock_->CurrentTime());
+  parts_generic_decoder_.DecodePart(CreatePart(90000, 4),
+                                    clock_->CurrentTime());
+  EXPECT_EQ(parts_decoder_.num_discarded_frames, 0);
+  EXPECT_EQ(parts_generic_decoder_.Decode(CreateFrame(90000, 10),
+                                          clock_->CurrentTime()),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  EXPECT_EQ(parts_decoder_.num_discarded_frames, 1);
+  EXPECT_EQ(parts_decoder_.num_complete_frames, 1);
+  ASSERT_EQ(parts_decoder_.parts.size(), 2u);
+  EXPECT_FALSE(parts_decoder_.parts[1].last_part);
+  absl::optional<VideoFrame> decoded_frame = user_callback_.PopLastFrame();
+  ASSERT_TRUE(decoded_frame.has_value());
+  EXPECT_EQ(decoded_frame->timestamp(), 90000u);
+}
+
+TEST_F(GenericDecoderFramePartsTest, DiscardsUnfinishedFrameOnPartOfNextFrame) {
+  parts_generic_decoder_.DecodePart(CreatePart(90000, 3),
+                                    clock_->CurrentTime());
+  parts_generic_decoder_.DecodePart(CreatePart(180000, 3),
+                                    clock_->CurrentTime());
+  EXPECT_EQ(parts_decoder_.num_discarded_frames, 1);
+}
+
+TEST_F(GenericDecoderTest, DoesNotPassPartsToDecoderWithoutSupport) {
+  EXPECT_EQ(generic_decoder_.DecodePart(EncodedImage(), clock_->CurrentTime()),
+            WEBRTC_VIDEO_CODEC_ERROR);
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
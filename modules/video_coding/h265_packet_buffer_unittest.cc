@@ -0,0 +1,415 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/video_coding/h265_packet_buffer.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/video/video_codec_type.h"
+#include "api/video/video_frame_type.h"
+#include "common_video/h265/h265_common.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/unused.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+using H265::NaluType::kAP;
+using H265::NaluType::kFU;
+using H265::NaluType::kIdrWRadl;
+using H265::NaluType::kPps;
+using H265::NaluType::kSps;
+using H265::NaluType::kTrailR;
+using H265::NaluType::kVps;
+
+constexpr int kBufferSize = 2048;
+constexpr uint8_t kFuSBit = 0x80;
+constexpr uint8_t kFuEBit = 0x40;
+
+std::vector<uint8_t> NalHeader(H265::NaluType type) {
+  return {static_cast<uint8_t>(type << 1), 0x01};
+}
+
+class Packet {
+ public:
+  // Single NAL unit packet.
+  explicit Packet(H265::NaluType type) {
+    payload_ = NalHeader(type);
+    payload_.push_back(0xFF);
+  }
+
+  // Aggregation packet carrying one NAL unit of each of `types`.
+  static Packet Ap(std::vector<H265::NaluType> types) {
+    Packet packet(kAP);
+    packet.payload_ = NalHeader(kAP);
+    for (H265::NaluType type : types) {
+      packet.payload_.insert(packet.payload_.end(), {0, 3});
+      std::vector<uint8_t> header = NalHeader(type);
+      packet.payload_.insert(packet.payload_.end(), header.begin(),
+                             header.end());
+      packet.payload_.push_back(0xFF);
+    }
+    return packet;
+  }
+
+  // Fragment of a NAL unit of `type`.
+  static Packet Fu(H265::NaluType type, bool first, bool last) {
+    Packet packet(kFU);
+    packet.payload_ = NalHeader(kFU);
+    packet.payload_.push_back(
+        static_cast<uint8_t>((first ? kFuSBit : 0) | (last ? kFuEBit : 0) |
+                             type));
+    packet.payload_.push_back(0xFF);
+    return packet;
+  }
+
+  Packet& Marker() {
+    marker_bit_ = true;
+    return *this;
+  }
+  Packet& Time(uint32_t rtp_timestamp) {
+    rtp_timestamp_ = rtp_timestamp;
+    return *this;
+  }
+  Packet& SeqNum(uint16_t rtp_seq_num) {
+    rtp_seq_num_ = rtp_seq_num;
+    return *this;
+  }
+  Packet& Resolution(int width, int height) {
+    width_ = width;
+    height_ = height;
+    return *this;
+  }
+
+  std::unique_ptr<H265PacketBuffer::Packet> Build() const {
+    auto res = std::make_unique<H265PacketBuffer::Packet>();
+    res->video_payload = rtc::CopyOnWriteBuffer(payload_);
+    res->marker_bit = marker_bit_;
+    res->timestamp = rtp_timestamp_;
+    res->seq_num = rtp_seq_num_;
+    res->video_header.codec = kVideoCodecH265;
+    res->video_header.width = width_;
+    res->video_header.height = height_;
+    return res;
+  }
+
+ private:
+  std::vector<uint8_t> payload_;
+  bool marker_bit_ = false;
+  uint32_t rtp_timestamp_ = 0;
+  uint16_t rtp_seq_num_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+};
+
+TEST(H265PacketBufferTest, IrapIsKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  EXPECT_THAT(
+      packet_buffer.InsertPacket(Packet(kIdrWRadl).Marker().Build()).packets,
+      SizeIs(1));
+}
+
+TEST(H265PacketBufferTest, IrapIsNotKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  EXPECT_THAT(
+      packet_buffer.InsertPacket(Packet(kIdrWRadl).Marker().Build()).packets,
+      IsEmpty());
+}
+
+TEST(H265PacketBufferTest, DeltaFrameDoesNotStartStream) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  EXPECT_THAT(
+      packet_buffer.InsertPacket(Packet(kTrailR).Marker().Build()).packets,
+      IsEmpty());
+}
+
+TEST(H265PacketBufferTest, VpsSpsPpsIrapIsKeyframeSingleNalus) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet(kVps).SeqNum(0).Time(0).Build()));
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet(kSps).SeqNum(1).Time(0).Build()));
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet(kPps).SeqNum(2).Time(0).Build()));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet(kIdrWRadl).SeqNum(3).Time(0).Marker().Build())
+          .packets,
+      SizeIs(4));
+}
+
+TEST(H265PacketBufferTest, SpsPpsIrapWithoutVpsIsNotKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet(kSps).SeqNum(0).Time(0).Build()));
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet(kPps).SeqNum(1).Time(0).Build()));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet(kIdrWRadl).SeqNum(2).Time(0).Marker().Build())
+          .packets,
+      IsEmpty());
+}
+
+TEST(H265PacketBufferTest, VpsSpsPpsIrapIsKeyframeAp) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(Packet::Ap({kVps, kSps, kPps, kIdrWRadl})
+                                    .SeqNum(0)
+                                    .Time(0)
+                                    .Marker()
+                                    .Build())
+                  .packets,
+              SizeIs(1));
+}
+
+TEST(H265PacketBufferTest, IrapIsKeyframeFuRequiresFirstFragment) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  // The first fragment is lost.
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(Packet::Fu(kIdrWRadl, false, true)
+                                    .SeqNum(1)
+                                    .Time(0)
+                                    .Marker()
+                                    .Build())
+                  .packets,
+              IsEmpty());
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(Packet::Fu(kIdrWRadl, true, false)
+                                    .SeqNum(2)
+                                    .Time(1)
+                                    .Build())
+                  .packets,
+              IsEmpty());
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(Packet::Fu(kIdrWRadl, false, true)
+                                    .SeqNum(3)
+                                    .Time(1)
+                                    .Marker()
+                                    .Build())
+                  .packets,
+              SizeIs(2));
+}
+
+TEST(H265PacketBufferTest, InsertingMidFuCompletesFrame) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet(kIdrWRadl).SeqNum(0).Time(0).Marker().Build())
+                  .packets,
+              SizeIs(1));
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet::Fu(kTrailR, true, false).SeqNum(1).Time(1).Build()));
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet::Fu(kTrailR, false, true).SeqNum(3).Time(1).Marker().Build()));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(
+              Packet::Fu(kTrailR, false, false).SeqNum(2).Time(1).Build())
+          .packets,
+      SizeIs(3));
+}
+
+TEST(H265PacketBufferTest, SeqNumJumpDoesNotCompleteFrame) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet(kIdrWRadl).SeqNum(0).Time(0).Marker().Build())
+                  .packets,
+              SizeIs(1));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet(kTrailR).SeqNum(2).Time(1).Marker().Build())
+          .packets,
+      IsEmpty());
+}
+
+TEST(H265PacketBufferTest, FrameBoundariesAreSet) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kIdrWRadl).SeqNum(0).Time(0).Build()));
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kIdrWRadl).SeqNum(1).Time(0).Build()));
+  auto packets =
+      packet_buffer
+          .InsertPacket(Packet(kIdrWRadl).SeqNum(2).Time(0).Marker().Build())
+          .packets;
+
+  ASSERT_THAT(packets, SizeIs(3));
+  EXPECT_TRUE(packets[0]->video_header.is_first_packet_in_frame);
+  EXPECT_FALSE(packets[0]->video_header.is_last_packet_in_frame);
+  EXPECT_FALSE(packets[1]->video_header.is_first_packet_in_frame);
+  EXPECT_FALSE(packets[1]->video_header.is_last_packet_in_frame);
+  EXPECT_FALSE(packets[2]->video_header.is_first_packet_in_frame);
+  EXPECT_TRUE(packets[2]->video_header.is_last_packet_in_frame);
+}
+
+TEST(H265PacketBufferTest, ResolutionSetOnFirstPacket) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet(kVps).SeqNum(0).Time(0).Build()));
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kSps).Resolution(320, 240).SeqNum(1).Time(0).Build()));
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet(kPps).SeqNum(2).Time(0).Build()));
+  auto packets =
+      packet_buffer
+          .InsertPacket(Packet(kIdrWRadl).SeqNum(3).Time(0).Marker().Build())
+          .packets;
+
+  ASSERT_THAT(packets, SizeIs(4));
+  EXPECT_EQ(packets[0]->video_header.width, 320);
+  EXPECT_EQ(packets[0]->video_header.height, 240);
+}
+
+TEST(H265PacketBufferTest, KeyframeAndDeltaFrameSetOnFirstPacket) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  auto key = packet_buffer
+                 .InsertPacket(
+                     Packet(kIdrWRadl).SeqNum(0).Time(0).Marker().Build())
+                 .packets;
+  auto delta =
+      packet_buffer
+          .InsertPacket(Packet(kTrailR).SeqNum(1).Time(1).Marker().Build())
+          .packets;
+
+  ASSERT_THAT(key, SizeIs(1));
+  ASSERT_THAT(delta, SizeIs(1));
+  EXPECT_EQ(key[0]->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(delta[0]->video_header.frame_type,
+            VideoFrameType::kVideoFrameDelta);
+}
+
+TEST(H265PacketBufferTest, PayloadIsNotModified) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  std::unique_ptr<H265PacketBuffer::Packet> packet =
+      Packet::Ap({kVps, kIdrWRadl}).Marker().Build();
+  rtc::CopyOnWriteBuffer payload = packet->video_payload;
+  auto packets = packet_buffer.InsertPacket(std::move(packet)).packets;
+
+  ASSERT_THAT(packets, SizeIs(1));
+  EXPECT_EQ(packets[0]->video_payload, payload);
+}
+
+TEST(H265PacketBufferTest, PaddingBridgesGapBetweenFrames) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet(kIdrWRadl).SeqNum(0).Time(0).Marker().Build())
+                  .packets,
+              SizeIs(1));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet(kTrailR).SeqNum(2).Time(1).Marker().Build())
+          .packets,
+      IsEmpty());
+  EXPECT_THAT(packet_buffer.InsertPadding(1).packets, SizeIs(1));
+}
+
+TEST(H265PacketBufferTest, FramePartEndsAfterCompleteNalUnits) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kIdrWRadl).SeqNum(0).Time(0).Marker().Build()));
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kTrailR).SeqNum(1).Time(1).Build()));
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet::Fu(kTrailR, true, false).SeqNum(2).Time(1).Build()));
+  H265PacketBuffer::FramePart part = packet_buffer.FindNextFramePart();
+  EXPECT_TRUE(part.first_part);
+  ASSERT_THAT(part.packets, SizeIs(1));
+  EXPECT_EQ(part.packets[0]->seq_num, 1);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet::Fu(kTrailR, false, true).SeqNum(3).Time(1).Build()));
+  part = packet_buffer.FindNextFramePart();
+  EXPECT_FALSE(part.first_part);
+  ASSERT_THAT(part.packets, SizeIs(2));
+  EXPECT_EQ(part.packets[0]->seq_num, 2);
+  EXPECT_EQ(part.packets[1]->seq_num, 3);
+  EXPECT_THAT(packet_buffer.FindNextFramePart().packets, IsEmpty());
+
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet(kTrailR).SeqNum(4).Time(1).Marker().Build())
+          .packets,
+      SizeIs(4));
+  EXPECT_THAT(packet_buffer.FindNextFramePart().packets, IsEmpty());
+}
+
+TEST(H265PacketBufferTest, FramePartSkipsPaddingBetweenFrames) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kIdrWRadl).SeqNum(0).Time(0).Marker().Build()));
+  RTC_UNUSED(packet_buffer.InsertPadding(1));
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kTrailR).SeqNum(2).Time(1).Build()));
+  H265PacketBuffer::FramePart part = packet_buffer.FindNextFramePart();
+  EXPECT_TRUE(part.first_part);
+  ASSERT_THAT(part.packets, SizeIs(1));
+  EXPECT_EQ(part.packets[0]->seq_num, 2);
+}
+
+TEST(H265PacketBufferTest, RtpSeqNumWrap) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet(kIdrWRadl).SeqNum(0xffff).Time(0).Build()));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet(kIdrWRadl).SeqNum(0).Time(0).Marker().Build())
+          .packets,
+      SizeIs(2));
+}
+
+TEST(H265PacketBufferTest, FullPacketBufferDoesNotBlockKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  for (int i = 0; i < kBufferSize; ++i) {
+    EXPECT_THAT(packet_buffer
+                    .InsertPacket(Packet(kTrailR).SeqNum(i).Time(0).Build())
+                    .packets,
+                IsEmpty());
+  }
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(Packet(kIdrWRadl)
+                                    .SeqNum(kBufferSize)
+                                    .Time(1)
+                                    .Marker()
+                                    .Build())
+                  .packets,
+              SizeIs(1));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,23 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_H266_PACKET_BUFFER_H_
+#define MODULES_VIDEO_CODING_H266_PACKET_BUFFER_H_
+
+#include "modules/rtp_rtcp/source/rtp_format_h266.h"
+#include "modules/video_coding/h26x_packet_buffer.h"
+
+namespace webrtc {
+
+using H266PacketBuffer = H26xPacketBuffer<H266NalTraits>;
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_H266_PACKET_BUFFER_H_
@@ -0,0 +1,403 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_H26X_PACKET_BUFFER_H_
+#define MODULES_VIDEO_CODING_H26X_PACKET_BUFFER_H_
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/video/video_frame_type.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+
+// The H26xPacketBuffer does the same job as the H264PacketBuffer for payloads
+// produced by VideoRtpDepacketizerH26x, see rtp_format_h26x.h for `NalTraits`.
+// Packets are expected to still carry their RFC 7798 / RFC 9328 payload
+// headers; they are returned untouched and only turned into an Annex B
+// bitstream by the depacketizer's AssembleFrame(), so assembly costs a single
+// copy of the payload.
+template <typename NalTraits>
+class H26xPacketBuffer {
+ public:
+  using Packet = video_coding::PacketBuffer::Packet;
+  using InsertResult = video_coding::PacketBuffer::InsertResult;
+  using FramePart = video_coding::PacketBuffer::FramePart;
+
+  // If `irap_only_keyframes_allowed` is false, a keyframe is only assembled
+  // if it also carries SPS, PPS and, if the codec requires one, VPS.
+  explicit H26xPacketBuffer(bool irap_only_keyframes_allowed)
+      : irap_only_keyframes_allowed_(irap_only_keyframes_allowed) {}
+
+  ABSL_MUST_USE_RESULT InsertResult
+  InsertPacket(std::unique_ptr<Packet> packet);
+
+  // Padding packets advance the continuous sequence if they directly follow
+  // it, so that padding sent between frames does not stall assembly.
+  ABSL_MUST_USE_RESULT InsertResult InsertPadding(uint16_t seq_num);
+
+  // Same as PacketBuffer::FindNextFramePart(), frames are split after every
+  // packet that ends a NAL unit.
+  FramePart FindNextFramePart();
+
+ private:
+  static constexpr int kBufferSize = 2048;
+  static constexpr size_t kNalHeaderSize = 2;
+  static constexpr size_t kLengthFieldSize = 2;
+
+  // NAL units that start in a packet. FU packets other than the first
+  // fragment start none.
+  struct NaluSummary {
+    bool has_vps = false;
+    bool has_sps = false;
+    bool has_pps = false;
+    bool has_irap = false;
+
+    void Add(uint8_t type) {
+      has_vps |= type == NalTraits::kVps;
+      has_sps |= type == NalTraits::kSps;
+      has_pps |= type == NalTraits::kPps;
+      has_irap |= NalTraits::IsIrap(type);
+    }
+    void Add(const NaluSummary& other) {
+      has_vps |= other.has_vps;
+      has_sps |= other.has_sps;
+      has_pps |= other.has_pps;
+      has_irap |= other.has_irap;
+    }
+  };
+
+  static NaluSummary SummarizeNalus(rtc::ArrayView<const uint8_t> payload);
+  // Returns true unless `packet` carries an FU that continues in the next
+  // packet.
+  static bool EndsNalUnit(const Packet& packet);
+
+  std::unique_ptr<Packet>& GetPacket(int64_t unwrapped_seq_num) {
+    int64_t index = unwrapped_seq_num % kBufferSize;
+    return buffer_[index < 0 ? index + kBufferSize : index];
+  }
+  bool BeginningOfStream(const Packet& packet) const;
+  std::vector<std::unique_ptr<Packet>> FindFrames(int64_t unwrapped_seq_num);
+  bool MaybeAssembleFrame(int64_t start_seq_num_unwrapped,
+                          int64_t end_sequence_number_unwrapped,
+                          std::vector<std::unique_ptr<Packet>>& packets);
+
+  const bool irap_only_keyframes_allowed_;
+  std::array<std::unique_ptr<Packet>, kBufferSize> buffer_;
+  absl::optional<int64_t> last_continuous_unwrapped_seq_num_;
+  // Where the frame after the newest assembled frame starts.
+  absl::optional<int64_t> next_frame_start_unwrapped_seq_num_;
+  // Progress of FindNextFramePart() through that frame. Packets before
+  // `part_end_seq_num` have been returned, packets from there up to
+  // `scan_end_seq_num` are contiguous and have been scanned.
+  struct FramePartScan {
+    uint32_t rtp_timestamp;
+    int64_t first_seq_num;
+    int64_t part_end_seq_num;
+    int64_t scan_end_seq_num;
+  };
+  absl::optional<FramePartScan> frame_part_scan_;
+  SeqNumUnwrapper<uint16_t> seq_num_unwrapper_;
+};
+
+// The payload has already been validated by the depacketizer.
+template <typename NalTraits>
+typename H26xPacketBuffer<NalTraits>::NaluSummary
+H26xPacketBuffer<NalTraits>::SummarizeNalus(
+    rtc::ArrayView<const uint8_t> payload) {
+  NaluSummary summary;
+  if (payload.size() < kNalHeaderSize)
+    return summary;
+  auto nalu_type = [&](size_t offset) {
+    return NalTraits::Type(
+        ByteReader<uint16_t>::ReadBigEndian(&payload[offset]));
+  };
+  const uint8_t payload_type = nalu_type(0);
+  if (payload_type == NalTraits::kAp) {
+    size_t offset = kNalHeaderSize;
+    while (offset + kLengthFieldSize < payload.size()) {
+      const size_t nalu_size =
+          ByteReader<uint16_t>::ReadBigEndian(&payload[offset]);
+      offset += kLengthFieldSize;
+      if (offset + kNalHeaderSize <= payload.size())
+        summary.Add(nalu_type(offset));
+      offset += nalu_size;
+    }
+  } else if (payload_type == NalTraits::kFu) {
+    if (payload.size() > kNalHeaderSize &&
+        (payload[kNalHeaderSize] & NalTraits::kFuSBit)) {
+      summary.Add(payload[kNalHeaderSize] & NalTraits::kFuTypeMask);
+    }
+  } else {
+    summary.Add(payload_type);
+  }
+  return summary;
+}
+
+template <typename NalTraits>
+bool H26xPacketBuffer<NalTraits>::EndsNalUnit(const Packet& packet) {
+  rtc::ArrayView<const uint8_t> payload = packet.video_payload;
+  if (NalTraits::Type(ByteReader<uint16_t>::ReadBigEndian(payload.data())) !=
+      NalTraits::kFu) {
+    return true;
+  }
+  return payload.size() > kNalHeaderSize &&
+         (payload[kNalHeaderSize] & NalTraits::kFuEBit);
+}
+
+template <typename NalTraits>
+typename H26xPacketBuffer<NalTraits>::InsertResult
+H26xPacketBuffer<NalTraits>::InsertPacket(std::unique_ptr<Packet> packet) {
+  RTC_DCHECK(packet->video_header.codec == NalTraits::kCodecType);
+
+  InsertResult result;
+  if (packet->video_payload.size() < kNalHeaderSize) {
+    return result;
+  }
+
+  int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(packet->seq_num);
+  auto& packet_slot = GetPacket(unwrapped_seq_num);
+  if (packet_slot != nullptr &&
+      AheadOrAt(packet_slot->timestamp, packet->timestamp)) {
+    // The incoming `packet` is old or a duplicate.
+    return result;
+  } else {
+    packet_slot = std::move(packet);
+  }
+
+  result.packets = FindFrames(unwrapped_seq_num);
+  return result;
+}
+
+template <typename NalTraits>
+typename H26xPacketBuffer<NalTraits>::InsertResult
+H26xPacketBuffer<NalTraits>::InsertPadding(uint16_t seq_num) {
+  InsertResult result;
+  int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(seq_num);
+  if (!last_continuous_unwrapped_seq_num_ ||
+      unwrapped_seq_num != *last_continuous_unwrapped_seq_num_ + 1) {
+    return result;
+  }
+
+  GetPacket(unwrapped_seq_num).reset();
+  last_continuous_unwrapped_seq_num_ = unwrapped_seq_num;
+  if (next_frame_start_unwrapped_seq_num_ == unwrapped_seq_num) {
+    ++*next_frame_start_unwrapped_seq_num_;
+  }
+
+  // Media packets that arrived before the padding may now be continuous.
+  const Packet* next_packet = GetPacket(unwrapped_seq_num + 1).get();
+  if (next_packet != nullptr &&
+      next_packet->seq_num == static_cast<uint16_t>(unwrapped_seq_num + 1)) {
+    result.packets = FindFrames(unwrapped_seq_num + 1);
+  }
+  return result;
+}
+
+template <typename NalTraits>
+typename H26xPacketBuffer<NalTraits>::FramePart
+H26xPacketBuffer<NalTraits>::FindNextFramePart() {
+  if (!next_frame_start_unwrapped_seq_num_) {
+    return {};
+  }
+  const int64_t first_seq_num = *next_frame_start_unwrapped_seq_num_;
+  const Packet* first_packet = GetPacket(first_seq_num).get();
+  if (first_packet == nullptr ||
+      first_packet->seq_num != static_cast<uint16_t>(first_seq_num)) {
+    return {};
+  }
+  if (!frame_part_scan_ || frame_part_scan_->first_seq_num != first_seq_num ||
+      frame_part_scan_->rtp_timestamp != first_packet->timestamp) {
+    frame_part_scan_ = {.rtp_timestamp = first_packet->timestamp,
+                        .first_seq_num = first_seq_num,
+                        .part_end_seq_num = first_seq_num,
+                        .scan_end_seq_num = first_seq_num};
+  }
+  FramePartScan& scan = *frame_part_scan_;
+
+  auto packet_at = [&](int64_t seq_num) -> const Packet* {
+    const Packet* packet = GetPacket(seq_num).get();
+    if (packet == nullptr ||
+        packet->seq_num != static_cast<uint16_t>(seq_num) ||
+        packet->timestamp != scan.rtp_timestamp) {
+      return nullptr;
+    }
+    return packet;
+  };
+
+  int64_t part_end_seq_num = scan.part_end_seq_num;
+  int64_t seq_num = scan.scan_end_seq_num;
+  for (; seq_num < first_seq_num + kBufferSize; ++seq_num) {
+    const Packet* packet = packet_at(seq_num);
+    if (packet == nullptr) {
+      break;
+    }
+    if (packet->marker_bit) {
+      // The frame is complete, it is returned by `FindFrames` once all frames
+      // before it are.
+      return {};
+    }
+    if (EndsNalUnit(*packet)) {
+      part_end_seq_num = seq_num + 1;
+    }
+  }
+  scan.scan_end_seq_num = seq_num;
+
+  FramePart part;
+  part.first_part = scan.part_end_seq_num == first_seq_num;
+  for (seq_num = scan.part_end_seq_num; seq_num < part_end_seq_num;
+       ++seq_num) {
+    part.packets.push_back(packet_at(seq_num));
+  }
+  scan.part_end_seq_num = part_end_seq_num;
+  return part;
+}
+
+template <typename NalTraits>
+bool H26xPacketBuffer<NalTraits>::BeginningOfStream(
+    const Packet& packet) const {
+  const NaluSummary nalus = SummarizeNalus(packet.video_payload);
+  return (NalTraits::kVpsRequired && nalus.has_vps) || nalus.has_sps ||
+         (irap_only_keyframes_allowed_ && nalus.has_irap);
+}
+
+template <typename NalTraits>
+std::vector<std::unique_ptr<typename H26xPacketBuffer<NalTraits>::Packet>>
+H26xPacketBuffer<NalTraits>::FindFrames(int64_t unwrapped_seq_num) {
+  std::vector<std::unique_ptr<Packet>> found_frames;
+
+  Packet* packet = GetPacket(unwrapped_seq_num).get();
+  RTC_CHECK(packet != nullptr);
+
+  // Check if the packet is continuous or the beginning of a new coded video
+  // sequence.
+  if (unwrapped_seq_num - 1 != last_continuous_unwrapped_seq_num_) {
+    if (unwrapped_seq_num <= last_continuous_unwrapped_seq_num_ ||
+        !BeginningOfStream(*packet)) {
+      return found_frames;
+    }
+
+    last_continuous_unwrapped_seq_num_ = unwrapped_seq_num;
+  }
+
+  for (int64_t seq_num = unwrapped_seq_num;
+       seq_num < unwrapped_seq_num + kBufferSize;) {
+    RTC_DCHECK_GE(seq_num, *last_continuous_unwrapped_seq_num_);
+
+    // Packets that were never assembled into a completed frame will stay in
+    // the 'buffer_'. Check that the `packet` sequence number match the expected
+    // unwrapped sequence number.
+    if (static_cast<uint16_t>(seq_num) != packet->seq_num) {
+      return found_frames;
+    }
+
+    last_continuous_unwrapped_seq_num_ = seq_num;
+    // Last packet of the frame, try to assemble the frame.
+    if (packet->marker_bit) {
+      uint32_t rtp_timestamp = packet->timestamp;
+
+      // Iterate backwards to find where the frame starts.
+      for (int64_t seq_num_start = seq_num;
+           seq_num_start > seq_num - kBufferSize; --seq_num_start) {
+        auto& prev_packet = GetPacket(seq_num_start - 1);
+
+        if (prev_packet == nullptr || prev_packet->timestamp != rtp_timestamp) {
+          if (MaybeAssembleFrame(seq_num_start, seq_num, found_frames)) {
+            // Frame was assembled, continue to look for more frames.
+            break;
+          } else {
+            // Frame was not assembled, no subsequent frame will be continuous.
+            return found_frames;
+          }
+        }
+      }
+    }
+
+    seq_num++;
+    packet = GetPacket(seq_num).get();
+    if (packet == nullptr) {
+      return found_frames;
+    }
+  }
+
+  return found_frames;
+}
+
+template <typename NalTraits>
+bool H26xPacketBuffer<NalTraits>::MaybeAssembleFrame(
+    int64_t start_seq_num_unwrapped,
+    int64_t end_sequence_number_unwrapped,
+    std::vector<std::unique_ptr<Packet>>& frames) {
+  NaluSummary frame_nalus;
+
+  int width = -1;
+  int height = -1;
+
+  for (int64_t seq_num = start_seq_num_unwrapped;
+       seq_num <= end_sequence_number_unwrapped; ++seq_num) {
+    const auto& packet = GetPacket(seq_num);
+    frame_nalus.Add(SummarizeNalus(packet->video_payload));
+
+    width = std::max<int>(packet->video_header.width, width);
+    height = std::max<int>(packet->video_header.height, height);
+  }
+
+  if (frame_nalus.has_irap && !irap_only_keyframes_allowed_ &&
+      ((NalTraits::kVpsRequired && !frame_nalus.has_vps) ||
+       !frame_nalus.has_sps || !frame_nalus.has_pps)) {
+    RTC_LOG(LS_WARNING) << "Received " << NalTraits::kName
+                        << " IRAP frame without parameter sets.";
+    return false;
+  }
+
+  for (int64_t seq_num = start_seq_num_unwrapped;
+       seq_num <= end_sequence_number_unwrapped; ++seq_num) {
+    auto& packet = GetPacket(seq_num);
+
+    packet->video_header.is_first_packet_in_frame =
+        (seq_num == start_seq_num_unwrapped);
+    packet->video_header.is_last_packet_in_frame =
+        (seq_num == end_sequence_number_unwrapped);
+
+    if (packet->video_header.is_first_packet_in_frame) {
+      if (width > 0 && height > 0) {
+        packet->video_header.width = width;
+        packet->video_header.height = height;
+      }
+
+      packet->video_header.frame_type = frame_nalus.has_irap
+                                            ? VideoFrameType::kVideoFrameKey
+                                            : VideoFrameType::kVideoFrameDelta;
+    }
+
+    frames.push_back(std::move(packet));
+  }
+  next_frame_start_unwrapped_seq_num_ = end_sequence_number_unwrapped + 1;
+
+  return true;
+}
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_H26X_PACKET_BUFFER_H_
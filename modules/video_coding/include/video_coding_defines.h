@@ -58,6 +58,9 @@ class VCMReceiveCallback {
 
   virtual void OnDroppedFrames(uint32_t frames_dropped);
 
+  // Called for every decoded frame, before FrameToRender().
+  virtual void OnTimingFrameInfo(const TimingFrameInfo& timing_frame_info);
+
   // Called when the current receive codec changes.
   virtual void OnIncomingPayloadType(int payload_type);
   virtual void OnDecoderInfoChanged(
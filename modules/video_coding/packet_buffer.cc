@@ -33,15 +33,56 @@
 
 namespace webrtc {
 namespace video_coding {
+namespace {
+
+// Y bit of the AV1 aggregation header, set if the last OBU element of the
+// packet continues in the next packet.
+constexpr uint8_t kAv1ObuContinuesBit = 0b0100'0000;
+
+// Returns true if the data of `packet` can be decoded without any of the
+// packets that follow it. `next_packet` is the next packet of the same frame,
+// if it has been received.
+bool EndsDecodableUnit(const PacketBuffer::Packet& packet,
+                       const PacketBuffer::Packet* next_packet) {
+  switch (packet.codec()) {
+    case kVideoCodecAV1:
+      return packet.video_payload.size() > 0 &&
+             (packet.video_payload.cdata()[0] & kAv1ObuContinuesBit) == 0;
+    case kVideoCodecH264: {
+      const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
+          &packet.video_header.video_type_header);
+      if (!h264_header) {
+        return false;
+      }
+      if (h264_header->packetization_type != kH264FuA) {
+        return true;
+      }
+      // The end of a fragmented NAL unit is only known once the next packet
+      // starts a new NAL unit.
+      if (!next_packet) {
+        return false;
+      }
+      const auto* next_h264_header = absl::get_if<RTPVideoHeaderH264>(
+          &next_packet->video_header.video_type_header);
+      return next_h264_header &&
+             (next_h264_header->packetization_type != kH264FuA ||
+              next_h264_header->nalus_length > 0);
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace
 
 PacketBuffer::Packet::Packet(const RtpPacketReceived& rtp_packet,
-                             const RTPVideoHeader& video_header)
+                             RTPVideoHeader video_header)
     : marker_bit(rtp_packet.Marker()),
       payload_type(rtp_packet.PayloadType()),
       seq_num(rtp_packet.SequenceNumber()),
       timestamp(rtp_packet.Timestamp()),
       times_nacked(-1),
-      video_header(video_header) {}
+      video_header(std::move(video_header)) {}
 
 PacketBuffer::PacketBuffer(size_t start_buffer_size, size_t max_buffer_size)
     : max_size_(max_buffer_size),
@@ -178,6 +219,76 @@ void PacketBuffer::ResetSpsPpsIdrIsH264Keyframe() {
   sps_pps_idr_is_h264_keyframe_ = false;
 }
 
+PacketBuffer::FramePart PacketBuffer::FindNextFramePart() {
+  if (!last_frame_end_seq_num_) {
+    return {};
+  }
+  uint16_t seq_num = *last_frame_end_seq_num_ + 1;
+  while (received_padding_.find(seq_num) != received_padding_.end()) {
+    ++seq_num;
+  }
+  const Packet* first_packet = buffer_[seq_num % buffer_.size()].get();
+  if (first_packet == nullptr || first_packet->seq_num != seq_num) {
+    return {};
+  }
+  const bool is_h264_descriptor = first_packet->codec() == kVideoCodecH264 &&
+                                  !first_packet->video_header.generic;
+  if (!is_h264_descriptor && !first_packet->is_first_packet_in_frame()) {
+    return {};
+  }
+  if (!frame_part_scan_ || frame_part_scan_->first_seq_num != seq_num ||
+      frame_part_scan_->rtp_timestamp != first_packet->timestamp) {
+    frame_part_scan_ = {.rtp_timestamp = first_packet->timestamp,
+                        .first_seq_num = seq_num,
+                        .part_end_seq_num = seq_num,
+                        .scan_end_seq_num = seq_num};
+  }
+  FramePartScan& scan = *frame_part_scan_;
+
+  auto packet_at = [&](uint16_t packet_seq_num) -> const Packet* {
+    const Packet* packet = buffer_[packet_seq_num % buffer_.size()].get();
+    if (packet == nullptr || packet->seq_num != packet_seq_num ||
+        packet->timestamp != scan.rtp_timestamp) {
+      return nullptr;
+    }
+    return packet;
+  };
+
+  // Whether the last scanned packet ends a decodable unit may depend on the
+  // packet after it, so it is scanned again.
+  uint16_t scan_seq_num = scan.scan_end_seq_num;
+  if (scan_seq_num != scan.part_end_seq_num) {
+    --scan_seq_num;
+  }
+  absl::optional<uint16_t> part_end_seq_num;
+  for (size_t i = 0; i < buffer_.size(); ++i, ++scan_seq_num) {
+    const Packet* packet = packet_at(scan_seq_num);
+    if (packet == nullptr) {
+      break;
+    }
+    if (packet->is_last_packet_in_frame()) {
+      // The frame is complete, it is returned by `FindFrames` once all frames
+      // before it are.
+      return {};
+    }
+    if (EndsDecodableUnit(*packet, packet_at(scan_seq_num + 1))) {
+      part_end_seq_num = scan_seq_num + 1;
+    }
+  }
+  scan.scan_end_seq_num = scan_seq_num;
+  if (!part_end_seq_num) {
+    return {};
+  }
+
+  FramePart part;
+  part.first_part = scan.part_end_seq_num == scan.first_seq_num;
+  for (uint16_t i = scan.part_end_seq_num; i != *part_end_seq_num; ++i) {
+    part.packets.push_back(packet_at(i));
+  }
+  scan.part_end_seq_num = *part_end_seq_num;
+  return part;
+}
+
 void PacketBuffer::ClearInternal() {
   for (auto& entry : buffer_) {
     entry = nullptr;
@@ -186,6 +297,8 @@ void PacketBuffer::ClearInternal() {
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
   newest_inserted_seq_num_.reset();
+  last_frame_end_seq_num_.reset();
+  frame_part_scan_.reset();
   missing_packets_.clear();
   received_padding_.clear();
 }
@@ -388,6 +501,10 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
           found_frames.push_back(std::move(packet));
         }
 
+        if (!last_frame_end_seq_num_ ||
+            AheadOf<uint16_t>(seq_num, *last_frame_end_seq_num_)) {
+          last_frame_end_seq_num_ = seq_num;
+        }
         missing_packets_.erase(missing_packets_.begin(),
                                missing_packets_.upper_bound(seq_num));
         received_padding_.erase(received_padding_.lower_bound(start),
@@ -33,8 +33,7 @@ class PacketBuffer {
  public:
   struct Packet {
     Packet() = default;
-    Packet(const RtpPacketReceived& rtp_packet,
-           const RTPVideoHeader& video_header);
+    Packet(const RtpPacketReceived& rtp_packet, RTPVideoHeader video_header);
     Packet(const Packet&) = delete;
     Packet(Packet&&) = delete;
     Packet& operator=(const Packet&) = delete;
@@ -84,6 +83,20 @@ class PacketBuffer {
   void ForceSpsPpsIdrIsH264Keyframe();
   void ResetSpsPpsIdrIsH264Keyframe();
 
+  struct FramePart {
+    std::vector<const Packet*> packets;
+    // Set if `packets` start the frame.
+    bool first_part = false;
+  };
+  // Returns the leading packets of the frame that follows the last frame
+  // returned by the buffer, while that frame is still incomplete. Only H.264
+  // and AV1 frames are split, and only up to the last packet that ends a NAL
+  // unit or an OBU respectively. Packets already returned by a previous call
+  // are not returned again, and only packets received since then are
+  // scanned. The packets stay in the buffer and the pointers are valid until
+  // the buffer is modified.
+  FramePart FindNextFramePart();
+
  private:
   void ClearInternal();
 
@@ -116,6 +129,19 @@ class PacketBuffer {
   std::vector<std::unique_ptr<Packet>> buffer_;
 
   absl::optional<uint16_t> newest_inserted_seq_num_;
+  // Sequence number of the last packet of the newest frame returned.
+  absl::optional<uint16_t> last_frame_end_seq_num_;
+  // Progress of FindNextFramePart() through the frame that starts at
+  // `first_seq_num`. Packets before `part_end_seq_num` have been returned,
+  // packets from there up to `scan_end_seq_num` are contiguous and have been
+  // scanned.
+  struct FramePartScan {
+    uint32_t rtp_timestamp;
+    uint16_t first_seq_num;
+    uint16_t part_end_seq_num;
+    uint16_t scan_end_seq_num;
+  };
+  absl::optional<FramePartScan> frame_part_scan_;
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_;
 
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> received_padding_;
@@ -855,6 +855,148 @@ TEST_F(PacketBufferH264FrameGap, DisallowFrameGapForH264NoGeneric) {
               IsEmpty());
 }
 
+class PacketBufferFramePartTest : public PacketBufferH264Test {
+ protected:
+  PacketBufferFramePartTest() : PacketBufferH264Test(false) {}
+
+  void InsertFuA(uint16_t seq_num, bool first_fragment, uint32_t timestamp) {
+    auto packet = std::make_unique<PacketBuffer::Packet>();
+    packet->video_header.codec = kVideoCodecH264;
+    auto& h264_header =
+        packet->video_header.video_type_header.emplace<RTPVideoHeaderH264>();
+    h264_header.packetization_type = kH264FuA;
+    if (first_fragment) {
+      h264_header.nalus[0].type = H264::NaluType::kSlice;
+      h264_header.nalus_length = 1;
+    }
+    packet->seq_num = seq_num;
+    packet->timestamp = timestamp;
+    packet->video_header.is_first_packet_in_frame = first_fragment;
+    IgnoreResult(packet_buffer_.InsertPacket(std::move(packet)));
+  }
+
+  void InsertAv1(uint16_t seq_num,
+                 IsFirst first,
+                 IsLast last,
+                 uint8_t aggregation_header,
+                 uint32_t timestamp) {
+    auto packet = std::make_unique<PacketBuffer::Packet>();
+    packet->video_header.codec = kVideoCodecAV1;
+    packet->video_header.generic.emplace();
+    packet->seq_num = seq_num;
+    packet->timestamp = timestamp;
+    packet->video_header.is_first_packet_in_frame = first == kFirst;
+    packet->video_header.is_last_packet_in_frame = last == kLast;
+    const uint8_t payload[] = {aggregation_header, 0x30};
+    packet->video_payload.SetData(payload, sizeof(payload));
+    IgnoreResult(packet_buffer_.InsertPacket(std::move(packet)));
+  }
+
+  std::vector<uint16_t> PartSeqNums() {
+    std::vector<uint16_t> seq_nums;
+    for (const PacketBuffer::Packet* packet :
+         packet_buffer_.FindNextFramePart().packets) {
+      seq_nums.push_back(packet->seq_num);
+    }
+    return seq_nums;
+  }
+};
+
+TEST_F(PacketBufferFramePartTest, NoPartBeforeFirstFrame) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kNotLast, 1000));
+  EXPECT_THAT(PartSeqNums(), IsEmpty());
+}
+
+TEST_F(PacketBufferFramePartTest, ReturnsLeadingNalUnitsOfNextFrame) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  IgnoreResult(InsertH264(11, kDeltaFrame, kFirst, kNotLast, 2000));
+  EXPECT_THAT(PartSeqNums(), ElementsAre(11));
+  IgnoreResult(InsertH264(12, kDeltaFrame, kNotFirst, kNotLast, 2000));
+  EXPECT_THAT(PartSeqNums(), ElementsAre(12));
+}
+
+TEST_F(PacketBufferFramePartTest, ReturnsEachPacketOnce) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  IgnoreResult(InsertH264(11, kDeltaFrame, kFirst, kNotLast, 2000));
+  IgnoreResult(InsertH264(12, kDeltaFrame, kNotFirst, kNotLast, 2000));
+  PacketBuffer::FramePart part = packet_buffer_.FindNextFramePart();
+  EXPECT_TRUE(part.first_part);
+  EXPECT_THAT(part.packets, SizeIs(2));
+  EXPECT_THAT(PartSeqNums(), IsEmpty());
+
+  IgnoreResult(InsertH264(13, kDeltaFrame, kNotFirst, kNotLast, 2000));
+  part = packet_buffer_.FindNextFramePart();
+  EXPECT_FALSE(part.first_part);
+  ASSERT_THAT(part.packets, SizeIs(1));
+  EXPECT_EQ(part.packets[0]->seq_num, 13);
+}
+
+TEST_F(PacketBufferFramePartTest, StartsOverAfterClear) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  IgnoreResult(InsertH264(11, kDeltaFrame, kFirst, kNotLast, 2000));
+  EXPECT_THAT(PartSeqNums(), ElementsAre(11));
+
+  packet_buffer_.Clear();
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  IgnoreResult(InsertH264(11, kDeltaFrame, kFirst, kNotLast, 2000));
+  PacketBuffer::FramePart part = packet_buffer_.FindNextFramePart();
+  EXPECT_TRUE(part.first_part);
+  EXPECT_THAT(part.packets, SizeIs(1));
+}
+
+TEST_F(PacketBufferFramePartTest, StopsAtMissingPacket) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  IgnoreResult(InsertH264(12, kDeltaFrame, kNotFirst, kNotLast, 2000));
+  EXPECT_THAT(PartSeqNums(), IsEmpty());
+  IgnoreResult(InsertH264(11, kDeltaFrame, kFirst, kNotLast, 2000));
+  EXPECT_THAT(PartSeqNums(), ElementsAre(11, 12));
+}
+
+TEST_F(PacketBufferFramePartTest, WaitsForEndOfFragmentedNalUnit) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  InsertFuA(11, /*first_fragment=*/true, 2000);
+  InsertFuA(12, /*first_fragment=*/false, 2000);
+  EXPECT_THAT(PartSeqNums(), IsEmpty());
+  InsertFuA(13, /*first_fragment=*/true, 2000);
+  EXPECT_THAT(PartSeqNums(), ElementsAre(11, 12));
+  IgnoreResult(InsertH264(14, kDeltaFrame, kNotFirst, kNotLast, 2000));
+  EXPECT_THAT(PartSeqNums(), ElementsAre(13, 14));
+}
+
+TEST_F(PacketBufferFramePartTest, NoPartOnceFrameIsComplete) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  IgnoreResult(InsertH264(11, kDeltaFrame, kFirst, kNotLast, 2000));
+  EXPECT_THAT(InsertH264(12, kDeltaFrame, kNotFirst, kLast, 2000).packets,
+              SizeIs(2));
+  EXPECT_THAT(PartSeqNums(), IsEmpty());
+  IgnoreResult(InsertH264(13, kDeltaFrame, kFirst, kNotLast, 3000));
+  EXPECT_THAT(PartSeqNums(), ElementsAre(13));
+}
+
+TEST_F(PacketBufferFramePartTest, SkipsPaddingBetweenFrames) {
+  IgnoreResult(InsertH264(10, kKeyFrame, kFirst, kLast, 1000));
+  IgnoreResult(packet_buffer_.InsertPadding(11));
+  IgnoreResult(InsertH264(12, kDeltaFrame, kFirst, kNotLast, 2000));
+  EXPECT_THAT(PartSeqNums(), ElementsAre(12));
+}
+
+TEST_F(PacketBufferFramePartTest, ReturnsLeadingObusOfNextAv1Frame) {
+  constexpr uint8_t kObuContinues = 0b0100'0000;
+  constexpr uint8_t kContinuesObu = 0b1000'0000;
+  InsertAv1(10, kFirst, kLast, 0, 1000);
+  InsertAv1(11, kFirst, kNotLast, 0, 2000);
+  InsertAv1(12, kNotFirst, kNotLast, kObuContinues, 2000);
+  EXPECT_THAT(PartSeqNums(), ElementsAre(11));
+  InsertAv1(13, kNotFirst, kNotLast, kContinuesObu, 2000);
+  EXPECT_THAT(PartSeqNums(), ElementsAre(12, 13));
+}
+
+TEST_F(PacketBufferFramePartTest, DoesNotSplitOtherCodecs) {
+  IgnoreResult(Insert(10, kKeyFrame, kFirst, kLast, {}, 1000));
+  IgnoreResult(Insert(11, kDeltaFrame, kFirst, kNotLast, {}, 2000));
+  EXPECT_THAT(PartSeqNums(), IsEmpty());
+}
+
 }  // namespace
 }  // namespace video_coding
 }  // namespace webrtc
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encode_speed_controller.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
+
+namespace webrtc {
+
+namespace {
+// Smoothing factor applied per frame to the encode time fraction.
+constexpr float kFilterAlpha = 0.9f;
+// Number of frames to measure after a change before acting on the result.
+constexpr int kMinFramesBetweenChanges = 15;
+// Encode time fraction, relative to the target, below which there is enough
+// headroom to step towards quality.
+constexpr double kUnderuseFactor = 0.6;
+// Delay between steps towards quality. Initially uses the standard delay,
+// backed off up to the max when such steps are quickly reverted.
+constexpr int kStandardQualityStepDelayFrames = 60;
+constexpr int kMaxQualityStepDelayFrames = 16 * kStandardQualityStepDelayFrames;
+constexpr int kQualityStepBackoffFactor = 2;
+}  // namespace
+
+EncodeSpeedController::EncodeSpeedController(const Config& config,
+                                             const Setting& initial_setting)
+    : config_(config),
+      setting_(initial_setting),
+      encode_time_fraction_(kFilterAlpha),
+      quality_step_delay_frames_(kStandardQualityStepDelayFrames) {
+  RTC_DCHECK_GT(config_.target_encode_time_fraction, 0.0);
+  RTC_DCHECK_LE(config_.min_speed_offset, config_.max_speed_offset);
+  RTC_DCHECK_GE(config_.min_num_threads, 1);
+  RTC_DCHECK_LE(config_.min_num_threads, config_.max_num_threads);
+  setting_.speed_offset =
+      rtc::SafeClamp(setting_.speed_offset, config_.min_speed_offset,
+                     config_.max_speed_offset);
+  setting_.num_threads = rtc::SafeClamp(
+      setting_.num_threads, config_.min_num_threads, config_.max_num_threads);
+}
+
+EncodeSpeedController::~EncodeSpeedController() = default;
+
+bool EncodeSpeedController::OnFrameEncoded(TimeDelta encode_time,
+                                           TimeDelta frame_interval,
+                                           bool is_keyframe) {
+  if (is_keyframe || frame_interval <= TimeDelta::Zero())
+    return false;
+
+  encode_time_fraction_.Apply(1.0f, encode_time / frame_interval);
+  ++frames_since_change_;
+  if (frames_since_quality_step_ >= 0)
+    ++frames_since_quality_step_;
+  if (frames_since_change_ < kMinFramesBetweenChanges)
+    return false;
+
+  const Setting old_setting = setting_;
+  const double fraction = encode_time_fraction_.filtered();
+  if (fraction > config_.target_encode_time_fraction) {
+    if (!IncreaseSpeed())
+      return false;
+    if (frames_since_quality_step_ >= 0) {
+      if (frames_since_quality_step_ < quality_step_delay_frames_) {
+        // The last step towards quality did not hold, back off.
+        quality_step_delay_frames_ =
+            std::min(quality_step_delay_frames_ * kQualityStepBackoffFactor,
+                     kMaxQualityStepDelayFrames);
+      } else {
+        quality_step_delay_frames_ = kStandardQualityStepDelayFrames;
+      }
+    }
+    frames_since_quality_step_ = -1;
+  } else if (fraction <
+                 config_.target_encode_time_fraction * kUnderuseFactor &&
+             frames_since_change_ >= quality_step_delay_frames_) {
+    if (!DecreaseSpeed())
+      return false;
+    frames_since_quality_step_ = 0;
+  } else {
+    return false;
+  }
+
+  RTC_LOG(LS_VERBOSE) << "Encode time fraction " << fraction
+                      << ", speed offset " << old_setting.speed_offset
+                      << " -> " << setting_.speed_offset << ", threads "
+                      << old_setting.num_threads << " -> "
+                      << setting_.num_threads;
+  ++num_adaptations_;
+  frames_since_change_ = 0;
+  encode_time_fraction_.Reset(kFilterAlpha);
+  return true;
+}
+
+double EncodeSpeedController::encode_time_fraction() const {
+  return encode_time_fraction_.filtered();
+}
+
+bool EncodeSpeedController::IncreaseSpeed() {
+  if (setting_.num_threads < config_.max_num_threads) {
+    ++setting_.num_threads;
+    return true;
+  }
+  if (setting_.speed_offset < config_.max_speed_offset) {
+    ++setting_.speed_offset;
+    return true;
+  }
+  return false;
+}
+
+bool EncodeSpeedController::DecreaseSpeed() {
+  if (setting_.speed_offset > config_.min_speed_offset) {
+    --setting_.speed_offset;
+    return true;
+  }
+  if (setting_.num_threads > config_.min_num_threads) {
+    --setting_.num_threads;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace webrtc
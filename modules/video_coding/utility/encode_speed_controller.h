@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_ENCODE_SPEED_CONTROLLER_H_
+#define MODULES_VIDEO_CODING_UTILITY_ENCODE_SPEED_CONTROLLER_H_
+
+#include "api/units/time_delta.h"
+#include "rtc_base/numerics/exp_filter.h"
+
+namespace webrtc {
+
+// Closed-loop controller that adapts the speed setting and the number of
+// threads of a software encoder to the measured encode time, so that the time
+// spent encoding a frame stays close to a target fraction of the frame
+// interval.
+//
+// The speed is expressed as an offset to the encoder's static speed setting,
+// where positive offsets are faster. When encoding takes too long, threads
+// are added first and the speed is increased once all threads are in use.
+// When there is headroom, the speed is decreased first, trading the spare CPU
+// for quality, and threads are released once the slowest speed is reached.
+// Steps towards quality are delayed, and the delay is backed off each time
+// such a step is quickly undone, to avoid oscillating between two settings.
+class EncodeSpeedController {
+ public:
+  struct Config {
+    // Target encode time as a fraction of the frame interval.
+    double target_encode_time_fraction = 0.7;
+    int min_speed_offset = 0;
+    int max_speed_offset = 0;
+    int min_num_threads = 1;
+    int max_num_threads = 1;
+  };
+
+  struct Setting {
+    int speed_offset = 0;
+    int num_threads = 1;
+
+    bool operator==(const Setting& rhs) const {
+      return speed_offset == rhs.speed_offset &&
+             num_threads == rhs.num_threads;
+    }
+    bool operator!=(const Setting& rhs) const { return !(*this == rhs); }
+  };
+
+  EncodeSpeedController(const Config& config, const Setting& initial_setting);
+  ~EncodeSpeedController();
+
+  // Reports the time it took to encode a frame, and the interval between
+  // frames at the current frame rate. Key frames are not representative of
+  // the steady-state load and are ignored. Returns true if `setting()` has
+  // changed and should be applied to the encoder before the next frame.
+  bool OnFrameEncoded(TimeDelta encode_time,
+                      TimeDelta frame_interval,
+                      bool is_keyframe);
+
+  const Setting& setting() const { return setting_; }
+  // Smoothed encode time as a fraction of the frame interval, or a negative
+  // value if no frame has been measured since the last change.
+  double encode_time_fraction() const;
+  int num_adaptations() const { return num_adaptations_; }
+
+ private:
+  bool IncreaseSpeed();
+  bool DecreaseSpeed();
+
+  const Config config_;
+  Setting setting_;
+  rtc::ExpFilter encode_time_fraction_;
+  int frames_since_change_ = 0;
+  int frames_since_quality_step_ = -1;
+  int quality_step_delay_frames_;
+  int num_adaptations_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_ENCODE_SPEED_CONTROLLER_H_
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/encode_speed_controller.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr TimeDelta kFrameInterval = TimeDelta::Millis(33);
+constexpr TimeDelta kSlowEncodeTime = TimeDelta::Millis(30);
+constexpr TimeDelta kFastEncodeTime = TimeDelta::Millis(5);
+constexpr TimeDelta kOnTargetEncodeTime = TimeDelta::Millis(18);
+constexpr int kMaxFramesPerStep = 2000;
+
+EncodeSpeedController::Config DefaultConfig() {
+  EncodeSpeedController::Config config;
+  config.target_encode_time_fraction = 0.7;
+  config.min_speed_offset = -2;
+  config.max_speed_offset = 3;
+  config.min_num_threads = 1;
+  config.max_num_threads = 2;
+  return config;
+}
+
+}  // namespace
+
+class EncodeSpeedControllerTest : public ::testing::Test {
+ protected:
+  EncodeSpeedControllerTest()
+      : controller_(DefaultConfig(), {.speed_offset = 0, .num_threads = 1}) {}
+
+  // Feeds frames with the given encode time until the setting changes.
+  // Returns the number of frames needed, or -1 if it did not change.
+  int FramesUntilChange(TimeDelta encode_time) {
+    for (int i = 1; i <= kMaxFramesPerStep; ++i) {
+      if (controller_.OnFrameEncoded(encode_time, kFrameInterval,
+                                     /*is_keyframe=*/false)) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  EncodeSpeedController controller_;
+};
+
+TEST_F(EncodeSpeedControllerTest, ClampsInitialSetting) {
+  EncodeSpeedController controller(DefaultConfig(),
+                                   {.speed_offset = 10, .num_threads = 0});
+  EXPECT_EQ(controller.setting().speed_offset, 3);
+  EXPECT_EQ(controller.setting().num_threads, 1);
+}
+
+TEST_F(EncodeSpeedControllerTest, KeepsSettingWhenOnTarget) {
+  EXPECT_EQ(FramesUntilChange(kOnTargetEncodeTime), -1);
+  EXPECT_EQ(controller_.num_adaptations(), 0);
+  EXPECT_NEAR(controller_.encode_time_fraction(),
+              kOnTargetEncodeTime / kFrameInterval, 0.01);
+}
+
+TEST_F(EncodeSpeedControllerTest, IgnoresKeyFrames) {
+  for (int i = 0; i < kMaxFramesPerStep; ++i) {
+    EXPECT_FALSE(controller_.OnFrameEncoded(kFrameInterval * 5, kFrameInterval,
+                                            /*is_keyframe=*/true));
+  }
+  EXPECT_LT(controller_.encode_time_fraction(), 0.0);
+}
+
+TEST_F(EncodeSpeedControllerTest, AddsThreadsBeforeIncreasingSpeed) {
+  EXPECT_GT(FramesUntilChange(kSlowEncodeTime), 0);
+  EXPECT_EQ(controller_.setting().num_threads, 2);
+  EXPECT_EQ(controller_.setting().speed_offset, 0);
+
+  for (int speed_offset = 1; speed_offset <= 3; ++speed_offset) {
+    EXPECT_GT(FramesUntilChange(kSlowEncodeTime), 0);
+    EXPECT_EQ(controller_.setting().num_threads, 2);
+    EXPECT_EQ(controller_.setting().speed_offset, speed_offset);
+  }
+
+  // Already at the fastest setting.
+  EXPECT_EQ(FramesUntilChange(kSlowEncodeTime), -1);
+  EXPECT_EQ(controller_.num_adaptations(), 4);
+}
+
+TEST_F(EncodeSpeedControllerTest, DecreasesSpeedBeforeRemovingThreads) {
+  EXPECT_GT(FramesUntilChange(kSlowEncodeTime), 0);
+  EXPECT_GT(FramesUntilChange(kSlowEncodeTime), 0);
+  ASSERT_EQ(controller_.setting().num_threads, 2);
+  ASSERT_EQ(controller_.setting().speed_offset, 1);
+
+  for (int speed_offset = 0; speed_offset >= -2; --speed_offset) {
+    EXPECT_GT(FramesUntilChange(kFastEncodeTime), 0);
+    EXPECT_EQ(controller_.setting().num_threads, 2);
+    EXPECT_EQ(controller_.setting().speed_offset, speed_offset);
+  }
+  EXPECT_GT(FramesUntilChange(kFastEncodeTime), 0);
+  EXPECT_EQ(controller_.setting().num_threads, 1);
+  EXPECT_EQ(controller_.setting().speed_offset, -2);
+
+  // Already at the slowest setting.
+  EXPECT_EQ(FramesUntilChange(kFastEncodeTime), -1);
+}
+
+TEST_F(EncodeSpeedControllerTest, StepsTowardsQualityMoreSlowly) {
+  int frames_to_speed_up = FramesUntilChange(kSlowEncodeTime);
+  int frames_to_slow_down = FramesUntilChange(kFastEncodeTime);
+  EXPECT_GT(frames_to_speed_up, 0);
+  EXPECT_GT(frames_to_slow_down, frames_to_speed_up);
+}
+
+TEST_F(EncodeSpeedControllerTest, BacksOffWhenQualityStepIsReverted) {
+  // Move to speed offset -1, with one thread.
+  EXPECT_GT(FramesUntilChange(kFastEncodeTime), 0);
+  int first_delay = FramesUntilChange(kFastEncodeTime);
+  ASSERT_EQ(controller_.setting().speed_offset, -2);
+
+  // The content gets more complex right after the step towards quality, so
+  // the step is reverted.
+  EXPECT_GT(FramesUntilChange(kSlowEncodeTime), 0);
+  ASSERT_EQ(controller_.setting().num_threads, 2);
+
+  // The encode time drops again; waits longer before the next quality step.
+  int second_delay = FramesUntilChange(kFastEncodeTime);
+  EXPECT_GT(second_delay, first_delay);
+}
+
+}  // namespace webrtc
@@ -37,7 +37,13 @@ absl::optional<uint32_t> QpParser::Parse(VideoCodecType codec_type,
   } else if (codec_type == kVideoCodecH264) {
     return h264_parsers_[spatial_idx].Parse(frame_data, frame_size);
   } else if (codec_type == kVideoCodecH265) {
-    // TODO(bugs.webrtc.org/13485)
+#ifdef RTC_ENABLE_H265
+    return h265_parsers_[spatial_idx].Parse(frame_data, frame_size);
+#endif
+  } else if (codec_type == kVideoCodecH266) {
+#ifdef RTC_ENABLE_H266
+    return h266_parsers_[spatial_idx].Parse(frame_data, frame_size);
+#endif
   }
 
   return absl::nullopt;
@@ -52,4 +58,22 @@ absl::optional<uint32_t> QpParser::H264QpParser::Parse(
   return bitstream_parser_.GetLastSliceQp();
 }
 
+#if defined(RTC_ENABLE_H265) || defined(RTC_ENABLE_H266)
+template <typename BitstreamParser>
+absl::optional<uint32_t> QpParser::H26xQpParser<BitstreamParser>::Parse(
+    const uint8_t* frame_data,
+    size_t frame_size) {
+  MutexLock lock(&mutex_);
+  bitstream_parser_.ParseBitstream(
+      rtc::ArrayView<const uint8_t>(frame_data, frame_size));
+  absl::optional<int> qp = bitstream_parser_.GetLastSliceQp();
+  // Slice QPs below zero are only valid for high bit depths and can not be
+  // reported.
+  if (!qp || *qp < 0) {
+    return absl::nullopt;
+  }
+  return *qp;
+}
+#endif
+
 }  // namespace webrtc
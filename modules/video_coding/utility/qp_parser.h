@@ -15,6 +15,12 @@
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_codec_type.h"
 #include "common_video/h264/h264_bitstream_parser.h"
+#ifdef RTC_ENABLE_H265
+#include "common_video/h265/h265_bitstream_parser.h"
+#endif
+#ifdef RTC_ENABLE_H266
+#include "common_video/h266/h266_bitstream_parser.h"
+#endif
 #include "rtc_base/synchronization/mutex.h"
 
 namespace webrtc {
@@ -37,7 +43,27 @@ class QpParser {
     H264BitstreamParser bitstream_parser_ RTC_GUARDED_BY(mutex_);
   };
 
+#if defined(RTC_ENABLE_H265) || defined(RTC_ENABLE_H266)
+  // A thread safe wrapper for the H265 and H266 bitstream parsers.
+  template <typename BitstreamParser>
+  class H26xQpParser {
+   public:
+    absl::optional<uint32_t> Parse(const uint8_t* frame_data,
+                                   size_t frame_size);
+
+   private:
+    Mutex mutex_;
+    BitstreamParser bitstream_parser_ RTC_GUARDED_BY(mutex_);
+  };
+#endif
+
   H264QpParser h264_parsers_[kMaxSimulcastStreams];
+#ifdef RTC_ENABLE_H265
+  H26xQpParser<H265BitstreamParser> h265_parsers_[kMaxSimulcastStreams];
+#endif
+#ifdef RTC_ENABLE_H266
+  H26xQpParser<H266BitstreamParser> h266_parsers_[kMaxSimulcastStreams];
+#endif
 };
 
 }  // namespace webrtc
@@ -51,6 +51,37 @@ const uint8_t kCodedFrameH264SpsPpsIdrQp49[] = {
 const uint8_t kCodedFrameH264InterSliceQpDelta0[] = {0x00, 0x00, 0x00, 0x01,
                                                      0x41, 0x9a, 0x39, 0xea};
 
+#ifdef RTC_ENABLE_H265
+// VPS, SPS, PPS and the start of an IDR slice with slice QP 34.
+const uint8_t kCodedFrameH265VpsSpsPpsIdrQp34[] = {
+    0x00, 0x00, 0x00, 0x01, 0x40, 0x01, 0x0c, 0x01, 0xff, 0xff, 0x04,
+    0x08, 0x00, 0x00, 0x03, 0x00, 0x9d, 0x08, 0x00, 0x00, 0x03, 0x00,
+    0x00, 0x78, 0x95, 0x98, 0x09, 0x00, 0x00, 0x00, 0x01, 0x42, 0x01,
+    0x01, 0x04, 0x08, 0x00, 0x00, 0x03, 0x00, 0x9d, 0x08, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x78, 0xb0, 0x03, 0xc0, 0x80, 0x10, 0xe5, 0x96,
+    0x56, 0x69, 0x24, 0xca, 0xe0, 0x10, 0x00, 0x00, 0x03, 0x00, 0x10,
+    0x00, 0x00, 0x03, 0x01, 0xe0, 0x80, 0x00, 0x00, 0x00, 0x01, 0x44,
+    0x01, 0xc1, 0x72, 0xb4, 0x62, 0x40, 0x00, 0x00, 0x01, 0x26, 0x01,
+    0xaf, 0x08, 0x42, 0x23, 0x10, 0x5d, 0x2b, 0x51, 0xf9, 0x7a, 0x55,
+    0x15, 0x0d, 0x10, 0x40, 0xe8, 0x10, 0x05, 0x30, 0x95, 0x09, 0x9a,
+    0xa5, 0xb6, 0x6a, 0x66, 0x6d, 0xde, 0xe0, 0xf9};
+#endif
+
+#ifdef RTC_ENABLE_H266
+// SPS, PPS and the start of an IDR slice with slice QP 35.
+const uint8_t kCodedFrameH266SpsPpsIdrQp35[] = {
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x79, 0x00, 0x0d, 0x02, 0x33, 0x80,
+    0x00, 0x00, 0x0a, 0x02, 0x00, 0xb4, 0x46, 0xa0, 0x0d, 0xe8, 0x8d,
+    0xdb, 0x69, 0x10, 0xa4, 0xc8, 0x9c, 0x26, 0xcc, 0x41, 0x62, 0x42,
+    0xa1, 0x0f, 0x0b, 0x5b, 0xd1, 0xed, 0x75, 0xcd, 0x7e, 0x44, 0xab,
+    0xcd, 0x80, 0x00, 0x00, 0x00, 0x01, 0x00, 0x81, 0x00, 0x00, 0x05,
+    0x01, 0x00, 0x5a, 0x22, 0xe0, 0x33, 0xf3, 0x7f, 0x00, 0x00, 0x00,
+    0x01, 0x00, 0x81, 0x04, 0x00, 0x05, 0x01, 0x00, 0x5a, 0x20, 0x94,
+    0xa5, 0x31, 0x60, 0x20, 0x5c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x41,
+    0xc4, 0x02, 0x49, 0x23, 0x10, 0x30, 0x00, 0x00, 0x08, 0x00, 0x00,
+    0x03, 0x02, 0x13, 0xfc};
+#endif
+
 }  // namespace
 
 TEST(QpParserTest, ParseQpVp8) {
@@ -87,6 +118,26 @@ TEST(QpParserTest, ParseQpH264) {
   EXPECT_EQ(qp, 49u);
 }
 
+#ifdef RTC_ENABLE_H265
+TEST(QpParserTest, ParseQpH265) {
+  QpParser parser;
+  absl::optional<uint32_t> qp =
+      parser.Parse(kVideoCodecH265, 0, kCodedFrameH265VpsSpsPpsIdrQp34,
+                   sizeof(kCodedFrameH265VpsSpsPpsIdrQp34));
+  EXPECT_EQ(qp, 34u);
+}
+#endif
+
+#ifdef RTC_ENABLE_H266
+TEST(QpParserTest, ParseQpH266) {
+  QpParser parser;
+  absl::optional<uint32_t> qp =
+      parser.Parse(kVideoCodecH266, 0, kCodedFrameH266SpsPpsIdrQp35,
+                   sizeof(kCodedFrameH266SpsPpsIdrQp35));
+  EXPECT_EQ(qp, 35u);
+}
+#endif
+
 TEST(QpParserTest, ParseQpUnsupportedCodecType) {
   QpParser parser;
   absl::optional<uint32_t> qp = parser.Parse(
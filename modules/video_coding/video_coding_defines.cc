@@ -13,6 +13,7 @@
 namespace webrtc {
 
 void VCMReceiveCallback::OnDroppedFrames(uint32_t frames_dropped) {}
+void VCMReceiveCallback::OnTimingFrameInfo(const TimingFrameInfo&) {}
 void VCMReceiveCallback::OnIncomingPayloadType(int payload_type) {}
 void VCMReceiveCallback::OnDecoderInfoChanged(
     const VideoDecoder::DecoderInfo&) {}
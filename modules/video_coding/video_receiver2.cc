@@ -85,6 +85,17 @@ int32_t VideoReceiver2::Decode(const EncodedFrame* frame) {
   return decoder->Decode(*frame, clock_->CurrentTime());
 }
 
+int32_t VideoReceiver2::DecodePart(const EncodedImage& part,
+                                   uint8_t payload_type) {
+  RTC_DCHECK_RUN_ON(&decoder_sequence_checker_);
+  TRACE_EVENT0("webrtc", "VideoReceiver2::DecodePart");
+  VCMGenericDecoder* decoder = codec_database_.GetCurrentDecoder(payload_type);
+  if (decoder == nullptr) {
+    return VCM_NO_CODEC_REGISTERED;
+  }
+  return decoder->DecodePart(part, clock_->CurrentTime());
+}
+
 // Register possible receive codecs, can be called multiple times.
 // Called before decoder thread is started.
 void VideoReceiver2::RegisterReceiveCodec(
@@ -50,6 +50,10 @@ class VideoReceiver2 {
   int32_t RegisterReceiveCallback(VCMReceiveCallback* receive_callback);
 
   int32_t Decode(const EncodedFrame* frame);
+  // Passes a part of a frame that is still being received to the decoder in
+  // use, see `VCMGenericDecoder::DecodePart`. Parts are never used to create
+  // or reconfigure a decoder.
+  int32_t DecodePart(const EncodedImage& part, uint8_t payload_type);
 
  private:
   RTC_NO_UNIQUE_ADDRESS SequenceChecker construction_sequence_checker_;
@@ -95,6 +95,7 @@ absl::optional<DataRate> GetExperimentalMinVideoBitrate(VideoCodecType type) {
       case kVideoCodecVP8:
         return min_bitrate_vp8.GetOptional();
       case kVideoCodecH265:
+      case kVideoCodecH266:
       //  TODO(bugs.webrtc.org/13485): Use VP9 bitrate limits for now.
       case kVideoCodecVP9:
         return min_bitrate_vp9.GetOptional();
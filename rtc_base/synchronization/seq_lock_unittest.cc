@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2025 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/seq_lock.h"
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Larger than a word, with fields that are only consistent when the struct is
+// copied as a whole.
+struct Value {
+  int64_t a = 0;
+  int64_t b = 0;
+  int32_t c = 0;
+};
+
+TEST(SeqLockTest, LoadsInitialValue) {
+  SeqLock<Value> seq_lock(Value{1, 2, 3});
+  Value value = seq_lock.Load();
+  EXPECT_EQ(value.a, 1);
+  EXPECT_EQ(value.b, 2);
+  EXPECT_EQ(value.c, 3);
+}
+
+TEST(SeqLockTest, LoadsLastStoredValue) {
+  SeqLock<Value> seq_lock;
+  EXPECT_EQ(seq_lock.Load().a, 0);
+  seq_lock.Store(Value{4, 5, 6});
+  seq_lock.Store(Value{7, 8, 9});
+  Value value = seq_lock.Load();
+  EXPECT_EQ(value.a, 7);
+  EXPECT_EQ(value.b, 8);
+  EXPECT_EQ(value.c, 9);
+}
+
+TEST(SeqLockTest, ReaderNeverSeesPartialStore) {
+  constexpr int64_t kNumStores = 200000;
+  SeqLock<Value> seq_lock;
+  std::atomic<bool> done(false);
+  rtc::PlatformThread writer = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        for (int64_t i = 1; i <= kNumStores; ++i) {
+          seq_lock.Store(Value{i, -i, static_cast<int32_t>(i)});
+        }
+        done.store(true);
+      },
+      "writer");
+
+  int64_t last_a = 0;
+  while (!done.load()) {
+    Value value = seq_lock.Load();
+    ASSERT_EQ(value.b, -value.a);
+    ASSERT_EQ(value.c, static_cast<int32_t>(value.a));
+    ASSERT_GE(value.a, last_a);
+    last_a = value.a;
+  }
+  writer.Finalize();
+  EXPECT_EQ(seq_lock.Load().a, kNumStores);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "rtc_tools/frame_analyzer/aligned_quality_analysis_lib.h"
+#include "rtc_tools/mapped_video_file_reader.h"
+#include "rtc_tools/video_file_reader.h"
+
+ABSL_FLAG(std::string,
+          reference_file,
+          "",
+          "The reference (sent) .yuv or .y4m file");
+ABSL_FLAG(std::string,
+          test_file,
+          "",
+          "The test (received) .yuv or .y4m file, e.g. recon.yuv");
+ABSL_FLAG(int, width, 0, "Frame width, required for .yuv input");
+ABSL_FLAG(int, height, 0, "Frame height, required for .yuv input");
+ABSL_FLAG(std::string,
+          frame_ids,
+          "",
+          "Reference frame index of every test frame, one per line, as "
+          "written by peerconnection_localvideo --recon_frame_ids. Negative "
+          "entries are skipped. Empty compares frame i with frame i.");
+ABSL_FLAG(std::string,
+          results_file,
+          "results.csv",
+          "CSV file the per-frame results are written to");
+ABSL_FLAG(int,
+          threads,
+          0,
+          "Number of analysis threads. 0 uses one thread per core.");
+
+/*
+ * A tool computing PSNR and SSIM of every received frame of a localvideo run
+ * against the source frame it was encoded from.
+ *
+ * Both files are memory mapped. The received file is aligned with the
+ * reference by the frame IDs the receiver logged next to recon.yuv, so
+ * dropped, frozen and repeated frames are compared with the right source
+ * frame. Frames are analyzed on all cores in a single pass and written as
+ * test_frame,reference_frame,psnr,ssim rows; unaligned frames have an empty
+ * reference_frame and no metrics.
+ *
+ * The max value for PSNR is 48.0 (between equal frames), as for SSIM it is 1.0.
+ */
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Runs PSNR and SSIM on a received video against its source, aligned "
+      "by frame ID.\n"
+      "Example usage:\n"
+      "./aligned_quality_analysis --reference_file=input.yuv "
+      "--test_file=recon.yuv --width=1920 --height=1080 "
+      "--frame_ids=recon_frame_ids.txt --results_file=results.csv\n");
+  absl::ParseCommandLine(argc, argv);
+
+  const int width = absl::GetFlag(FLAGS_width);
+  const int height = absl::GetFlag(FLAGS_height);
+  rtc::scoped_refptr<webrtc::test::Video> reference_video =
+      webrtc::test::OpenMappedYuvOrY4mFile(absl::GetFlag(FLAGS_reference_file),
+                                           width, height);
+  rtc::scoped_refptr<webrtc::test::Video> test_video =
+      webrtc::test::OpenMappedYuvOrY4mFile(absl::GetFlag(FLAGS_test_file),
+                                           width, height);
+  if (!reference_video || !test_video) {
+    fprintf(stderr, "Error opening video files\n");
+    return EXIT_FAILURE;
+  }
+  if (reference_video->width() != test_video->width() ||
+      reference_video->height() != test_video->height()) {
+    fprintf(stderr,
+            "Reference and test video files do not have same size: %dx%d "
+            "versus %dx%d\n",
+            reference_video->width(), reference_video->height(),
+            test_video->width(), test_video->height());
+    return EXIT_FAILURE;
+  }
+
+  std::vector<absl::optional<size_t>> reference_indices;
+  if (!absl::GetFlag(FLAGS_frame_ids).empty()) {
+    absl::optional<std::vector<absl::optional<size_t>>> index =
+        webrtc::test::ReadFrameIdIndex(absl::GetFlag(FLAGS_frame_ids));
+    if (!index) {
+      fprintf(stderr, "Error reading frame ID index\n");
+      return EXIT_FAILURE;
+    }
+    reference_indices = std::move(*index);
+  }
+
+  const std::vector<webrtc::test::AlignedFrameResult> results =
+      webrtc::test::RunAlignedAnalysis(reference_video, test_video,
+                                       reference_indices,
+                                       absl::GetFlag(FLAGS_threads));
+
+  FILE* results_file = fopen(absl::GetFlag(FLAGS_results_file).c_str(), "w");
+  if (!results_file) {
+    fprintf(stderr, "Error opening results file\n");
+    return EXIT_FAILURE;
+  }
+  fprintf(results_file, "test_frame,reference_frame,psnr,ssim\n");
+  size_t aligned_frames = 0;
+  double psnr_sum = 0.0;
+  double ssim_sum = 0.0;
+  for (const webrtc::test::AlignedFrameResult& result : results) {
+    if (!result.reference_frame) {
+      fprintf(results_file, "%zu,,,\n", result.test_frame);
+      continue;
+    }
+    fprintf(results_file, "%zu,%zu,%f,%f\n", result.test_frame,
+            *result.reference_frame, result.psnr, result.ssim);
+    ++aligned_frames;
+    psnr_sum += result.psnr;
+    ssim_sum += result.ssim;
+  }
+  fclose(results_file);
+
+  printf("Frames: %zu, aligned: %zu\n", results.size(), aligned_frames);
+  if (aligned_frames > 0) {
+    printf("Average PSNR: %f, average SSIM: %f\n", psnr_sum / aligned_frames,
+           ssim_sum / aligned_frames);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/frame_analyzer/aligned_quality_analysis_lib.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/string_view.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/string_to_number.h"
+#include "rtc_tools/frame_analyzer/video_quality_analysis.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+// Frames handed to a worker at a time. Large enough to keep the shared
+// counter off the profile, small enough to balance the tail across cores.
+constexpr size_t kFramesPerTask = 4;
+
+}  // namespace
+
+absl::optional<std::vector<absl::optional<size_t>>> ReadFrameIdIndex(
+    const std::string& file_name) {
+  FILE* file = fopen(file_name.c_str(), "r");
+  if (!file) {
+    RTC_LOG(LS_ERROR) << "Could not open frame ID index " << file_name;
+    return absl::nullopt;
+  }
+
+  std::vector<absl::optional<size_t>> indices;
+  char line[64];
+  int line_number = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), file)) {
+    ++line_number;
+    absl::string_view text = absl::StripAsciiWhitespace(line);
+    if (text.empty())
+      continue;
+    absl::optional<int64_t> id = rtc::StringToNumber<int64_t>(text);
+    if (!id) {
+      RTC_LOG(LS_ERROR) << file_name << ":" << line_number
+                        << ": malformed frame ID '" << text << "'";
+      ok = false;
+      break;
+    }
+    if (*id < 0) {
+      indices.push_back(absl::nullopt);
+    } else {
+      indices.push_back(static_cast<size_t>(*id));
+    }
+  }
+  fclose(file);
+  if (!ok)
+    return absl::nullopt;
+  return indices;
+}
+
+std::vector<AlignedFrameResult> RunAlignedAnalysis(
+    const rtc::scoped_refptr<Video>& reference_video,
+    const rtc::scoped_refptr<Video>& test_video,
+    const std::vector<absl::optional<size_t>>& reference_indices,
+    int num_threads) {
+  RTC_CHECK_EQ(reference_video->width(), test_video->width());
+  RTC_CHECK_EQ(reference_video->height(), test_video->height());
+
+  size_t num_frames = test_video->number_of_frames();
+  if (reference_indices.empty()) {
+    num_frames = std::min(num_frames, reference_video->number_of_frames());
+  } else if (reference_indices.size() != num_frames) {
+    RTC_LOG(LS_WARNING) << "Frame ID index has " << reference_indices.size()
+                        << " entries for " << num_frames
+                        << " test frames, analyzing the common prefix.";
+    num_frames = std::min(num_frames, reference_indices.size());
+  }
+
+  std::vector<AlignedFrameResult> results(num_frames);
+  for (size_t i = 0; i < num_frames; ++i) {
+    AlignedFrameResult& result = results[i];
+    result.test_frame = i;
+    if (reference_indices.empty()) {
+      result.reference_frame = i;
+    } else if (reference_indices[i] &&
+               *reference_indices[i] < reference_video->number_of_frames()) {
+      result.reference_frame = reference_indices[i];
+    }
+  }
+
+  // Every worker claims the next kFramesPerTask frames and writes only to
+  // their slots in `results`, so no further synchronization is needed.
+  std::atomic<size_t> next_frame{0};
+  auto worker = [&] {
+    while (true) {
+      const size_t begin = next_frame.fetch_add(kFramesPerTask);
+      if (begin >= num_frames)
+        return;
+      const size_t end = std::min(begin + kFramesPerTask, num_frames);
+      for (size_t i = begin; i < end; ++i) {
+        AlignedFrameResult& result = results[i];
+        if (!result.reference_frame)
+          continue;
+        const rtc::scoped_refptr<I420BufferInterface> reference_frame =
+            reference_video->GetFrame(*result.reference_frame);
+        const rtc::scoped_refptr<I420BufferInterface> test_frame =
+            test_video->GetFrame(i);
+        result.psnr = Psnr(reference_frame, test_frame);
+        result.ssim = Ssim(reference_frame, test_frame);
+      }
+    }
+  };
+
+  if (num_threads <= 0)
+    num_threads = static_cast<int>(CpuInfo::DetectNumberOfCores());
+  const size_t num_tasks = (num_frames + kFramesPerTask - 1) / kFramesPerTask;
+  const size_t num_helpers =
+      std::min<size_t>(std::max(num_threads, 1) - 1, num_tasks);
+  std::vector<rtc::PlatformThread> helpers;
+  helpers.reserve(num_helpers);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    helpers.push_back(
+        rtc::PlatformThread::SpawnJoinable(worker, "AlignedQualityAnalysis"));
+  }
+  worker();
+  // Joins the helper threads.
+  helpers.clear();
+
+  return results;
+}
+
+}  // namespace test
+}  // namespace webrtc
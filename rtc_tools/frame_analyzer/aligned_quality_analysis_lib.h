@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_FRAME_ANALYZER_ALIGNED_QUALITY_ANALYSIS_LIB_H_
+#define RTC_TOOLS_FRAME_ANALYZER_ALIGNED_QUALITY_ANALYSIS_LIB_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "rtc_tools/video_file_reader.h"
+
+namespace webrtc {
+namespace test {
+
+struct AlignedFrameResult {
+  // Index of the frame in the test (received) video.
+  size_t test_frame = 0;
+  // Index of the reference frame it was compared against. Unset if the test
+  // frame could not be aligned, in which case no metrics were computed.
+  absl::optional<size_t> reference_frame;
+  double psnr = 0.0;
+  double ssim = 0.0;
+};
+
+// Reads the reference frame index of every test frame from `file_name`, one
+// decimal number per line. Negative numbers mark test frames without a known
+// source frame, e.g. frames that arrived without a frame tag. Returns nullopt
+// if the file cannot be opened or contains a malformed line.
+absl::optional<std::vector<absl::optional<size_t>>> ReadFrameIdIndex(
+    const std::string& file_name);
+
+// Computes PSNR and SSIM of every test frame against the reference frame
+// `reference_indices[i]`. If `reference_indices` is empty, test frame i is
+// compared with reference frame i. Test frames without an index, or with an
+// index past the end of the reference video, are reported unaligned.
+//
+// Frames are distributed over `num_threads` threads, including the calling
+// one; 0 uses one thread per core. Both videos must support GetFrame() from
+// any thread, which the readers in mapped_video_file_reader.h do. Results are
+// returned in test frame order.
+std::vector<AlignedFrameResult> RunAlignedAnalysis(
+    const rtc::scoped_refptr<Video>& reference_video,
+    const rtc::scoped_refptr<Video>& test_video,
+    const std::vector<absl::optional<size_t>>& reference_indices,
+    int num_threads);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_FRAME_ANALYZER_ALIGNED_QUALITY_ANALYSIS_LIB_H_
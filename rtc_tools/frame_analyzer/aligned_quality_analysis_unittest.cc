@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/frame_analyzer/aligned_quality_analysis_lib.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "api/video/i420_buffer.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+
+namespace {
+
+constexpr int kWidth = 32;
+constexpr int kHeight = 32;
+
+// In-memory video with one frame per entry of `luma_values`, all of whose
+// luma samples are set to that value.
+class SyntheticVideo : public Video {
+ public:
+  explicit SyntheticVideo(std::vector<uint8_t> luma_values) {
+    for (uint8_t value : luma_values) {
+      rtc::scoped_refptr<I420Buffer> frame =
+          I420Buffer::Create(kWidth, kHeight);
+      I420Buffer::SetBlack(frame.get());
+      memset(frame->MutableDataY(), value, kWidth * kHeight);
+      frames_.push_back(frame);
+    }
+  }
+
+  int width() const override { return kWidth; }
+  int height() const override { return kHeight; }
+  size_t number_of_frames() const override { return frames_.size(); }
+  rtc::scoped_refptr<I420BufferInterface> GetFrame(
+      size_t index) const override {
+    return frames_[index];
+  }
+
+ private:
+  std::vector<rtc::scoped_refptr<I420BufferInterface>> frames_;
+};
+
+}  // namespace
+
+TEST(AlignedQualityAnalysisTest, ComparesFramesInOrderWithoutIndex) {
+  auto reference = rtc::make_ref_counted<SyntheticVideo>(
+      std::vector<uint8_t>{10, 20, 30});
+  auto test = rtc::make_ref_counted<SyntheticVideo>(
+      std::vector<uint8_t>{10, 20});
+
+  std::vector<AlignedFrameResult> results =
+      RunAlignedAnalysis(reference, test, {}, /*num_threads=*/1);
+  ASSERT_EQ(2u, results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(i, results[i].test_frame);
+    EXPECT_EQ(i, results[i].reference_frame);
+    EXPECT_DOUBLE_EQ(48.0, results[i].psnr);
+    EXPECT_NEAR(1.0, results[i].ssim, 1e-6);
+  }
+}
+
+TEST(AlignedQualityAnalysisTest, AlignsFramesByIndex) {
+  auto reference = rtc::make_ref_counted<SyntheticVideo>(
+      std::vector<uint8_t>{10, 20, 30, 40});
+  // Frame 1 was dropped, frame 2 was repeated and the last test frame carries
+  // no frame ID.
+  auto test = rtc::make_ref_counted<SyntheticVideo>(
+      std::vector<uint8_t>{10, 30, 30, 40, 40});
+  std::vector<absl::optional<size_t>> indices = {0, 2, 2, 3, absl::nullopt};
+
+  std::vector<AlignedFrameResult> results =
+      RunAlignedAnalysis(reference, test, indices, /*num_threads=*/1);
+  ASSERT_EQ(5u, results.size());
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(indices[i], results[i].reference_frame);
+    EXPECT_DOUBLE_EQ(48.0, results[i].psnr);
+  }
+  EXPECT_FALSE(results[4].reference_frame);
+}
+
+TEST(AlignedQualityAnalysisTest, IndexPastReferenceEndIsUnaligned) {
+  auto reference =
+      rtc::make_ref_counted<SyntheticVideo>(std::vector<uint8_t>{10});
+  auto test = rtc::make_ref_counted<SyntheticVideo>(
+      std::vector<uint8_t>{10, 10});
+
+  std::vector<AlignedFrameResult> results =
+      RunAlignedAnalysis(reference, test, {0, 1}, /*num_threads=*/1);
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ(0u, results[0].reference_frame);
+  EXPECT_FALSE(results[1].reference_frame);
+}
+
+TEST(AlignedQualityAnalysisTest, ThreadCountDoesNotChangeResults) {
+  std::vector<uint8_t> reference_values;
+  std::vector<uint8_t> test_values;
+  for (int i = 0; i < 37; ++i) {
+    reference_values.push_back(static_cast<uint8_t>(4 * i));
+    test_values.push_back(static_cast<uint8_t>(4 * i + i % 3));
+  }
+  auto reference = rtc::make_ref_counted<SyntheticVideo>(reference_values);
+  auto test = rtc::make_ref_counted<SyntheticVideo>(test_values);
+
+  std::vector<AlignedFrameResult> expected =
+      RunAlignedAnalysis(reference, test, {}, /*num_threads=*/1);
+  std::vector<AlignedFrameResult> results =
+      RunAlignedAnalysis(reference, test, {}, /*num_threads=*/8);
+  ASSERT_EQ(expected.size(), results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(i, results[i].test_frame);
+    EXPECT_EQ(expected[i].psnr, results[i].psnr);
+    EXPECT_EQ(expected[i].ssim, results[i].ssim);
+  }
+}
+
+TEST(AlignedQualityAnalysisTest, ReadsFrameIdIndex) {
+  const std::string file_name =
+      TempFilename(OutputPath(), "aligned_quality_analysis_ids.txt");
+  FILE* file = fopen(file_name.c_str(), "w");
+  ASSERT_TRUE(file != nullptr);
+  fprintf(file, "0\n2\n-1\n 7 \n");
+  fclose(file);
+
+  absl::optional<std::vector<absl::optional<size_t>>> indices =
+      ReadFrameIdIndex(file_name);
+  RemoveFile(file_name);
+  ASSERT_TRUE(indices);
+  ASSERT_EQ(4u, indices->size());
+  EXPECT_EQ(0u, (*indices)[0]);
+  EXPECT_EQ(2u, (*indices)[1]);
+  EXPECT_FALSE((*indices)[2]);
+  EXPECT_EQ(7u, (*indices)[3]);
+}
+
+TEST(AlignedQualityAnalysisTest, RejectsMalformedFrameIdIndex) {
+  const std::string file_name =
+      TempFilename(OutputPath(), "aligned_quality_analysis_bad_ids.txt");
+  FILE* file = fopen(file_name.c_str(), "w");
+  ASSERT_TRUE(file != nullptr);
+  fprintf(file, "0\nframe\n");
+  fclose(file);
+
+  EXPECT_FALSE(ReadFrameIdIndex(file_name));
+  RemoveFile(file_name);
+}
+
+}  // namespace test
+}  // namespace webrtc
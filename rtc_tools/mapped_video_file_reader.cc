@@ -0,0 +1,375 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/mapped_video_file_reader.h"
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/make_ref_counted.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/string_encode.h"
+#include "rtc_base/string_to_number.h"
+
+namespace webrtc {
+namespace test {
+
+#if defined(WEBRTC_POSIX)
+namespace {
+
+constexpr char kY4mFileHeader[] = "YUV4MPEG2 ";
+constexpr char kY4mFrameHeader[] = "FRAME";
+
+// Read-only I420 view into a mapped file. Holds a reference to the owning
+// video so that the mapping outlives every frame handed out.
+class MappedI420Buffer : public I420BufferInterface {
+ public:
+  MappedI420Buffer(rtc::scoped_refptr<const Video> owner,
+                   int width,
+                   int height,
+                   const uint8_t* data)
+      : owner_(std::move(owner)), width_(width), height_(height), data_(data) {}
+
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  const uint8_t* DataY() const override { return data_; }
+  const uint8_t* DataU() const override { return data_ + width_ * height_; }
+  const uint8_t* DataV() const override {
+    return DataU() + ChromaWidth() * ChromaHeight();
+  }
+
+  int StrideY() const override { return width_; }
+  int StrideU() const override { return ChromaWidth(); }
+  int StrideV() const override { return ChromaWidth(); }
+
+ private:
+  const rtc::scoped_refptr<const Video> owner_;
+  const int width_;
+  const int height_;
+  const uint8_t* const data_;
+};
+
+class MappedVideoFile : public Video {
+ public:
+  MappedVideoFile(int width,
+                  int height,
+                  std::vector<size_t> frame_offsets,
+                  uint8_t* data,
+                  size_t size,
+                  size_t read_ahead_frames)
+      : width_(width),
+        height_(height),
+        frame_size_(3 * width * height / 2),
+        frame_offsets_(std::move(frame_offsets)),
+        data_(data),
+        size_(size),
+        read_ahead_frames_(
+            std::min(read_ahead_frames, frame_offsets_.size())) {
+    madvise(data_, size_, MADV_SEQUENTIAL);
+    if (read_ahead_frames_ > 0) {
+      prefetch_thread_ = rtc::PlatformThread::SpawnJoinable(
+          [this] { PrefetchLoop(); }, "MappedVideoPrefetch",
+          rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh));
+      // Warm up the first window before the first GetFrame() call.
+      wake_prefetch_.Set();
+    }
+  }
+
+  ~MappedVideoFile() override {
+    if (!prefetch_thread_.empty()) {
+      stop_prefetch_.store(true);
+      wake_prefetch_.Set();
+      prefetch_thread_.Finalize();
+    }
+    munmap(data_, size_);
+  }
+
+  size_t number_of_frames() const override { return frame_offsets_.size(); }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> GetFrame(
+      size_t frame_index) const override {
+    RTC_CHECK_LT(frame_index, frame_offsets_.size());
+    if (read_ahead_frames_ > 0) {
+      requested_frame_.store(frame_index, std::memory_order_relaxed);
+      // Only wake the prefetcher once half of its window has been consumed
+      // (or on a seek), so that steady-state playback does not signal the
+      // event on every frame.
+      const size_t num_frames = frame_offsets_.size();
+      const size_t consumed =
+          (frame_index + num_frames -
+           prefetch_start_.load(std::memory_order_relaxed)) %
+          num_frames;
+      if (consumed >= std::max<size_t>(read_ahead_frames_ / 2, 1))
+        wake_prefetch_.Set();
+    }
+    return rtc::make_ref_counted<MappedI420Buffer>(
+        rtc::scoped_refptr<const Video>(this), width_, height_,
+        data_ + frame_offsets_[frame_index]);
+  }
+
+ private:
+  void PrefetchLoop() {
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    while (true) {
+      wake_prefetch_.Wait(rtc::Event::kForever);
+      if (stop_prefetch_.load())
+        return;
+      const size_t start = requested_frame_.load(std::memory_order_relaxed);
+      prefetch_start_.store(start, std::memory_order_relaxed);
+      for (size_t i = 0; i < read_ahead_frames_ && !stop_prefetch_.load();
+           ++i) {
+        TouchFrame((start + i) % frame_offsets_.size(), page_size);
+      }
+    }
+  }
+
+  // Faults in all pages backing a frame so that the consumer finds them
+  // resident.
+  void TouchFrame(size_t frame_index, size_t page_size) {
+    const size_t begin =
+        frame_offsets_[frame_index] / page_size * page_size;
+    const size_t end =
+        std::min(frame_offsets_[frame_index] + frame_size_, size_);
+    madvise(data_ + begin, end - begin, MADV_WILLNEED);
+    uint8_t sum = 0;
+    for (size_t offset = begin; offset < end; offset += page_size)
+      sum += data_[offset];
+    touch_sink_ = sum;
+  }
+
+  const int width_;
+  const int height_;
+  const size_t frame_size_;
+  const std::vector<size_t> frame_offsets_;
+  uint8_t* const data_;
+  const size_t size_;
+  const size_t read_ahead_frames_;
+
+  mutable std::atomic<size_t> requested_frame_{0};
+  std::atomic<size_t> prefetch_start_{0};
+  std::atomic<bool> stop_prefetch_{false};
+  volatile uint8_t touch_sink_ = 0;
+  mutable rtc::Event wake_prefetch_;
+  rtc::PlatformThread prefetch_thread_;
+};
+
+// Maps `file_name` read-only into memory. Returns false and logs on failure.
+bool MapFile(const std::string& file_name, uint8_t** data, size_t* size) {
+  const int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    RTC_LOG(LS_ERROR) << "Could not open input file for reading: " << file_name;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    RTC_LOG(LS_ERROR) << "Could not determine size of non-empty file: "
+                      << file_name;
+    close(fd);
+    return false;
+  }
+  void* mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd,
+                       /*offset=*/0);
+  // The mapping keeps its own reference to the file.
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    RTC_LOG(LS_ERROR) << "Could not map input file: " << file_name;
+    return false;
+  }
+  *data = static_cast<uint8_t*>(mapping);
+  *size = file_stat.st_size;
+  return true;
+}
+
+bool HasEvenDimensions(int width, int height) {
+  if (width % 2 != 0 || height % 2 != 0) {
+    RTC_LOG(LS_ERROR)
+        << "Only supports even width/height so that chroma size is a "
+           "whole number.";
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+rtc::scoped_refptr<Video> OpenMappedYuvFile(const std::string& file_name,
+                                            int width,
+                                            int height,
+                                            size_t read_ahead_frames) {
+  if (width <= 0 || height <= 0 || !HasEvenDimensions(width, height))
+    return nullptr;
+
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  if (!MapFile(file_name, &data, &size))
+    return nullptr;
+
+  const size_t i420_frame_size = 3 * width * height / 2;
+  std::vector<size_t> frame_offsets;
+  for (size_t offset = 0; offset + i420_frame_size <= size;
+       offset += i420_frame_size) {
+    frame_offsets.push_back(offset);
+  }
+  if (frame_offsets.empty()) {
+    RTC_LOG(LS_ERROR) << "Could not find any frames in the file";
+    munmap(data, size);
+    return nullptr;
+  }
+  RTC_LOG(LS_INFO) << "Video has " << frame_offsets.size() << " frames";
+
+  return rtc::make_ref_counted<MappedVideoFile>(width, height,
+                                                std::move(frame_offsets), data,
+                                                size, read_ahead_frames);
+}
+
+rtc::scoped_refptr<Video> OpenMappedY4mFile(const std::string& file_name,
+                                            size_t read_ahead_frames) {
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  if (!MapFile(file_name, &data, &size))
+    return nullptr;
+
+  const absl::string_view contents(reinterpret_cast<const char*>(data), size);
+  const size_t header_end = contents.find('\n');
+  if (!absl::StartsWith(contents, kY4mFileHeader) ||
+      header_end == absl::string_view::npos) {
+    RTC_LOG(LS_ERROR) << "File " << file_name
+                      << " does not start with YUV4MPEG2 header";
+    munmap(data, size);
+    return nullptr;
+  }
+
+  absl::optional<int> width;
+  absl::optional<int> height;
+  const size_t params_begin = strlen(kY4mFileHeader);
+  for (absl::string_view field : rtc::split(
+           contents.substr(params_begin, header_end - params_begin), ' ')) {
+    if (field.empty())
+      continue;
+    const absl::string_view suffix = field.substr(1);
+    switch (field.front()) {
+      case 'W':
+        width = rtc::StringToNumber<int>(suffix);
+        break;
+      case 'H':
+        height = rtc::StringToNumber<int>(suffix);
+        break;
+      case 'C':
+        if (suffix != "420" && suffix != "420mpeg2") {
+          RTC_LOG(LS_ERROR)
+              << "Does not support any other color space than I420 or "
+                 "420mpeg2, but was: "
+              << suffix;
+          munmap(data, size);
+          return nullptr;
+        }
+        break;
+    }
+  }
+  if (!width || !height || *width <= 0 || *height <= 0) {
+    RTC_LOG(LS_ERROR) << "Could not find width and height in file header";
+    munmap(data, size);
+    return nullptr;
+  }
+  if (!HasEvenDimensions(*width, *height)) {
+    munmap(data, size);
+    return nullptr;
+  }
+
+  const size_t i420_frame_size = 3 * *width * *height / 2;
+  std::vector<size_t> frame_offsets;
+  size_t pos = header_end + 1;
+  while (pos < size) {
+    // Frame headers may carry parameters, so skip to the end of the line.
+    const size_t frame_header_end = contents.find('\n', pos);
+    if (!absl::StartsWith(contents.substr(pos), kY4mFrameHeader) ||
+        frame_header_end == absl::string_view::npos) {
+      RTC_LOG(LS_ERROR) << "Did not find FRAME header, ignoring rest of file";
+      break;
+    }
+    pos = frame_header_end + 1;
+    if (pos + i420_frame_size > size) {
+      RTC_LOG(LS_ERROR) << "Truncated last frame, ignoring rest of file";
+      break;
+    }
+    frame_offsets.push_back(pos);
+    pos += i420_frame_size;
+  }
+  if (frame_offsets.empty()) {
+    RTC_LOG(LS_ERROR) << "Could not find any frames in the file";
+    munmap(data, size);
+    return nullptr;
+  }
+  RTC_LOG(LS_INFO) << "Video has resolution: " << *width << "x" << *height
+                   << " and " << frame_offsets.size() << " frames";
+
+  return rtc::make_ref_counted<MappedVideoFile>(*width, *height,
+                                                std::move(frame_offsets), data,
+                                                size, read_ahead_frames);
+}
+
+#else  // defined(WEBRTC_POSIX)
+
+rtc::scoped_refptr<Video> OpenMappedYuvFile(const std::string& file_name,
+                                            int width,
+                                            int height,
+                                            size_t read_ahead_frames) {
+  RTC_LOG(LS_WARNING) << "Memory mapped video files are not supported on this "
+                         "platform, falling back to buffered reads.";
+  return OpenYuvFile(file_name, width, height);
+}
+
+rtc::scoped_refptr<Video> OpenMappedY4mFile(const std::string& file_name,
+                                            size_t read_ahead_frames) {
+  RTC_LOG(LS_WARNING) << "Memory mapped video files are not supported on this "
+                         "platform, falling back to buffered reads.";
+  return OpenY4mFile(file_name);
+}
+
+#endif  // defined(WEBRTC_POSIX)
+
+rtc::scoped_refptr<Video> OpenMappedYuvOrY4mFile(const std::string& file_name,
+                                                 int width,
+                                                 int height,
+                                                 size_t read_ahead_frames) {
+  if (absl::EndsWith(file_name, ".yuv"))
+    return OpenMappedYuvFile(file_name, width, height, read_ahead_frames);
+  if (absl::EndsWith(file_name, ".y4m"))
+    return OpenMappedY4mFile(file_name, read_ahead_frames);
+
+  RTC_LOG(LS_ERROR) << "Video file does not end in either .yuv or .y4m: "
+                    << file_name;
+
+  return nullptr;
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef RTC_TOOLS_MAPPED_VIDEO_FILE_READER_H_
+#define RTC_TOOLS_MAPPED_VIDEO_FILE_READER_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "api/scoped_refptr.h"
+#include "rtc_tools/video_file_reader.h"
+
+namespace webrtc {
+namespace test {
+
+// Memory-mapped counterparts of OpenYuvFile() and OpenY4mFile(). The whole
+// file is mapped read-only and GetFrame() returns an I420BufferInterface that
+// points directly into the mapping, so no pixel data is copied or allocated
+// per frame and no file syscalls are made on the calling thread. The returned
+// buffers keep the mapping alive until they are released.
+//
+// If `read_ahead_frames` is non-zero, a background thread keeps the pages of
+// the next `read_ahead_frames` frames after the most recently requested one
+// resident (wrapping around at the end of the file), so that a real-time
+// caller does not stall on page faults. Unlike the Video objects returned by
+// video_file_reader.h, GetFrame() on these objects may be called from any
+// thread.
+//
+// On platforms without mmap support these fall back to the regular
+// fread-based readers.
+rtc::scoped_refptr<Video> OpenMappedYuvFile(const std::string& file_name,
+                                            int width,
+                                            int height,
+                                            size_t read_ahead_frames = 0);
+
+rtc::scoped_refptr<Video> OpenMappedY4mFile(const std::string& file_name,
+                                            size_t read_ahead_frames = 0);
+
+// Picks one of the two functions above based on the file extension.
+rtc::scoped_refptr<Video> OpenMappedYuvOrY4mFile(const std::string& file_name,
+                                                 int width,
+                                                 int height,
+                                                 size_t read_ahead_frames = 0);
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_MAPPED_VIDEO_FILE_READER_H_
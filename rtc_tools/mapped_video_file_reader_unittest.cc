@@ -0,0 +1,131 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/mapped_video_file_reader.h"
+
+#include <stdint.h>
+
+#include <string>
+
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kWidth = 6;
+constexpr int kHeight = 4;
+constexpr int kI420Size = kWidth * kHeight * 3 / 2;
+constexpr int kNumFrames = 3;
+
+void ExpectFramePixels(const I420BufferInterface& frame, int first_value) {
+  int cnt = first_value;
+  for (int i = 0; i < kWidth * kHeight; ++i, ++cnt)
+    EXPECT_EQ(static_cast<uint8_t>(cnt), frame.DataY()[i]);
+  for (int i = 0; i < kWidth * kHeight / 4; ++i, ++cnt)
+    EXPECT_EQ(static_cast<uint8_t>(cnt), frame.DataU()[i]);
+  for (int i = 0; i < kWidth * kHeight / 4; ++i, ++cnt)
+    EXPECT_EQ(static_cast<uint8_t>(cnt), frame.DataV()[i]);
+}
+
+}  // namespace
+
+class MappedYuvFileReaderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    filename_ = TempFilename(OutputPath(), "test_mapped_video_file.yuv");
+    FILE* file = fopen(filename_.c_str(), "wb");
+    ASSERT_TRUE(file != nullptr);
+    for (int i = 0; i < kNumFrames * kI420Size; ++i)
+      fputc(static_cast<char>(i), file);
+    // Trailing partial frame must be ignored.
+    fputc(0, file);
+    fclose(file);
+  }
+
+  void TearDown() override { RemoveFile(filename_); }
+
+ protected:
+  std::string filename_;
+};
+
+TEST_F(MappedYuvFileReaderTest, ParsesDimensionsAndFrameCount) {
+  rtc::scoped_refptr<Video> video =
+      OpenMappedYuvFile(filename_, kWidth, kHeight);
+  ASSERT_TRUE(video);
+  EXPECT_EQ(kWidth, video->width());
+  EXPECT_EQ(kHeight, video->height());
+  EXPECT_EQ(static_cast<size_t>(kNumFrames), video->number_of_frames());
+}
+
+TEST_F(MappedYuvFileReaderTest, PixelContent) {
+  rtc::scoped_refptr<Video> video =
+      OpenMappedYuvFile(filename_, kWidth, kHeight);
+  ASSERT_TRUE(video);
+  int frame_index = 0;
+  for (const rtc::scoped_refptr<I420BufferInterface> frame : *video)
+    ExpectFramePixels(*frame, kI420Size * frame_index++);
+}
+
+TEST_F(MappedYuvFileReaderTest, FrameOutlivesVideo) {
+  rtc::scoped_refptr<I420BufferInterface> frame;
+  {
+    rtc::scoped_refptr<Video> video =
+        OpenMappedYuvFile(filename_, kWidth, kHeight);
+    ASSERT_TRUE(video);
+    frame = video->GetFrame(1);
+  }
+  ExpectFramePixels(*frame, kI420Size);
+}
+
+TEST_F(MappedYuvFileReaderTest, ReadAheadWrapsAround) {
+  rtc::scoped_refptr<Video> video = OpenMappedYuvFile(
+      filename_, kWidth, kHeight, /*read_ahead_frames=*/2);
+  ASSERT_TRUE(video);
+  for (int loop = 0; loop < 4; ++loop) {
+    for (int i = 0; i < kNumFrames; ++i)
+      ExpectFramePixels(*video->GetFrame(i), kI420Size * i);
+  }
+}
+
+TEST_F(MappedYuvFileReaderTest, RejectsOddDimensions) {
+  EXPECT_FALSE(OpenMappedYuvFile(filename_, kWidth + 1, kHeight));
+}
+
+TEST(MappedY4mFileReaderTest, ParsesHeaderAndPixelContent) {
+  const std::string filename =
+      TempFilename(OutputPath(), "test_mapped_video_file.y4m");
+  FILE* file = fopen(filename.c_str(), "wb");
+  ASSERT_TRUE(file != nullptr);
+  fprintf(file, "YUV4MPEG2 W6 H4 F30000:1001 C420 dummyParam\n");
+  fprintf(file, "FRAME\n");
+  for (int i = 0; i < kI420Size; ++i)
+    fputc(static_cast<char>(i), file);
+  // Frame headers may carry parameters.
+  fprintf(file, "FRAME Ixyz\n");
+  for (int i = 0; i < kI420Size; ++i)
+    fputc(static_cast<char>(i + kI420Size), file);
+  fclose(file);
+
+  rtc::scoped_refptr<Video> video =
+      OpenMappedY4mFile(filename, /*read_ahead_frames=*/1);
+  ASSERT_TRUE(video);
+  EXPECT_EQ(kWidth, video->width());
+  EXPECT_EQ(kHeight, video->height());
+  ASSERT_EQ(2u, video->number_of_frames());
+  ExpectFramePixels(*video->GetFrame(0), 0);
+  ExpectFramePixels(*video->GetFrame(1), kI420Size);
+  video = nullptr;
+  RemoveFile(filename);
+}
+
+}  // namespace test
+}  // namespace webrtc
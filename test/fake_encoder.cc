@@ -16,8 +16,10 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "api/video/video_content_type.h"
+#include "common_video/h264/h264_common.h"
 #include "modules/video_coding/codecs/h264/include/h264_globals.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/include/video_error_codes.h"
@@ -150,6 +152,9 @@ int32_t FakeEncoder::Encode(const VideoFrame& input_image,
       encoded.qp_ = *qp;
     encoded.SetSimulcastIndex(i);
     CodecSpecificInfo codec_specific = EncodeHook(encoded, buffer);
+    if (!EncodePartsHook(encoded, codec_specific, callback)) {
+      return -1;
+    }
 
     if (callback->OnEncodedImage(encoded, &codec_specific).error !=
         EncodedImageCallback::Result::OK) {
@@ -167,6 +172,12 @@ CodecSpecificInfo FakeEncoder::EncodeHook(
   return codec_specific;
 }
 
+bool FakeEncoder::EncodePartsHook(const EncodedImage& encoded_image,
+                                  const CodecSpecificInfo& codec_specific,
+                                  EncodedImageCallback* callback) {
+  return true;
+}
+
 FakeEncoder::FrameInfo FakeEncoder::NextFrame(
     const std::vector<VideoFrameType>* frame_types,
     bool keyframe,
@@ -312,6 +323,11 @@ const VideoCodec& FakeEncoder::config() const {
 FakeH264Encoder::FakeH264Encoder(Clock* clock)
     : FakeEncoder(clock), idr_counter_(0) {}
 
+void FakeH264Encoder::SetSendFrameParts(bool send_frame_parts) {
+  MutexLock lock(&local_mutex_);
+  send_frame_parts_ = send_frame_parts;
+}
+
 CodecSpecificInfo FakeH264Encoder::EncodeHook(
     EncodedImage& encoded_image,
     rtc::scoped_refptr<EncodedImageBuffer> buffer) {
@@ -320,10 +336,12 @@ CodecSpecificInfo FakeH264Encoder::EncodeHook(
   const size_t kPpsSize = 11;
   const int kIdrFrequency = 10;
   int current_idr_counter;
+  bool send_frame_parts;
   {
     MutexLock lock(&local_mutex_);
     current_idr_counter = idr_counter_;
     ++idr_counter_;
+    send_frame_parts = send_frame_parts_;
   }
   for (size_t i = 0; i < encoded_image.size(); ++i) {
     buffer->data()[i] = static_cast<uint8_t>(i);
@@ -352,6 +370,12 @@ CodecSpecificInfo FakeH264Encoder::EncodeHook(
     memcpy(buffer->data(), kStartCode.data(), kStartCode.size());
     const size_t kNalHeader = 0x41;
     buffer->data()[kStartCode.size()] = kNalHeader;
+    if (send_frame_parts) {
+      // Second slice, so that the frame is sent in two parts.
+      uint8_t* slice = buffer->data() + encoded_image.size() / 2;
+      memcpy(slice, kStartCode.data(), kStartCode.size());
+      slice[kStartCode.size()] = kNalHeader;
+    }
   }
 
   CodecSpecificInfo codec_specific;
@@ -361,6 +385,32 @@ CodecSpecificInfo FakeH264Encoder::EncodeHook(
   return codec_specific;
 }
 
+bool FakeH264Encoder::EncodePartsHook(const EncodedImage& encoded_image,
+                                      const CodecSpecificInfo& codec_specific,
+                                      EncodedImageCallback* callback) {
+  {
+    MutexLock lock(&local_mutex_);
+    if (!send_frame_parts_)
+      return true;
+  }
+  std::vector<H264::NaluIndex> nalu_indices =
+      H264::FindNaluIndices(encoded_image.data(), encoded_image.size());
+  for (size_t i = 0; i < nalu_indices.size(); ++i) {
+    const bool last_part = i + 1 == nalu_indices.size();
+    const size_t part_start = nalu_indices[i].start_offset;
+    const size_t part_end = last_part ? encoded_image.size()
+                                      : nalu_indices[i + 1].start_offset;
+    EncodedImage encoded_part = encoded_image;
+    encoded_part.SetEncodedData(EncodedImageBuffer::Create(
+        encoded_image.data() + part_start, part_end - part_start));
+    if (callback->OnEncodedImagePart(encoded_part, &codec_specific, last_part)
+            .error != EncodedImageCallback::Result::OK) {
+      return false;
+    }
+  }
+  return true;
+}
+
 DelayedEncoder::DelayedEncoder(Clock* clock, int delay_ms)
     : test::FakeEncoder(clock), delay_ms_(delay_ms) {
   // The encoder could be created on a different thread than
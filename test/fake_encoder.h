@@ -96,6 +96,13 @@ class FakeEncoder : public VideoEncoder {
       EncodedImage& encoded_image,
       rtc::scoped_refptr<EncodedImageBuffer> buffer);
 
+  // Called after EncodeHook, to let subclasses pass the image to
+  // `callback`->OnEncodedImagePart in parts before it is passed to
+  // `callback`->OnEncodedImage. Returns false if sending a part failed.
+  virtual bool EncodePartsHook(const EncodedImage& encoded_image,
+                               const CodecSpecificInfo& codec_specific,
+                               EncodedImageCallback* callback);
+
   void SetRatesLocked(const RateControlParameters& parameters)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
@@ -124,12 +131,22 @@ class FakeH264Encoder : public FakeEncoder {
   explicit FakeH264Encoder(Clock* clock);
   virtual ~FakeH264Encoder() = default;
 
+  // Makes the encoder pass each NAL unit to OnEncodedImagePart before the
+  // complete image is passed to OnEncodedImage. Delta frames are then written
+  // as two slices.
+  void SetSendFrameParts(bool send_frame_parts)
+      RTC_LOCKS_EXCLUDED(local_mutex_);
+
  private:
   CodecSpecificInfo EncodeHook(
       EncodedImage& encoded_image,
       rtc::scoped_refptr<EncodedImageBuffer> buffer) override;
+  bool EncodePartsHook(const EncodedImage& encoded_image,
+                       const CodecSpecificInfo& codec_specific,
+                       EncodedImageCallback* callback) override;
 
   int idr_counter_ RTC_GUARDED_BY(local_mutex_);
+  bool send_frame_parts_ RTC_GUARDED_BY(local_mutex_) = false;
   Mutex local_mutex_;
 };
 
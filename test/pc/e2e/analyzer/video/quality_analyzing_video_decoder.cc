@@ -133,6 +133,8 @@ int32_t QualityAnalyzingVideoDecoder::Release() {
 VideoDecoder::DecoderInfo QualityAnalyzingVideoDecoder::GetDecoderInfo() const {
   DecoderInfo info = delegate_->GetDecoderInfo();
   info.implementation_name = implementation_name_;
+  // The analyzer needs to see complete frames.
+  info.supports_frame_parts = false;
   return info;
 }
 
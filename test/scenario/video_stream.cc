@@ -208,6 +208,7 @@ CreateEncoderSpecificSettings(VideoStreamConfig config) {
     case Codec::kVideoCodecGeneric:
     case Codec::kVideoCodecAV1:
     case Codec::kVideoCodecH265:
+    case Codec::kVideoCodecH266:
       return nullptr;
     case Codec::kVideoCodecMultiplex:
       RTC_DCHECK_NOTREACHED();
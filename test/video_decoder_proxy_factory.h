@@ -51,6 +51,11 @@ class VideoDecoderProxyFactory final : public VideoDecoderFactory {
                    int64_t render_time_ms) override {
       return decoder_->Decode(input_image, render_time_ms);
     }
+    int32_t DecodePart(const EncodedImage& input_part,
+                       bool last_part) override {
+      return decoder_->DecodePart(input_part, last_part);
+    }
+    void DiscardFrameParts() override { decoder_->DiscardFrameParts(); }
     bool Configure(const Settings& settings) override {
       return decoder_->Configure(settings);
     }
@@ -37,6 +37,8 @@ static std::string CodecTypeToHistogramSuffix(VideoCodecType codec) {
       return "H264";
     case kVideoCodecH265:
       return "H265";
+    case kVideoCodecH266:
+      return "H266";
     case kVideoCodecGeneric:
       return "Generic";
     case kVideoCodecMultiplex:
@@ -279,6 +281,8 @@ INSTANTIATE_TEST_SUITE_P(
                           {VideoCodecType::kVideoCodecH264, false},
                           {VideoCodecType::kVideoCodecH264, true},
                           {VideoCodecType::kVideoCodecH265, false},
-                          {VideoCodecType::kVideoCodecH265, true}}));
+                          {VideoCodecType::kVideoCodecH265, true},
+                          {VideoCodecType::kVideoCodecH266, false},
+                          {VideoCodecType::kVideoCodecH266, true}}));
 
 }  // namespace webrtc
@@ -26,6 +26,7 @@
 #include "test/gmock.h"
 #include "test/gtest.h"
 #include "test/rtcp_packet_parser.h"
+#include "test/scoped_key_value_config.h"
 #include "test/video_test_constants.h"
 
 using ::testing::Contains;
@@ -363,6 +364,14 @@ TEST_F(FecEndToEndTest, RecoversWithFlexfecAndSendsCorrespondingRtcp) {
   RunBaseTest(&test);
 }
 
+TEST_F(FecEndToEndTest, RecoversWithReedSolomonFec) {
+  // Reed-Solomon FEC is sent and received in place of FlexFEC.
+  test::ScopedKeyValueConfig field_trials(field_trials_,
+                                          "WebRTC-ReedSolomonFec/Enabled/");
+  FlexfecRenderObserver test(false, false);
+  RunBaseTest(&test);
+}
+
 TEST_F(FecEndToEndTest, ReceivedUlpfecPacketsNotNacked) {
   class UlpfecNackObserver : public test::EndToEndTest {
    public:
@@ -70,7 +70,10 @@ int32_t FrameDumpingDecoder::Release() {
 }
 
 VideoDecoder::DecoderInfo FrameDumpingDecoder::GetDecoderInfo() const {
-  return decoder_->GetDecoderInfo();
+  DecoderInfo info = decoder_->GetDecoderInfo();
+  // Only complete frames are written to the dump.
+  info.supports_frame_parts = false;
+  return info;
 }
 
 const char* FrameDumpingDecoder::ImplementationName() const {
@@ -139,14 +139,68 @@ void FrameEncodeMetadataWriter::OnEncodeStarted(const VideoFrame& frame) {
 void FrameEncodeMetadataWriter::FillTimingInfo(size_t simulcast_svc_idx,
                                                EncodedImage* encoded_image) {
   MutexLock lock(&lock_);
-  absl::optional<size_t> outlier_frame_size;
-  absl::optional<int64_t> encode_start_ms;
-  uint8_t timing_flags = VideoSendTiming::kNotTriggered;
+  int64_t encode_done_ms = rtc::TimeMillis();
 
+  absl::optional<int64_t> encode_start_ms =
+      ExtractEncodeStartTimeAndFillMetadata(
+          simulcast_svc_idx, /*keep_metadata=*/false, encoded_image);
+
+  if (simulcast_svc_idx < images_in_parts_.size()) {
+    absl::optional<ImageInParts> image_in_parts =
+        std::exchange(images_in_parts_[simulcast_svc_idx], absl::nullopt);
+    if (image_in_parts &&
+        image_in_parts->rtp_timestamp == encoded_image->RtpTimestamp() &&
+        image_in_parts->timing) {
+      // Timing was decided when the last part was sent, keep it consistent.
+      encoded_image->timing_ = *image_in_parts->timing;
+      return;
+    }
+  }
+
+  FillTiming(simulcast_svc_idx, encode_start_ms, encode_done_ms,
+             encoded_image->size(), encoded_image);
+}
+
+void FrameEncodeMetadataWriter::FillPartTimingInfo(size_t simulcast_svc_idx,
+                                                   EncodedImage* encoded_part,
+                                                   bool last_part) {
+  MutexLock lock(&lock_);
   int64_t encode_done_ms = rtc::TimeMillis();
 
-  encode_start_ms =
-      ExtractEncodeStartTimeAndFillMetadata(simulcast_svc_idx, encoded_image);
+  // The metadata is still needed by the following parts and by the complete
+  // image.
+  absl::optional<int64_t> encode_start_ms =
+      ExtractEncodeStartTimeAndFillMetadata(
+          simulcast_svc_idx, /*keep_metadata=*/true, encoded_part);
+
+  if (images_in_parts_.size() <= simulcast_svc_idx)
+    images_in_parts_.resize(simulcast_svc_idx + 1);
+  absl::optional<ImageInParts>& image_in_parts =
+      images_in_parts_[simulcast_svc_idx];
+  if (!image_in_parts ||
+      image_in_parts->rtp_timestamp != encoded_part->RtpTimestamp()) {
+    image_in_parts.emplace();
+    image_in_parts->rtp_timestamp = encoded_part->RtpTimestamp();
+  }
+  image_in_parts->size += encoded_part->size();
+
+  if (!last_part) {
+    encoded_part->timing_.flags = VideoSendTiming::kInvalid;
+    return;
+  }
+  FillTiming(simulcast_svc_idx, encode_start_ms, encode_done_ms,
+             image_in_parts->size, encoded_part);
+  image_in_parts->timing = encoded_part->timing_;
+}
+
+void FrameEncodeMetadataWriter::FillTiming(
+    size_t simulcast_svc_idx,
+    absl::optional<int64_t> encode_start_ms,
+    int64_t encode_done_ms,
+    size_t frame_size,
+    EncodedImage* encoded_image) {
+  absl::optional<size_t> outlier_frame_size;
+  uint8_t timing_flags = VideoSendTiming::kNotTriggered;
 
   if (timing_frames_info_.size() > simulcast_svc_idx) {
     size_t target_bitrate =
@@ -162,7 +216,7 @@ void FrameEncodeMetadataWriter::FillTimingInfo(size_t simulcast_svc_idx,
 
   // Outliers trigger timing frames, but do not affect scheduled timing
   // frames.
-  if (outlier_frame_size && encoded_image->size() >= *outlier_frame_size) {
+  if (outlier_frame_size && frame_size >= *outlier_frame_size) {
     timing_flags |= VideoSendTiming::kTriggeredBySize;
   }
 
@@ -218,6 +272,7 @@ void FrameEncodeMetadataWriter::Reset() {
   for (auto& info : timing_frames_info_) {
     info.frames.clear();
   }
+  images_in_parts_.clear();
   last_timing_frame_time_ms_ = -1;
   reordered_frames_logged_messages_ = 0;
   stalled_encoder_logged_messages_ = 0;
@@ -226,6 +281,7 @@ void FrameEncodeMetadataWriter::Reset() {
 absl::optional<int64_t>
 FrameEncodeMetadataWriter::ExtractEncodeStartTimeAndFillMetadata(
     size_t simulcast_svc_idx,
+    bool keep_metadata,
     EncodedImage* encoded_image) {
   absl::optional<int64_t> result;
   size_t num_simulcast_svc_streams = timing_frames_info_.size();
@@ -257,7 +313,8 @@ FrameEncodeMetadataWriter::ExtractEncodeStartTimeAndFillMetadata(
       encoded_image->rotation_ = metadata_list->front().rotation;
       encoded_image->SetColorSpace(metadata_list->front().color_space);
       encoded_image->SetPacketInfos(metadata_list->front().packet_infos);
-      metadata_list->pop_front();
+      if (!keep_metadata)
+        metadata_list->pop_front();
     } else {
       ++reordered_frames_logged_messages_;
       if (reordered_frames_logged_messages_ <= kMessagesThrottlingThreshold ||
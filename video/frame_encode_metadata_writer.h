@@ -35,6 +35,14 @@ class FrameEncodeMetadataWriter {
   void OnEncodeStarted(const VideoFrame& frame);
 
   void FillTimingInfo(size_t simulcast_svc_idx, EncodedImage* encoded_image);
+  // Like FillTimingInfo(), for a part of an image that is sent before the
+  // encoder has finished the complete image. Every part gets the frame
+  // metadata. Timing is only known once the whole image is encoded, so it is
+  // set on the last part only, and reused when the complete image is passed
+  // to FillTimingInfo().
+  void FillPartTimingInfo(size_t simulcast_svc_idx,
+                          EncodedImage* encoded_part,
+                          bool last_part);
 
   void UpdateBitstream(const CodecSpecificInfo* codec_specific_info,
                        EncodedImage* encoded_image);
@@ -43,11 +51,22 @@ class FrameEncodeMetadataWriter {
 
  private:
   // For non-internal-source encoders, returns encode started time and fixes
-  // capture timestamp for the frame, if corrupted by the encoder.
+  // capture timestamp for the frame, if corrupted by the encoder. The
+  // recorded metadata is consumed unless `keep_metadata` is set, which is
+  // used for parts of an image.
   absl::optional<int64_t> ExtractEncodeStartTimeAndFillMetadata(
       size_t simulcast_svc_idx,
+      bool keep_metadata,
       EncodedImage* encoded_image) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Sets the timing of `encoded_image`, whose complete size is `frame_size`.
+  void FillTiming(size_t simulcast_svc_idx,
+                  absl::optional<int64_t> encode_start_ms,
+                  int64_t encode_done_ms,
+                  size_t frame_size,
+                  EncodedImage* encoded_image)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   struct FrameMetadata {
     uint32_t rtp_timestamp;
     int64_t encode_start_time_ms;
@@ -63,6 +82,13 @@ class FrameEncodeMetadataWriter {
     size_t target_bitrate_bytes_per_sec = 0;
     std::list<FrameMetadata> frames;
   };
+  // Image whose parts are being passed to FillPartTimingInfo().
+  struct ImageInParts {
+    uint32_t rtp_timestamp;
+    size_t size = 0;
+    // Set once the last part has been seen.
+    absl::optional<EncodedImage::Timing> timing;
+  };
 
   Mutex lock_;
   EncodedImageCallback* const frame_drop_callback_;
@@ -72,6 +98,8 @@ class FrameEncodeMetadataWriter {
   size_t num_spatial_layers_ RTC_GUARDED_BY(&lock_);
   // Separate instance for each simulcast stream or spatial layer.
   std::vector<TimingFramesLayerInfo> timing_frames_info_ RTC_GUARDED_BY(&lock_);
+  std::vector<absl::optional<ImageInParts>> images_in_parts_
+      RTC_GUARDED_BY(&lock_);
   int64_t last_timing_frame_time_ms_ RTC_GUARDED_BY(&lock_);
   size_t reordered_frames_logged_messages_ RTC_GUARDED_BY(&lock_);
   size_t stalled_encoder_logged_messages_ RTC_GUARDED_BY(&lock_);
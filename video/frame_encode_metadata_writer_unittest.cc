@@ -228,6 +228,90 @@ TEST(FrameEncodeMetadataWriterTest, NoTimingFrameIfNoEncodeStartTime) {
   EXPECT_FALSE(IsTimingFrame(image));
 }
 
+TEST(FrameEncodeMetadataWriterTest, FillsPartsAndKeepsTimingForImage) {
+  const int64_t kTimestampMs = 123456;
+  constexpr size_t kPartSize = 100;
+  FakeEncodedImageCallback sink;
+  FrameEncodeMetadataWriter encode_timer(&sink);
+  encode_timer.OnEncoderInit(VideoCodec());
+  // Any non-zero bitrate needed to be set before the first frame.
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, 500000);
+  encode_timer.OnSetRates(bitrate_allocation, 30);
+
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_timestamp_ms(kTimestampMs)
+                         .set_timestamp_rtp(kTimestampMs * 90)
+                         .set_rotation(kVideoRotation_180)
+                         .set_video_frame_buffer(kFrameBuffer)
+                         .build();
+  encode_timer.OnEncodeStarted(frame);
+
+  EncodedImage part;
+  part.SetEncodedData(EncodedImageBuffer::Create(kPartSize));
+  part.SetRtpTimestamp(static_cast<uint32_t>(kTimestampMs * 90));
+  encode_timer.FillPartTimingInfo(0, &part, /*last_part=*/false);
+  // Metadata is known from the first part, timing only once the image is
+  // complete.
+  EXPECT_EQ(part.capture_time_ms_, kTimestampMs);
+  EXPECT_EQ(part.rotation_, kVideoRotation_180);
+  EXPECT_FALSE(IsTimingFrame(part));
+
+  part.timing_ = EncodedImage::Timing();
+  part.capture_time_ms_ = 0;
+  encode_timer.FillPartTimingInfo(0, &part, /*last_part=*/true);
+  EXPECT_EQ(part.capture_time_ms_, kTimestampMs);
+  EXPECT_TRUE(IsTimingFrame(part));
+
+  EncodedImage image;
+  image.SetEncodedData(EncodedImageBuffer::Create(2 * kPartSize));
+  image.SetRtpTimestamp(static_cast<uint32_t>(kTimestampMs * 90));
+  encode_timer.FillTimingInfo(0, &image);
+  EXPECT_EQ(image.capture_time_ms_, kTimestampMs);
+  EXPECT_EQ(image.rotation_, kVideoRotation_180);
+  EXPECT_EQ(image.timing_.flags, part.timing_.flags);
+  EXPECT_EQ(image.timing_.encode_finish_ms, part.timing_.encode_finish_ms);
+  EXPECT_EQ(sink.GetNumFramesDropped(), 0u);
+}
+
+TEST(FrameEncodeMetadataWriterTest, MarksOutlierSentInParts) {
+  const int64_t kTimestampMs = 123456;
+  FakeEncodedImageCallback sink;
+  FrameEncodeMetadataWriter encode_timer(&sink);
+  VideoCodec codec_settings;
+  codec_settings.timing_frame_thresholds = {/*delay_ms=*/100000,
+                                            kDefaultOutlierFrameSizePercent};
+  encode_timer.OnEncoderInit(codec_settings);
+  VideoBitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, 8 * 30 * 1000);
+  encode_timer.OnSetRates(bitrate_allocation, 30);
+  // The average frame is 1000 bytes, the outlier threshold 5000 bytes.
+  constexpr size_t kPartSize = 3000;
+
+  for (int64_t timestamp_ms : {kTimestampMs, kTimestampMs + 1}) {
+    VideoFrame frame = VideoFrame::Builder()
+                           .set_timestamp_ms(timestamp_ms)
+                           .set_timestamp_rtp(timestamp_ms * 90)
+                           .set_video_frame_buffer(kFrameBuffer)
+                           .build();
+    encode_timer.OnEncodeStarted(frame);
+  }
+  // The first frame is a timing frame because of the timer.
+  EncodedImage image;
+  image.SetEncodedData(EncodedImageBuffer::Create(1000));
+  image.SetRtpTimestamp(static_cast<uint32_t>(kTimestampMs * 90));
+  encode_timer.FillTimingInfo(0, &image);
+  EXPECT_EQ(image.timing_.flags, VideoSendTiming::kTriggeredByTimer);
+
+  // Neither part is an outlier on its own, but the image is.
+  EncodedImage part;
+  part.SetEncodedData(EncodedImageBuffer::Create(kPartSize));
+  part.SetRtpTimestamp(static_cast<uint32_t>((kTimestampMs + 1) * 90));
+  encode_timer.FillPartTimingInfo(0, &part, /*last_part=*/false);
+  encode_timer.FillPartTimingInfo(0, &part, /*last_part=*/true);
+  EXPECT_EQ(part.timing_.flags, VideoSendTiming::kTriggeredBySize);
+}
+
 TEST(FrameEncodeMetadataWriterTest, NotifiesAboutDroppedFrames) {
   const int64_t kTimestampMs1 = 47721840;
   const int64_t kTimestampMs2 = 47721850;
@@ -537,11 +537,11 @@ RtpVideoStreamReceiver2::ParseGenericDependenciesExtension(
 void RtpVideoStreamReceiver2::OnReceivedPayloadData(
     rtc::CopyOnWriteBuffer codec_payload,
     const RtpPacketReceived& rtp_packet,
-    const RTPVideoHeader& video) {
+    RTPVideoHeader video) {
   RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
 
-  auto packet =
-      std::make_unique<video_coding::PacketBuffer::Packet>(rtp_packet, video);
+  auto packet = std::make_unique<video_coding::PacketBuffer::Packet>(
+      rtp_packet, std::move(video));
 
   int64_t unwrapped_rtp_seq_num =
       rtp_seq_num_unwrapper_.Unwrap(rtp_packet.SequenceNumber());
@@ -703,6 +703,26 @@ void RtpVideoStreamReceiver2::OnReceivedPayloadData(
 
   rtcp_feedback_buffer_.SendBufferedRtcpFeedback();
   frame_counter_.Add(packet->timestamp);
+#ifdef RTC_ENABLE_H265
+  if (packet->codec() == kVideoCodecH265) {
+    if (!h265_packet_buffer_) {
+      h265_packet_buffer_ = std::make_unique<H265PacketBuffer>(
+          /*irap_only_keyframes_allowed=*/true);
+    }
+    OnInsertedPacket(h265_packet_buffer_->InsertPacket(std::move(packet)));
+    return;
+  }
+#endif
+#ifdef RTC_ENABLE_H266
+  if (packet->codec() == kVideoCodecH266) {
+    if (!h266_packet_buffer_) {
+      h266_packet_buffer_ = std::make_unique<H266PacketBuffer>(
+          /*irap_only_keyframes_allowed=*/true);
+    }
+    OnInsertedPacket(h266_packet_buffer_->InsertPacket(std::move(packet)));
+    return;
+  }
+#endif
   OnInsertedPacket(packet_buffer_.InsertPacket(std::move(packet)));
 }
 
@@ -806,6 +826,11 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
 
     frame_boundary = packet->is_last_packet_in_frame();
     if (packet->is_last_packet_in_frame()) {
+      if (!last_frame_end_ ||
+          AheadOf(packet->seq_num, last_frame_end_->seq_num)) {
+        last_frame_end_ = {.seq_num = packet->seq_num,
+                           .rtp_timestamp = packet->timestamp};
+      }
       auto depacketizer_it = payload_type_map_.find(first_packet->payload_type);
       RTC_CHECK(depacketizer_it != payload_type_map_.end());
 
@@ -845,8 +870,66 @@ void RtpVideoStreamReceiver2::OnInsertedPacket(
     last_received_keyframe_rtp_system_time_.reset();
     last_received_keyframe_rtp_timestamp_.reset();
     packet_infos_.clear();
+    last_frame_end_.reset();
     RequestKeyFrame();
   }
+  MaybeDeliverFrameParts();
+}
+
+void RtpVideoStreamReceiver2::MaybeDeliverFrameParts() {
+  if (!config_.enable_frame_part_decoding || !last_frame_end_ ||
+      buffered_frame_decryptor_ || frame_transformer_delegate_) {
+    return;
+  }
+  MaybeDeliverFramePart(packet_buffer_.FindNextFramePart());
+#ifdef RTC_ENABLE_H265
+  if (h265_packet_buffer_) {
+    MaybeDeliverFramePart(h265_packet_buffer_->FindNextFramePart());
+  }
+#endif
+#ifdef RTC_ENABLE_H266
+  if (h266_packet_buffer_) {
+    MaybeDeliverFramePart(h266_packet_buffer_->FindNextFramePart());
+  }
+#endif
+}
+
+void RtpVideoStreamReceiver2::MaybeDeliverFramePart(
+    video_coding::PacketBuffer::FramePart frame_part) {
+  // The part follows the newest frame of its packet buffer, which is only the
+  // newest frame of the stream if no other packet buffer returned a newer one.
+  if (frame_part.packets.empty() ||
+      !AheadOf(frame_part.packets.front()->seq_num, last_frame_end_->seq_num)) {
+    return;
+  }
+  const video_coding::PacketBuffer::Packet& first_packet =
+      *frame_part.packets.front();
+  auto depacketizer_it = payload_type_map_.find(first_packet.payload_type);
+  if (depacketizer_it == payload_type_map_.end()) {
+    return;
+  }
+  std::vector<rtc::ArrayView<const uint8_t>> payloads;
+  bool is_keyframe = false;
+  for (const video_coding::PacketBuffer::Packet* packet : frame_part.packets) {
+    payloads.emplace_back(packet->video_payload);
+    is_keyframe |=
+        packet->video_header.frame_type == VideoFrameType::kVideoFrameKey;
+  }
+  rtc::scoped_refptr<EncodedImageBuffer> bitstream =
+      depacketizer_it->second->AssembleFrame(payloads);
+  if (!bitstream) {
+    return;
+  }
+
+  OnCompleteFrameCallback::FramePart part;
+  part.image.SetEncodedData(std::move(bitstream));
+  part.image.SetRtpTimestamp(first_packet.timestamp);
+  part.image._frameType = is_keyframe ? VideoFrameType::kVideoFrameKey
+                                      : VideoFrameType::kVideoFrameDelta;
+  part.payload_type = first_packet.payload_type;
+  part.first_part = frame_part.first_part;
+  part.previous_frame_rtp_timestamp = last_frame_end_->rtp_timestamp;
+  complete_frame_callback_->OnFramePart(std::move(part));
 }
 
 void RtpVideoStreamReceiver2::OnAssembledFrame(
@@ -1099,7 +1182,7 @@ void RtpVideoStreamReceiver2::ReceivePacket(const RtpPacketReceived& packet) {
   }
 
   OnReceivedPayloadData(std::move(parsed_payload->video_payload), packet,
-                        parsed_payload->video_header);
+                        std::move(parsed_payload->video_header));
 }
 
 void RtpVideoStreamReceiver2::ParseAndHandleEncapsulatingHeader(
@@ -1130,6 +1213,16 @@ void RtpVideoStreamReceiver2::NotifyReceiverOfEmptyPacket(uint16_t seq_num) {
   OnCompleteFrames(reference_finder_->PaddingReceived(seq_num));
 
   OnInsertedPacket(packet_buffer_.InsertPadding(seq_num));
+#ifdef RTC_ENABLE_H265
+  if (h265_packet_buffer_) {
+    OnInsertedPacket(h265_packet_buffer_->InsertPadding(seq_num));
+  }
+#endif
+#ifdef RTC_ENABLE_H266
+  if (h266_packet_buffer_) {
+    OnInsertedPacket(h266_packet_buffer_->InsertPadding(seq_num));
+  }
+#endif
   if (nack_module_) {
     nack_module_->OnReceivedPacket(seq_num, /* is_keyframe = */ false,
                                    /* is _recovered = */ false);
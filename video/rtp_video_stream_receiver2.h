@@ -21,6 +21,7 @@
 #include "api/sequence_checker.h"
 #include "api/units/timestamp.h"
 #include "api/video/color_space.h"
+#include "api/video/encoded_image.h"
 #include "api/video/video_codec_type.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
@@ -50,6 +51,13 @@
 #include "video/buffered_frame_decryptor.h"
 #include "video/unique_timestamp_counter.h"
 
+#ifdef RTC_ENABLE_H265
+#include "modules/video_coding/h265_packet_buffer.h"
+#endif
+#ifdef RTC_ENABLE_H266
+#include "modules/video_coding/h266_packet_buffer.h"
+#endif
+
 namespace webrtc {
 
 class NackRequester;
@@ -73,8 +81,20 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
   // references are known.
   class OnCompleteFrameCallback {
    public:
+    // The leading part of a frame that is still incomplete, see
+    // `VideoReceiveStreamInterface::Config::enable_frame_part_decoding`.
+    struct FramePart {
+      // Only holds the data received since the previous part of the frame.
+      EncodedImage image;
+      uint8_t payload_type;
+      bool first_part;
+      // RTP timestamp of the frame that precedes this one in the stream.
+      uint32_t previous_frame_rtp_timestamp;
+    };
+
     virtual ~OnCompleteFrameCallback() {}
     virtual void OnCompleteFrame(std::unique_ptr<EncodedFrame> frame) = 0;
+    virtual void OnFramePart(FramePart part) {}
   };
 
   RtpVideoStreamReceiver2(
@@ -135,7 +155,7 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
   // Public only for tests.
   void OnReceivedPayloadData(rtc::CopyOnWriteBuffer codec_payload,
                              const RtpPacketReceived& rtp_packet,
-                             const RTPVideoHeader& video);
+                             RTPVideoHeader video);
 
   // Implements RecoveredPacketReceiver.
   void OnRecoveredPacket(const RtpPacketReceived& packet) override;
@@ -300,6 +320,11 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
       RTC_RUN_ON(packet_sequence_checker_);
   void OnInsertedPacket(video_coding::PacketBuffer::InsertResult result)
       RTC_RUN_ON(packet_sequence_checker_);
+  // Passes the leading parts of the next frame that have become decodable
+  // since the last call to `complete_frame_callback_`.
+  void MaybeDeliverFrameParts() RTC_RUN_ON(packet_sequence_checker_);
+  void MaybeDeliverFramePart(video_coding::PacketBuffer::FramePart frame_part)
+      RTC_RUN_ON(packet_sequence_checker_);
   ParseGenericDependenciesResult ParseGenericDependenciesExtension(
       const RtpPacketReceived& rtp_packet,
       RTPVideoHeader* video_header) RTC_RUN_ON(packet_sequence_checker_);
@@ -357,6 +382,17 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
 
   video_coding::PacketBuffer packet_buffer_
       RTC_GUARDED_BY(packet_sequence_checker_);
+#ifdef RTC_ENABLE_H265
+  // H265 frames are delimited by RTP timestamp and marker bit rather than by
+  // `packet_buffer_`. Created when the first H265 packet arrives.
+  std::unique_ptr<H265PacketBuffer> h265_packet_buffer_
+      RTC_GUARDED_BY(packet_sequence_checker_);
+#endif
+#ifdef RTC_ENABLE_H266
+  // Same as `h265_packet_buffer_`, for H266.
+  std::unique_ptr<H266PacketBuffer> h266_packet_buffer_
+      RTC_GUARDED_BY(packet_sequence_checker_);
+#endif
   UniqueTimestampCounter frame_counter_
       RTC_GUARDED_BY(packet_sequence_checker_);
   SeqNumUnwrapper<uint16_t> frame_id_unwrapper_
@@ -381,6 +417,14 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
   uint32_t last_assembled_frame_rtp_timestamp_
       RTC_GUARDED_BY(packet_sequence_checker_);
 
+  // The newest frame, by sequence number, returned by a packet buffer.
+  struct FrameEnd {
+    uint16_t seq_num;
+    uint32_t rtp_timestamp;
+  };
+  absl::optional<FrameEnd> last_frame_end_
+      RTC_GUARDED_BY(packet_sequence_checker_);
+
   std::map<int64_t, uint16_t> last_seq_num_for_pic_id_
       RTC_GUARDED_BY(packet_sequence_checker_);
   video_coding::H264SpsPpsTracker tracker_
@@ -96,6 +96,7 @@ class MockOnCompleteFrameCallback
   MOCK_METHOD(void, DoOnCompleteFrameFailNullptr, (EncodedFrame*), ());
   MOCK_METHOD(void, DoOnCompleteFrameFailLength, (EncodedFrame*), ());
   MOCK_METHOD(void, DoOnCompleteFrameFailBitstream, (EncodedFrame*), ());
+  MOCK_METHOD(void, OnFramePart, (FramePart), (override));
   void OnCompleteFrame(std::unique_ptr<EncodedFrame> frame) override {
     if (!frame) {
       DoOnCompleteFrameFailNullptr(nullptr);
@@ -679,6 +680,147 @@ TEST_P(RtpVideoStreamReceiver2TestH264, ForceSpsPpsIdrIsKeyframe) {
                                                     idr_video_header);
 }
 
+class RtpVideoStreamReceiver2FramePartTest
+    : public RtpVideoStreamReceiver2Test {
+ protected:
+  static constexpr int kH264PayloadType = 99;
+
+  RtpVideoStreamReceiver2FramePartTest() {
+    config_.enable_frame_part_decoding = true;
+    // Example parameter sets from
+    // https://tools.ietf.org/html/rfc3984#section-8.2.
+    rtp_video_stream_receiver_->AddReceiveCodec(
+        kH264PayloadType, kVideoCodecH264,
+        {{cricket::kH264FmtpSpropParameterSets, "Z0IACpZTBYmI,aMljiA=="}},
+        /*raw_payload=*/false);
+  }
+
+  void InsertKeyFrame(uint16_t seq_num, uint32_t rtp_timestamp) {
+    const uint8_t binary_sps[] = {0x67, 0x42, 0x00, 0x0a, 0x96,
+                                  0x53, 0x05, 0x89, 0x88};
+    const uint8_t binary_pps[] = {0x68, 0xc9, 0x63, 0x88};
+    const uint8_t idr[] = {0x65, 1, 2};
+    rtc::CopyOnWriteBuffer data(idr);
+    mock_on_complete_frame_callback_.ClearExpectedBitstream();
+    for (rtc::ArrayView<const uint8_t> nalu :
+         {rtc::ArrayView<const uint8_t>(binary_sps),
+          rtc::ArrayView<const uint8_t>(binary_pps),
+          rtc::ArrayView<const uint8_t>(data.cdata(), data.size())}) {
+      mock_on_complete_frame_callback_.AppendExpectedBitstream(
+          kH264StartCode, sizeof(kH264StartCode));
+      mock_on_complete_frame_callback_.AppendExpectedBitstream(nalu.data(),
+                                                               nalu.size());
+    }
+
+    RtpPacketReceived rtp_packet;
+    rtp_packet.SetPayloadType(kH264PayloadType);
+    rtp_packet.SetSequenceNumber(seq_num);
+    rtp_packet.SetTimestamp(rtp_timestamp);
+    RTPVideoHeader video_header = GetDefaultH264VideoHeader();
+    AddIdr(&video_header, 0);
+    video_header.is_first_packet_in_frame = true;
+    video_header.is_last_packet_in_frame = true;
+    video_header.frame_type = VideoFrameType::kVideoFrameKey;
+    EXPECT_CALL(mock_on_complete_frame_callback_, DoOnCompleteFrame);
+    rtp_video_stream_receiver_->OnReceivedPayloadData(data, rtp_packet,
+                                                      video_header);
+  }
+
+  void InsertSlice(const rtc::CopyOnWriteBuffer& data,
+                   uint16_t seq_num,
+                   uint32_t rtp_timestamp,
+                   bool last_packet) {
+    RtpPacketReceived rtp_packet;
+    rtp_packet.SetPayloadType(kH264PayloadType);
+    rtp_packet.SetSequenceNumber(seq_num);
+    rtp_packet.SetTimestamp(rtp_timestamp);
+    rtp_packet.SetMarker(last_packet);
+    RTPVideoHeader video_header = GetDefaultH264VideoHeader();
+    auto& h264 = absl::get<RTPVideoHeaderH264>(video_header.video_type_header);
+    h264.nalus[h264.nalus_length++] = {.type = H264::NaluType::kSlice,
+                                       .sps_id = -1,
+                                       .pps_id = 0};
+    // Set for every single NAL unit packet by the H.264 depacketizer.
+    video_header.is_first_packet_in_frame = true;
+    video_header.is_last_packet_in_frame = last_packet;
+    video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+    rtp_video_stream_receiver_->OnReceivedPayloadData(data, rtp_packet,
+                                                      video_header);
+  }
+};
+
+TEST_F(RtpVideoStreamReceiver2FramePartTest,
+       DeliversLeadingSlicesOfIncompleteFrame) {
+  rtp_video_stream_receiver_->StartReceive();
+  InsertKeyFrame(/*seq_num=*/10, /*rtp_timestamp=*/1000);
+
+  const uint8_t slices[][2] = {{0x41, 1}, {0x41, 2}, {0x41, 3}};
+  EXPECT_CALL(mock_on_complete_frame_callback_, OnFramePart)
+      .WillOnce([&](const RtpVideoStreamReceiver2::OnCompleteFrameCallback::
+                        FramePart& part) {
+        EXPECT_TRUE(part.first_part);
+        EXPECT_EQ(part.previous_frame_rtp_timestamp, 1000u);
+        EXPECT_EQ(part.payload_type, kH264PayloadType);
+        EXPECT_EQ(part.image.RtpTimestamp(), 4000u);
+        EXPECT_EQ(part.image.size(), sizeof(kH264StartCode) + 2);
+      })
+      .WillOnce([&](const RtpVideoStreamReceiver2::OnCompleteFrameCallback::
+                        FramePart& part) {
+        EXPECT_FALSE(part.first_part);
+        EXPECT_EQ(part.image.size(), sizeof(kH264StartCode) + 2);
+      });
+  InsertSlice(rtc::CopyOnWriteBuffer(slices[0]), /*seq_num=*/11,
+              /*rtp_timestamp=*/4000, /*last_packet=*/false);
+  InsertSlice(rtc::CopyOnWriteBuffer(slices[1]), /*seq_num=*/12,
+              /*rtp_timestamp=*/4000, /*last_packet=*/false);
+
+  mock_on_complete_frame_callback_.ClearExpectedBitstream();
+  for (const auto& slice : slices) {
+    mock_on_complete_frame_callback_.AppendExpectedBitstream(
+        kH264StartCode, sizeof(kH264StartCode));
+    mock_on_complete_frame_callback_.AppendExpectedBitstream(slice,
+                                                             sizeof(slice));
+  }
+  EXPECT_CALL(mock_on_complete_frame_callback_, DoOnCompleteFrame);
+  InsertSlice(rtc::CopyOnWriteBuffer(slices[2]), /*seq_num=*/13,
+              /*rtp_timestamp=*/4000, /*last_packet=*/true);
+}
+
+TEST_F(RtpVideoStreamReceiver2FramePartTest, DeliversPartAfterPadding) {
+  rtp_video_stream_receiver_->StartReceive();
+  InsertKeyFrame(/*seq_num=*/10, /*rtp_timestamp=*/1000);
+
+  const uint8_t slice[] = {0x41, 1};
+  EXPECT_CALL(mock_on_complete_frame_callback_, OnFramePart).Times(0);
+  InsertSlice(rtc::CopyOnWriteBuffer(slice), /*seq_num=*/12,
+              /*rtp_timestamp=*/4000, /*last_packet=*/false);
+  testing::Mock::VerifyAndClearExpectations(&mock_on_complete_frame_callback_);
+
+  EXPECT_CALL(mock_on_complete_frame_callback_, OnFramePart)
+      .WillOnce([&](const RtpVideoStreamReceiver2::OnCompleteFrameCallback::
+                        FramePart& part) {
+        EXPECT_TRUE(part.first_part);
+        EXPECT_EQ(part.image.RtpTimestamp(), 4000u);
+      });
+  RtpPacketReceived padding;
+  padding.SetPayloadType(kH264PayloadType);
+  padding.SetSequenceNumber(11);
+  padding.SetTimestamp(1000);
+  rtp_video_stream_receiver_->OnReceivedPayloadData(
+      {}, padding, GetDefaultH264VideoHeader());
+}
+
+TEST_F(RtpVideoStreamReceiver2FramePartTest, NoPartsWhenDisabled) {
+  config_.enable_frame_part_decoding = false;
+  rtp_video_stream_receiver_->StartReceive();
+  InsertKeyFrame(/*seq_num=*/10, /*rtp_timestamp=*/1000);
+
+  EXPECT_CALL(mock_on_complete_frame_callback_, OnFramePart).Times(0);
+  const uint8_t slice[] = {0x41, 1};
+  InsertSlice(rtc::CopyOnWriteBuffer(slice), /*seq_num=*/11,
+              /*rtp_timestamp=*/4000, /*last_packet=*/false);
+}
+
 TEST_F(RtpVideoStreamReceiver2Test, PaddingInMediaStream) {
   RtpPacketReceived rtp_packet;
   RTPVideoHeader video_header = GetDefaultH264VideoHeader();
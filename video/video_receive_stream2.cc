@@ -358,6 +358,7 @@ void VideoReceiveStream2::Start() {
     settings.set_max_render_resolution(
         InitialDecoderResolution(call_->trials()));
     settings.set_number_of_cores(num_cpu_cores_);
+    settings.set_frame_parts_enabled(config_.enable_frame_part_decoding);
 
     const bool raw_payload =
         config_.rtp.raw_payload_types.count(decoder.payload_type) > 0;
@@ -373,7 +374,8 @@ void VideoReceiveStream2::Start() {
 
   RTC_DCHECK(renderer != nullptr);
   video_stream_decoder_.reset(
-      new VideoStreamDecoder(&video_receiver_, &stats_proxy_, renderer));
+      new VideoStreamDecoder(&video_receiver_, &stats_proxy_, renderer,
+                             config_.timing_frame_info_observer));
 
   // Make sure we register as a stats observer *after* we've prepared the
   // `video_stream_decoder_`.
@@ -706,6 +708,40 @@ void VideoReceiveStream2::OnCompleteFrame(std::unique_ptr<EncodedFrame> frame) {
   }
 }
 
+void VideoReceiveStream2::OnFramePart(FramePart part) {
+  RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
+  // Decoding ahead of the rest of the frame only pays off if the frame is
+  // decoded as soon as it is complete.
+  if (!timing_->min_playout_delay().IsZero() ||
+      frame_maximum_playout_delay_ != TimeDelta::Zero()) {
+    return;
+  }
+
+  // TODO(bugs.webrtc.org/11993): Call on the network thread.
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
+  if (part.first_part) {
+    frame_in_parts_rtp_timestamp_.reset();
+    // The decoder must already have been given the frame that precedes this
+    // one, otherwise the part would be decoded out of order.
+    if (last_released_frame_rtp_timestamp_ !=
+            part.previous_frame_rtp_timestamp ||
+        (keyframe_required_ &&
+         part.image.FrameType() != VideoFrameType::kVideoFrameKey)) {
+      return;
+    }
+    frame_in_parts_rtp_timestamp_ = part.image.RtpTimestamp();
+  } else if (frame_in_parts_rtp_timestamp_ != part.image.RtpTimestamp()) {
+    return;
+  }
+
+  decode_queue_.PostTask([this, part = std::move(part)] {
+    RTC_DCHECK_RUN_ON(&decode_queue_);
+    if (decoder_stopped_)
+      return;
+    video_receiver_.DecodePart(part.image, part.payload_type);
+  });
+}
+
 void VideoReceiveStream2::OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   // TODO(bugs.webrtc.org/13757): Replace with TimeDelta.
@@ -768,6 +804,7 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
     }
   }
   stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
+  last_released_frame_rtp_timestamp_ = frame->RtpTimestamp();
 
   decode_queue_.PostTask([this, now, keyframe_request_is_due,
                           received_frame_is_keyframe, frame = std::move(frame),
@@ -175,6 +175,7 @@ class VideoReceiveStream2
 
   // Implements RtpVideoStreamReceiver2::OnCompleteFrameCallback.
   void OnCompleteFrame(std::unique_ptr<EncodedFrame> frame) override;
+  void OnFramePart(FramePart part) override;
 
   // Implements CallStatsObserver::OnRttUpdate
   void OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) override;
@@ -305,6 +306,13 @@ class VideoReceiveStream2
   absl::optional<Timestamp> last_keyframe_request_
       RTC_GUARDED_BY(packet_sequence_checker_);
 
+  // RTP timestamp of the newest frame released for decoding, and of the frame
+  // of which leading parts are being decoded.
+  absl::optional<uint32_t> last_released_frame_rtp_timestamp_
+      RTC_GUARDED_BY(packet_sequence_checker_);
+  absl::optional<uint32_t> frame_in_parts_rtp_timestamp_
+      RTC_GUARDED_BY(packet_sequence_checker_);
+
   // Keyframe request intervals are configurable through field trials.
   TimeDelta max_wait_for_keyframe_ RTC_GUARDED_BY(packet_sequence_checker_);
   TimeDelta max_wait_for_frame_ RTC_GUARDED_BY(packet_sequence_checker_);
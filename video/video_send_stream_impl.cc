@@ -560,6 +560,17 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
   return rtp_video_sender_->OnEncodedImage(encoded_image, codec_specific_info);
 }
 
+EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImagePart(
+    const EncodedImage& encoded_part,
+    const CodecSpecificInfo* codec_specific_info,
+    bool last_part) {
+  // Bookkeeping of the encoder activity is done when the complete image is
+  // delivered to OnEncodedImage().
+  RTC_DCHECK(!worker_queue_->IsCurrent());
+  return rtp_video_sender_->OnEncodedImagePart(encoded_part,
+                                               codec_specific_info, last_part);
+}
+
 void VideoSendStreamImpl::OnDroppedFrame(
     EncodedImageCallback::DropReason reason) {
   activity_ = true;
@@ -112,6 +112,10 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   EncodedImageCallback::Result OnEncodedImage(
       const EncodedImage& encoded_image,
       const CodecSpecificInfo* codec_specific_info) override;
+  EncodedImageCallback::Result OnEncodedImagePart(
+      const EncodedImage& encoded_part,
+      const CodecSpecificInfo* codec_specific_info,
+      bool last_part) override;
 
   // Implements EncodedImageCallback.
   void OnDroppedFrame(EncodedImageCallback::DropReason reason) override;
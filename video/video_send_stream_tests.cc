@@ -496,6 +496,72 @@ TEST_F(VideoSendStreamTest, SupportsVideoTimingFrames) {
   RunBaseTest(&test);
 }
 
+TEST_F(VideoSendStreamTest, SupportsVideoTimingFramesSentInParts) {
+  class VideoTimingObserver : public test::SendTest {
+   public:
+    VideoTimingObserver()
+        : SendTest(test::VideoTestConstants::kDefaultTimeout),
+          encoder_factory_([]() {
+            auto encoder = std::make_unique<test::FakeH264Encoder>(
+                Clock::GetRealTimeClock());
+            encoder->SetSendFrameParts(true);
+            return encoder;
+          }) {
+      extensions_.Register<VideoTimingExtension>(kVideoTimingExtensionId);
+    }
+
+    Action OnSendRtp(rtc::ArrayView<const uint8_t> packet) override {
+      RtpPacket rtp_packet(&extensions_);
+      EXPECT_TRUE(rtp_packet.Parse(packet));
+      // Don't check packets of the following frames if they happen to get
+      // through before the test terminates.
+      if (first_frame_sent_ || rtp_packet.payload_size() == 0)
+        return SEND_PACKET;
+      if (!first_frame_timestamp_) {
+        // The key frame is sent NAL unit by NAL unit, so its SPS is not
+        // aggregated with the other parameter sets.
+        constexpr uint8_t kSps = 7;
+        EXPECT_EQ(rtp_packet.payload()[0] & 0x1F, kSps);
+        first_frame_timestamp_ = rtp_packet.Timestamp();
+      }
+      if (rtp_packet.Timestamp() != *first_frame_timestamp_)
+        return SEND_PACKET;
+      // Only the last packet of the last part must have the extension.
+      EXPECT_EQ(rtp_packet.HasExtension<VideoTimingExtension>(),
+                rtp_packet.Marker());
+      if (rtp_packet.Marker()) {
+        observation_complete_.Set();
+        first_frame_sent_ = true;
+      }
+      return SEND_PACKET;
+    }
+
+    void ModifyVideoConfigs(
+        VideoSendStream::Config* send_config,
+        std::vector<VideoReceiveStreamInterface::Config>* receive_configs,
+        VideoEncoderConfig* encoder_config) override {
+      send_config->encoder_settings.encoder_factory = &encoder_factory_;
+      send_config->rtp.payload_name = "H264";
+      encoder_config->codec_type = kVideoCodecH264;
+      send_config->rtp.extensions.clear();
+      send_config->rtp.extensions.push_back(
+          RtpExtension(RtpExtension::kVideoTimingUri, kVideoTimingExtensionId));
+    }
+
+    void PerformTest() override {
+      EXPECT_TRUE(Wait()) << "Timed out while waiting for timing frames.";
+    }
+
+   private:
+    test::FunctionVideoEncoderFactory encoder_factory_;
+    RtpHeaderExtensionMap extensions_;
+    absl::optional<uint32_t> first_frame_timestamp_;
+    bool first_frame_sent_ = false;
+  } test;
+
+  RunBaseTest(&test);
+}
+
 class FakeReceiveStatistics : public ReceiveStatisticsProvider {
  public:
   FakeReceiveStatistics(uint32_t send_ssrc,
@@ -21,10 +21,12 @@ namespace internal {
 VideoStreamDecoder::VideoStreamDecoder(
     VideoReceiver2* video_receiver,
     ReceiveStatisticsProxy* receive_statistics_proxy,
-    rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream)
+    rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream,
+    TimingFrameInfoObserver* timing_frame_info_observer)
     : video_receiver_(video_receiver),
       receive_stats_callback_(receive_statistics_proxy),
-      incoming_video_stream_(incoming_video_stream) {
+      incoming_video_stream_(incoming_video_stream),
+      timing_frame_info_observer_(timing_frame_info_observer) {
   RTC_DCHECK(video_receiver_);
 
   video_receiver_->RegisterReceiveCallback(this);
@@ -58,6 +60,12 @@ void VideoStreamDecoder::OnDroppedFrames(uint32_t frames_dropped) {
   receive_stats_callback_->OnDroppedFrames(frames_dropped);
 }
 
+void VideoStreamDecoder::OnTimingFrameInfo(
+    const TimingFrameInfo& timing_frame_info) {
+  if (timing_frame_info_observer_)
+    timing_frame_info_observer_->OnTimingFrameInfo(timing_frame_info);
+}
+
 void VideoStreamDecoder::OnIncomingPayloadType(int payload_type) {
   receive_stats_callback_->OnIncomingPayloadType(payload_type);
 }
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "api/scoped_refptr.h"
+#include "api/video/timing_frame_info_observer.h"
 #include "api/video/video_sink_interface.h"
 #include "api/video_codecs/video_decoder.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
@@ -36,7 +37,8 @@ class VideoStreamDecoder : public VCMReceiveCallback {
   VideoStreamDecoder(
       VideoReceiver2* video_receiver,
       ReceiveStatisticsProxy* receive_statistics_proxy,
-      rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream);
+      rtc::VideoSinkInterface<VideoFrame>* incoming_video_stream,
+      TimingFrameInfoObserver* timing_frame_info_observer = nullptr);
   ~VideoStreamDecoder() override;
 
   // Implements VCMReceiveCallback.
@@ -46,6 +48,7 @@ class VideoStreamDecoder : public VCMReceiveCallback {
                         VideoContentType content_type,
                         VideoFrameType frame_type) override;
   void OnDroppedFrames(uint32_t frames_dropped) override;
+  void OnTimingFrameInfo(const TimingFrameInfo& timing_frame_info) override;
   void OnIncomingPayloadType(int payload_type) override;
   void OnDecoderInfoChanged(
       const VideoDecoder::DecoderInfo& decoder_info) override;
@@ -54,6 +57,7 @@ class VideoStreamDecoder : public VCMReceiveCallback {
   VideoReceiver2* const video_receiver_;
   ReceiveStatisticsProxy* const receive_stats_callback_;
   rtc::VideoSinkInterface<VideoFrame>* const incoming_video_stream_;
+  TimingFrameInfoObserver* const timing_frame_info_observer_;
 };
 
 }  // namespace internal
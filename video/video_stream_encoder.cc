@@ -530,6 +530,32 @@ absl::optional<int> ParseEncoderThreadLimit(const FieldTrialsView& trials) {
   return encoder_thread_limit.GetOptional();
 }
 
+absl::optional<double> ParseTargetEncodeTimeFraction(
+    const FieldTrialsView& trials) {
+  FieldTrialOptional<double> target_encode_time_fraction(
+      "target_encode_time_fraction");
+  ParseFieldTrial({&target_encode_time_fraction},
+                  trials.Lookup("WebRTC-VideoEncoderSettings"));
+  return target_encode_time_fraction.GetOptional();
+}
+
+bool ParseParallelSimulcastEncoding(const FieldTrialsView& trials) {
+  FieldTrialParameter<bool> parallel_simulcast_encoding(
+      "parallel_simulcast_encoding", false);
+  ParseFieldTrial({&parallel_simulcast_encoding},
+                  trials.Lookup("WebRTC-VideoEncoderSettings"));
+  return parallel_simulcast_encoding.Get();
+}
+
+absl::optional<int> ParseTimingFramesDelayMs(const FieldTrialsView& trials) {
+  FieldTrialOptional<int> timing_frames_delay_ms("timing_frames_delay_ms");
+  ParseFieldTrial({&timing_frames_delay_ms},
+                  trials.Lookup("WebRTC-VideoEncoderSettings"));
+  if (timing_frames_delay_ms && *timing_frames_delay_ms < 0)
+    return absl::nullopt;
+  return timing_frames_delay_ms.GetOptional();
+}
+
 absl::optional<VideoSourceRestrictions> MergeRestrictions(
     const std::vector<absl::optional<VideoSourceRestrictions>>& list) {
   absl::optional<VideoSourceRestrictions> return_value;
@@ -546,6 +572,16 @@ absl::optional<VideoSourceRestrictions> MergeRestrictions(
   return return_value;
 }
 
+// Returns the index of the layer the metadata writer tracks `encoded_image` in.
+int GetStreamIndex(const EncodedImage& encoded_image) {
+  // We could either have simulcast layers or spatial layers.
+  // TODO(https://crbug.com/webrtc/14891): If we want to support a mix of
+  // simulcast and SVC we'll also need to consider the case where we have both
+  // simulcast and spatial indices.
+  return encoded_image.SpatialIndex().value_or(
+      encoded_image.SimulcastIndex().value_or(0));
+}
+
 }  //  namespace
 
 VideoStreamEncoder::EncoderRateSettings::EncoderRateSettings()
@@ -722,6 +758,11 @@ VideoStreamEncoder::VideoStreamEncoder(
       vp9_low_tier_core_threshold_(
           ParseVp9LowTierCoreCountThreshold(field_trials)),
       experimental_encoder_thread_limit_(ParseEncoderThreadLimit(field_trials)),
+      experimental_target_encode_time_fraction_(
+          ParseTargetEncodeTimeFraction(field_trials)),
+      experimental_parallel_simulcast_encoding_(
+          ParseParallelSimulcastEncoding(field_trials)),
+      timing_frames_delay_ms_(ParseTimingFramesDelayMs(field_trials)),
       encoder_queue_(std::move(encoder_queue)) {
   TRACE_EVENT0("webrtc", "VideoStreamEncoder::VideoStreamEncoder");
   RTC_DCHECK_RUN_ON(worker_queue_);
@@ -1146,6 +1187,8 @@ void VideoStreamEncoder::ReconfigureEncoder() {
   if (!VideoCodecInitializer::SetupCodec(encoder_config_, streams, &codec)) {
     RTC_LOG(LS_ERROR) << "Failed to create encoder configuration.";
   }
+  if (timing_frames_delay_ms_)
+    codec.timing_frame_thresholds.delay_ms = *timing_frames_delay_ms_;
 
   if (encoder_config_.codec_type == kVideoCodecVP9 ||
       encoder_config_.codec_type == kVideoCodecAV1) {
@@ -1295,6 +1338,10 @@ void VideoStreamEncoder::ReconfigureEncoder() {
     VideoEncoder::Settings settings = VideoEncoder::Settings(
         settings_.capabilities, number_of_cores_, max_data_payload_length);
     settings.encoder_thread_limit = experimental_encoder_thread_limit_;
+    settings.target_encode_time_fraction =
+        experimental_target_encode_time_fraction_;
+    settings.parallel_simulcast_encoding =
+        experimental_parallel_simulcast_encoding_;
     int error = encoder_->InitEncode(&send_codec_, settings);
     if (error != 0) {
       RTC_LOG(LS_ERROR) << "Failed to initialize the encoder associated with "
@@ -2105,12 +2152,7 @@ EncodedImage VideoStreamEncoder::AugmentEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info) {
   EncodedImage image_copy(encoded_image);
-  // We could either have simulcast layers or spatial layers.
-  // TODO(https://crbug.com/webrtc/14891): If we want to support a mix of
-  // simulcast and SVC we'll also need to consider the case where we have both
-  // simulcast and spatial indices.
-  int stream_idx = encoded_image.SpatialIndex().value_or(
-      encoded_image.SimulcastIndex().value_or(0));
+  int stream_idx = GetStreamIndex(encoded_image);
   frame_encode_metadata_writer_.FillTimingInfo(stream_idx, &image_copy);
   frame_encode_metadata_writer_.UpdateBitstream(codec_specific_info,
                                                 &image_copy);
@@ -2229,6 +2271,21 @@ EncodedImageCallback::Result VideoStreamEncoder::OnEncodedImage(
   return result;
 }
 
+EncodedImageCallback::Result VideoStreamEncoder::OnEncodedImagePart(
+    const EncodedImage& encoded_part,
+    const CodecSpecificInfo* codec_specific_info,
+    bool last_part) {
+  // Stats and quality bookkeeping need the complete image and are done in
+  // OnEncodedImage(). The parts get the same metadata, timing and parameter
+  // set rewriting as the complete image, as they are what is sent.
+  EncodedImage part_copy(encoded_part);
+  frame_encode_metadata_writer_.FillPartTimingInfo(
+      GetStreamIndex(encoded_part), &part_copy, last_part);
+  frame_encode_metadata_writer_.UpdateBitstream(codec_specific_info,
+                                                &part_copy);
+  return sink_->OnEncodedImagePart(part_copy, codec_specific_info, last_part);
+}
+
 void VideoStreamEncoder::OnDroppedFrame(DropReason reason) {
   switch (reason) {
     case DropReason::kDroppedByMediaOptimizations:
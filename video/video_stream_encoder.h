@@ -230,6 +230,10 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   EncodedImageCallback::Result OnEncodedImage(
       const EncodedImage& encoded_image,
       const CodecSpecificInfo* codec_specific_info) override;
+  EncodedImageCallback::Result OnEncodedImagePart(
+      const EncodedImage& encoded_part,
+      const CodecSpecificInfo* codec_specific_info,
+      bool last_part) override;
 
   void OnDroppedFrame(EncodedImageCallback::DropReason reason) override;
 
@@ -459,6 +463,11 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
 
   const absl::optional<int> vp9_low_tier_core_threshold_;
   const absl::optional<int> experimental_encoder_thread_limit_;
+  const absl::optional<double> experimental_target_encode_time_fraction_;
+  const bool experimental_parallel_simulcast_encoding_;
+  // Overrides the minimum interval between timing frames, see
+  // VideoCodec::timing_frame_thresholds. 0 makes every frame a timing frame.
+  const absl::optional<int> timing_frames_delay_ms_;
 
   // These are copies of restrictions (glorified max_pixel_count) set by
   // a) OnVideoSourceRestrictionsUpdated
@@ -8539,6 +8539,21 @@ TEST_F(VideoStreamEncoderTest,
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, TimingFramesDelayOverriddenByFieldTrial) {
+  webrtc::test::ScopedKeyValueConfig field_trials(
+      field_trials_, "WebRTC-VideoEncoderSettings/timing_frames_delay_ms:0/");
+  ResetEncoder("VP8", /*num_stream=*/1, /*num_temporal_layers=*/1,
+               /*num_spatial_layers=*/1, /*screenshare=*/false);
+
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  video_source_.IncomingCapturedFrame(CreateFrame(1, codec_width_,
+                                                  codec_height_));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(fake_encoder_.config().timing_frame_thresholds.delay_ms, 0);
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, LowComplexityWithTwoCores) {
   ResetEncoder("VP9", /*num_stream=*/1, /*num_temporal_layers=*/1,
                /*num_spatial_layers=*/1,